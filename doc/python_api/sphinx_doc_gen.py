@@ -278,6 +278,7 @@ else:
         "bmesh.utils",
         "bmesh.geometry",
         "bpy.app",
+        "bpy.app.geometry_nodes_trace",
         "bpy.app.handlers",
         "bpy.app.timers",
         "bpy.app.translations",
@@ -2265,6 +2266,7 @@ def write_rst_importable_modules(basepath):
         "bpy.app": "Application Data",
         "bpy.app.handlers": "Application Handlers",
         "bpy.app.translations": "Application Translations",
+        "bpy.app.geometry_nodes_trace": "Application Geometry Nodes Trace",
         "bpy.app.icons": "Application Icons",
         "bpy.app.timers": "Application Timers",
         "bpy.props": "Property Definitions",
@@ -23,6 +23,7 @@
 using EigenSparseMatrix = Eigen::SparseMatrix<double, Eigen::ColMajor>;
 using EigenSparseLU = Eigen::SparseLU<EigenSparseMatrix>;
 using EigenVectorX = Eigen::VectorXd;
+using EigenMatrixX = Eigen::MatrixXd;
 using EigenTriplet = Eigen::Triplet<double>;
 
 /* Linear Solver data structure */
@@ -301,9 +302,8 @@ bool EIG_linear_solver_solve(LinearSolver *solver)
   }
 
   if (result) {
-    /* solve for each right hand side */
+    /* modify for locked variables */
     for (int rhs = 0; rhs < solver->num_rhs; rhs++) {
-      /* modify for locked variables */
       EigenVectorX &b = solver->b[rhs];
 
       for (int i = 0; i < solver->num_variables; i++) {
@@ -317,23 +317,28 @@ bool EIG_linear_solver_solve(LinearSolver *solver)
           }
         }
       }
+    }
 
-      /* solve */
+    /* Solve for all right hand sides at once: the triangular solves of the factorization are
+     * done in a single pass over its supernodes, instead of one pass per right hand side. */
+    EigenMatrixX B(solver->n, solver->num_rhs);
+    for (int rhs = 0; rhs < solver->num_rhs; rhs++) {
       if (solver->least_squares) {
-        EigenVectorX Mtb = solver->M.transpose() * b;
-        solver->x[rhs] = solver->sparseLU->solve(Mtb);
+        B.col(rhs) = solver->M.transpose() * solver->b[rhs];
       }
       else {
-        EigenVectorX &b = solver->b[rhs];
-        solver->x[rhs] = solver->sparseLU->solve(b);
-      }
-
-      if (solver->sparseLU->info() != Eigen::Success) {
-        result = false;
+        B.col(rhs) = solver->b[rhs];
       }
     }
+    const EigenMatrixX X = solver->sparseLU->solve(B);
 
-    if (result) {
+    if (solver->sparseLU->info() != Eigen::Success) {
+      result = false;
+    }
+    else {
+      for (int rhs = 0; rhs < solver->num_rhs; rhs++) {
+        solver->x[rhs] = X.col(rhs);
+      }
       linear_solver_vector_to_variables(solver);
     }
   }
@@ -7,6 +7,8 @@
 #ifndef OPENSUBDIV_EVAL_OUTPUT_H_
 #define OPENSUBDIV_EVAL_OUTPUT_H_
 
+#include <type_traits>
+
 #include <opensubdiv/osd/cpuPatchTable.h>
 #include <opensubdiv/osd/glPatchTable.h>
 #include <opensubdiv/osd/mesh.h>
@@ -14,6 +16,7 @@
 
 #include "opensubdiv_evaluator.hh"
 #include "opensubdiv_evaluator_capi.hh"
+#include "opensubdiv_topology_refiner.hh"
 
 using OpenSubdiv::Far::PatchTable;
 using OpenSubdiv::Far::StencilTable;
@@ -163,6 +166,12 @@ class ConstPatchCoordWrapperBuffer : public RawDataWrapperVertexBuffer<const Pat
 bool is_adaptive(const CpuPatchTable *patch_table);
 bool is_adaptive(const GLPatchTable *patch_table);
 
+// The CPU evaluator works on the tables of the topology refiner directly, which are shared by all
+// its evaluators. Other evaluators convert the tables to their own representation and own it.
+template<typename STENCIL_TABLE, typename PATCH_TABLE>
+inline constexpr bool uses_shared_evaluator_tables = std::is_same_v<STENCIL_TABLE, StencilTable> &&
+                                                     std::is_same_v<PATCH_TABLE, CpuPatchTable>;
+
 template<typename EVAL_VERTEX_BUFFER,
          typename STENCIL_TABLE,
          typename PATCH_TABLE,
@@ -190,14 +199,21 @@ class FaceVaryingVolatileEval {
                                                 face_varying_stencils->GetNumStencils();
     src_face_varying_data_ = EVAL_VERTEX_BUFFER::Create(
         2, num_total_face_varying_vertices, device_context);
-    face_varying_stencils_ = convertToCompatibleStencilTable<STENCIL_TABLE>(face_varying_stencils,
-                                                                            device_context_);
+    if constexpr (uses_shared_evaluator_tables<STENCIL_TABLE, PATCH_TABLE>) {
+      face_varying_stencils_ = face_varying_stencils;
+    }
+    else {
+      face_varying_stencils_ = convertToCompatibleStencilTable<STENCIL_TABLE>(
+          face_varying_stencils, device_context_);
+    }
   }
 
   ~FaceVaryingVolatileEval()
   {
     delete src_face_varying_data_;
-    delete face_varying_stencils_;
+    if constexpr (!uses_shared_evaluator_tables<STENCIL_TABLE, PATCH_TABLE>) {
+      delete face_varying_stencils_;
+    }
   }
 
   void updateData(const float *src, int start_vertex, int num_vertices)
@@ -316,11 +332,8 @@ class VolatileEvalOutput : public EvalOutputAPI::EvalOutput {
                                                   EVALUATOR,
                                                   DEVICE_CONTEXT>;
 
-  VolatileEvalOutput(const StencilTable *vertex_stencils,
-                     const StencilTable *varying_stencils,
-                     const std::vector<const StencilTable *> &all_face_varying_stencils,
+  VolatileEvalOutput(const EvaluatorTables &tables,
                      const int face_varying_width,
-                     const PatchTable *patch_table,
                      EvaluatorCache *evaluator_cache = NULL,
                      DEVICE_CONTEXT *device_context = NULL)
       : src_vertex_data_(NULL),
@@ -331,6 +344,8 @@ class VolatileEvalOutput : public EvalOutputAPI::EvalOutput {
         evaluator_cache_(evaluator_cache),
         device_context_(device_context)
   {
+    const StencilTable *vertex_stencils = tables.vertex_stencils;
+    const StencilTable *varying_stencils = tables.varying_stencils;
     // Total number of vertices = coarse points + refined points + local points.
     int num_total_vertices = vertex_stencils->GetNumControlVertices() +
                              vertex_stencils->GetNumStencils();
@@ -338,16 +353,23 @@ class VolatileEvalOutput : public EvalOutputAPI::EvalOutput {
     using OpenSubdiv::Osd::convertToCompatibleStencilTable;
     src_data_ = SRC_VERTEX_BUFFER::Create(3, num_total_vertices, device_context_);
     src_varying_data_ = SRC_VERTEX_BUFFER::Create(3, num_total_vertices, device_context_);
-    patch_table_ = PATCH_TABLE::Create(patch_table, device_context_);
-    vertex_stencils_ = convertToCompatibleStencilTable<STENCIL_TABLE>(vertex_stencils,
-                                                                      device_context_);
-    varying_stencils_ = convertToCompatibleStencilTable<STENCIL_TABLE>(varying_stencils,
-                                                                       device_context_);
+    if constexpr (uses_shared_evaluator_tables<STENCIL_TABLE, PATCH_TABLE>) {
+      patch_table_ = tables.getCpuPatchTable();
+      vertex_stencils_ = vertex_stencils;
+      varying_stencils_ = varying_stencils;
+    }
+    else {
+      patch_table_ = PATCH_TABLE::Create(tables.patch_table, device_context_);
+      vertex_stencils_ = convertToCompatibleStencilTable<STENCIL_TABLE>(vertex_stencils,
+                                                                        device_context_);
+      varying_stencils_ = convertToCompatibleStencilTable<STENCIL_TABLE>(varying_stencils,
+                                                                         device_context_);
+    }
 
     // Create evaluators for every face varying channel.
-    face_varying_evaluators_.reserve(all_face_varying_stencils.size());
+    face_varying_evaluators_.reserve(tables.all_face_varying_stencils.size());
     int face_varying_channel = 0;
-    for (const StencilTable *face_varying_stencils : all_face_varying_stencils) {
+    for (const StencilTable *face_varying_stencils : tables.all_face_varying_stencils) {
       face_varying_evaluators_.push_back(new FaceVaryingEval(face_varying_channel,
                                                              face_varying_stencils,
                                                              face_varying_width,
@@ -363,9 +385,11 @@ class VolatileEvalOutput : public EvalOutputAPI::EvalOutput {
     delete src_data_;
     delete src_varying_data_;
     delete src_vertex_data_;
-    delete patch_table_;
-    delete vertex_stencils_;
-    delete varying_stencils_;
+    if constexpr (!uses_shared_evaluator_tables<STENCIL_TABLE, PATCH_TABLE>) {
+      delete patch_table_;
+      delete vertex_stencils_;
+      delete varying_stencils_;
+    }
     for (FaceVaryingEval *face_varying_evaluator : face_varying_evaluators_) {
       delete face_varying_evaluator;
     }
@@ -27,22 +27,14 @@ class CpuEvalOutput : public VolatileEvalOutput<CpuVertexBuffer,
                                                 CpuPatchTable,
                                                 CpuEvaluator> {
  public:
-  CpuEvalOutput(const StencilTable *vertex_stencils,
-                const StencilTable *varying_stencils,
-                const std::vector<const StencilTable *> &all_face_varying_stencils,
+  CpuEvalOutput(const EvaluatorTables &tables,
                 const int face_varying_width,
-                const PatchTable *patch_table,
                 EvaluatorCache *evaluator_cache = nullptr)
       : VolatileEvalOutput<CpuVertexBuffer,
                            CpuVertexBuffer,
                            StencilTable,
                            CpuPatchTable,
-                           CpuEvaluator>(vertex_stencils,
-                                         varying_stencils,
-                                         all_face_varying_stencils,
-                                         face_varying_width,
-                                         patch_table,
-                                         evaluator_cache)
+                           CpuEvaluator>(tables, face_varying_width, evaluator_cache)
   {
   }
 };
@@ -24,22 +24,14 @@ static void buildPatchArraysBufferFromVector(const PatchArrayVector &patch_array
       patch_arrays_buffer, 0, patch_array_byte_site, patch_arrays.data());
 }
 
-GpuEvalOutput::GpuEvalOutput(const StencilTable *vertex_stencils,
-                             const StencilTable *varying_stencils,
-                             const std::vector<const StencilTable *> &all_face_varying_stencils,
+GpuEvalOutput::GpuEvalOutput(const EvaluatorTables &tables,
                              const int face_varying_width,
-                             const PatchTable *patch_table,
                              VolatileEvalOutput::EvaluatorCache *evaluator_cache)
     : VolatileEvalOutput<GLVertexBuffer,
                          GLVertexBuffer,
                          GLStencilTableSSBO,
                          GLPatchTable,
-                         GLComputeEvaluator>(vertex_stencils,
-                                             varying_stencils,
-                                             all_face_varying_stencils,
-                                             face_varying_width,
-                                             patch_table,
-                                             evaluator_cache)
+                         GLComputeEvaluator>(tables, face_varying_width, evaluator_cache)
 {
 }
 
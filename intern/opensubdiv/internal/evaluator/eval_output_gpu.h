@@ -23,11 +23,8 @@ class GpuEvalOutput : public VolatileEvalOutput<GLVertexBuffer,
                                                 GLPatchTable,
                                                 GLComputeEvaluator> {
  public:
-  GpuEvalOutput(const StencilTable *vertex_stencils,
-                const StencilTable *varying_stencils,
-                const std::vector<const StencilTable *> &all_face_varying_stencils,
+  GpuEvalOutput(const EvaluatorTables &tables,
                 const int face_varying_width,
-                const PatchTable *patch_table,
                 EvaluatorCache *evaluator_cache = nullptr);
 
   void fillPatchArraysBuffer(OpenSubdiv_Buffer *patch_arrays_buffer) override;
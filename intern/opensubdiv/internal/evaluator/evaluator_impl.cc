@@ -138,7 +138,7 @@ static void convertPatchCoordsToArray(const OpenSubdiv_PatchCoord *patch_coords,
 ////////////////////////////////////////////////////////////////////////////////
 // Evaluator wrapper for anonymous API.
 
-EvalOutputAPI::EvalOutputAPI(EvalOutput *implementation, PatchMap *patch_map)
+EvalOutputAPI::EvalOutputAPI(EvalOutput *implementation, const PatchMap *patch_map)
     : patch_map_(patch_map), implementation_(implementation)
 {
 }
@@ -406,40 +406,49 @@ bool EvalOutputAPI::hasVertexData() const
 
 }  // namespace blender::opensubdiv
 
-OpenSubdiv_Evaluator::OpenSubdiv_Evaluator()
-    : eval_output(nullptr), patch_map(nullptr), patch_table(nullptr)
+namespace blender::opensubdiv {
+
+// Work around ASAN warnings, due to OpenSubdiv pretending to have an actual StencilTable
+// instance while it's really its base class.
+static void delete_stencil_table(const StencilTable *table)
 {
+  static_assert(std::is_base_of_v<StencilTableReal<float>, StencilTable>);
+  delete reinterpret_cast<const StencilTableReal<float> *>(table);
 }
 
-OpenSubdiv_Evaluator::~OpenSubdiv_Evaluator()
+EvaluatorTables::~EvaluatorTables()
 {
-  delete eval_output;
-  delete patch_map;
+  delete_stencil_table(vertex_stencils);
+  delete_stencil_table(varying_stencils);
+  for (const StencilTable *table : all_face_varying_stencils) {
+    delete_stencil_table(table);
+  }
   delete patch_table;
+  delete patch_map;
+  delete cpu_patch_table_;
 }
 
-OpenSubdiv_Evaluator *openSubdiv_createEvaluatorFromTopologyRefiner(
-    blender::opensubdiv::TopologyRefinerImpl *topology_refiner,
-    eOpenSubdivEvaluator evaluator_type,
-    OpenSubdiv_EvaluatorCache *evaluator_cache_descr)
+CpuPatchTable *EvaluatorTables::getCpuPatchTable() const
+{
+  std::call_once(cpu_patch_table_once_,
+                 [&]() { cpu_patch_table_ = CpuPatchTable::Create(patch_table); });
+  return cpu_patch_table_;
+}
+
+static EvaluatorTables *create_evaluator_tables(TopologyRefiner *refiner,
+                                                const OpenSubdiv_TopologyRefinerSettings &settings)
 {
-  TopologyRefiner *refiner = topology_refiner->topology_refiner;
-  if (refiner == nullptr) {
-    // Happens on bad topology.
-    return nullptr;
-  }
   // TODO(sergey): Base this on actual topology.
   const bool has_varying_data = false;
   const int num_face_varying_channels = refiner->GetNumFVarChannels();
   const bool has_face_varying_data = (num_face_varying_channels != 0);
-  const int level = topology_refiner->settings.level;
-  const bool is_adaptive = topology_refiner->settings.is_adaptive;
+  const int level = settings.level;
+  const bool is_adaptive = settings.is_adaptive;
   // Common settings for stencils and patches.
   const bool stencil_generate_intermediate_levels = is_adaptive;
   const bool stencil_generate_offsets = true;
   const bool use_inf_sharp_patch = true;
   // Refine the topology with given settings.
-  // TODO(sergey): What if topology is already refined?
   if (is_adaptive) {
     TopologyRefiner::AdaptiveOptions options(level);
     options.considerFVarChannels = has_face_varying_data;
@@ -451,12 +460,7 @@ OpenSubdiv_Evaluator *openSubdiv_createEvaluatorFromTopologyRefiner(
     refiner->RefineUniform(options);
   }
 
-  // Work around ASAN warnings, due to OpenSubdiv pretending to have an actual StencilTable
-  // instance while it's really its base class.
-  auto delete_stencil_table = [](const StencilTable *table) {
-    static_assert(std::is_base_of_v<StencilTableReal<float>, StencilTable>);
-    delete reinterpret_cast<const StencilTableReal<float> *>(table);
-  };
+  EvaluatorTables *tables = new EvaluatorTables();
 
   // Generate stencil table to update the bi-cubic patches control vertices
   // after they have been re-posed (both for vertex & varying interpolation).
@@ -480,7 +484,8 @@ OpenSubdiv_Evaluator *openSubdiv_createEvaluatorFromTopologyRefiner(
     varying_stencils = StencilTableFactory::Create(*refiner, varying_stencil_options);
   }
   // Face warying stencil.
-  std::vector<const StencilTable *> all_face_varying_stencils;
+  std::vector<const StencilTable *> &all_face_varying_stencils =
+      tables->all_face_varying_stencils;
   all_face_varying_stencils.reserve(num_face_varying_channels);
   for (int face_varying_channel = 0; face_varying_channel < num_face_varying_channels;
        ++face_varying_channel)
@@ -533,6 +538,95 @@ OpenSubdiv_Evaluator *openSubdiv_createEvaluatorFromTopologyRefiner(
       all_face_varying_stencils[face_varying_channel] = table;
     }
   }
+
+  tables->vertex_stencils = vertex_stencils;
+  tables->varying_stencils = varying_stencils;
+  tables->patch_table = patch_table;
+  tables->patch_map = new PatchMap(*patch_table);
+  return tables;
+}
+
+std::shared_ptr<const EvaluatorTables> TopologyRefinerImpl::ensureEvaluatorTables()
+{
+  if (topology_refiner == nullptr) {
+    // Happens on bad topology.
+    return nullptr;
+  }
+  std::lock_guard lock(evaluator_tables_mutex);
+  if (!evaluator_tables) {
+    // The refinement is only done once: the tables are kept for as long as the refiner lives, so
+    // that refiners shared between multiple subdivision surfaces are not modified afterwards.
+    evaluator_tables.reset(create_evaluator_tables(topology_refiner, settings));
+  }
+  return evaluator_tables;
+}
+
+static int64_t stencil_table_memory_bytes(const StencilTable *table)
+{
+  if (table == nullptr) {
+    return 0;
+  }
+  return int64_t(table->GetSizes().size() + table->GetOffsets().size() +
+                 table->GetControlIndices().size()) *
+             sizeof(int) +
+         int64_t(table->GetWeights().size()) * sizeof(float);
+}
+
+int64_t TopologyRefinerImpl::estimateMemoryBytes() const
+{
+  int64_t bytes = sizeof(*this);
+  if (topology_refiner != nullptr) {
+    // Rough estimate of the topology tables of all levels: every vertex, edge and face keeps a
+    // handful of indices for its neighborhood.
+    const int num_vertices = topology_refiner->GetNumVerticesTotal();
+    const int num_edges = topology_refiner->GetNumEdgesTotal();
+    const int num_faces = topology_refiner->GetNumFacesTotal();
+    const int num_face_vertices = topology_refiner->GetNumFaceVerticesTotal();
+    bytes += (int64_t(num_vertices) * 12 + int64_t(num_edges) * 8 + int64_t(num_faces) * 4 +
+              int64_t(num_face_vertices) * 4) *
+             int64_t(sizeof(int));
+  }
+  if (evaluator_tables) {
+    bytes += stencil_table_memory_bytes(evaluator_tables->vertex_stencils);
+    bytes += stencil_table_memory_bytes(evaluator_tables->varying_stencils);
+    for (const StencilTable *table : evaluator_tables->all_face_varying_stencils) {
+      bytes += stencil_table_memory_bytes(table);
+    }
+    if (const PatchTable *patch_table = evaluator_tables->patch_table) {
+      bytes += int64_t(patch_table->GetPatchControlVerticesTable().size()) * sizeof(int);
+      bytes += int64_t(patch_table->GetNumPatchesTotal()) *
+               int64_t(sizeof(OpenSubdiv::Far::PatchParam));
+    }
+    if (const PatchMap *patch_map = evaluator_tables->patch_map) {
+      bytes += int64_t(patch_map->getHandles().size()) * int64_t(sizeof(PatchMap::Handle));
+      bytes += int64_t(patch_map->nodes().size()) * int64_t(sizeof(PatchMap::QuadNode));
+    }
+  }
+  return bytes;
+}
+
+}  // namespace blender::opensubdiv
+
+OpenSubdiv_Evaluator::OpenSubdiv_Evaluator() : eval_output(nullptr), patch_map(nullptr) {}
+
+OpenSubdiv_Evaluator::~OpenSubdiv_Evaluator()
+{
+  delete eval_output;
+}
+
+OpenSubdiv_Evaluator *openSubdiv_createEvaluatorFromTopologyRefiner(
+    blender::opensubdiv::TopologyRefinerImpl *topology_refiner,
+    eOpenSubdivEvaluator evaluator_type,
+    OpenSubdiv_EvaluatorCache *evaluator_cache_descr)
+{
+  // The tables only depend on the topology, so they are shared between all evaluators which are
+  // created for the same topology refiner.
+  std::shared_ptr<const blender::opensubdiv::EvaluatorTables> tables =
+      topology_refiner->ensureEvaluatorTables();
+  if (!tables) {
+    // Happens on bad topology.
+    return nullptr;
+  }
   // Create OpenSubdiv's CPU side evaluator.
   blender::opensubdiv::EvalOutputAPI::EvalOutput *eval_output = nullptr;
 
@@ -544,32 +638,19 @@ OpenSubdiv_Evaluator *openSubdiv_createEvaluatorFromTopologyRefiner(
           evaluator_cache_descr->impl->eval_cache);
     }
 
-    eval_output = new blender::opensubdiv::GpuEvalOutput(vertex_stencils,
-                                                         varying_stencils,
-                                                         all_face_varying_stencils,
-                                                         2,
-                                                         patch_table,
-                                                         evaluator_cache);
+    eval_output = new blender::opensubdiv::GpuEvalOutput(*tables, 2, evaluator_cache);
   }
   else {
-    eval_output = new blender::opensubdiv::CpuEvalOutput(
-        vertex_stencils, varying_stencils, all_face_varying_stencils, 2, patch_table);
+    eval_output = new blender::opensubdiv::CpuEvalOutput(*tables, 2);
   }
 
-  blender::opensubdiv::PatchMap *patch_map = new blender::opensubdiv::PatchMap(*patch_table);
   // Wrap everything we need into an object which we control from our side.
   OpenSubdiv_Evaluator *evaluator = new OpenSubdiv_Evaluator();
   evaluator->type = evaluator_type;
 
-  evaluator->eval_output = new blender::opensubdiv::EvalOutputAPI(eval_output, patch_map);
-  evaluator->patch_map = patch_map;
-  evaluator->patch_table = patch_table;
-  // TODO(sergey): Look into whether we've got duplicated stencils arrays.
-  delete_stencil_table(vertex_stencils);
-  delete_stencil_table(varying_stencils);
-  for (const StencilTable *table : all_face_varying_stencils) {
-    delete_stencil_table(table);
-  }
+  evaluator->eval_output = new blender::opensubdiv::EvalOutputAPI(eval_output, tables->patch_map);
+  evaluator->patch_map = tables->patch_map;
+  evaluator->tables = std::move(tables);
 
   return evaluator;
 }
@@ -90,12 +90,12 @@ class PatchMap {
     return _patchesAreTriangular;
   }
 
-  const std::vector<Handle> &getHandles()
+  const std::vector<Handle> &getHandles() const
   {
     return _handles;
   }
 
-  const std::vector<QuadNode> &nodes()
+  const std::vector<QuadNode> &nodes() const
   {
     return _quadtree;
   }
@@ -11,6 +11,8 @@
 #  include <iso646.h>
 #endif
 
+#include <memory>
+
 #include <opensubdiv/far/patchMap.h>
 #include <opensubdiv/far/patchTable.h>
 
@@ -24,6 +26,7 @@ struct OpenSubdiv_PatchCoord;
 namespace blender::opensubdiv {
 
 class TopologyRefinerImpl;
+class EvaluatorTables;
 class PatchMap;
 
 // Wrapper around implementation, which defines API which we are capable to
@@ -34,7 +37,7 @@ class EvalOutputAPI {
   class EvalOutput;
 
   // NOTE: PatchMap is not owned, only referenced.
-  EvalOutputAPI(EvalOutput *implementation, PatchMap *patch_map);
+  EvalOutputAPI(EvalOutput *implementation, const PatchMap *patch_map);
 
   ~EvalOutputAPI();
 
@@ -172,7 +175,7 @@ class EvalOutputAPI {
   bool hasVertexData() const;
 
  protected:
-  PatchMap *patch_map_;
+  const PatchMap *patch_map_;
   EvalOutput *implementation_;
 };
 
@@ -180,8 +183,11 @@ class EvalOutputAPI {
 
 struct OpenSubdiv_Evaluator {
   blender::opensubdiv::EvalOutputAPI *eval_output;
+  // Owned by the tables.
   const blender::opensubdiv::PatchMap *patch_map;
-  const OpenSubdiv::Far::PatchTable *patch_table;
+  // Stencil and patch tables of the topology refiner the evaluator is created for. The evaluator
+  // keeps them alive, so it can outlive the topology refiner.
+  std::shared_ptr<const blender::opensubdiv::EvaluatorTables> tables;
 
   eOpenSubdivEvaluator type;
 
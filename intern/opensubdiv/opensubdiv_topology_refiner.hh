@@ -11,7 +11,15 @@
 #  include <iso646.h>
 #endif
 
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <opensubdiv/far/patchTable.h>
+#include <opensubdiv/far/stencilTable.h>
 #include <opensubdiv/far/topologyRefiner.h>
+#include <opensubdiv/osd/cpuPatchTable.h>
 
 #include "internal/topology/mesh_topology.h"
 
@@ -29,6 +37,33 @@ struct OpenSubdiv_Converter;
 
 namespace blender::opensubdiv {
 
+class PatchMap;
+
+// Tables which are needed to evaluate the limit surface. They only depend on the topology and
+// the refinement settings, so they are created once per topology refiner and are shared by all
+// evaluators created for it. The CPU evaluator uses them directly, GPU evaluators upload their
+// own copy to the device.
+class EvaluatorTables {
+ public:
+  const OpenSubdiv::Far::StencilTable *vertex_stencils = nullptr;
+  const OpenSubdiv::Far::StencilTable *varying_stencils = nullptr;
+  std::vector<const OpenSubdiv::Far::StencilTable *> all_face_varying_stencils;
+  const OpenSubdiv::Far::PatchTable *patch_table = nullptr;
+  const PatchMap *patch_map = nullptr;
+
+  ~EvaluatorTables();
+
+  // The patch table in the layout used by the CPU evaluator, created on first use. Can be called
+  // from multiple threads.
+  OpenSubdiv::Osd::CpuPatchTable *getCpuPatchTable() const;
+
+ private:
+  mutable std::once_flag cpu_patch_table_once_;
+  mutable OpenSubdiv::Osd::CpuPatchTable *cpu_patch_table_ = nullptr;
+
+  MEM_CXX_CLASS_ALLOC_FUNCS("EvaluatorTables");
+};
+
 class TopologyRefinerImpl {
  public:
   // NOTE: Will return nullptr if topology refiner can not be created (for
@@ -49,6 +84,15 @@ class TopologyRefinerImpl {
   // Covers options, geometry, and geometry tags.
   bool isEqualToConverter(const OpenSubdiv_Converter *converter) const;
 
+  // Refine the topology and create the tables for evaluation on the first call. Can be called
+  // from multiple threads, the refiner is not modified by later calls.
+  //
+  // Returns nullptr on bad topology.
+  std::shared_ptr<const EvaluatorTables> ensureEvaluatorTables();
+
+  // Approximate amount of memory used by the refiner and its evaluator tables, in bytes.
+  int64_t estimateMemoryBytes() const;
+
   OpenSubdiv::Far::TopologyRefiner *topology_refiner;
 
   // Subdivision settingsa this refiner is created for.
@@ -70,6 +114,9 @@ class TopologyRefinerImpl {
   //    corner vertices.
   MeshTopology base_mesh_topology;
 
+  std::mutex evaluator_tables_mutex;
+  std::shared_ptr<const EvaluatorTables> evaluator_tables;
+
   MEM_CXX_CLASS_ALLOC_FUNCS("TopologyRefinerImpl");
 };
 
@@ -4,6 +4,7 @@
 
 #include "ANIM_evaluation.hh"
 
+#include "BKE_anim_eval_plan.hh"
 #include "BKE_animsys.h"
 #include "BKE_fcurve.hh"
 
@@ -143,8 +144,13 @@ static EvaluationResult evaluate_keyframe_data(PointerRNA &animated_id_ptr,
     return {};
   }
 
+  const Span<FCurve *> fcurves = channelbag_for_slot->fcurves();
+  bke::FCurvesEvalPlan *plan = bke::fcurves_eval_plan_ensure(
+      animated_id_ptr, channelbag_for_slot, fcurves);
+
   EvaluationResult evaluation_result;
-  for (FCurve *fcu : channelbag_for_slot->fcurves()) {
+  for (const int i : fcurves.index_range()) {
+    FCurve *fcu = fcurves[i];
     /* Blatant copy of animsys_evaluate_fcurves(). */
 
     if (!is_fcurve_evaluatable(fcu)) {
@@ -152,8 +158,11 @@ static EvaluationResult evaluate_keyframe_data(PointerRNA &animated_id_ptr,
     }
 
     PathResolvedRNA anim_rna;
-    if (!BKE_animsys_rna_path_resolve(
-            &animated_id_ptr, fcu->rna_path, fcu->array_index, &anim_rna))
+    if (plan && plan->is_resolved[i]) {
+      anim_rna = plan->rna[i];
+    }
+    else if (!BKE_animsys_rna_path_resolve(
+                 &animated_id_ptr, fcu->rna_path, fcu->array_index, &anim_rna))
     {
       /* Log this at quite a high level, because it can get _very_ noisy when playing back
        * animation. */
@@ -166,7 +175,8 @@ static EvaluationResult evaluate_keyframe_data(PointerRNA &animated_id_ptr,
       continue;
     }
 
-    const float curval = calculate_fcurve(&anim_rna, fcu, &offset_eval_context);
+    const float curval = calculate_fcurve(
+        &anim_rna, fcu, &offset_eval_context, plan ? &plan->segment_hints[i] : nullptr);
     evaluation_result.store(fcu->rna_path, fcu->array_index, curval, anim_rna);
   }
 
@@ -0,0 +1,75 @@
+/* SPDX-FileCopyrightText: 2025 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+/** \file
+ * \ingroup bke
+ *
+ * Evaluation plans cache what is needed to evaluate a list of F-Curves on an evaluated ID, so
+ * that it does not have to be recomputed on every frame. Most importantly that is the resolved
+ * RNA property of every F-Curve, which is expensive to find from the RNA path.
+ *
+ * The plans are stored in #AnimData::eval_plans of evaluated IDs and are freed together with the
+ * evaluated copy. Since the cached properties point into the evaluated ID and the F-Curves belong
+ * to the evaluated Action, all plans are invalidated when the depsgraph relations are rebuilt or
+ * an Action is copied to its evaluated copy again.
+ */
+
+#include <memory>
+
+#include "BLI_array.hh"
+#include "BLI_bit_vector.hh"
+#include "BLI_map.hh"
+#include "BLI_span.hh"
+
+#include "RNA_types.hh"
+
+struct AnimData;
+struct FCurve;
+struct PointerRNA;
+
+namespace blender::bke {
+
+/** Cached evaluation data for a list of F-Curves, stored in a struct-of-arrays layout. */
+struct FCurvesEvalPlan {
+  /** The F-Curves the plan was created for, used to detect when the plan is outdated. */
+  Array<const FCurve *> fcurves;
+  /** The resolved property of every F-Curve. Only valid when #is_resolved is set. */
+  Array<PathResolvedRNA> rna;
+  bits::BitVector<> is_resolved;
+  /**
+   * The keyframe segment that was used in the last evaluation of every F-Curve. During playback
+   * the next evaluation usually uses the same or the next segment, so it is checked first.
+   */
+  Array<int> segment_hints;
+};
+
+struct AnimDataEvalPlans {
+  /** Plans are outdated when this does not match the global generation anymore. */
+  uint64_t generation = 0;
+  /** The plans for the F-Curve lists that were evaluated on the ID, by an owner of the list. */
+  Map<const void *, std::unique_ptr<FCurvesEvalPlan>> plans;
+};
+
+/**
+ * Get the evaluation plan for F-Curves that are evaluated on the given ID, creating it if
+ * necessary.
+ *
+ * \param key: Identifies the list of F-Curves, e.g. the Action or Channelbag that contains them.
+ * \return Null when the ID is not an evaluated copy, in which case the F-Curves should be
+ * evaluated without caching.
+ */
+FCurvesEvalPlan *fcurves_eval_plan_ensure(PointerRNA &id_ptr,
+                                          const void *key,
+                                          Span<FCurve *> fcurves);
+
+void anim_eval_plans_free(AnimData &adt);
+
+/**
+ * Invalidate the evaluation plans of all IDs. They are recreated lazily on the next evaluation.
+ */
+void anim_eval_plans_invalidate_all();
+
+}  // namespace blender::bke
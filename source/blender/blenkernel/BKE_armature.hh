@@ -629,6 +629,21 @@ void BKE_pose_eval_cleanup(Depsgraph *depsgraph, Scene *scene, Object *object);
 /* Note that we could have a 'BKE_armature_deform_coords' that doesn't take object data
  * currently there are no callers for this though. */
 
+namespace blender::bke {
+
+/**
+ * The vertex group weights of a mesh in a compressed sparse row layout, which only contains
+ * the weights of groups that belong to deforming bones. It is rebuilt when the vertex group data
+ * of the mesh or the mapping of vertex groups to bones changes, so that it can be reused for
+ * every frame of an animation.
+ */
+struct ArmatureDeformSkinningCache;
+
+ArmatureDeformSkinningCache *armature_deform_skinning_cache_new();
+void armature_deform_skinning_cache_free(ArmatureDeformSkinningCache *cache);
+
+}  // namespace blender::bke
+
 void BKE_armature_deform_coords_with_curves(
     const Object &ob_arm,
     const Object &ob_target,
@@ -640,15 +655,17 @@ void BKE_armature_deform_coords_with_curves(
     int deformflag,
     blender::StringRefNull defgrp_name);
 
-void BKE_armature_deform_coords_with_mesh(const Object *ob_arm,
-                                          const Object *ob_target,
-                                          float (*vert_coords)[3],
-                                          float (*vert_deform_mats)[3][3],
-                                          int vert_coords_len,
-                                          int deformflag,
-                                          float (*vert_coords_prev)[3],
-                                          const char *defgrp_name,
-                                          const Mesh *me_target);
+void BKE_armature_deform_coords_with_mesh(
+    const Object *ob_arm,
+    const Object *ob_target,
+    float (*vert_coords)[3],
+    float (*vert_deform_mats)[3][3],
+    int vert_coords_len,
+    int deformflag,
+    float (*vert_coords_prev)[3],
+    const char *defgrp_name,
+    const Mesh *me_target,
+    blender::bke::ArmatureDeformSkinningCache *skinning_cache = nullptr);
 
 void BKE_armature_deform_coords_with_editmesh(const Object *ob_arm,
                                               const Object *ob_target,
@@ -7,6 +7,7 @@
 #include <functional>
 #include <optional>
 
+#include "BLI_bit_vector.hh"
 #include "BLI_function_ref.hh"
 #include "BLI_generic_pointer.hh"
 #include "BLI_generic_virtual_array.hh"
@@ -644,6 +645,15 @@ class AttributeAccessor {
     return {VArray<T>::ForSingle(default_value, this->domain_size(domain)), domain};
   }
 
+  /**
+   * Read a boolean attribute packed into bits, which take 8 times less memory than the attribute
+   * itself. If necessary, the attribute is interpolated to the given domain and converted to
+   * booleans. If the attribute does not exist, all bits are set to the default value.
+   */
+  BitVector<> lookup_or_default_bits(StringRef attribute_id,
+                                     AttrDomain domain,
+                                     bool default_value) const;
+
   /**
    * Same as the generic version above, but should be used when the type is known at compile time.
    */
@@ -7,9 +7,8 @@
  * \ingroup bke
  */
 
-#ifdef __cplusplus
-extern "C" {
-#endif
+#include "BLI_math_vector_types.hh"
+#include "BLI_span.hh"
 
 struct Collection;
 struct Depsgraph;
@@ -130,6 +129,11 @@ void BKE_effectors_apply(struct ListBase *effectors,
                          float *wind_force,
                          float *impulse);
 void BKE_effectors_free(struct ListBase *lb);
+/**
+ * Whether an effector uses random noise. Then the result of #BKE_effectors_apply depends on the
+ * order in which points are evaluated.
+ */
+bool BKE_effectors_use_random_noise(const struct ListBase *effectors);
 
 void pd_point_from_particle(struct ParticleSimulationData *sim,
                             struct ParticleData *pa,
@@ -277,6 +281,38 @@ void BKE_sim_debug_data_remove_element(unsigned int hash);
 void BKE_sim_debug_data_clear(void);
 void BKE_sim_debug_data_clear_category(const char *category);
 
-#ifdef __cplusplus
-}
-#endif
+/**
+ * Evaluate the effectors for many points at once, with the same result as calling
+ * #BKE_effectors_apply for every point in order. Effectors are evaluated one after the other:
+ * data that doesn't depend on the point is computed once per effector, and points outside of the
+ * effector's maximum distance are skipped early. The points are evaluated in parallel, except for
+ * effectors with random noise, which depends on the order of evaluation.
+ *
+ * The results are added to the existing values.
+ *
+ * \param r_wind_forces, r_impulses: Optional, when empty all of the force is added to
+ * \a r_forces and impulses are ignored.
+ */
+void BKE_effectors_apply_points(ListBase *effectors,
+                                ListBase *colliders,
+                                EffectorWeights *weights,
+                                blender::MutableSpan<EffectedPoint> points,
+                                blender::MutableSpan<blender::float3> r_forces,
+                                blender::MutableSpan<blender::float3> r_wind_forces,
+                                blender::MutableSpan<blender::float3> r_impulses);
+
+/**
+ * Evaluate the effectors for points created by #pd_point_from_loc for every position, see
+ * #BKE_effectors_apply_points.
+ *
+ * \param r_wind_forces: Optional, when empty all of the force is added to \a r_forces.
+ * It may also be the same as \a r_forces.
+ */
+void BKE_effectors_apply_array(ListBase *effectors,
+                               ListBase *colliders,
+                               EffectorWeights *weights,
+                               const Scene *scene,
+                               blender::Span<blender::float3> positions,
+                               blender::Span<blender::float3> velocities,
+                               blender::MutableSpan<blender::float3> r_forces,
+                               blender::MutableSpan<blender::float3> r_wind_forces);
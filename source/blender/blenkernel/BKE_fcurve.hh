@@ -594,8 +594,13 @@ void BKE_fcurve_correct_bezpart(const float v1[2], float v2[2], float v3[2], con
 
 /* -------- Evaluation -------- */
 
-/* evaluate fcurve */
-float evaluate_fcurve(const FCurve *fcu, float evaltime);
+/**
+ * Evaluate the F-Curve at the given time.
+ *
+ * \param segment_hint: Optional index of the keyframe segment found in a previous evaluation.
+ * It is checked before searching all keyframes and is updated to the segment that was used.
+ */
+float evaluate_fcurve(const FCurve *fcu, float evaltime, int *segment_hint = nullptr);
 float evaluate_fcurve_only_curve(const FCurve *fcu, float evaltime);
 float evaluate_fcurve_driver(PathResolvedRNA *anim_rna,
                              FCurve *fcu,
@@ -611,7 +616,8 @@ bool BKE_fcurve_is_empty(const FCurve *fcu);
  */
 float calculate_fcurve(PathResolvedRNA *anim_rna,
                        FCurve *fcu,
-                       const AnimationEvalContext *anim_eval_context);
+                       const AnimationEvalContext *anim_eval_context,
+                       int *segment_hint = nullptr);
 
 /* ************* F-Curve Samples API ******************** */
 
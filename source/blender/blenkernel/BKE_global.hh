@@ -271,6 +271,8 @@ enum {
 
   G_DEBUG_GHOST = (1 << 24),  /* Debug GHOST module. */
   G_DEBUG_WINTAB = (1 << 25), /* Debug Wintab. */
+  /* Compare incrementally updated dependency graphs against a full rebuild. */
+  G_DEBUG_DEPSGRAPH_VALIDATE = (1 << 26),
 };
 
 #define G_DEBUG_ALL \
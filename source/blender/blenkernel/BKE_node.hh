@@ -403,6 +403,12 @@ struct bNodeType {
 
   /** True when the node cannot be muted. */
   bool no_muting = false;
+  /**
+   * True when the outputs of #geometry_node_execute only depend on the node inputs and settings.
+   * Outputs of such nodes can be reused when the node is evaluated again with the same inputs.
+   * The node storage must not contain pointers, because it is compared byte-wise.
+   */
+  bool geometry_node_cacheable = false;
   /** True when the node still works but it's usage is discouraged. */
   const char *deprecation_notice = nullptr;
 
@@ -64,9 +64,10 @@ void BKE_ntree_update_tag_image_user_changed(bNodeTree *ntree, ImageUser *iuser)
 struct NodeTreeUpdateExtraParams {
   /**
    * Called for every tree that has been changed during the update. This can be used to send
-   * notifiers to trigger redraws or depsgraph updates.
+   * notifiers to trigger redraws or depsgraph updates. When only values of the tree changed, its
+   * evaluated copy may be updated without copying the whole tree again.
    */
-  std::function<void(bNodeTree &, ID &owner)> tree_changed_fn;
+  std::function<void(bNodeTree &, ID &owner, bool only_values_changed)> tree_changed_fn;
 
   /**
    * Called for every tree whose output value may have changed based on the provided update tags.
@@ -0,0 +1,102 @@
+/* SPDX-FileCopyrightText: 2025 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+/** \file
+ * \ingroup bke
+ *
+ * Cache of evaluated object geometry for animation playback in the viewport. When enabled, the
+ * evaluated mesh, curves and point cloud of objects are stored for every frame. When the same
+ * frame is evaluated again without any change to the scene in between, the modifier stack is
+ * skipped and the cached geometry is used instead. This gives real-time playback for scenes that
+ * are too heavy to evaluate in real-time, after the first time the frame range was played.
+ *
+ * The cached geometry shares its data with the evaluated geometry with implicit sharing, so
+ * storing it is cheap. The cache is owned by the depsgraph and is cleared when any ID is tagged
+ * for an update that may change geometry, or when the relations are rebuilt. The amount of memory
+ * is limited by the "Memory Cache Limit" user preference, the least recently used frames are
+ * removed first.
+ */
+
+#include <atomic>
+#include <mutex>
+
+#include "BLI_map.hh"
+#include "BLI_memory_counter.hh"
+#include "BLI_utility_mixins.hh"
+
+#include "DNA_customdata_types.h"
+
+#include "BKE_geometry_set.hh"
+
+struct Depsgraph;
+struct Object;
+
+namespace blender::bke {
+
+class PlaybackGeometryCache : NonCopyable, NonMovable {
+ public:
+  struct Entry {
+    /** The evaluated geometry of the object, which owns a copy of the evaluated data. */
+    GeometrySet geometry;
+    /** Only used for meshes, the evaluated mesh with only deform modifiers applied. */
+    GeometrySet deform_geometry;
+    /** The mesh data masks that were requested when the geometry was evaluated. */
+    CustomData_MeshMasks requested_mesh_masks;
+    CustomData_MeshMasks mesh_masks;
+    bool need_mapping = false;
+    /** The memory that is only used by this entry, at the time it was added. */
+    int64_t memory_bytes = 0;
+    uint64_t last_used = 0;
+  };
+
+ private:
+  struct Key {
+    uint32_t session_uid;
+    float frame;
+
+    uint64_t hash() const;
+    BLI_STRUCT_EQUALITY_OPERATORS_2(Key, session_uid, frame)
+  };
+
+  std::mutex mutex_;
+  Map<Key, std::unique_ptr<Entry>> entries_;
+  /** Counts data that is shared between entries only once. */
+  memory_counter::MemoryCount memory_;
+  uint64_t usage_clock_ = 0;
+  std::atomic<bool> is_empty_ = true;
+
+ public:
+  /**
+   * Whether the geometry of the object can be cached in the depsgraph. Caching is only done for
+   * the active viewport depsgraph, for objects in object mode that don't depend on simulation
+   * state.
+   */
+  static bool is_supported(const Depsgraph &depsgraph, const Object &object);
+
+  /** Whether tagging an ID with the given #IDRecalcFlag flags may change evaluated geometry. */
+  static bool is_invalidated_by_recalc(unsigned int flags);
+
+  /**
+   * Replace the evaluated geometry of the object with the geometry cached for the current frame.
+   * \param mesh_masks: The mesh data masks that are requested for the evaluated mesh.
+   * \return False if there is no cached geometry for the frame.
+   */
+  bool restore(const Depsgraph &depsgraph, Object &object, const CustomData_MeshMasks &mesh_masks);
+
+  /** Add the evaluated geometry of the object for the current frame to the cache. */
+  void store(const Depsgraph &depsgraph,
+             const Object &object,
+             const CustomData_MeshMasks &mesh_masks);
+
+  void clear();
+
+  int64_t memory_bytes();
+
+ private:
+  void remove_least_recently_used(int64_t max_bytes);
+};
+
+}  // namespace blender::bke
@@ -8,6 +8,8 @@
 
 #pragma once
 
+#include <cstdint>
+
 #include "BLI_compiler_compat.h"
 
 struct Mesh;
@@ -193,6 +195,13 @@ struct Subdiv {
 void init();
 void exit();
 
+/**
+ * Set how much memory topology refiners which are not used by any subdivision surface can use.
+ * They are kept to be reused when an equal topology is subdivided again, the least recently used
+ * ones are freed when the limit is exceeded.
+ */
+void topology_refiner_cache_set_limit(int64_t max_bytes);
+
 /* --------------------------------------------------------------------
  * Conversion helpers.
  */
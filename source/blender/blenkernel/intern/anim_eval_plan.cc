@@ -0,0 +1,123 @@
+/* SPDX-FileCopyrightText: 2025 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup bke
+ */
+
+#include <atomic>
+
+#include "MEM_guardedalloc.h"
+
+#include "DNA_anim_types.h"
+#include "DNA_ID.h"
+
+#include "BKE_anim_data.hh"
+#include "BKE_anim_eval_plan.hh"
+#include "BKE_animsys.h"
+#include "BKE_lib_id.hh"
+
+#include "RNA_access.hh"
+
+namespace blender::bke {
+
+static std::atomic<uint64_t> global_generation = 1;
+
+/**
+ * Only properties of the ID itself and its embedded IDs are cached. Other IDs may be copied to
+ * their evaluated copy again without the animated ID being copied, which would invalidate the
+ * pointers into their data.
+ */
+static bool is_cacheable_property(const ID &id, const PathResolvedRNA &rna)
+{
+  ID *owner_id = rna.ptr.owner_id;
+  if (owner_id == &id) {
+    return true;
+  }
+  if (owner_id != nullptr && (owner_id->flag & ID_FLAG_EMBEDDED_DATA)) {
+    return BKE_id_owner_get(owner_id, false) == &id;
+  }
+  return false;
+}
+
+static bool plan_matches(const FCurvesEvalPlan &plan, const Span<FCurve *> fcurves)
+{
+  if (plan.fcurves.size() != fcurves.size()) {
+    return false;
+  }
+  for (const int i : fcurves.index_range()) {
+    if (plan.fcurves[i] != fcurves[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static std::unique_ptr<FCurvesEvalPlan> create_plan(PointerRNA &id_ptr,
+                                                    const Span<FCurve *> fcurves)
+{
+  const ID &id = *id_ptr.owner_id;
+  auto plan = std::make_unique<FCurvesEvalPlan>();
+  plan->fcurves.reinitialize(fcurves.size());
+  plan->rna.reinitialize(fcurves.size());
+  plan->is_resolved.resize(fcurves.size(), false);
+  plan->segment_hints.reinitialize(fcurves.size());
+  plan->segment_hints.fill(0);
+  for (const int i : fcurves.index_range()) {
+    const FCurve *fcu = fcurves[i];
+    plan->fcurves[i] = fcu;
+    PathResolvedRNA &rna = plan->rna[i];
+    /* Properties that can't be cached are resolved again on every evaluation. */
+    if (BKE_animsys_rna_path_resolve(&id_ptr, fcu->rna_path, fcu->array_index, &rna) &&
+        is_cacheable_property(id, rna))
+    {
+      plan->is_resolved[i].set();
+    }
+  }
+  return plan;
+}
+
+FCurvesEvalPlan *fcurves_eval_plan_ensure(PointerRNA &id_ptr,
+                                          const void *key,
+                                          const Span<FCurve *> fcurves)
+{
+  ID *id = id_ptr.owner_id;
+  if (id == nullptr || id_ptr.data != id || (id->tag & ID_TAG_COPIED_ON_EVAL) == 0) {
+    /* Original data can change at any time without the plans being invalidated. */
+    return nullptr;
+  }
+  AnimData *adt = BKE_animdata_from_id(id);
+  if (adt == nullptr) {
+    return nullptr;
+  }
+  if (adt->eval_plans == nullptr) {
+    adt->eval_plans = MEM_new<AnimDataEvalPlans>(__func__);
+  }
+  AnimDataEvalPlans &plans = *adt->eval_plans;
+  const uint64_t generation = global_generation.load(std::memory_order_acquire);
+  if (plans.generation != generation) {
+    plans.plans.clear();
+    plans.generation = generation;
+  }
+
+  std::unique_ptr<FCurvesEvalPlan> &plan = plans.plans.lookup_or_add_default(key);
+  if (plan && plan_matches(*plan, fcurves)) {
+    return plan.get();
+  }
+  plan = create_plan(id_ptr, fcurves);
+  return plan.get();
+}
+
+void anim_eval_plans_free(AnimData &adt)
+{
+  MEM_delete(adt.eval_plans);
+  adt.eval_plans = nullptr;
+}
+
+void anim_eval_plans_invalidate_all()
+{
+  global_generation.fetch_add(1, std::memory_order_release);
+}
+
+}  // namespace blender::bke
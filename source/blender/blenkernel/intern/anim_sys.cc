@@ -38,6 +38,7 @@
 
 #include "BKE_action.hh"
 #include "BKE_anim_data.hh"
+#include "BKE_anim_eval_plan.hh"
 #include "BKE_animsys.h"
 #include "BKE_context.hh"
 #include "BKE_fcurve.hh"
@@ -560,26 +561,40 @@ static void animsys_write_orig_anim_rna(PointerRNA *ptr,
  * Evaluate all the F-Curves in the given list
  * This performs a set of standard checks. If extra checks are required,
  * separate code should be used.
+ *
+ * \param plan_key: When not null, the resolved properties are cached in an evaluation plan with
+ * this key, see #bke::fcurves_eval_plan_ensure.
  */
 static void animsys_evaluate_fcurves(PointerRNA *ptr,
                                      Span<FCurve *> fcurves,
                                      const AnimationEvalContext *anim_eval_context,
-                                     bool flush_to_original)
+                                     bool flush_to_original,
+                                     const void *plan_key = nullptr)
 {
+  bke::FCurvesEvalPlan *plan = plan_key ?
+                                   bke::fcurves_eval_plan_ensure(*ptr, plan_key, fcurves) :
+                                   nullptr;
+
   /* Calculate then execute each curve. */
-  for (FCurve *fcu : fcurves) {
+  for (const int i : fcurves.index_range()) {
+    FCurve *fcu = fcurves[i];
 
     if (!is_fcurve_evaluatable(fcu)) {
       continue;
     }
 
     PathResolvedRNA anim_rna;
-    if (BKE_animsys_rna_path_resolve(ptr, fcu->rna_path, fcu->array_index, &anim_rna)) {
-      const float curval = calculate_fcurve(&anim_rna, fcu, anim_eval_context);
-      BKE_animsys_write_to_rna_path(&anim_rna, curval);
-      if (flush_to_original) {
-        animsys_write_orig_anim_rna(ptr, fcu->rna_path, fcu->array_index, curval);
-      }
+    if (plan && plan->is_resolved[i]) {
+      anim_rna = plan->rna[i];
+    }
+    else if (!BKE_animsys_rna_path_resolve(ptr, fcu->rna_path, fcu->array_index, &anim_rna)) {
+      continue;
+    }
+    const float curval = calculate_fcurve(
+        &anim_rna, fcu, anim_eval_context, plan ? &plan->segment_hints[i] : nullptr);
+    BKE_animsys_write_to_rna_path(&anim_rna, curval);
+    if (flush_to_original) {
+      animsys_write_orig_anim_rna(ptr, fcu->rna_path, fcu->array_index, curval);
     }
   }
 }
@@ -889,7 +904,7 @@ void animsys_evaluate_action(PointerRNA *ptr,
     action_idcode_patch_check(ptr->owner_id, act);
 
     Vector<FCurve *> fcurves = animrig::legacy::fcurves_all(act);
-    animsys_evaluate_fcurves(ptr, fcurves, anim_eval_context, flush_to_original);
+    animsys_evaluate_fcurves(ptr, fcurves, anim_eval_context, flush_to_original, act);
     return;
   }
 
@@ -898,8 +913,13 @@ void animsys_evaluate_action(PointerRNA *ptr,
   /* Note that this is _only_ for evaluation of actions linked by NLA strips. As in, legacy code
    * paths that I (Sybren) tried to keep as much intact as possible when adding support for slotted
    * Actions. This code will go away when we implement layered Actions. */
-  Span<FCurve *> fcurves = animrig::fcurves_for_action_slot(action, action_slot_handle);
-  animsys_evaluate_fcurves(ptr, fcurves, anim_eval_context, flush_to_original);
+  animrig::Channelbag *channelbag = animrig::channelbag_for_action_slot(action,
+                                                                       action_slot_handle);
+  if (channelbag == nullptr) {
+    return;
+  }
+  animsys_evaluate_fcurves(
+      ptr, channelbag->fcurves(), anim_eval_context, flush_to_original, channelbag);
 }
 
 void animsys_blend_in_action(PointerRNA *ptr,
@@ -16,11 +16,18 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "BLI_array.hh"
+#include "BLI_bit_span_ops.hh"
+#include "BLI_bit_vector.hh"
+#include "BLI_implicit_sharing.hh"
 #include "BLI_listbase.h"
 #include "BLI_math_matrix.h"
+#include "BLI_math_matrix_types.hh"
 #include "BLI_math_rotation.h"
 #include "BLI_math_vector.h"
+#include "BLI_offset_indices.hh"
 #include "BLI_task.h"
+#include "BLI_task.hh"
 
 #include "DNA_armature_types.h"
 #include "DNA_lattice_types.h"
@@ -249,6 +256,14 @@ struct ArmatureUserdata {
   bPoseChannel **pchan_from_defbase;
   int defbase_len;
 
+  /** Replaces the vertex group weights in #dverts when available. */
+  const blender::bke::ArmatureDeformSkinningCache *skinning;
+  /**
+   * True when the bone matrices can be blended before transforming the position, which is the
+   * case for linear blend skinning when no bone needs the position to compute its influence.
+   */
+  bool use_matrix_blend;
+
   float premat[4][4];
   float postmat[4][4];
 
@@ -258,6 +273,200 @@ struct ArmatureUserdata {
   } bmesh;
 };
 
+namespace blender::bke {
+
+struct ArmatureDeformSkinningCache {
+  /**
+   * The vertex group data the cache was created from. A weak user is added, so that the sharing
+   * info is not freed and its address is not reused while the cache exists.
+   */
+  const ImplicitSharingInfo *dverts_sharing_info = nullptr;
+  int64_t dverts_version = 0;
+  const MDeformVert *dverts_data = nullptr;
+  /** The vertex groups that were mapped to a deforming bone. */
+  bits::BitVector<> deforming_groups;
+
+  /** Separates the weights of every vertex in #groups and #weights. */
+  Array<int> vert_offsets;
+  Array<int> groups;
+  Array<float> weights;
+
+  ~ArmatureDeformSkinningCache()
+  {
+    if (dverts_sharing_info) {
+      dverts_sharing_info->remove_weak_user_and_delete_if_last();
+    }
+  }
+};
+
+ArmatureDeformSkinningCache *armature_deform_skinning_cache_new()
+{
+  return MEM_new<ArmatureDeformSkinningCache>(__func__);
+}
+
+void armature_deform_skinning_cache_free(ArmatureDeformSkinningCache *cache)
+{
+  MEM_delete(cache);
+}
+
+}  // namespace blender::bke
+
+static const blender::bke::ArmatureDeformSkinningCache *skinning_cache_ensure(
+    blender::bke::ArmatureDeformSkinningCache &cache,
+    const Mesh &mesh,
+    const bPoseChannel *const *pchan_from_defbase,
+    const int defbase_len)
+{
+  using namespace blender;
+  const int layer_index = CustomData_get_layer_index(&mesh.vert_data, CD_MDEFORMVERT);
+  if (layer_index == -1) {
+    return nullptr;
+  }
+  const CustomDataLayer &layer = mesh.vert_data.layers[layer_index];
+  if (layer.sharing_info == nullptr) {
+    return nullptr;
+  }
+
+  bits::BitVector<> deforming_groups(defbase_len, false);
+  for (const int i : IndexRange(defbase_len)) {
+    deforming_groups[i].set(pchan_from_defbase[i] != nullptr);
+  }
+
+  if (cache.dverts_sharing_info == layer.sharing_info &&
+      cache.dverts_version == layer.sharing_info->version() && cache.dverts_data == layer.data &&
+      cache.vert_offsets.size() == mesh.verts_num + 1 &&
+      bits::spans_equal(cache.deforming_groups, deforming_groups))
+  {
+    return &cache;
+  }
+
+  if (cache.dverts_sharing_info) {
+    cache.dverts_sharing_info->remove_weak_user_and_delete_if_last();
+  }
+  layer.sharing_info->add_weak_user();
+  cache.dverts_sharing_info = layer.sharing_info;
+  cache.dverts_version = layer.sharing_info->version();
+  cache.dverts_data = static_cast<const MDeformVert *>(layer.data);
+  cache.deforming_groups = std::move(deforming_groups);
+
+  const Span<MDeformVert> dverts(cache.dverts_data, mesh.verts_num);
+  const bits::BitSpan deforming = cache.deforming_groups;
+  auto is_deforming = [&](const MDeformWeight &dw) {
+    return dw.def_nr < uint(defbase_len) && deforming[dw.def_nr];
+  };
+
+  cache.vert_offsets.reinitialize(mesh.verts_num + 1);
+  threading::parallel_for(dverts.index_range(), 4096, [&](const IndexRange range) {
+    for (const int vert : range) {
+      const Span<MDeformWeight> dws(dverts[vert].dw, dverts[vert].totweight);
+      cache.vert_offsets[vert] = std::count_if(dws.begin(), dws.end(), is_deforming);
+    }
+  });
+  const OffsetIndices<int> offsets = offset_indices::accumulate_counts_to_offsets(
+      cache.vert_offsets);
+
+  cache.groups.reinitialize(offsets.total_size());
+  cache.weights.reinitialize(offsets.total_size());
+  threading::parallel_for(dverts.index_range(), 4096, [&](const IndexRange range) {
+    for (const int vert : range) {
+      int dst = offsets[vert].start();
+      for (const MDeformWeight &dw : Span(dverts[vert].dw, dverts[vert].totweight)) {
+        if (is_deforming(dw)) {
+          cache.groups[dst] = int(dw.def_nr);
+          cache.weights[dst] = dw.weight;
+          dst++;
+        }
+      }
+    }
+  });
+  return &cache;
+}
+
+/**
+ * Deform with the weights of the skinning cache.
+ * \return False when the vertex is not in any group of a deforming bone.
+ */
+static bool armature_vert_deform_skinning(const ArmatureUserdata *data,
+                                          const int i,
+                                          const float co[3],
+                                          float vec[3],
+                                          DualQuat *dq,
+                                          float mat[3][3],
+                                          const bool full_deform,
+                                          float *contrib)
+{
+  using namespace blender;
+  const bke::ArmatureDeformSkinningCache &skinning = *data->skinning;
+  const IndexRange range = OffsetIndices<int>(skinning.vert_offsets)[i];
+  if (range.is_empty()) {
+    return false;
+  }
+  const Span<int> groups = skinning.groups.as_span().slice(range);
+  const Span<float> weights = skinning.weights.as_span().slice(range);
+
+  if (!data->use_matrix_blend) {
+    for (const int j : range.index_range()) {
+      const bPoseChannel *pchan = data->pchan_from_defbase[groups[j]];
+      float weight = weights[j];
+      const Bone *bone = pchan->bone;
+      if (bone && bone->flag & BONE_MULT_VG_ENV) {
+        weight *= distfactor_to_bone(
+            co, bone->arm_head, bone->arm_tail, bone->rad_head, bone->rad_tail, bone->dist);
+      }
+      pchan_bone_deform(pchan, weight, vec, dq, mat, co, full_deform, contrib);
+    }
+    return true;
+  }
+
+  /* Blend the bone matrices and transform the position once, instead of transforming it by
+   * every bone. This is a fixed number of multiply-adds per influence that vectorizes well. */
+  float4x4 blend_mat = float4x4::zero();
+  float weight_sum = 0.0f;
+  for (const int j : range.index_range()) {
+    const float weight = weights[j];
+    if (weight == 0.0f) {
+      continue;
+    }
+    const float4x4 &bone_mat = *reinterpret_cast<const float4x4 *>(
+        data->pchan_from_defbase[groups[j]]->chan_mat);
+    for (const int col : IndexRange(4)) {
+      blend_mat[col] += bone_mat[col] * weight;
+    }
+    weight_sum += weight;
+  }
+  if (weight_sum == 0.0f) {
+    return true;
+  }
+  const float3x3 blend_mat3(blend_mat);
+  const float3 position(co);
+  const float3 offset = blend_mat3 * position + blend_mat.location() - position * weight_sum;
+  add_v3_v3(vec, offset);
+  if (full_deform) {
+    add_m3_m3m3(mat, mat, blend_mat3.ptr());
+  }
+  *contrib += weight_sum;
+  return true;
+}
+
+static void armature_envelope_deform(const ArmatureUserdata *data,
+                                     float vec[3],
+                                     DualQuat *dq,
+                                     float mat[3][3],
+                                     const float co[3],
+                                     const bool full_deform,
+                                     float *contrib)
+{
+  for (const bPoseChannel *pchan =
+           static_cast<const bPoseChannel *>(data->ob_arm->pose->chanbase.first);
+       pchan;
+       pchan = pchan->next)
+  {
+    if (!(pchan->bone->flag & BONE_NO_DEFORM)) {
+      *contrib += dist_bone_deform(pchan, vec, dq, mat, co, full_deform);
+    }
+  }
+}
+
 static void armature_vert_task_with_dvert(const ArmatureUserdata *data,
                                           const int i,
                                           const MDeformVert *dvert)
@@ -332,7 +541,15 @@ static void armature_vert_task_with_dvert(const ArmatureUserdata *data,
   /* Apply the object's matrix */
   mul_m4_v3(data->premat, co);
 
-  if (use_dverts && dvert && dvert->totweight) { /* use weight groups ? */
+  if (data->skinning) {
+    const bool deformed = armature_vert_deform_skinning(
+        data, i, co, vec, dq, smat, full_deform, &contrib);
+    /* If there are no groups with bones (like for soft-body groups). */
+    if (!deformed && use_envelope) {
+      armature_envelope_deform(data, vec, dq, smat, co, full_deform, &contrib);
+    }
+  }
+  else if (use_dverts && dvert && dvert->totweight) { /* use weight groups ? */
     const MDeformWeight *dw = dvert->dw;
     int deformed = 0;
     uint j;
@@ -360,23 +577,11 @@ static void armature_vert_task_with_dvert(const ArmatureUserdata *data,
     }
     /* If there are vertex-groups but not groups with bones (like for soft-body groups). */
     if (deformed == 0 && use_envelope) {
-      for (pchan = static_cast<const bPoseChannel *>(data->ob_arm->pose->chanbase.first); pchan;
-           pchan = pchan->next)
-      {
-        if (!(pchan->bone->flag & BONE_NO_DEFORM)) {
-          contrib += dist_bone_deform(pchan, vec, dq, smat, co, full_deform);
-        }
-      }
+      armature_envelope_deform(data, vec, dq, smat, co, full_deform, &contrib);
     }
   }
   else if (use_envelope) {
-    for (pchan = static_cast<const bPoseChannel *>(data->ob_arm->pose->chanbase.first); pchan;
-         pchan = pchan->next)
-    {
-      if (!(pchan->bone->flag & BONE_NO_DEFORM)) {
-        contrib += dist_bone_deform(pchan, vec, dq, smat, co, full_deform);
-      }
-    }
+    armature_envelope_deform(data, vec, dq, smat, co, full_deform, &contrib);
   }
 
   /* actually should be EPSILON? weight values and contrib can be like 10e-39 small */
@@ -490,7 +695,8 @@ static void armature_deform_coords_impl(const Object *ob_arm,
                                         const char *defgrp_name,
                                         blender::Span<MDeformVert> dverts,
                                         const Mesh *me_target,
-                                        const BMEditMesh *em_target)
+                                        const BMEditMesh *em_target,
+                                        blender::bke::ArmatureDeformSkinningCache *skinning_cache)
 {
   const bArmature *arm = static_cast<const bArmature *>(ob_arm->data);
   bPoseChannel **pchan_from_defbase = nullptr;
@@ -554,6 +760,26 @@ static void armature_deform_coords_impl(const Object *ob_arm,
     }
   }
 
+  const blender::bke::ArmatureDeformSkinningCache *skinning = nullptr;
+  bool use_matrix_blend = false;
+  if (skinning_cache && use_dverts && me_target && !em_target) {
+    skinning = skinning_cache_ensure(*skinning_cache, *me_target, pchan_from_defbase, defbase_len);
+    use_matrix_blend = !use_quaternion;
+    for (const int i : blender::IndexRange(defbase_len)) {
+      const bPoseChannel *pchan = pchan_from_defbase[i];
+      if (pchan == nullptr) {
+        continue;
+      }
+      const Bone *bone = pchan->bone;
+      if ((bone->segments > 1 && pchan->runtime.bbone_segments == bone->segments) ||
+          (bone->flag & BONE_MULT_VG_ENV))
+      {
+        use_matrix_blend = false;
+        break;
+      }
+    }
+  }
+
   ArmatureUserdata data{};
   data.ob_arm = ob_arm;
   data.me_target = me_target;
@@ -569,6 +795,8 @@ static void armature_deform_coords_impl(const Object *ob_arm,
   data.dverts_len = dverts.size();
   data.pchan_from_defbase = pchan_from_defbase;
   data.defbase_len = defbase_len;
+  data.skinning = skinning;
+  data.use_matrix_blend = use_matrix_blend;
   data.bmesh.cd_dvert_offset = cd_dvert_offset;
 
   float obinv[4][4];
@@ -639,18 +867,21 @@ void BKE_armature_deform_coords_with_curves(
       defgrp_name.c_str(),
       dverts,
       nullptr,
+      nullptr,
       nullptr);
 }
 
-void BKE_armature_deform_coords_with_mesh(const Object *ob_arm,
-                                          const Object *ob_target,
-                                          float (*vert_coords)[3],
-                                          float (*vert_deform_mats)[3][3],
-                                          int vert_coords_len,
-                                          int deformflag,
-                                          float (*vert_coords_prev)[3],
-                                          const char *defgrp_name,
-                                          const Mesh *me_target)
+void BKE_armature_deform_coords_with_mesh(
+    const Object *ob_arm,
+    const Object *ob_target,
+    float (*vert_coords)[3],
+    float (*vert_deform_mats)[3][3],
+    int vert_coords_len,
+    int deformflag,
+    float (*vert_coords_prev)[3],
+    const char *defgrp_name,
+    const Mesh *me_target,
+    blender::bke::ArmatureDeformSkinningCache *skinning_cache)
 {
   /* Note armature modifier on legacy curves calls this, so vertex groups are not guaranteed to
    * exist. */
@@ -681,7 +912,8 @@ void BKE_armature_deform_coords_with_mesh(const Object *ob_arm,
                               defgrp_name,
                               dverts,
                               me_target,
-                              nullptr);
+                              nullptr,
+                              skinning_cache);
 }
 
 void BKE_armature_deform_coords_with_editmesh(const Object *ob_arm,
@@ -706,7 +938,8 @@ void BKE_armature_deform_coords_with_editmesh(const Object *ob_arm,
                               defgrp_name,
                               {},
                               nullptr,
-                              em_target);
+                              em_target,
+                              nullptr);
 }
 
 /** \} */
@@ -0,0 +1,202 @@
+/* SPDX-FileCopyrightText: 2025 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include "testing/testing.h"
+
+#include "BLI_array.hh"
+#include "BLI_listbase.h"
+#include "BLI_math_euler.hh"
+#include "BLI_math_matrix.h"
+#include "BLI_math_matrix.hh"
+#include "BLI_math_rotation.h"
+#include "BLI_math_vector.h"
+#include "BLI_string.h"
+
+#include "BKE_action.hh"
+#include "BKE_armature.hh"
+#include "BKE_deform.hh"
+#include "BKE_idtype.hh"
+#include "BKE_lib_id.hh"
+#include "BKE_main.hh"
+#include "BKE_mesh.hh"
+#include "BKE_object.hh"
+#include "BKE_object_types.hh"
+
+#include "DNA_action_types.h"
+#include "DNA_armature_types.h"
+#include "DNA_mesh_types.h"
+#include "DNA_meshdata_types.h"
+#include "DNA_object_types.h"
+
+#include "MEM_guardedalloc.h"
+
+namespace blender::bke::tests {
+
+/* NOTE: Using a struct with constructor and destructor instead of a fixture here, to have all the
+ * tests in the same group (`armature_deform`). */
+struct ArmatureDeformTestContext {
+  Main *bmain = nullptr;
+  Object *ob_arm = nullptr;
+  Object *ob_mesh = nullptr;
+  Mesh *mesh = nullptr;
+
+  ArmatureDeformTestContext()
+  {
+    BKE_idtype_init();
+    bmain = BKE_main_new();
+
+    bArmature *arm = static_cast<bArmature *>(BKE_id_new(bmain, ID_AR, "Armature"));
+    for (const char *name : {"Bone0", "Bone1", "Bone2", "NoDeform"}) {
+      Bone *bone = MEM_cnew<Bone>(__func__);
+      STRNCPY(bone->name, name);
+      unit_m4(bone->arm_mat);
+      if (STREQ(name, "NoDeform")) {
+        bone->flag |= BONE_NO_DEFORM;
+      }
+      BLI_addtail(&arm->bonebase, bone);
+    }
+
+    ob_arm = BKE_object_add_only_object(bmain, OB_ARMATURE, "Armature");
+    ob_arm->data = arm;
+    ob_arm->runtime->object_to_world = math::from_location<float4x4>(float3(0.5f, -1.0f, 2.0f));
+    BKE_pose_rebuild(nullptr, ob_arm, arm, false);
+
+    int i;
+    LISTBASE_FOREACH_INDEX (bPoseChannel *, pchan, &ob_arm->pose->chanbase, i) {
+      const float4x4 chan_mat = math::from_loc_rot_scale<float4x4>(
+          float3(0.1f * i, 0.3f, -0.2f * i),
+          math::EulerXYZ(0.4f * i, -0.3f, 0.7f + 0.2f * i),
+          float3(1.0f + 0.1f * i));
+      copy_m4_m4(pchan->chan_mat, chan_mat.ptr());
+      mat4_to_dquat(&pchan->runtime.deform_dual_quat, pchan->bone->arm_mat, pchan->chan_mat);
+    }
+
+    constexpr int verts_num = 64;
+    mesh = BKE_mesh_new_nomain(verts_num, 0, 0, 0);
+    MutableSpan<float3> positions = mesh->vert_positions_for_write();
+    for (const int vert : positions.index_range()) {
+      positions[vert] = float3(vert % 4, (vert / 4) % 4, vert / 16) - float3(1.5f);
+    }
+
+    ob_mesh = BKE_object_add_only_object(bmain, OB_MESH, "Mesh");
+    ob_mesh->data = mesh;
+    /* Includes a group without a bone and one for a non-deforming bone. */
+    for (const char *name : {"Bone0", "Missing", "Bone1", "NoDeform", "Bone2"}) {
+      BKE_object_defgroup_new(ob_mesh, name);
+    }
+    this->assign_weights(0);
+  }
+
+  ~ArmatureDeformTestContext()
+  {
+    BKE_main_free(bmain);
+    BKE_id_free(nullptr, mesh);
+  }
+
+  void assign_weights(const int seed)
+  {
+    MutableSpan<MDeformVert> dverts = mesh->deform_verts_for_write();
+    for (const int vert : dverts.index_range()) {
+      BKE_defvert_clear(&dverts[vert]);
+      const int pattern = (vert + seed) % 6;
+      if (pattern == 0) {
+        /* No weights at all. */
+        continue;
+      }
+      for (const int group : IndexRange(5)) {
+        if ((pattern + group) % 3 == 0) {
+          continue;
+        }
+        /* Also exercise zero weights. */
+        const float weight = ((vert + group) % 7) / 6.0f;
+        BKE_defvert_add_index_notest(&dverts[vert], group, weight);
+      }
+    }
+  }
+
+  void deform(const int deformflag,
+              ArmatureDeformSkinningCache *skinning_cache,
+              MutableSpan<float3> positions,
+              MutableSpan<float3x3> deform_mats) const
+  {
+    positions.copy_from(mesh->vert_positions());
+    deform_mats.fill(float3x3::identity());
+    BKE_armature_deform_coords_with_mesh(ob_arm,
+                                         ob_mesh,
+                                         reinterpret_cast<float(*)[3]>(positions.data()),
+                                         reinterpret_cast<float(*)[3][3]>(deform_mats.data()),
+                                         positions.size(),
+                                         deformflag,
+                                         nullptr,
+                                         nullptr,
+                                         mesh,
+                                         skinning_cache);
+  }
+
+  /** Compare the result of the skinning cache with the deformation that reads vertex groups. */
+  void expect_cache_matches_vertex_groups(const int deformflag,
+                                          ArmatureDeformSkinningCache *skinning_cache) const
+  {
+    const int verts_num = mesh->verts_num;
+    Array<float3> expected_positions(verts_num);
+    Array<float3x3> expected_mats(verts_num);
+    this->deform(deformflag, nullptr, expected_positions, expected_mats);
+
+    Array<float3> positions(verts_num);
+    Array<float3x3> mats(verts_num);
+    this->deform(deformflag, skinning_cache, positions, mats);
+
+    for (const int vert : IndexRange(verts_num)) {
+      EXPECT_V3_NEAR(positions[vert], expected_positions[vert], 1e-5f);
+      EXPECT_M3_NEAR(mats[vert], expected_mats[vert], 1e-5f);
+    }
+  }
+};
+
+TEST(armature_deform, skinning_cache_linear)
+{
+  ArmatureDeformTestContext ctx;
+  ArmatureDeformSkinningCache *cache = armature_deform_skinning_cache_new();
+  ctx.expect_cache_matches_vertex_groups(ARM_DEF_VGROUP, cache);
+  /* Reuse the cache built by the previous evaluation. */
+  ctx.expect_cache_matches_vertex_groups(ARM_DEF_VGROUP, cache);
+  armature_deform_skinning_cache_free(cache);
+}
+
+TEST(armature_deform, skinning_cache_quaternion)
+{
+  ArmatureDeformTestContext ctx;
+  ArmatureDeformSkinningCache *cache = armature_deform_skinning_cache_new();
+  ctx.expect_cache_matches_vertex_groups(ARM_DEF_VGROUP | ARM_DEF_QUATERNION, cache);
+  armature_deform_skinning_cache_free(cache);
+}
+
+TEST(armature_deform, skinning_cache_envelope)
+{
+  ArmatureDeformTestContext ctx;
+  LISTBASE_FOREACH (bPoseChannel *, pchan, &ctx.ob_arm->pose->chanbase) {
+    pchan->bone->rad_head = 1.0f;
+    pchan->bone->rad_tail = 1.0f;
+    pchan->bone->dist = 2.0f;
+    pchan->bone->weight = 1.0f;
+    copy_v3_fl3(pchan->bone->arm_tail, 0.0f, 1.0f, 0.0f);
+  }
+  ArmatureDeformSkinningCache *cache = armature_deform_skinning_cache_new();
+  /* Vertices without weights fall back to the envelope. */
+  ctx.expect_cache_matches_vertex_groups(ARM_DEF_VGROUP | ARM_DEF_ENVELOPE, cache);
+  armature_deform_skinning_cache_free(cache);
+}
+
+TEST(armature_deform, skinning_cache_weights_changed)
+{
+  ArmatureDeformTestContext ctx;
+  ArmatureDeformSkinningCache *cache = armature_deform_skinning_cache_new();
+  ctx.expect_cache_matches_vertex_groups(ARM_DEF_VGROUP, cache);
+  /* Writing the vertex groups has to invalidate the cached weights. */
+  ctx.assign_weights(1);
+  ctx.expect_cache_matches_vertex_groups(ARM_DEF_VGROUP, cache);
+  armature_deform_skinning_cache_free(cache);
+}
+
+}  // namespace blender::bke::tests
@@ -2,6 +2,7 @@
  *
  * SPDX-License-Identifier: GPL-2.0-or-later */
 
+#include <array>
 #include <utility>
 
 #include "BKE_anonymous_attribute_id.hh"
@@ -18,9 +19,11 @@
 #include "DNA_pointcloud_types.h"
 
 #include "BLI_array_utils.hh"
+#include "BLI_bit_bool_conversion.hh"
 #include "BLI_color.hh"
 #include "BLI_math_vector_types.hh"
 #include "BLI_span.hh"
+#include "BLI_task.hh"
 
 #include "BLT_translation.hh"
 
@@ -672,6 +675,42 @@ GAttributeReader AttributeAccessor::lookup_or_default(const StringRef attribute_
   return {GVArray::ForSingle(type, domain_size, default_value), domain, nullptr};
 }
 
+BitVector<> AttributeAccessor::lookup_or_default_bits(const StringRef attribute_id,
+                                                     const AttrDomain domain,
+                                                     const bool default_value) const
+{
+  const AttributeReader<bool> attribute = this->lookup<bool>(attribute_id, domain);
+  if (!attribute) {
+    return BitVector<>(this->domain_size(domain), default_value);
+  }
+  const VArray<bool> &varray = attribute.varray;
+  if (const std::optional<bool> value = varray.get_if_single()) {
+    return BitVector<>(varray.size(), *value);
+  }
+  if (varray.is_span()) {
+    return BitVector<>(varray.get_internal_span());
+  }
+  /* Convert chunks of the virtual array, to avoid allocating a boolean array for all elements.
+   * The chunk size is a multiple of the bit integer size, so that threads write separate
+   * integers. */
+  constexpr int64_t chunk_size = 4096;
+  static_assert(chunk_size % bits::BitsPerInt == 0);
+  BitVector<> result(varray.size(), false);
+  MutableBitSpan result_bits = result;
+  const int64_t chunks_num = divide_ceil_ul(varray.size(), chunk_size);
+  threading::parallel_for(IndexRange(chunks_num), 1, [&](const IndexRange chunks) {
+    std::array<bool, chunk_size> buffer;
+    for (const int64_t chunk_i : chunks) {
+      const int64_t start = chunk_i * chunk_size;
+      const IndexRange chunk(start, std::min(chunk_size, varray.size() - start));
+      MutableSpan<bool> bools = MutableSpan<bool>(buffer).take_front(chunk.size());
+      varray.materialize_compressed(chunk, bools);
+      bits::or_bools_into_bits(bools, result_bits.slice(chunk));
+    }
+  });
+  return result;
+}
+
 bool AttributeAccessor::contains(const StringRef attribute_id) const
 {
   bool found = false;
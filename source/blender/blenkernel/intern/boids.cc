@@ -25,7 +25,7 @@
 
 #include "BKE_boids.h"
 #include "BKE_collision.h"
-#include "BKE_effect.h"
+#include "BKE_effect.hh"
 #include "BKE_particle.h"
 #include "BLI_kdopbvh.hh"
 
@@ -19,6 +19,7 @@
 #include "BLI_listbase.h"
 #include "BLI_math_base.hh"
 #include "BLI_rand.h"
+#include "BLI_simd.hh"
 
 #include "BLT_translation.hh"
 
@@ -1261,6 +1262,105 @@ void BKE_brush_randomize_texture_coords(UnifiedPaintSettings *ups, bool mask)
   }
 }
 
+/** The falloff of the curve presets, for a factor of 1 at the brush center and 0 at the edge. */
+template<eBrushCurvePreset Preset> static float curve_preset_falloff(const float factor)
+{
+  if constexpr (Preset == BRUSH_CURVE_SHARP) {
+    return factor * factor;
+  }
+  else if constexpr (Preset == BRUSH_CURVE_SMOOTH) {
+    return 3.0f * factor * factor - 2.0f * factor * factor * factor;
+  }
+  else if constexpr (Preset == BRUSH_CURVE_SMOOTHER) {
+    return pow3f(factor) * (factor * (factor * 6.0f - 15.0f) + 10.0f);
+  }
+  else if constexpr (Preset == BRUSH_CURVE_ROOT) {
+    return sqrtf(factor);
+  }
+  else if constexpr (Preset == BRUSH_CURVE_LIN) {
+    return factor;
+  }
+  else if constexpr (Preset == BRUSH_CURVE_SPHERE) {
+    return sqrtf(2 * factor - factor * factor);
+  }
+  else if constexpr (Preset == BRUSH_CURVE_POW4) {
+    return factor * factor * factor * factor;
+  }
+  else if constexpr (Preset == BRUSH_CURVE_INVSQUARE) {
+    return factor * (2.0f - factor);
+  }
+}
+
+#if BLI_HAVE_SSE2
+/** The same as the scalar #curve_preset_falloff, with the same order of operations. */
+template<eBrushCurvePreset Preset> static __m128 curve_preset_falloff(const __m128 factor)
+{
+  if constexpr (Preset == BRUSH_CURVE_SHARP) {
+    return _mm_mul_ps(factor, factor);
+  }
+  else if constexpr (Preset == BRUSH_CURVE_SMOOTH) {
+    const __m128 a = _mm_mul_ps(_mm_mul_ps(_mm_set1_ps(3.0f), factor), factor);
+    const __m128 b = _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(_mm_set1_ps(2.0f), factor), factor),
+                                factor);
+    return _mm_sub_ps(a, b);
+  }
+  else if constexpr (Preset == BRUSH_CURVE_SMOOTHER) {
+    const __m128 cube = _mm_mul_ps(_mm_mul_ps(factor, factor), factor);
+    const __m128 inner = _mm_sub_ps(_mm_mul_ps(factor, _mm_set1_ps(6.0f)), _mm_set1_ps(15.0f));
+    return _mm_mul_ps(cube, _mm_add_ps(_mm_mul_ps(factor, inner), _mm_set1_ps(10.0f)));
+  }
+  else if constexpr (Preset == BRUSH_CURVE_ROOT) {
+    return _mm_sqrt_ps(factor);
+  }
+  else if constexpr (Preset == BRUSH_CURVE_LIN) {
+    return factor;
+  }
+  else if constexpr (Preset == BRUSH_CURVE_SPHERE) {
+    return _mm_sqrt_ps(
+        _mm_sub_ps(_mm_mul_ps(_mm_set1_ps(2.0f), factor), _mm_mul_ps(factor, factor)));
+  }
+  else if constexpr (Preset == BRUSH_CURVE_POW4) {
+    return _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(factor, factor), factor), factor);
+  }
+  else if constexpr (Preset == BRUSH_CURVE_INVSQUARE) {
+    return _mm_mul_ps(factor, _mm_sub_ps(_mm_set1_ps(2.0f), factor));
+  }
+}
+#endif
+
+/**
+ * Multiply the factors by the falloff of the normalized distance from the brush edge, four
+ * vertices at a time. Vertices outside of the radius are masked out instead of skipped.
+ */
+template<eBrushCurvePreset Preset>
+static void apply_curve_factors(const blender::Span<float> distances,
+                                const float brush_radius,
+                                const blender::MutableSpan<float> factors)
+{
+  const float radius_rcp = blender::math::rcp(brush_radius);
+  int i = 0;
+#if BLI_HAVE_SSE2
+  const __m128 radius_v = _mm_set1_ps(brush_radius);
+  const __m128 radius_rcp_v = _mm_set1_ps(radius_rcp);
+  for (; i + 4 <= distances.size(); i += 4) {
+    const __m128 distance = _mm_loadu_ps(&distances[i]);
+    const __m128 factor = _mm_sub_ps(_mm_set1_ps(1.0f), _mm_mul_ps(distance, radius_rcp_v));
+    /* Lanes outside of the radius may be NaN before they are masked out. */
+    const __m128 result = _mm_mul_ps(_mm_loadu_ps(&factors[i]),
+                                     curve_preset_falloff<Preset>(factor));
+    _mm_storeu_ps(&factors[i], _mm_and_ps(_mm_cmplt_ps(distance, radius_v), result));
+  }
+#endif
+  for (; i < distances.size(); i++) {
+    const float distance = distances[i];
+    if (distance >= brush_radius) {
+      factors[i] = 0.0f;
+      continue;
+    }
+    factors[i] *= curve_preset_falloff<Preset>(1.0f - distance * radius_rcp);
+  }
+}
+
 void BKE_brush_calc_curve_factors(const eBrushCurvePreset preset,
                                   const CurveMapping *cumap,
                                   const blender::Span<float> distances,
@@ -1269,116 +1369,56 @@ void BKE_brush_calc_curve_factors(const eBrushCurvePreset preset,
 {
   BLI_assert(factors.size() == distances.size());
 
-  const float radius_rcp = blender::math::rcp(brush_radius);
   switch (preset) {
     case BRUSH_CURVE_CUSTOM: {
+      const float radius_rcp = blender::math::rcp(brush_radius);
       for (const int i : distances.index_range()) {
         const float distance = distances[i];
         if (distance >= brush_radius) {
           factors[i] = 0.0f;
           continue;
         }
+        if (factors[i] == 0.0f) {
+          /* Avoid evaluating the curve for hidden, masked or otherwise unaffected vertices. */
+          continue;
+        }
         factors[i] *= BKE_curvemapping_evaluateF(cumap, 0, distance * radius_rcp);
       }
       break;
     }
     case BRUSH_CURVE_SHARP: {
-      for (const int i : distances.index_range()) {
-        const float distance = distances[i];
-        if (distance >= brush_radius) {
-          factors[i] = 0.0f;
-          continue;
-        }
-        const float factor = 1.0f - distance * radius_rcp;
-        factors[i] *= factor * factor;
-      }
+      apply_curve_factors<BRUSH_CURVE_SHARP>(distances, brush_radius, factors);
       break;
     }
     case BRUSH_CURVE_SMOOTH: {
-      for (const int i : distances.index_range()) {
-        const float distance = distances[i];
-        if (distance >= brush_radius) {
-          factors[i] = 0.0f;
-          continue;
-        }
-        const float factor = 1.0f - distance * radius_rcp;
-        factors[i] *= 3.0f * factor * factor - 2.0f * factor * factor * factor;
-      }
+      apply_curve_factors<BRUSH_CURVE_SMOOTH>(distances, brush_radius, factors);
       break;
     }
     case BRUSH_CURVE_SMOOTHER: {
-      for (const int i : distances.index_range()) {
-        const float distance = distances[i];
-        if (distance >= brush_radius) {
-          factors[i] = 0.0f;
-          continue;
-        }
-        const float factor = 1.0f - distance * radius_rcp;
-        factors[i] *= pow3f(factor) * (factor * (factor * 6.0f - 15.0f) + 10.0f);
-      }
+      apply_curve_factors<BRUSH_CURVE_SMOOTHER>(distances, brush_radius, factors);
       break;
     }
     case BRUSH_CURVE_ROOT: {
-      for (const int i : distances.index_range()) {
-        const float distance = distances[i];
-        if (distance >= brush_radius) {
-          factors[i] = 0.0f;
-          continue;
-        }
-        const float factor = 1.0f - distance * radius_rcp;
-        factors[i] *= sqrtf(factor);
-      }
+      apply_curve_factors<BRUSH_CURVE_ROOT>(distances, brush_radius, factors);
       break;
     }
     case BRUSH_CURVE_LIN: {
-      for (const int i : distances.index_range()) {
-        const float distance = distances[i];
-        if (distance >= brush_radius) {
-          factors[i] = 0.0f;
-          continue;
-        }
-        const float factor = 1.0f - distance * radius_rcp;
-        factors[i] *= factor;
-      }
+      apply_curve_factors<BRUSH_CURVE_LIN>(distances, brush_radius, factors);
       break;
     }
     case BRUSH_CURVE_CONSTANT: {
       break;
     }
     case BRUSH_CURVE_SPHERE: {
-      for (const int i : distances.index_range()) {
-        const float distance = distances[i];
-        if (distance >= brush_radius) {
-          factors[i] = 0.0f;
-          continue;
-        }
-        const float factor = 1.0f - distance * radius_rcp;
-        factors[i] *= sqrtf(2 * factor - factor * factor);
-      }
+      apply_curve_factors<BRUSH_CURVE_SPHERE>(distances, brush_radius, factors);
       break;
     }
     case BRUSH_CURVE_POW4: {
-      for (const int i : distances.index_range()) {
-        const float distance = distances[i];
-        if (distance >= brush_radius) {
-          factors[i] = 0.0f;
-          continue;
-        }
-        const float factor = 1.0f - distance * radius_rcp;
-        factors[i] *= factor * factor * factor * factor;
-      }
+      apply_curve_factors<BRUSH_CURVE_POW4>(distances, brush_radius, factors);
       break;
     }
     case BRUSH_CURVE_INVSQUARE: {
-      for (const int i : distances.index_range()) {
-        const float distance = distances[i];
-        if (distance >= brush_radius) {
-          factors[i] = 0.0f;
-          continue;
-        }
-        const float factor = 1.0f - distance * radius_rcp;
-        factors[i] *= factor * (2.0f - factor);
-      }
+      apply_curve_factors<BRUSH_CURVE_INVSQUARE>(distances, brush_radius, factors);
       break;
     }
   }
@@ -9,6 +9,7 @@
 #include "DNA_meshdata_types.h"
 #include "DNA_pointcloud_types.h"
 
+#include "BLI_bit_span_ops.hh"
 #include "BLI_math_geom.h"
 
 #include "BKE_attribute.hh"
@@ -567,33 +568,19 @@ BVHTreeFromMesh bvhtree_from_mesh_corner_tris_ex(const Span<float3> vert_positio
 
 static BitVector<> loose_verts_no_hidden_mask_get(const Mesh &mesh)
 {
-  int count = mesh.verts_num;
-  BitVector<> verts_mask(count, true);
-
   const AttributeAccessor attributes = mesh.attributes();
   const Span<int2> edges = mesh.edges();
   const VArray<bool> hide_edge = *attributes.lookup_or_default(
       ".hide_edge", AttrDomain::Edge, false);
-  const VArray<bool> hide_vert = *attributes.lookup_or_default(
-      ".hide_vert", AttrDomain::Point, false);
 
+  /* Start with the visible vertices and remove the ones used by visible edges. */
+  BitVector<> verts_mask = attributes.lookup_or_default_bits(
+      ".hide_vert", AttrDomain::Point, false);
+  bits::invert(MutableBoundedBitSpan(verts_mask));
   for (const int i : edges.index_range()) {
-    if (hide_edge[i]) {
-      continue;
-    }
-    for (const int vert : {edges[i][0], edges[i][1]}) {
-      if (verts_mask[vert]) {
-        verts_mask[vert].reset();
-        count--;
-      }
-    }
-  }
-
-  if (count) {
-    for (const int vert : verts_mask.index_range()) {
-      if (verts_mask[vert] && hide_vert[vert]) {
-        verts_mask[vert].reset();
-      }
+    if (!hide_edge[i]) {
+      verts_mask[edges[i][0]].reset();
+      verts_mask[edges[i][1]].reset();
     }
   }
 
@@ -602,34 +589,21 @@ static BitVector<> loose_verts_no_hidden_mask_get(const Mesh &mesh)
 
 static BitVector<> loose_edges_no_hidden_mask_get(const Mesh &mesh)
 {
-  int count = mesh.edges_num;
-  BitVector<> edge_mask(count, true);
-
   const AttributeAccessor attributes = mesh.attributes();
   const OffsetIndices faces = mesh.faces();
   const Span<int> corner_edges = mesh.corner_edges();
   const VArray<bool> hide_poly = *attributes.lookup_or_default(
       ".hide_poly", AttrDomain::Face, false);
-  const VArray<bool> hide_edge = *attributes.lookup_or_default(
-      ".hide_edge", AttrDomain::Edge, false);
 
+  /* Start with the visible edges and remove the ones used by visible faces. */
+  BitVector<> edge_mask = attributes.lookup_or_default_bits(".hide_edge", AttrDomain::Edge, false);
+  bits::invert(MutableBoundedBitSpan(edge_mask));
   for (const int i : faces.index_range()) {
     if (hide_poly[i]) {
       continue;
     }
     for (const int edge : corner_edges.slice(faces[i])) {
-      if (edge_mask[edge]) {
-        edge_mask[edge].reset();
-        count--;
-      }
-    }
-  }
-
-  if (count) {
-    for (const int edge : edge_mask.index_range()) {
-      if (edge_mask[edge] && hide_edge[edge]) {
-        edge_mask[edge].reset();
-      }
+      edge_mask[edge].reset();
     }
   }
 
@@ -29,7 +29,7 @@
 #include "BKE_bvhutils.hh"
 #include "BKE_cloth.hh"
 #include "BKE_customdata.hh"
-#include "BKE_effect.h"
+#include "BKE_effect.hh"
 #include "BKE_global.hh"
 #include "BKE_lib_id.hh"
 #include "BKE_mesh.hh"
@@ -6,8 +6,11 @@
  * \ingroup bke
  */
 
+#include "BKE_attribute.hh"
 #include "BKE_curves.hh"
 
+#include "BLI_bit_vector.hh"
+
 #include "testing/testing.h"
 
 namespace blender::bke::tests {
@@ -477,4 +480,43 @@ TEST(curves_geometry, BezierGenericEvaluation)
   }
 }
 
+static void expect_bits_eq(const BitSpan bits, const VArray<bool> &expected)
+{
+  EXPECT_EQ(bits.size(), expected.size());
+  for (const int64_t i : expected.index_range()) {
+    EXPECT_EQ(bits[i].test(), expected[i]) << "at index " << i;
+  }
+}
+
+TEST(curves_geometry, LookupOrDefaultBits)
+{
+  CurvesGeometry curves = create_basic_curves(10000, 100);
+  MutableAttributeAccessor attributes = curves.attributes_for_write();
+
+  expect_bits_eq(attributes.lookup_or_default_bits("missing", AttrDomain::Point, true),
+                 VArray<bool>::ForSingle(true, curves.points_num()));
+
+  SpanAttributeWriter<bool> selection = attributes.lookup_or_add_for_write_only_span<bool>(
+      "selection", AttrDomain::Point);
+  for (const int i : selection.span.index_range()) {
+    selection.span[i] = i % 3 == 0 || i % 1000 == 7;
+  }
+  selection.finish();
+  SpanAttributeWriter<float> weight = attributes.lookup_or_add_for_write_only_span<float>(
+      "weight", AttrDomain::Point);
+  for (const int i : weight.span.index_range()) {
+    weight.span[i] = (i % 5 == 0) ? 1.0f : 0.0f;
+  }
+  weight.finish();
+
+  /* Stored as a span. */
+  expect_bits_eq(attributes.lookup_or_default_bits("selection", AttrDomain::Point, false),
+                 *attributes.lookup<bool>("selection", AttrDomain::Point));
+  /* Virtual arrays which are converted in chunks. */
+  expect_bits_eq(attributes.lookup_or_default_bits("weight", AttrDomain::Point, false),
+                 *attributes.lookup<bool>("weight", AttrDomain::Point));
+  expect_bits_eq(attributes.lookup_or_default_bits("selection", AttrDomain::Curve, false),
+                 *attributes.lookup<bool>("selection", AttrDomain::Curve));
+}
+
 }  // namespace blender::bke::tests
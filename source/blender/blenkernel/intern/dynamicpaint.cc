@@ -45,7 +45,7 @@
 #include "BKE_customdata.hh"
 #include "BKE_deform.hh"
 #include "BKE_dynamicpaint.h"
-#include "BKE_effect.h"
+#include "BKE_effect.hh"
 #include "BKE_image.hh"
 #include "BKE_image_format.hh"
 #include "BKE_lib_id.hh"
@@ -23,6 +23,7 @@
 #include "DNA_scene_types.h"
 #include "DNA_texture_types.h"
 
+#include "BLI_array.hh"
 #include "BLI_ghash.h"
 #include "BLI_math_base_safe.h"
 #include "BLI_math_matrix.h"
@@ -31,6 +32,7 @@
 #include "BLI_noise.h"
 #include "BLI_rand.h"
 #include "BLI_string.h"
+#include "BLI_task.hh"
 #include "BLI_time.h"
 #include "BLI_utildefines.h"
 
@@ -40,7 +42,7 @@
 #include "BKE_collision.h"
 #include "BKE_curve.hh"
 #include "BKE_displist.h"
-#include "BKE_effect.h"
+#include "BKE_effect.hh"
 #include "BKE_fluid.h"
 #include "BKE_global.hh"
 #include "BKE_modifier.hh"
@@ -671,14 +673,48 @@ bool closest_point_on_surface(SurfaceModifierData *surmd,
 
   return false;
 }
-bool get_effector_data(EffectorCache *eff,
-                       EffectorData *efd,
-                       EffectedPoint *point,
-                       int real_velocity)
+/**
+ * Effector data that doesn't depend on the effected point. It is computed once per effector when
+ * evaluating many points with #BKE_effectors_apply_points.
+ */
+struct EffectorPrecalc {
+  /** Object location and normalized Z axis, see #effector_object_axes. */
+  float location[3];
+  float z_axis[3];
+  /**
+   * The effector is the object itself (or its XY plane or Z axis) rather than its surface,
+   * vertices or particles. Then #get_effector_data always succeeds.
+   */
+  bool is_object;
+  /** Collision objects for #eff_calc_visibility, null when visibility isn't used. */
+  ListBase *colliders;
+  bool free_colliders;
+};
+
+static void effector_object_axes(const EffectorCache *eff, float r_location[3], float r_z_axis[3])
+{
+  copy_v3_v3(r_location, eff->ob->object_to_world().location());
+  normalize_v3_v3(r_z_axis, eff->ob->object_to_world().ptr()[2]);
+}
+
+static bool get_effector_data_ex(EffectorCache *eff,
+                                 EffectorData *efd,
+                                 EffectedPoint *point,
+                                 int real_velocity,
+                                 const EffectorPrecalc *precalc)
 {
   float cfra = DEG_get_ctime(eff->depsgraph);
   bool ret = false;
 
+  float ob_location[3], ob_z_axis[3];
+  if (precalc) {
+    copy_v3_v3(ob_location, precalc->location);
+    copy_v3_v3(ob_z_axis, precalc->z_axis);
+  }
+  else {
+    effector_object_axes(eff, ob_location, ob_z_axis);
+  }
+
   /* In case surface object is in Edit mode when loading the .blend,
    * surface modifier is never executed and bvhtree never built, see #48415. */
   if (eff->pd && eff->pd->shape == PFIELD_SHAPE_SURFACE && eff->surmd &&
@@ -756,26 +792,25 @@ bool get_effector_data(EffectorCache *eff,
   }
   else {
     /* use center of object for distance calculus */
-    const Object *ob = eff->ob;
 
     /* Use z-axis as normal. */
-    normalize_v3_v3(efd->nor, ob->object_to_world().ptr()[2]);
+    copy_v3_v3(efd->nor, ob_z_axis);
 
     if (eff->pd && ELEM(eff->pd->shape, PFIELD_SHAPE_PLANE, PFIELD_SHAPE_LINE)) {
       float temp[3], translate[3];
-      sub_v3_v3v3(temp, point->loc, ob->object_to_world().location());
+      sub_v3_v3v3(temp, point->loc, ob_location);
       project_v3_v3v3(translate, temp, efd->nor);
 
       /* for vortex the shape chooses between old / new force */
       if (eff->pd->forcefield == PFIELD_VORTEX || eff->pd->shape == PFIELD_SHAPE_LINE) {
-        add_v3_v3v3(efd->loc, ob->object_to_world().location(), translate);
+        add_v3_v3v3(efd->loc, ob_location, translate);
       }
       else { /* Normally `efd->loc` is closest point on effector XY-plane. */
         sub_v3_v3v3(efd->loc, point->loc, translate);
       }
     }
     else {
-      copy_v3_v3(efd->loc, ob->object_to_world().location());
+      copy_v3_v3(efd->loc, ob_location);
     }
 
     zero_v3(efd->vel);
@@ -800,13 +835,21 @@ bool get_effector_data(EffectorCache *eff,
     }
     else {
       /* for some effectors we need the object center every time */
-      sub_v3_v3v3(efd->vec_to_point2, point->loc, eff->ob->object_to_world().location());
-      normalize_v3_v3(efd->nor2, eff->ob->object_to_world().ptr()[2]);
+      sub_v3_v3v3(efd->vec_to_point2, point->loc, ob_location);
+      copy_v3_v3(efd->nor2, ob_z_axis);
     }
   }
 
   return ret;
 }
+
+bool get_effector_data(EffectorCache *eff,
+                       EffectorData *efd,
+                       EffectedPoint *point,
+                       int real_velocity)
+{
+  return get_effector_data_ex(eff, efd, point, real_velocity, nullptr);
+}
 static void get_effector_tot(
     EffectorCache *eff, EffectorData *efd, EffectedPoint *point, int *tot, int *p, int *step)
 {
@@ -1107,6 +1150,64 @@ static void do_physical_effector(EffectorCache *eff,
   }
 }
 
+/** Add the force of one effector on the point, see #BKE_effectors_apply. */
+static void effector_apply_point(EffectorCache *eff,
+                                 const EffectorPrecalc *precalc,
+                                 ListBase *colliders,
+                                 EffectorWeights *weights,
+                                 EffectedPoint *point,
+                                 float *force,
+                                 float *wind_force,
+                                 float *impulse)
+{
+  EffectorData efd;
+  int p = 0, tot = 1, step = 1;
+
+  get_effector_tot(eff, &efd, point, &tot, &p, &step);
+
+  for (; p < tot; p += step) {
+    if (get_effector_data_ex(eff, &efd, point, 0, precalc)) {
+      efd.falloff = effector_falloff(eff, &efd, point, weights);
+
+      if (efd.falloff > 0.0f) {
+        if (precalc == nullptr) {
+          efd.falloff *= eff_calc_visibility(colliders, eff, &efd, point);
+        }
+        else if (precalc->colliders) {
+          efd.falloff *= eff_calc_visibility(precalc->colliders, eff, &efd, point);
+        }
+      }
+      if (efd.falloff > 0.0f) {
+        float out_force[3] = {0, 0, 0};
+
+        if (eff->pd->forcefield == PFIELD_TEXTURE) {
+          do_texture_effector(eff, &efd, point, out_force);
+        }
+        else {
+          do_physical_effector(eff, &efd, point, out_force);
+
+          /* for softbody backward compatibility */
+          if (point->flag & PE_WIND_AS_SPEED && impulse) {
+            sub_v3_v3v3(impulse, impulse, out_force);
+          }
+        }
+
+        if (wind_force) {
+          madd_v3_v3fl(force, out_force, 1.0f - eff->pd->f_wind_factor);
+          madd_v3_v3fl(wind_force, out_force, eff->pd->f_wind_factor);
+        }
+        else {
+          add_v3_v3(force, out_force);
+        }
+      }
+    }
+    else if (eff->flag & PE_VELOCITY_TO_IMPULSE && impulse) {
+      /* special case for harmonic effector */
+      add_v3_v3v3(impulse, impulse, efd.vel);
+    }
+  }
+}
+
 void BKE_effectors_apply(ListBase *effectors,
                          ListBase *colliders,
                          EffectorWeights *weights,
@@ -1144,8 +1245,6 @@ void BKE_effectors_apply(ListBase *effectors,
    *   (particles are guided along a curve bezier or old nurbs)
    *   (is independent of other effectors)
    */
-  EffectorData efd;
-  int p = 0, tot = 1, step = 1;
 
   /* Cycle through collected objects, get total of (1/(gravity_strength * dist^gravity_power)) */
   /* Check for min distance here? (yes would be cool to add that, ton) */
@@ -1153,47 +1252,188 @@ void BKE_effectors_apply(ListBase *effectors,
   if (effectors) {
     LISTBASE_FOREACH (EffectorCache *, eff, effectors) {
       /* object effectors were fully checked to be OK to evaluate! */
+      effector_apply_point(eff, nullptr, colliders, weights, point, force, wind_force, impulse);
+    }
+  }
+}
 
-      get_effector_tot(eff, &efd, point, &tot, &p, &step);
+/** Whether the result depends on the order in which points are evaluated. */
+static bool effector_uses_random_noise(const EffectorCache *eff)
+{
+  return eff->pd->f_noise > 0.0f && eff->pd->forcefield != PFIELD_TEXTURE;
+}
 
-      for (; p < tot; p += step) {
-        if (get_effector_data(eff, &efd, point, 0)) {
-          efd.falloff = effector_falloff(eff, &efd, point, weights);
+bool BKE_effectors_use_random_noise(const ListBase *effectors)
+{
+  if (effectors == nullptr) {
+    return false;
+  }
+  LISTBASE_FOREACH (const EffectorCache *, eff, effectors) {
+    if (effector_uses_random_noise(eff)) {
+      return true;
+    }
+  }
+  return false;
+}
 
-          if (efd.falloff > 0.0f) {
-            efd.falloff *= eff_calc_visibility(colliders, eff, &efd, point);
-          }
-          if (efd.falloff > 0.0f) {
-            float out_force[3] = {0, 0, 0};
-
-            if (eff->pd->forcefield == PFIELD_TEXTURE) {
-              do_texture_effector(eff, &efd, point, out_force);
-            }
-            else {
-              do_physical_effector(eff, &efd, point, out_force);
-
-              /* for softbody backward compatibility */
-              if (point->flag & PE_WIND_AS_SPEED && impulse) {
-                sub_v3_v3v3(impulse, impulse, out_force);
-              }
-            }
-
-            if (wind_force) {
-              madd_v3_v3fl(force, out_force, 1.0f - eff->pd->f_wind_factor);
-              madd_v3_v3fl(wind_force, out_force, eff->pd->f_wind_factor);
-            }
-            else {
-              add_v3_v3(force, out_force);
-            }
-          }
-        }
-        else if (eff->flag & PE_VELOCITY_TO_IMPULSE && impulse) {
-          /* special case for harmonic effector */
-          add_v3_v3v3(impulse, impulse, efd.vel);
+static void effector_precalc_init(EffectorCache *eff, ListBase *colliders, EffectorPrecalc &r_data)
+{
+  effector_object_axes(eff, r_data.location, r_data.z_axis);
+
+  /* The same conditions as in #get_effector_data. */
+  const bool use_surface = eff->pd->shape == PFIELD_SHAPE_SURFACE && eff->surmd &&
+                           eff->surmd->runtime.bvhtree;
+  r_data.is_object = !use_surface && eff->pd->shape != PFIELD_SHAPE_POINTS &&
+                     eff->psys == nullptr && (eff->flag & PE_USE_NORMAL_DATA) == 0;
+
+  r_data.colliders = nullptr;
+  r_data.free_colliders = false;
+  if (eff->pd->flag & PFIELD_VISIBILITY) {
+    if (colliders) {
+      r_data.colliders = colliders;
+    }
+    else {
+      r_data.colliders = BKE_collider_cache_create(eff->depsgraph, eff->ob, nullptr);
+      r_data.free_colliders = true;
+    }
+  }
+}
+
+static void effector_precalc_free(EffectorPrecalc &data)
+{
+  if (data.free_colliders) {
+    BKE_collider_cache_free(&data.colliders);
+  }
+}
+
+/**
+ * Whether the effector has no influence on the point, because it is outside of the effector's
+ * maximum distance or on the wrong side of it. This is a cheap test for the most common cases, it
+ * only returns true when #effector_falloff would return zero.
+ */
+static bool effector_out_of_range(const EffectorCache *eff,
+                                  const EffectorPrecalc &precalc,
+                                  const EffectedPoint *point)
+{
+  if (!precalc.is_object) {
+    return false;
+  }
+  const PartDeflect *pd = eff->pd;
+  float vec_to_point[3];
+  sub_v3_v3v3(vec_to_point, point->loc, precalc.location);
+  /* The same as `fac` in #effector_falloff. */
+  const float fac = dot_v3v3(precalc.z_axis, vec_to_point);
+
+  if (pd->zdir == PFIELD_Z_POS && fac < 0.0f) {
+    return true;
+  }
+  if (pd->zdir == PFIELD_Z_NEG && fac > 0.0f) {
+    return true;
+  }
+  if ((pd->flag & PFIELD_USEMAX) == 0) {
+    return false;
+  }
+  switch (pd->falloff) {
+    case PFIELD_FALL_SPHERE:
+      /* The distance is measured to the plane or line of these shapes instead. */
+      if (ELEM(pd->shape, PFIELD_SHAPE_PLANE, PFIELD_SHAPE_LINE)) {
+        return false;
+      }
+      return len_v3(vec_to_point) > pd->maxdist;
+    case PFIELD_FALL_TUBE:
+    case PFIELD_FALL_CONE:
+      return fabsf(fac) > pd->maxdist;
+  }
+  return false;
+}
+
+void BKE_effectors_apply_points(ListBase *effectors,
+                                ListBase *colliders,
+                                EffectorWeights *weights,
+                                blender::MutableSpan<EffectedPoint> points,
+                                blender::MutableSpan<blender::float3> r_forces,
+                                blender::MutableSpan<blender::float3> r_wind_forces,
+                                blender::MutableSpan<blender::float3> r_impulses)
+{
+  using namespace blender;
+  BLI_assert(r_forces.size() == points.size());
+  BLI_assert(r_wind_forces.is_empty() || r_wind_forces.size() == points.size());
+  BLI_assert(r_impulses.is_empty() || r_impulses.size() == points.size());
+  if (effectors == nullptr) {
+    return;
+  }
+
+  /* Effectors are evaluated one after the other, so every point accumulates the forces in the
+   * same order as with #BKE_effectors_apply. */
+  LISTBASE_FOREACH (EffectorCache *, eff, effectors) {
+    EffectorPrecalc precalc;
+    effector_precalc_init(eff, colliders, precalc);
+
+    /* The falloff of the effector is zero everywhere. */
+    if (precalc.is_object && weights &&
+        weights->weight[0] * weights->weight[eff->pd->forcefield] == 0.0f)
+    {
+      effector_precalc_free(precalc);
+      continue;
+    }
+
+    const auto apply_range = [&](const IndexRange range) {
+      for (const int i : range) {
+        EffectedPoint *point = &points[i];
+        if (effector_out_of_range(eff, precalc, point)) {
+          continue;
         }
+        effector_apply_point(eff,
+                             &precalc,
+                             colliders,
+                             weights,
+                             point,
+                             r_forces[i],
+                             r_wind_forces.is_empty() ? nullptr : &r_wind_forces[i].x,
+                             r_impulses.is_empty() ? nullptr : &r_impulses[i].x);
       }
+    };
+
+    if (effector_uses_random_noise(eff)) {
+      /* The random numbers depend on the order in which points are evaluated. */
+      apply_range(points.index_range());
     }
+    else {
+      threading::parallel_for(points.index_range(), 256, apply_range);
+    }
+
+    effector_precalc_free(precalc);
+  }
+}
+
+void BKE_effectors_apply_array(ListBase *effectors,
+                               ListBase *colliders,
+                               EffectorWeights *weights,
+                               const Scene *scene,
+                               const blender::Span<blender::float3> positions,
+                               const blender::Span<blender::float3> velocities,
+                               blender::MutableSpan<blender::float3> r_forces,
+                               blender::MutableSpan<blender::float3> r_wind_forces)
+{
+  using namespace blender;
+  BLI_assert(velocities.size() == positions.size());
+  if (effectors == nullptr) {
+    return;
   }
+
+  Array<EffectedPoint> points(positions.size());
+  threading::parallel_for(positions.index_range(), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      /* The location and velocity of points are only read. */
+      pd_point_from_loc(const_cast<Scene *>(scene),
+                        const_cast<float *>(&positions[i].x),
+                        const_cast<float *>(&velocities[i].x),
+                        i,
+                        &points[i]);
+    }
+  });
+  BKE_effectors_apply_points(
+      effectors, colliders, weights, points, r_forces, r_wind_forces, {});
 }
 
 /* ======== Simulation Debugging ======== */
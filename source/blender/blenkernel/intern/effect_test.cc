@@ -0,0 +1,280 @@
+/* SPDX-FileCopyrightText: 2025 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+#include "testing/testing.h"
+
+#include "MEM_guardedalloc.h"
+
+#include "CLG_log.h"
+
+#include "BLI_array.hh"
+#include "BLI_listbase.h"
+#include "BLI_math_matrix.hh"
+#include "BLI_math_rotation.hh"
+#include "BLI_rand.h"
+#include "BLI_rand.hh"
+
+#include "DNA_object_force_types.h"
+#include "DNA_object_types.h"
+#include "DNA_scene_types.h"
+
+#include "BKE_effect.hh"
+#include "BKE_idtype.hh"
+#include "BKE_layer.hh"
+#include "BKE_main.hh"
+#include "BKE_object.hh"
+#include "BKE_object_types.hh"
+#include "BKE_scene.hh"
+
+#include "DEG_depsgraph.hh"
+
+namespace blender::bke::tests {
+
+class EffectorsTest : public testing::Test {
+ public:
+  Main *bmain = nullptr;
+  Scene *scene = nullptr;
+  Depsgraph *depsgraph = nullptr;
+  EffectorWeights *weights = nullptr;
+
+  static void SetUpTestSuite()
+  {
+    CLG_init();
+    BKE_idtype_init();
+  }
+
+  static void TearDownTestSuite()
+  {
+    CLG_exit();
+  }
+
+  void SetUp() override
+  {
+    bmain = BKE_main_new();
+    scene = BKE_scene_add(bmain, "EffectorsScene");
+    depsgraph = DEG_graph_new(
+        bmain, scene, BKE_view_layer_default_view(scene), DAG_EVAL_VIEWPORT);
+    weights = BKE_effector_add_weights(nullptr);
+  }
+
+  void TearDown() override
+  {
+    MEM_freeN(weights);
+    DEG_graph_free(depsgraph);
+    BKE_main_free(bmain);
+  }
+
+  PartDeflect *add_effector(ListBase *effectors,
+                            const short type,
+                            const float3 &location,
+                            const math::EulerXYZ &rotation,
+                            const uint seed = 0)
+  {
+    Object *ob = BKE_object_add_only_object(bmain, OB_EMPTY, "Effector");
+    ob->runtime->object_to_world = math::from_loc_rot<float4x4>(location, rotation);
+    ob->pd = BKE_partdeflect_new(type);
+
+    EffectorCache *eff = static_cast<EffectorCache *>(
+        MEM_callocN(sizeof(EffectorCache), "EffectorCache"));
+    eff->depsgraph = depsgraph;
+    eff->scene = scene;
+    eff->ob = ob;
+    eff->pd = ob->pd;
+    eff->frame = -1;
+    eff->rng = BLI_rng_new(seed);
+    BLI_addtail(effectors, eff);
+    return ob->pd;
+  }
+
+  /** Effectors of every kind that can be evaluated without evaluated object data. */
+  ListBase *create_effectors()
+  {
+    ListBase *effectors = static_cast<ListBase *>(
+        MEM_callocN(sizeof(ListBase), "effector effectors"));
+
+    PartDeflect *pd = add_effector(effectors, PFIELD_FORCE, {0.5f, 0.0f, 0.0f}, {});
+    pd->flag |= PFIELD_USEMAX;
+    pd->maxdist = 1.5f;
+
+    pd = add_effector(effectors, PFIELD_WIND, {0.0f, 0.0f, -1.0f}, {0.3f, 0.2f, 0.0f});
+    pd->shape = PFIELD_SHAPE_PLANE;
+    pd->f_flow = 0.5f;
+
+    pd = add_effector(effectors, PFIELD_VORTEX, {0.0f, 1.0f, 0.0f}, {0.0f, 0.4f, 0.0f});
+    pd->zdir = PFIELD_Z_POS;
+    pd->f_power = 1.0f;
+
+    pd = add_effector(effectors, PFIELD_HARMONIC, {-1.0f, 0.0f, 0.5f}, {});
+    pd->f_size = 0.5f;
+    pd->f_damp = 0.3f;
+    pd->falloff = PFIELD_FALL_TUBE;
+    pd->flag |= PFIELD_USEMAX;
+    pd->maxdist = 0.75f;
+
+    pd = add_effector(effectors, PFIELD_MAGNET, {0.0f, -1.0f, 0.0f}, {1.0f, 0.0f, 0.5f});
+    pd->falloff = PFIELD_FALL_CONE;
+    pd->flag |= PFIELD_USEMAX;
+    pd->maxdist = 1.0f;
+    pd->f_power_r = 45.0f;
+
+    pd = add_effector(effectors, PFIELD_DRAG, {0.0f, 0.0f, 0.0f}, {});
+    pd->f_damp = 0.5f;
+
+    pd = add_effector(effectors, PFIELD_TURBULENCE, {0.2f, 0.3f, 0.1f}, {});
+    pd->f_size = 0.7f;
+
+    pd = add_effector(effectors, PFIELD_FORCE, {0.0f, 2.0f, 2.0f}, {});
+    pd->shape = PFIELD_SHAPE_LINE;
+    pd->flag |= PFIELD_USEMAX;
+    pd->maxdist = 0.5f;
+    pd->f_strength = -2.0f;
+
+    return effectors;
+  }
+};
+
+static void random_points(const int size, Array<float3> &r_positions, Array<float3> &r_velocities)
+{
+  RandomNumberGenerator rng(42);
+  r_positions.reinitialize(size);
+  r_velocities.reinitialize(size);
+  for (const int i : IndexRange(size)) {
+    r_positions[i] = float3(rng.get_float(), rng.get_float(), rng.get_float()) * 6.0f - 3.0f;
+    r_velocities[i] = float3(rng.get_float(), rng.get_float(), rng.get_float()) - 0.5f;
+  }
+}
+
+static void expect_forces_eq(const Span<float3> a, const Span<float3> b)
+{
+  ASSERT_EQ(a.size(), b.size());
+  for (const int i : a.index_range()) {
+    EXPECT_V3_NEAR(a[i], b[i], 1e-5f);
+  }
+}
+
+TEST_F(EffectorsTest, ApplyArrayMatchesApply)
+{
+  ListBase *effectors = create_effectors();
+  Array<float3> positions;
+  Array<float3> velocities;
+  random_points(2000, positions, velocities);
+
+  Array<float3> expected_forces(positions.size(), float3(0.0f));
+  Array<float3> expected_wind_forces(positions.size(), float3(0.0f));
+  for (const int i : positions.index_range()) {
+    EffectedPoint point;
+    pd_point_from_loc(scene, positions[i], velocities[i], i, &point);
+    BKE_effectors_apply(
+        effectors, nullptr, weights, &point, expected_forces[i], expected_wind_forces[i], nullptr);
+  }
+
+  Array<float3> forces(positions.size(), float3(0.0f));
+  Array<float3> wind_forces(positions.size(), float3(0.0f));
+  BKE_effectors_apply_array(
+      effectors, nullptr, weights, scene, positions, velocities, forces, wind_forces);
+  expect_forces_eq(forces, expected_forces);
+  expect_forces_eq(wind_forces, expected_wind_forces);
+
+  /* Without separate wind forces, all of the force is added to the forces. */
+  Array<float3> total_forces(positions.size(), float3(0.0f));
+  BKE_effectors_apply_array(
+      effectors, nullptr, weights, scene, positions, velocities, total_forces, {});
+  for (const int i : positions.index_range()) {
+    const float3 expected_force = expected_forces[i] + expected_wind_forces[i];
+    EXPECT_V3_NEAR(total_forces[i], expected_force, 1e-5f);
+  }
+
+  BKE_effectors_free(effectors);
+}
+
+TEST_F(EffectorsTest, ApplyPointsImpulses)
+{
+  ListBase *effectors = create_effectors();
+  Array<float3> positions;
+  Array<float3> velocities;
+  random_points(500, positions, velocities);
+
+  Array<float3> expected_forces(positions.size(), float3(0.0f));
+  Array<float3> expected_impulses(positions.size(), float3(0.0f));
+  Array<EffectedPoint> points(positions.size());
+  for (const int i : positions.index_range()) {
+    pd_point_from_soft(scene, positions[i], velocities[i], i, &points[i]);
+    BKE_effectors_apply(effectors,
+                        nullptr,
+                        weights,
+                        &points[i],
+                        expected_forces[i],
+                        nullptr,
+                        expected_impulses[i]);
+  }
+
+  /* Weights of effector types are taken into account too. */
+  weights->weight[PFIELD_DRAG] = 0.0f;
+  Array<float3> expected_weighted_forces(positions.size(), float3(0.0f));
+  for (const int i : positions.index_range()) {
+    BKE_effectors_apply(
+        effectors, nullptr, weights, &points[i], expected_weighted_forces[i], nullptr, nullptr);
+  }
+
+  Array<float3> weighted_forces(positions.size(), float3(0.0f));
+  BKE_effectors_apply_points(effectors, nullptr, weights, points, weighted_forces, {}, {});
+  expect_forces_eq(weighted_forces, expected_weighted_forces);
+
+  weights->weight[PFIELD_DRAG] = 1.0f;
+  Array<float3> forces(positions.size(), float3(0.0f));
+  Array<float3> impulses(positions.size(), float3(0.0f));
+  BKE_effectors_apply_points(effectors, nullptr, weights, points, forces, {}, impulses);
+  expect_forces_eq(forces, expected_forces);
+  expect_forces_eq(impulses, expected_impulses);
+
+  BKE_effectors_free(effectors);
+}
+
+TEST_F(EffectorsTest, ApplyArrayNoise)
+{
+  /* Random noise depends on the order in which points are evaluated, which has to be kept. */
+  auto create_noise_effectors = [&]() {
+    ListBase *effectors = create_effectors();
+    PartDeflect *pd = add_effector(effectors, PFIELD_WIND, {0.0f, 0.0f, 1.0f}, {}, 7);
+    pd->f_noise = 2.0f;
+    return effectors;
+  };
+  ListBase *effectors_a = create_noise_effectors();
+  ListBase *effectors_b = create_noise_effectors();
+  EXPECT_TRUE(BKE_effectors_use_random_noise(effectors_a));
+
+  Array<float3> positions;
+  Array<float3> velocities;
+  random_points(1000, positions, velocities);
+
+  Array<float3> expected_forces(positions.size(), float3(0.0f));
+  for (const int i : positions.index_range()) {
+    EffectedPoint point;
+    pd_point_from_loc(scene, positions[i], velocities[i], i, &point);
+    BKE_effectors_apply(
+        effectors_a, nullptr, weights, &point, expected_forces[i], nullptr, nullptr);
+  }
+
+  Array<float3> forces(positions.size(), float3(0.0f));
+  BKE_effectors_apply_array(
+      effectors_b, nullptr, weights, scene, positions, velocities, forces, forces);
+  expect_forces_eq(forces, expected_forces);
+
+  BKE_effectors_free(effectors_a);
+  BKE_effectors_free(effectors_b);
+}
+
+TEST_F(EffectorsTest, ApplyArrayNoEffectors)
+{
+  Array<float3> positions;
+  Array<float3> velocities;
+  random_points(10, positions, velocities);
+  Array<float3> forces(positions.size(), float3(1.0f));
+  BKE_effectors_apply_array(
+      nullptr, nullptr, weights, scene, positions, velocities, forces, forces);
+  for (const float3 &force : forces) {
+    EXPECT_EQ(force, float3(1.0f));
+  }
+}
+
+}  // namespace blender::bke::tests
@@ -2000,9 +2000,66 @@ static float fcurve_eval_keyframes_extrapolate(const FCurve *fcu,
   return endpoint_bezt->vec[1][1] - (fac * dx);
 }
 
+/**
+ * Check whether the keyframe at \a index is the one that the binary search in
+ * #BKE_fcurve_bezt_binarysearch_index_ex would find, without searching. That is the case when
+ * there is no ambiguity about which keyframes are within the threshold.
+ */
+static bool fcurve_bezt_index_matches(const BezTriple *bezts,
+                                      const int totvert,
+                                      const int index,
+                                      const float evaltime,
+                                      const float threshold,
+                                      bool *r_exact)
+{
+  if (index < 0 || index >= totvert) {
+    return false;
+  }
+  const float frame = bezts[index].vec[1][0];
+  const bool prev_is_far = index == 0 ||
+                           !IS_EQT(evaltime, bezts[index - 1].vec[1][0], threshold);
+  if (IS_EQT(evaltime, frame, threshold)) {
+    const bool next_is_far = index == totvert - 1 ||
+                             !IS_EQT(evaltime, bezts[index + 1].vec[1][0], threshold);
+    *r_exact = true;
+    return prev_is_far && next_is_far;
+  }
+  *r_exact = false;
+  return index > 0 && prev_is_far && bezts[index - 1].vec[1][0] < evaltime && evaltime < frame;
+}
+
+/**
+ * Find the keyframe at or after \a evaltime. When a segment hint is given, the keyframe that was
+ * found in the previous evaluation and the one after it are checked first, which avoids the
+ * binary search during playback.
+ */
+static int fcurve_bezt_find_index(const FCurve *fcu,
+                                  const BezTriple *bezts,
+                                  const float evaltime,
+                                  const float threshold,
+                                  int *segment_hint,
+                                  bool *r_exact)
+{
+  if (segment_hint) {
+    for (const int index : {*segment_hint, *segment_hint + 1}) {
+      if (fcurve_bezt_index_matches(bezts, fcu->totvert, index, evaltime, threshold, r_exact)) {
+        *segment_hint = index;
+        return index;
+      }
+    }
+  }
+  const int index = BKE_fcurve_bezt_binarysearch_index_ex(
+      bezts, evaltime, fcu->totvert, threshold, r_exact);
+  if (segment_hint) {
+    *segment_hint = index;
+  }
+  return index;
+}
+
 static float fcurve_eval_keyframes_interpolate(const FCurve *fcu,
                                                const BezTriple *bezts,
-                                               float evaltime)
+                                               float evaltime,
+                                               int *segment_hint)
 {
   const float eps = 1.e-8f;
   uint a;
@@ -2020,7 +2077,7 @@ static float fcurve_eval_keyframes_interpolate(const FCurve *fcu,
    *   Weird errors, like selecting the wrong keyframe range (see #39207), occur.
    *   This lower bound was established in b888a32eee8147b028464336ad2404d8155c64dd.
    */
-  a = BKE_fcurve_bezt_binarysearch_index_ex(bezts, evaltime, fcu->totvert, 0.0001, &exact);
+  a = fcurve_bezt_find_index(fcu, bezts, evaltime, 0.0001, segment_hint, &exact);
   const BezTriple *bezt = bezts + a;
 
   if (exact) {
@@ -2264,7 +2321,10 @@ static float fcurve_eval_keyframes_interpolate(const FCurve *fcu,
 }
 
 /* Calculate F-Curve value for 'evaltime' using #BezTriple keyframes. */
-static float fcurve_eval_keyframes(const FCurve *fcu, const BezTriple *bezts, float evaltime)
+static float fcurve_eval_keyframes(const FCurve *fcu,
+                                   const BezTriple *bezts,
+                                   float evaltime,
+                                   int *segment_hint)
 {
   if (evaltime <= bezts->vec[1][0]) {
     return fcurve_eval_keyframes_extrapolate(fcu, bezts, evaltime, 0, +1);
@@ -2275,7 +2335,7 @@ static float fcurve_eval_keyframes(const FCurve *fcu, const BezTriple *bezts, fl
     return fcurve_eval_keyframes_extrapolate(fcu, bezts, evaltime, fcu->totvert - 1, -1);
   }
 
-  return fcurve_eval_keyframes_interpolate(fcu, bezts, evaltime);
+  return fcurve_eval_keyframes_interpolate(fcu, bezts, evaltime, segment_hint);
 }
 
 /* Calculate F-Curve value for 'evaltime' using #FPoint samples. */
@@ -2323,7 +2383,10 @@ static float fcurve_eval_samples(const FCurve *fcu, const FPoint *fpts, float ev
 /* Evaluate and return the value of the given F-Curve at the specified frame ("evaltime")
  * NOTE: this is also used for drivers.
  */
-static float evaluate_fcurve_ex(const FCurve *fcu, float evaltime, float cvalue)
+static float evaluate_fcurve_ex(const FCurve *fcu,
+                                float evaltime,
+                                float cvalue,
+                                int *segment_hint = nullptr)
 {
   /* Evaluate modifiers which modify time to evaluate the base curve at. */
   FModifiersStackStorage storage;
@@ -2339,7 +2402,7 @@ static float evaluate_fcurve_ex(const FCurve *fcu, float evaltime, float cvalue)
    *   F-Curve modifier on the stack requested the curve to be evaluated at.
    */
   if (fcu->bezt) {
-    cvalue = fcurve_eval_keyframes(fcu, fcu->bezt, devaltime);
+    cvalue = fcurve_eval_keyframes(fcu, fcu->bezt, devaltime, segment_hint);
   }
   else if (fcu->fpt) {
     cvalue = fcurve_eval_samples(fcu, fcu->fpt, devaltime);
@@ -2358,11 +2421,11 @@ static float evaluate_fcurve_ex(const FCurve *fcu, float evaltime, float cvalue)
   return cvalue;
 }
 
-float evaluate_fcurve(const FCurve *fcu, float evaltime)
+float evaluate_fcurve(const FCurve *fcu, float evaltime, int *segment_hint)
 {
   BLI_assert(fcu->driver == nullptr);
 
-  return evaluate_fcurve_ex(fcu, evaltime, 0.0);
+  return evaluate_fcurve_ex(fcu, evaltime, 0.0, segment_hint);
 }
 
 float evaluate_fcurve_only_curve(const FCurve *fcu, float evaltime)
@@ -2429,7 +2492,8 @@ bool BKE_fcurve_is_empty(const FCurve *fcu)
 
 float calculate_fcurve(PathResolvedRNA *anim_rna,
                        FCurve *fcu,
-                       const AnimationEvalContext *anim_eval_context)
+                       const AnimationEvalContext *anim_eval_context,
+                       int *segment_hint)
 {
   /* Only calculate + set curval (overriding the existing value) if curve has
    * any data which warrants this...
@@ -2444,7 +2508,7 @@ float calculate_fcurve(PathResolvedRNA *anim_rna,
     curval = evaluate_fcurve_driver(anim_rna, fcu, fcu->driver, anim_eval_context);
   }
   else {
-    curval = evaluate_fcurve(fcu, anim_eval_context->eval_time);
+    curval = evaluate_fcurve(fcu, anim_eval_context->eval_time, segment_hint);
   }
   fcu->curval = curval; /* Debug display only, not thread safe! */
   return curval;
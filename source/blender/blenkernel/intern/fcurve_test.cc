@@ -93,6 +93,36 @@ TEST(evaluate_fcurve, InterpolationLinear)
   BKE_fcurve_free(fcu);
 }
 
+TEST(evaluate_fcurve, SegmentHint)
+{
+  FCurve *fcu = BKE_fcurve_create();
+
+  const KeyframeSettings settings = get_keyframe_settings(false);
+  for (const int i : IndexRange(10)) {
+    insert_vert_fcurve(fcu, {float(i), float(i * i)}, settings, INSERTKEY_NOFLAGS);
+  }
+
+  /* The hint must not change the result, no matter whether it is correct, outdated or invalid. */
+  const float time_epsilon = 0.00008f;
+  for (const int initial_hint : {-5, 0, 3, 4, 9, 100}) {
+    for (const float frame :
+         {0.5f, 3.5f, 4.0f, 4.0f - time_epsilon, 4.0f + time_epsilon, 4.25f, 8.99f, 1.5f})
+    {
+      int hint = initial_hint;
+      EXPECT_EQ(evaluate_fcurve(fcu, frame, &hint), evaluate_fcurve(fcu, frame));
+    }
+  }
+
+  /* Playing forward keeps the hint up to date. */
+  int hint = 0;
+  for (float frame = 0.0f; frame < 9.0f; frame += 0.25f) {
+    EXPECT_EQ(evaluate_fcurve(fcu, frame, &hint), evaluate_fcurve(fcu, frame));
+  }
+  EXPECT_EQ(hint, 9);
+
+  BKE_fcurve_free(fcu);
+}
+
 TEST(evaluate_fcurve, InterpolationBezier)
 {
   FCurve *fcu = BKE_fcurve_create();
@@ -27,7 +27,7 @@
 #include "DNA_rigidbody_types.h"
 
 #include "BKE_attribute.hh"
-#include "BKE_effect.h"
+#include "BKE_effect.hh"
 #include "BKE_fluid.h"
 #include "BKE_global.hh"
 #include "BKE_layer.hh"
@@ -14,13 +14,18 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "BLI_array.hh"
+#include "BLI_cache_mutex.hh"
 #include "BLI_endian_switch.h"
 #include "BLI_math_matrix.h"
 #include "BLI_math_vector.h"
+#include "BLI_math_vector_types.hh"
 #include "BLI_string.h"
 #include "BLI_string_utf8.h"
 #include "BLI_string_utils.hh"
+#include "BLI_task.hh"
 #include "BLI_utildefines.h"
+#include "BLI_vector.hh"
 
 #include "BLT_translation.hh"
 
@@ -56,11 +61,37 @@
 
 #include "BLO_read_write.hh"
 
+namespace blender::bke {
+
+/**
+ * The difference between a key block and its reference key block. Most shape keys only move a
+ * small part of the geometry, storing only the elements that are different avoids adding zeros
+ * for all other elements when blending relative shape keys.
+ */
+struct KeyBlockDeltas {
+  /** The key blocks the deltas were computed from, to detect when they are outdated. */
+  const KeyBlock *reference = nullptr;
+  const void *data = nullptr;
+  /** Sorted indices of elements that differ from the reference. Unused when #is_dense is set. */
+  Array<int> indices;
+  /** The reference position minus the key block position, for every element in #indices. */
+  Array<float3> deltas;
+  bool is_dense = false;
+};
+
+struct KeyRuntime {
+  /** Deltas of every key block, in the order of #Key::block. */
+  Array<KeyBlockDeltas> deltas;
+  CacheMutex deltas_cache_mutex;
+};
+
+}  // namespace blender::bke
+
 static void shapekey_copy_data(Main * /*bmain*/,
                                std::optional<Library *> /*owner_library*/,
                                ID *id_dst,
                                const ID *id_src,
-                               const int /*flag*/)
+                               const int flag)
 {
   Key *key_dst = (Key *)id_dst;
   const Key *key_src = (const Key *)id_src;
@@ -79,6 +110,11 @@ static void shapekey_copy_data(Main * /*bmain*/,
       key_dst->refkey = kb_dst;
     }
   }
+
+  key_dst->runtime = nullptr;
+  if (flag & LIB_ID_COPY_SET_COPIED_ON_WRITE) {
+    key_dst->runtime = MEM_new<blender::bke::KeyRuntime>(__func__);
+  }
 }
 
 static void shapekey_free_data(ID *id)
@@ -90,6 +126,8 @@ static void shapekey_free_data(ID *id)
     }
     MEM_freeN(kb);
   }
+  MEM_delete(key->runtime);
+  key->runtime = nullptr;
 }
 
 static void shapekey_foreach_id(ID *id, LibraryForeachIDData *data)
@@ -178,6 +216,7 @@ static void shapekey_blend_read_data(BlendDataReader *reader, ID *id)
   BLO_read_struct_list(reader, KeyBlock, &(key->block));
 
   BLO_read_struct(reader, KeyBlock, &key->refkey);
+  key->runtime = nullptr;
 
   LISTBASE_FOREACH (KeyBlock *, kb, &key->block) {
     BLO_read_data_address(reader, &kb->data);
@@ -997,6 +1036,163 @@ static void key_evaluate_relative(const int start,
   }
 }
 
+namespace blender::bke {
+
+static KeyBlockDeltas calc_keyblock_deltas(const KeyBlock &kb, const KeyBlock &reference)
+{
+  KeyBlockDeltas result;
+  result.reference = &reference;
+  result.data = kb.data;
+  if (kb.data == nullptr || reference.data == nullptr || kb.totelem != reference.totelem) {
+    /* Should not happen, evaluated without cached deltas. */
+    result.reference = nullptr;
+    return result;
+  }
+  const Span<float3> positions(static_cast<const float3 *>(kb.data), kb.totelem);
+  const Span<float3> ref_positions(static_cast<const float3 *>(reference.data), kb.totelem);
+
+  Vector<int> indices;
+  for (const int i : positions.index_range()) {
+    if (positions[i] != ref_positions[i]) {
+      indices.append(i);
+    }
+  }
+
+  /* Storing the indices costs more than it saves when most elements are moved. */
+  if (indices.size() > positions.size() / 2) {
+    result.is_dense = true;
+    result.deltas.reinitialize(positions.size());
+    for (const int i : positions.index_range()) {
+      result.deltas[i] = ref_positions[i] - positions[i];
+    }
+    return result;
+  }
+  result.indices = indices.as_span();
+  result.deltas.reinitialize(indices.size());
+  for (const int i : indices.index_range()) {
+    result.deltas[i] = ref_positions[indices[i]] - positions[indices[i]];
+  }
+  return result;
+}
+
+static Span<KeyBlockDeltas> keyblock_deltas_ensure(Key &key)
+{
+  KeyRuntime &runtime = *key.runtime;
+  runtime.deltas_cache_mutex.ensure([&]() {
+    Vector<const KeyBlock *> keyblocks;
+    LISTBASE_FOREACH (const KeyBlock *, kb, &key.block) {
+      keyblocks.append(kb);
+    }
+    runtime.deltas.reinitialize(keyblocks.size());
+    threading::parallel_for(keyblocks.index_range(), 1, [&](const IndexRange range) {
+      for (const int i : range) {
+        const KeyBlock &kb = *keyblocks[i];
+        const KeyBlock *reference = static_cast<const KeyBlock *>(
+            BLI_findlink(&key.block, kb.relative));
+        if (&kb == key.refkey || reference == nullptr) {
+          continue;
+        }
+        runtime.deltas[i] = calc_keyblock_deltas(kb, *reference);
+      }
+    });
+  });
+  return runtime.deltas;
+}
+
+/**
+ * Faster version of #key_evaluate_relative for evaluated shape keys with positions only, which
+ * only visits the elements that are moved by every key block. The key blocks are applied in the
+ * same order and with the same arithmetic for every element, so the result is the same.
+ *
+ * \return False when the cached deltas can't be used, nothing is written in that case.
+ */
+static bool key_evaluate_relative_sparse(Key *key,
+                                         KeyBlock *actkb,
+                                         const int tot,
+                                         char *basispoin,
+                                         float **per_keyblock_weights)
+{
+  if (key->runtime == nullptr || key->from == nullptr ||
+      key->elemsize != sizeof(float[KEYELEM_FLOAT_LEN_COORD]))
+  {
+    return false;
+  }
+  if (GS(key->from->name) == ID_ME) {
+    /* The active key block is read from the edit-mesh, see #key_block_get_data. */
+    if (reinterpret_cast<const Mesh *>(key->from)->runtime->edit_mesh) {
+      return false;
+    }
+  }
+  else if (GS(key->from->name) != ID_LT) {
+    return false;
+  }
+
+  struct BlendItem {
+    const KeyBlockDeltas *deltas;
+    const float *weights;
+    float factor;
+  };
+
+  const Span<KeyBlockDeltas> all_deltas = keyblock_deltas_ensure(*key);
+  Vector<BlendItem> items;
+  int keyblock_index = 0;
+  LISTBASE_FOREACH_INDEX (KeyBlock *, kb, &key->block, keyblock_index) {
+    if (kb == key->refkey || (kb->flag & KEYBLOCK_MUTE) || kb->curval == 0.0f ||
+        kb->totelem != tot)
+    {
+      continue;
+    }
+    const KeyBlock *reference = static_cast<const KeyBlock *>(
+        BLI_findlink(&key->block, kb->relative));
+    if (reference == nullptr) {
+      continue;
+    }
+    if (keyblock_index >= all_deltas.size()) {
+      return false;
+    }
+    const KeyBlockDeltas &deltas = all_deltas[keyblock_index];
+    if (deltas.reference != reference || deltas.data != kb->data) {
+      return false;
+    }
+    items.append({&deltas,
+                  per_keyblock_weights ? per_keyblock_weights[keyblock_index] : nullptr,
+                  kb->curval});
+  }
+
+  cp_key(0, tot, tot, basispoin, key, actkb, key->refkey, nullptr, KEY_MODE_DUMMY);
+
+  MutableSpan<float3> positions(reinterpret_cast<float3 *>(basispoin), tot);
+  threading::parallel_for(positions.index_range(), 4096, [&](const IndexRange range) {
+    for (const BlendItem &item : items) {
+      const Span<float3> deltas = item.deltas->deltas;
+      if (item.deltas->is_dense) {
+        if (item.weights) {
+          for (const int i : range) {
+            positions[i] -= (item.weights[i] * item.factor) * deltas[i];
+          }
+        }
+        else {
+          for (const int i : range) {
+            positions[i] -= item.factor * deltas[i];
+          }
+        }
+        continue;
+      }
+      const Span<int> indices = item.deltas->indices;
+      const int64_t begin = std::lower_bound(indices.begin(), indices.end(), range.first()) -
+                            indices.begin();
+      for (int64_t j = begin; j < indices.size() && indices[j] < range.one_after_last(); j++) {
+        const int i = indices[j];
+        const float weight = item.weights ? (item.weights[i] * item.factor) : item.factor;
+        positions[i] -= weight * deltas[j];
+      }
+    }
+  });
+  return true;
+}
+
+}  // namespace blender::bke
+
 static void do_key(const int start,
                    int end,
                    const int tot,
@@ -1394,7 +1590,9 @@ static void do_mesh_key(Object *ob, Key *key, char *out, const int tot)
     WeightsArrayCache cache = {0, nullptr};
     float **per_keyblock_weights;
     per_keyblock_weights = keyblock_get_per_block_weights(ob, key, &cache);
-    key_evaluate_relative(0, tot, tot, out, key, actkb, per_keyblock_weights, KEY_MODE_DUMMY);
+    if (!blender::bke::key_evaluate_relative_sparse(key, actkb, tot, out, per_keyblock_weights)) {
+      key_evaluate_relative(0, tot, tot, out, key, actkb, per_keyblock_weights, KEY_MODE_DUMMY);
+    }
     keyblock_free_per_block_weights(key, per_keyblock_weights, &cache);
   }
   else {
@@ -1486,7 +1684,9 @@ static void do_latt_key(Object *ob, Key *key, char *out, const int tot)
   if (key->type == KEY_RELATIVE) {
     float **per_keyblock_weights;
     per_keyblock_weights = keyblock_get_per_block_weights(ob, key, nullptr);
-    key_evaluate_relative(0, tot, tot, out, key, actkb, per_keyblock_weights, KEY_MODE_DUMMY);
+    if (!blender::bke::key_evaluate_relative_sparse(key, actkb, tot, out, per_keyblock_weights)) {
+      key_evaluate_relative(0, tot, tot, out, key, actkb, per_keyblock_weights, KEY_MODE_DUMMY);
+    }
     keyblock_free_per_block_weights(key, per_keyblock_weights, nullptr);
   }
   else {
@@ -0,0 +1,206 @@
+/* SPDX-FileCopyrightText: 2025 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+#include "testing/testing.h"
+
+#include "MEM_guardedalloc.h"
+
+#include "CLG_log.h"
+
+#include "BLI_array.hh"
+#include "BLI_function_ref.hh"
+#include "BLI_listbase.h"
+#include "BLI_rand.hh"
+#include "BLI_string.h"
+
+#include "DNA_key_types.h"
+#include "DNA_mesh_types.h"
+#include "DNA_meshdata_types.h"
+#include "DNA_object_types.h"
+
+#include "BKE_deform.hh"
+#include "BKE_idtype.hh"
+#include "BKE_key.hh"
+#include "BKE_lib_id.hh"
+#include "BKE_main.hh"
+#include "BKE_mesh.h"
+#include "BKE_object.hh"
+#include "BKE_object_deform.h"
+
+namespace blender::bke::tests {
+
+/**
+ * Relative shape keys of evaluated copies are blended from cached sparse deltas, original keys
+ * are blended by the per-element code. Both have to give the same result.
+ */
+class KeyRelativeSparseTest : public testing::Test {
+ public:
+  /* More than one range of the parallel loop over elements. */
+  static constexpr int verts_num = 10000;
+
+  Main *bmain = nullptr;
+  Mesh *mesh = nullptr;
+  Object *ob = nullptr;
+  Key *key = nullptr;
+  Array<float3> basis_positions;
+
+  static void SetUpTestSuite()
+  {
+    CLG_init();
+    BKE_idtype_init();
+  }
+
+  static void TearDownTestSuite()
+  {
+    CLG_exit();
+  }
+
+  void SetUp() override
+  {
+    bmain = BKE_main_new();
+    mesh = BKE_mesh_new_nomain(verts_num, 0, 0, 0);
+    BKE_libblock_management_main_add(bmain, mesh);
+    ob = BKE_object_add_only_object(bmain, OB_MESH, "KeyObject");
+    ob->data = mesh;
+    key = BKE_key_add(bmain, &mesh->id);
+    key->type = KEY_RELATIVE;
+    mesh->key = key;
+
+    RandomNumberGenerator rng(0);
+    basis_positions.reinitialize(verts_num);
+    for (float3 &position : basis_positions) {
+      position = float3(rng.get_float(), rng.get_float(), rng.get_float());
+    }
+    add_keyblock("Basis", 0, [&](const int i) { return basis_positions[i]; });
+  }
+
+  void TearDown() override
+  {
+    BKE_main_free(bmain);
+  }
+
+  KeyBlock *add_keyblock(const char *name,
+                         const int relative,
+                         const FunctionRef<float3(int)> get_position)
+  {
+    KeyBlock *kb = BKE_keyblock_add(key, name);
+    float3 *positions = static_cast<float3 *>(
+        MEM_malloc_arrayN(verts_num, sizeof(float3), __func__));
+    for (const int i : IndexRange(verts_num)) {
+      positions[i] = get_position(i);
+    }
+    kb->data = positions;
+    kb->totelem = verts_num;
+    kb->relative = relative;
+    kb->curval = 1.0f;
+    return kb;
+  }
+
+  /** Move every vertex whose index is a multiple of \a step. */
+  KeyBlock *add_sparse_keyblock(const char *name,
+                                const int relative,
+                                const int step,
+                                const float3 &offset)
+  {
+    const float3 *reference = static_cast<const float3 *>(
+        static_cast<KeyBlock *>(BLI_findlink(&key->block, relative))->data);
+    return add_keyblock(name, relative, [&](const int i) {
+      return i % step == 0 ? reference[i] + offset : reference[i];
+    });
+  }
+
+  Array<float3> evaluate(Key &key_to_evaluate)
+  {
+    mesh->key = &key_to_evaluate;
+    int totelem = 0;
+    float *data = BKE_key_evaluate_object(ob, &totelem);
+    mesh->key = key;
+    Array<float3> positions(Span(reinterpret_cast<const float3 *>(data), totelem));
+    MEM_freeN(data);
+    return positions;
+  }
+
+  void expect_sparse_matches_dense()
+  {
+    /* Only evaluated copies have the runtime data that stores the deltas. */
+    Key *key_eval = reinterpret_cast<Key *>(BKE_id_copy_ex(
+        nullptr, &key->id, nullptr, LIB_ID_COPY_LOCALIZE | LIB_ID_COPY_SET_COPIED_ON_WRITE));
+    ASSERT_NE(key_eval->runtime, nullptr);
+    ASSERT_EQ(key->runtime, nullptr);
+
+    const Array<float3> dense = evaluate(*key);
+    const Array<float3> sparse = evaluate(*key_eval);
+    ASSERT_EQ(dense.size(), verts_num);
+    ASSERT_EQ(sparse.size(), verts_num);
+    for (const int i : dense.index_range()) {
+      EXPECT_V3_NEAR(sparse[i], dense[i], 1e-6f);
+    }
+
+    /* Evaluating again uses the deltas cached by the first evaluation. */
+    const Array<float3> sparse_cached = evaluate(*key_eval);
+    EXPECT_EQ(sparse_cached.as_span(), sparse.as_span());
+
+    BKE_id_free(nullptr, key_eval);
+  }
+};
+
+TEST_F(KeyRelativeSparseTest, SparseAndDenseKeys)
+{
+  add_sparse_keyblock("Sparse", 0, 97, float3(0.1f, -0.2f, 0.3f))->curval = 0.3f;
+  add_keyblock("Dense", 0, [&](const int i) { return basis_positions[i] * 1.5f; })->curval = 0.7f;
+  /* Moving more than half of the vertices stores the deltas densely too. */
+  add_keyblock("MostlyMoved", 0, [&](const int i) {
+    return i % 4 == 0 ? basis_positions[i] : basis_positions[i] + float3(0.0f, 0.0f, 1.0f);
+  })->curval = -0.5f;
+  add_sparse_keyblock("Muted", 0, 3, float3(1.0f))->flag |= KEYBLOCK_MUTE;
+  add_sparse_keyblock("Zero", 0, 5, float3(1.0f))->curval = 0.0f;
+  expect_sparse_matches_dense();
+}
+
+TEST_F(KeyRelativeSparseTest, EmptyDeltas)
+{
+  add_keyblock("Unchanged", 0, [&](const int i) { return basis_positions[i]; });
+  add_sparse_keyblock("Single", 0, verts_num, float3(2.0f));
+  expect_sparse_matches_dense();
+  /* Only the first vertex is moved. */
+  const Array<float3> positions = evaluate(*key);
+  const float3 moved_position = basis_positions[0] + float3(2.0f);
+  EXPECT_V3_NEAR(positions[0], moved_position, 1e-6f);
+  EXPECT_EQ(positions[1], basis_positions[1]);
+}
+
+TEST_F(KeyRelativeSparseTest, RelativeToNonBasis)
+{
+  add_keyblock("Base", 0, [&](const int i) { return basis_positions[i] + float3(0.5f); })
+      ->curval = 0.25f;
+  add_sparse_keyblock("RelativeToBase", 1, 7, float3(-0.3f, 0.2f, 0.0f))->curval = 0.8f;
+  /* Relative to a key block that comes later in the list. */
+  KeyBlock *kb = add_sparse_keyblock("RelativeToLater", 0, 11, float3(0.0f));
+  kb->relative = 4;
+  add_sparse_keyblock("Later", 0, 13, float3(0.0f, 1.0f, 0.0f))->curval = 0.4f;
+  expect_sparse_matches_dense();
+}
+
+TEST_F(KeyRelativeSparseTest, VertexGroupWeights)
+{
+  BKE_object_defgroup_add_name(ob, "Group");
+  MutableSpan<MDeformVert> dverts = mesh->deform_verts_for_write();
+  for (const int i : dverts.index_range()) {
+    if (i % 4 != 0) {
+      BKE_defvert_add_index_notest(&dverts[i], 0, float(i % 10) / 10.0f);
+    }
+  }
+
+  KeyBlock *sparse = add_sparse_keyblock("Sparse", 0, 3, float3(0.4f, 0.0f, -0.1f));
+  STRNCPY(sparse->vgroup, "Group");
+  sparse->curval = 0.6f;
+  KeyBlock *dense = add_keyblock(
+      "Dense", 0, [&](const int i) { return basis_positions[i] + float3(0.0f, 0.3f, 0.0f); });
+  STRNCPY(dense->vgroup, "Group");
+  /* A vertex group that doesn't exist is ignored. */
+  KeyBlock *missing = add_sparse_keyblock("Missing", 0, 5, float3(0.2f));
+  STRNCPY(missing->vgroup, "Missing");
+  expect_sparse_matches_dense();
+}
+
+}  // namespace blender::bke::tests
@@ -43,12 +43,14 @@ static void propagate_node_tree_changes(Main &bmain,
                                         const std::optional<blender::Span<ID *>> modified_ids)
 {
   NodeTreeUpdateExtraParams params;
-  params.tree_changed_fn = [](bNodeTree &ntree, ID &owner_id) {
+  params.tree_changed_fn = [](bNodeTree &ntree, ID &owner_id, const bool only_values_changed) {
     send_notifiers_after_node_tree_change(&owner_id, &ntree);
-    DEG_id_tag_update(&ntree.id, ID_RECALC_SYNC_TO_EVAL);
+    DEG_id_tag_update(&ntree.id, only_values_changed ? ID_RECALC_SYNC_VALUES_TO_EVAL :
+                                                       ID_RECALC_SYNC_TO_EVAL);
   };
   params.tree_output_changed_fn = [](bNodeTree &ntree, ID & /*owner_id*/) {
-    DEG_id_tag_update(&ntree.id, ID_RECALC_NTREE_OUTPUT);
+    /* The tree is already tagged for a full copy above when more than values changed. */
+    DEG_id_tag_update(&ntree.id, ID_RECALC_NTREE_OUTPUT | ID_RECALC_SYNC_VALUES_TO_EVAL);
   };
 
   std::optional<blender::Vector<bNodeTree *>> modified_trees;
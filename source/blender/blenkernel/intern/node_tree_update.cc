@@ -361,6 +361,11 @@ class NodeTreeMainUpdater {
       bNodeTree *ntree = item.key;
       const TreeUpdateResult &result = item.value;
 
+      /* Socket properties are mostly default values, other changes are detected when the evaluated
+       * copy is synchronized. */
+      const bool only_values_changed = !result.interface_changed &&
+                                       (ntree->runtime->changed_flag &
+                                        ~NTREE_CHANGED_SOCKET_PROPERTY) == 0;
       this->reset_changed_flags(*ntree);
 
       if (result.interface_changed) {
@@ -384,7 +389,7 @@ class NodeTreeMainUpdater {
       ID *owner_id = BKE_id_owner_get(&ntree->id);
       ID &owner_or_self_id = owner_id ? *owner_id : ntree->id;
       if (params_.tree_changed_fn) {
-        params_.tree_changed_fn(*ntree, owner_or_self_id);
+        params_.tree_changed_fn(*ntree, owner_or_self_id, only_values_changed);
       }
       if (params_.tree_output_changed_fn && result.output_changed) {
         params_.tree_output_changed_fn(*ntree, owner_or_self_id);
@@ -78,7 +78,7 @@
 #include "BKE_duplilist.hh"
 #include "BKE_editmesh.hh"
 #include "BKE_editmesh_cache.hh"
-#include "BKE_effect.h"
+#include "BKE_effect.hh"
 #include "BKE_fcurve.hh"
 #include "BKE_geometry_set.hh"
 #include "BKE_geometry_set_instances.hh"
@@ -30,6 +30,7 @@
 #include "BKE_mesh.hh"
 #include "BKE_object.hh"
 #include "BKE_particle.h"
+#include "BKE_playback_geometry_cache.hh"
 #include "BKE_pointcache.h"
 #include "BKE_pointcloud.hh"
 #include "BKE_scene.hh"
@@ -125,34 +126,57 @@ void BKE_object_eval_transform_final(Depsgraph *depsgraph, Object *ob)
   ob->runtime->last_update_transform = DEG_get_update_count(depsgraph);
 }
 
+static void object_sync_evaluated_bounds(Depsgraph *depsgraph, Object *ob)
+{
+  if (DEG_is_active(depsgraph)) {
+    Object *object_orig = DEG_get_original_object(ob);
+    object_orig->runtime->bounds_eval = BKE_object_evaluated_geometry_bounds(ob);
+  }
+}
+
+static CustomData_MeshMasks object_mesh_data_masks(Depsgraph *depsgraph, Scene *scene)
+{
+  CustomData_MeshMasks cddata_masks = scene->customdata_mask;
+  CustomData_MeshMasks_update(&cddata_masks, &CD_MASK_BAREMESH);
+  /* Custom attributes should not be removed automatically. They might be used by the render
+   * engine or scripts. They can still be removed explicitly using geometry nodes.
+   * Vertex groups can be used in arbitrary situations with geometry nodes as well. */
+  cddata_masks.vmask |= CD_MASK_PROP_ALL | CD_MASK_MDEFORMVERT;
+  cddata_masks.emask |= CD_MASK_PROP_ALL;
+  cddata_masks.fmask |= CD_MASK_PROP_ALL;
+  cddata_masks.pmask |= CD_MASK_PROP_ALL;
+  cddata_masks.lmask |= CD_MASK_PROP_ALL;
+
+  /* Make sure Freestyle edge/face marks appear in evaluated mesh (see #40315).
+   * Due to Line Art implementation, edge marks should also be shown in viewport. */
+#ifdef WITH_FREESTYLE
+  cddata_masks.emask |= CD_MASK_FREESTYLE_EDGE;
+  cddata_masks.pmask |= CD_MASK_FREESTYLE_FACE;
+#endif
+  if (DEG_get_mode(depsgraph) == DAG_EVAL_RENDER) {
+    /* Always compute orcos for render. */
+    cddata_masks.vmask |= CD_MASK_ORCO;
+  }
+  return cddata_masks;
+}
+
 void BKE_object_handle_data_update(Depsgraph *depsgraph, Scene *scene, Object *ob)
 {
   DEG_debug_print_eval(depsgraph, __func__, ob->id.name, ob);
 
+  const CustomData_MeshMasks cddata_masks = object_mesh_data_masks(depsgraph, scene);
+  blender::bke::PlaybackGeometryCache *playback_cache = nullptr;
+  if (blender::bke::PlaybackGeometryCache::is_supported(*depsgraph, *ob)) {
+    playback_cache = &DEG_get_playback_geometry_cache(depsgraph);
+    if (playback_cache->restore(*depsgraph, *ob, cddata_masks)) {
+      object_sync_evaluated_bounds(depsgraph, ob);
+      return;
+    }
+  }
+
   /* includes all keys and modifiers */
   switch (ob->type) {
     case OB_MESH: {
-      CustomData_MeshMasks cddata_masks = scene->customdata_mask;
-      CustomData_MeshMasks_update(&cddata_masks, &CD_MASK_BAREMESH);
-      /* Custom attributes should not be removed automatically. They might be used by the render
-       * engine or scripts. They can still be removed explicitly using geometry nodes.
-       * Vertex groups can be used in arbitrary situations with geometry nodes as well. */
-      cddata_masks.vmask |= CD_MASK_PROP_ALL | CD_MASK_MDEFORMVERT;
-      cddata_masks.emask |= CD_MASK_PROP_ALL;
-      cddata_masks.fmask |= CD_MASK_PROP_ALL;
-      cddata_masks.pmask |= CD_MASK_PROP_ALL;
-      cddata_masks.lmask |= CD_MASK_PROP_ALL;
-
-      /* Make sure Freestyle edge/face marks appear in evaluated mesh (see #40315).
-       * Due to Line Art implementation, edge marks should also be shown in viewport. */
-#ifdef WITH_FREESTYLE
-      cddata_masks.emask |= CD_MASK_FREESTYLE_EDGE;
-      cddata_masks.pmask |= CD_MASK_FREESTYLE_FACE;
-#endif
-      if (DEG_get_mode(depsgraph) == DAG_EVAL_RENDER) {
-        /* Always compute orcos for render. */
-        cddata_masks.vmask |= CD_MASK_ORCO;
-      }
       blender::bke::mesh_data_update(*depsgraph, *scene, *ob, cddata_masks);
       break;
     }
@@ -220,10 +244,11 @@ void BKE_object_handle_data_update(Depsgraph *depsgraph, Scene *scene, Object *o
     }
   }
 
-  if (DEG_is_active(depsgraph)) {
-    Object *object_orig = DEG_get_original_object(ob);
-    object_orig->runtime->bounds_eval = BKE_object_evaluated_geometry_bounds(ob);
+  if (playback_cache) {
+    playback_cache->store(*depsgraph, *ob, cddata_masks);
   }
+
+  object_sync_evaluated_bounds(depsgraph, ob);
 }
 
 void BKE_object_sync_to_original(Depsgraph *depsgraph, Object *object)
@@ -32,6 +32,7 @@
 #include "DNA_particle_types.h"
 #include "DNA_scene_types.h"
 
+#include "BLI_array.hh"
 #include "BLI_kdopbvh.hh"
 #include "BLI_kdtree.h"
 #include "BLI_linklist.h"
@@ -43,8 +44,10 @@
 #include "BLI_rand.h"
 #include "BLI_string.h"
 #include "BLI_task.h"
+#include "BLI_task.hh"
 #include "BLI_threads.h"
 #include "BLI_utildefines.h"
+#include "BLI_vector.hh"
 
 #include "BLT_translation.hh"
 
@@ -56,7 +59,7 @@
 #include "BKE_customdata.hh"
 #include "BKE_deform.hh"
 #include "BKE_displist.h"
-#include "BKE_effect.h"
+#include "BKE_effect.hh"
 #include "BKE_idtype.hh"
 #include "BKE_key.hh"
 #include "BKE_lattice.hh"
@@ -2496,6 +2499,35 @@ bool do_guides(Depsgraph *depsgraph,
   return false;
 }
 
+/** Move the path key along the effector force, see #do_path_effectors. */
+static void apply_path_effector_force(ParticleSimulationData *sim,
+                                      ParticleCacheKey *ca,
+                                      int k,
+                                      int steps,
+                                      float effector,
+                                      float force[3],
+                                      float *length,
+                                      float *vec)
+{
+  mul_v3_fl(force,
+            effector * powf(float(k) / float(steps), 100.0f * sim->psys->part->eff_hair) /
+                float(steps));
+
+  add_v3_v3(force, vec);
+
+  normalize_v3(force);
+
+  if (k < steps) {
+    sub_v3_v3v3(vec, (ca + 1)->co, ca->co);
+  }
+
+  madd_v3_v3v3fl(ca->co, (ca - 1)->co, force, *length);
+
+  if (k < steps) {
+    *length = len_v3(vec);
+  }
+}
+
 static void do_path_effectors(ParticleSimulationData *sim,
                               int i,
                               ParticleCacheKey *ca,
@@ -2530,24 +2562,110 @@ static void do_path_effectors(ParticleSimulationData *sim,
                       nullptr,
                       nullptr);
 
-  mul_v3_fl(force,
-            effector * powf(float(k) / float(steps), 100.0f * sim->psys->part->eff_hair) /
-                float(steps));
-
-  add_v3_v3(force, vec);
+  apply_path_effector_force(sim, ca, k, steps, effector, force, length, vec);
+}
 
-  normalize_v3(force);
+/**
+ * Apply the effectors to the paths of all particles, like #do_path_effectors. Every key depends
+ * on the previous one, so the effectors are evaluated for the same key of all paths at once.
+ */
+static void cache_paths_apply_effectors(ParticleSimulationData *sim,
+                                        ParticleCacheKey **cache,
+                                        const int segments,
+                                        float *vg_effector,
+                                        const float dfra,
+                                        const float cfra)
+{
+  using namespace blender;
+  PARTICLE_PSMD;
+  ParticleSystem *psys = sim->psys;
+  PARTICLE_P;
 
-  if (k < steps) {
-    sub_v3_v3v3(vec, (ca + 1)->co, ca->co);
+  /* Don't apply effectors for dynamic hair, otherwise the effectors don't get applied twice. */
+  if (psys->flag & PSYS_HAIR_DYNAMICS) {
+    return;
   }
 
-  madd_v3_v3v3fl(ca->co, (ca - 1)->co, force, *length);
+  Vector<int> indices;
+  Vector<float> effector_factors;
+  Vector<float> lengths;
+  Vector<float3> vecs;
+  LOOP_PARTICLES
+  {
+    if (cache[p]->segments < 0) {
+      continue;
+    }
+    float effector = 1.0f;
+    if (vg_effector) {
+      effector *= psys_particle_value_from_verts(
+          psmd->mesh_final, psys->part->from, pa, vg_effector);
+    }
+    float3 vec;
+    sub_v3_v3v3(vec, (cache[p] + 1)->co, cache[p]->co);
+    indices.append(p);
+    effector_factors.append(effector);
+    lengths.append(len_v3(vec));
+    vecs.append(vec);
+  }
+
+  if (BKE_effectors_use_random_noise(psys->effectors)) {
+    /* Keep the order in which random numbers are used. */
+    for (const int i : indices.index_range()) {
+      const int p = indices[i];
+      ParticleCacheKey *ca = cache[p] + 1;
+      for (int k = 1; k <= segments; k++, ca++) {
+        do_path_effectors(sim,
+                          p,
+                          ca,
+                          k,
+                          segments,
+                          cache[p]->co,
+                          effector_factors[i],
+                          dfra,
+                          cfra,
+                          &lengths[i],
+                          vecs[i]);
+      }
+    }
+    return;
+  }
 
-  if (k < steps) {
-    *length = len_v3(vec);
+  Array<ParticleKey> keys(indices.size());
+  Array<EffectedPoint> points(indices.size());
+  Array<float3> forces(indices.size());
+  for (const int k : IndexRange(1, segments)) {
+    threading::parallel_for(indices.index_range(), 1024, [&](const IndexRange range) {
+      for (const int i : range) {
+        const ParticleCacheKey *ca = cache[indices[i]] + k;
+        copy_v3_v3(keys[i].co, (ca - 1)->co);
+        copy_v3_v3(keys[i].vel, (ca - 1)->vel);
+        copy_qt_qt(keys[i].rot, (ca - 1)->rot);
+        pd_point_from_particle(sim, psys->particles + indices[i], &keys[i], &points[i]);
+      }
+    });
+    forces.fill(float3(0.0f));
+    BKE_effectors_apply_points(psys->effectors,
+                               sim->colliders,
+                               psys->part->effector_weights,
+                               points,
+                               forces,
+                               {},
+                               {});
+    threading::parallel_for(indices.index_range(), 1024, [&](const IndexRange range) {
+      for (const int i : range) {
+        apply_path_effector_force(sim,
+                                  cache[indices[i]] + k,
+                                  k,
+                                  segments,
+                                  effector_factors[i],
+                                  forces[i],
+                                  &lengths[i],
+                                  vecs[i]);
+      }
+    });
   }
 }
+
 static void offset_child(ChildParticle *cpa,
                          ParticleKey *par,
                          float *par_rot,
@@ -3279,7 +3397,6 @@ void psys_cache_paths(ParticleSimulationData *sim, float cfra, const bool use_re
   int k;
   int segments = int(pow(2.0, double((use_render_params) ? part->ren_step : part->draw_step)));
   int totpart = psys->totpart;
-  float length, vec[3];
   float *vg_effector = nullptr;
   float *vg_length = nullptr, pa_length = 1.0f;
   int keyed, baked;
@@ -3324,6 +3441,9 @@ void psys_cache_paths(ParticleSimulationData *sim, float cfra, const bool use_re
     BKE_mesh_tessface_ensure(psmd->mesh_final);
   }
 
+  /* Rotations of the first keys, set after the rotations of the other keys are computed. */
+  blender::Array<blender::float4> root_rotations(totpart);
+
   /*---first main loop: create all actual particles' paths---*/
   LOOP_PARTICLES
   {
@@ -3399,26 +3519,30 @@ void psys_cache_paths(ParticleSimulationData *sim, float cfra, const bool use_re
       }
     }
 
-    /*--modify paths and calculate rotation & velocity--*/
+    /* First rotation is based on emitting face orientation.
+     * This is way better than having flipping rotations resulting
+     * from using a global axis as a rotation pole (vec_to_quat()).
+     * It's not an ideal solution though since it disregards the
+     * initial tangent, but taking that in to account will allow
+     * the possibility of flipping again. -jahka
+     */
+    mat3_to_quat_legacy(root_rotations[p], rotmat);
+  }
 
-    if (!(psys->flag & PSYS_GLOBAL_HAIR)) {
-      /* apply effectors */
-      if ((psys->part->flag & PART_CHILD_EFFECT) == 0) {
-        float effector = 1.0f;
-        if (vg_effector) {
-          effector *= psys_particle_value_from_verts(
-              psmd->mesh_final, psys->part->from, pa, vg_effector);
-        }
+  /*--modify paths and calculate rotation & velocity--*/
 
-        sub_v3_v3v3(vec, (cache[p] + 1)->co, cache[p]->co);
-        length = len_v3(vec);
+  /* apply effectors */
+  if (!(psys->flag & PSYS_GLOBAL_HAIR) && (psys->part->flag & PART_CHILD_EFFECT) == 0) {
+    cache_paths_apply_effectors(sim, cache, segments, vg_effector, dfra, cfra);
+  }
 
-        for (k = 1, ca = cache[p] + 1; k <= segments; k++, ca++) {
-          do_path_effectors(
-              sim, p, ca, k, segments, cache[p]->co, effector, dfra, cfra, &length, vec);
-        }
-      }
+  LOOP_PARTICLES
+  {
+    if (cache[p]->segments < 0) {
+      continue;
+    }
 
+    if (!(psys->flag & PSYS_GLOBAL_HAIR)) {
       /* apply guide curves to path data */
       if (sim->psys->effectors && (psys->part->flag & PART_CHILD_EFFECT) == 0) {
         for (k = 0, ca = cache[p]; k <= segments; k++, ca++) {
@@ -3459,14 +3583,7 @@ void psys_cache_paths(ParticleSimulationData *sim, float cfra, const bool use_re
 
       ca->time = float(k) / float(segments);
     }
-    /* First rotation is based on emitting face orientation.
-     * This is way better than having flipping rotations resulting
-     * from using a global axis as a rotation pole (vec_to_quat()).
-     * It's not an ideal solution though since it disregards the
-     * initial tangent, but taking that in to account will allow
-     * the possibility of flipping again. -jahka
-     */
-    mat3_to_quat_legacy(cache[p]->rot, rotmat);
+    copy_qt_qt(cache[p]->rot, root_rotations[p]);
   }
 
   psys->totcached = totpart;
@@ -27,6 +27,7 @@
 #include "DNA_scene_types.h"
 #include "DNA_texture_types.h"
 
+#include "BLI_array.hh"
 #include "BLI_kdopbvh.hh"
 #include "BLI_kdtree.h"
 #include "BLI_linklist.h"
@@ -40,13 +41,14 @@
 #include "BLI_task.h"
 #include "BLI_threads.h"
 #include "BLI_utildefines.h"
+#include "BLI_vector.hh"
 
 #include "BKE_animsys.h"
 #include "BKE_boids.h"
 #include "BKE_collision.h"
 #include "BKE_colortools.hh"
 #include "BKE_customdata.hh"
-#include "BKE_effect.h"
+#include "BKE_effect.hh"
 #include "BKE_lib_id.hh"
 #include "BKE_lib_query.hh"
 #include "BKE_mesh_legacy_convert.hh"
@@ -2227,10 +2229,78 @@ static void sph_integrate(ParticleSimulationData *sim,
 /*          Basic physics                       */
 /************************************************/
 
+/**
+ * Effector results for the first force evaluation of every dynamic particle in
+ * #integrate_particle, computed for all particles at once before they are integrated.
+ */
+struct ParticleEffectorsPrecalc {
+  /** The initial state of the particle, including the angular velocity changed by effectors. */
+  blender::Array<ParticleKey> states;
+  blender::Array<blender::float3> forces;
+  blender::Array<blender::float3> impulses;
+};
+
+static bool precalc_particle_effectors(ParticleSimulationData *sim,
+                                       ParticleEffectorsPrecalc &r_precalc)
+{
+  using namespace blender;
+  ParticleSystem *psys = sim->psys;
+  ParticleSettings *part = psys->part;
+  PARTICLE_P;
+
+  if (psys->effectors == nullptr) {
+    return false;
+  }
+  if (part->type == PART_HAIR && !(part->effector_weights->flag & EFF_WEIGHT_DO_HAIR)) {
+    return false;
+  }
+  LISTBASE_FOREACH (EffectorCache *, eff, psys->effectors) {
+    if (eff->psys == psys) {
+      /* The particles see the updated state of the particles that are integrated before them. */
+      return false;
+    }
+  }
+  if (ELEM(part->integrator, PART_INT_MIDPOINT, PART_INT_RK4) &&
+      BKE_effectors_use_random_noise(psys->effectors))
+  {
+    /* The later integration steps would use the random numbers in a different order. */
+    return false;
+  }
+
+  r_precalc.states.reinitialize(psys->totpart);
+  Vector<int> indices;
+  Vector<EffectedPoint> points;
+  LOOP_DYNAMIC_PARTICLES
+  {
+    ParticleKey &state = r_precalc.states[p];
+    copy_particle_key(&state, &pa->state, 1);
+    /* The angular velocity is reset in #basic_integrate. */
+    copy_v3_v3(state.ave, pa->prev_state.ave);
+    points.append({});
+    pd_point_from_particle(sim, pa, &state, &points.last());
+    indices.append(p);
+  }
+
+  Array<float3> forces(points.size(), float3(0.0f));
+  Array<float3> impulses(points.size(), float3(0.0f));
+  BKE_effectors_apply_points(
+      psys->effectors, sim->colliders, part->effector_weights, points, forces, {}, impulses);
+
+  r_precalc.forces.reinitialize(psys->totpart);
+  r_precalc.impulses.reinitialize(psys->totpart);
+  for (const int i : indices.index_range()) {
+    r_precalc.forces[indices[i]] = forces[i];
+    r_precalc.impulses[indices[i]] = impulses[i];
+  }
+  return true;
+}
+
 struct EfData {
   ParticleTexture ptex;
   ParticleSimulationData *sim;
   ParticleData *pa;
+  /** Effector results for the first force evaluation, optional. */
+  const ParticleEffectorsPrecalc *effectors_precalc;
 };
 static void basic_force_cb(void *efdata_v, ParticleKey *state, float *force, float *impulse)
 {
@@ -2243,7 +2313,16 @@ static void basic_force_cb(void *efdata_v, ParticleKey *state, float *force, flo
 
   /* add effectors */
   pd_point_from_particle(efdata->sim, efdata->pa, state, &epoint);
-  if (part->type != PART_HAIR || part->effector_weights->flag & EFF_WEIGHT_DO_HAIR) {
+  if (efdata->effectors_precalc) {
+    /* Only valid for the initial state, evaluate the other integration steps directly. */
+    const ParticleEffectorsPrecalc &precalc = *efdata->effectors_precalc;
+    const int p = pa - sim->psys->particles;
+    add_v3_v3(force, precalc.forces[p]);
+    add_v3_v3(impulse, precalc.impulses[p]);
+    copy_v3_v3(state->ave, precalc.states[p].ave);
+    efdata->effectors_precalc = nullptr;
+  }
+  else if (part->type != PART_HAIR || part->effector_weights->flag & EFF_WEIGHT_DO_HAIR) {
     BKE_effectors_apply(sim->psys->effectors,
                         sim->colliders,
                         part->effector_weights,
@@ -2273,7 +2352,11 @@ static void basic_force_cb(void *efdata_v, ParticleKey *state, float *force, flo
   }
 }
 /* gathers all forces that effect particles and calculates a new state for the particle */
-static void basic_integrate(ParticleSimulationData *sim, int p, float dfra, float cfra)
+static void basic_integrate(ParticleSimulationData *sim,
+                            int p,
+                            float dfra,
+                            float cfra,
+                            const ParticleEffectorsPrecalc *effectors_precalc = nullptr)
 {
   ParticleSettings *part = sim->psys->part;
   ParticleData *pa = sim->psys->particles + p;
@@ -2286,6 +2369,7 @@ static void basic_integrate(ParticleSimulationData *sim, int p, float dfra, floa
 
   efdata.pa = pa;
   efdata.sim = sim;
+  efdata.effectors_precalc = effectors_precalc;
 
   /* add global acceleration (gravitation) */
   if (psys_uses_gravity(sim) &&
@@ -3962,10 +4046,15 @@ static void dynamics_step(ParticleSimulationData *sim, float cfra)
 
   switch (part->phystype) {
     case PART_PHYS_NEWTON: {
+      /* Evaluate the effectors for all particles at once. */
+      ParticleEffectorsPrecalc effectors_precalc;
+      const bool use_effectors_precalc = precalc_particle_effectors(sim, effectors_precalc);
+
       LOOP_DYNAMIC_PARTICLES
       {
         /* do global forces & effectors */
-        basic_integrate(sim, p, pa->state.time, cfra);
+        basic_integrate(
+            sim, p, pa->state.time, cfra, use_effectors_precalc ? &effectors_precalc : nullptr);
 
         /* deflection */
         if (sim->colliders) {
@@ -0,0 +1,329 @@
+/* SPDX-FileCopyrightText: 2025 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup bke
+ */
+
+#include <algorithm>
+
+#include "BLI_hash.hh"
+#include "BLI_listbase.h"
+#include "BLI_vector.hh"
+
+#include "DNA_ID.h"
+#include "DNA_mesh_types.h"
+#include "DNA_modifier_types.h"
+#include "DNA_object_types.h"
+#include "DNA_userdef_types.h"
+
+#include "BKE_curves.h"
+#include "BKE_curves.hh"
+#include "BKE_customdata.hh"
+#include "BKE_mesh.h"
+#include "BKE_modifier.hh"
+#include "BKE_object.hh"
+#include "BKE_object_types.hh"
+#include "BKE_playback_geometry_cache.hh"
+#include "BKE_pointcloud.hh"
+#include "BKE_shrinkwrap.hh"
+
+#include "DEG_depsgraph.hh"
+#include "DEG_depsgraph_query.hh"
+
+namespace blender::bke {
+
+uint64_t PlaybackGeometryCache::Key::hash() const
+{
+  return get_default_hash(this->session_uid, this->frame);
+}
+
+/* -------------------------------------------------------------------- */
+/** \name Cache Conditions
+ * \{ */
+
+static bool object_uses_simulation(const Object &object)
+{
+  if (object.particlesystem.first || object.rigidbody_object || object.soft) {
+    return true;
+  }
+  LISTBASE_FOREACH (const ModifierData *, md, &object.modifiers) {
+    const ModifierTypeInfo *mti = BKE_modifier_get_info(ModifierType(md->type));
+    if (mti->flags & eModifierTypeFlag_UsesPointCache) {
+      return true;
+    }
+    if (md->type == eModifierType_Nodes) {
+      /* Simulation zones and bake nodes depend on the state of previous frames. */
+      if (reinterpret_cast<const NodesModifierData *>(md)->bakes_num > 0) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+bool PlaybackGeometryCache::is_supported(const Depsgraph &depsgraph, const Object &object)
+{
+  if (!USER_EXPERIMENTAL_TEST(&U, use_playback_geometry_cache)) {
+    return false;
+  }
+  if (DEG_get_mode(&depsgraph) != DAG_EVAL_VIEWPORT || !DEG_is_active(&depsgraph)) {
+    return false;
+  }
+  if (!ELEM(object.type, OB_MESH, OB_CURVES, OB_POINTCLOUD)) {
+    return false;
+  }
+  if (object.mode != OB_MODE_OBJECT) {
+    return false;
+  }
+  return !object_uses_simulation(object);
+}
+
+bool PlaybackGeometryCache::is_invalidated_by_recalc(const unsigned int flags)
+{
+  if (flags == 0) {
+    /* Tagging without flags means that everything has to be evaluated again. */
+    return true;
+  }
+  const unsigned int non_geometry_flags = ID_RECALC_SHADING | ID_RECALC_SELECT |
+                                          ID_RECALC_BASE_FLAGS | ID_RECALC_EDITORS |
+                                          ID_RECALC_FRAME_CHANGE | ID_RECALC_AUDIO_FPS |
+                                          ID_RECALC_AUDIO_VOLUME | ID_RECALC_AUDIO_MUTE |
+                                          ID_RECALC_AUDIO_LISTENER | ID_RECALC_AUDIO |
+                                          ID_RECALC_SEQUENCER_STRIPS | ID_RECALC_NTREE_OUTPUT |
+                                          ID_RECALC_TAG_FOR_UNDO | ID_RECALC_POINT_CACHE;
+  return (flags & ~non_geometry_flags) != 0;
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Restore and Store
+ * \{ */
+
+bool PlaybackGeometryCache::restore(const Depsgraph &depsgraph,
+                                    Object &object,
+                                    const CustomData_MeshMasks &mesh_masks)
+{
+  if (is_empty_.load(std::memory_order_relaxed)) {
+    return false;
+  }
+  const Key key{object.id.session_uid, DEG_get_ctime(&depsgraph)};
+  GeometrySet geometry;
+  GeometrySet deform_geometry;
+  CustomData_MeshMasks last_mesh_masks;
+  bool need_mapping;
+  {
+    std::lock_guard lock{mutex_};
+    const std::unique_ptr<Entry> *entry = entries_.lookup_ptr(key);
+    if (entry == nullptr) {
+      return false;
+    }
+    if (object.type == OB_MESH &&
+        !CustomData_MeshMasks_are_matching(&(*entry)->requested_mesh_masks, &mesh_masks))
+    {
+      return false;
+    }
+    (*entry)->last_used = ++usage_clock_;
+    geometry = (*entry)->geometry;
+    deform_geometry = (*entry)->deform_geometry;
+    last_mesh_masks = (*entry)->mesh_masks;
+    need_mapping = (*entry)->need_mapping;
+  }
+
+  /* Free any evaluated data and restore original data. The evaluated data is always owned by the
+   * object, so that the cache can't be modified through it. */
+  BKE_object_free_derived_caches(&object);
+
+  switch (object.type) {
+    case OB_MESH: {
+      const Mesh *mesh = static_cast<const Mesh *>(object.data);
+      Mesh *mesh_eval = BKE_mesh_copy_for_eval(*geometry.get_mesh());
+      BKE_object_eval_assign_data(&object, &mesh_eval->id, true);
+      geometry.remove<MeshComponent>();
+      geometry.get_component_for_write<MeshComponent>().replace(mesh_eval,
+                                                                GeometryOwnershipType::Editable);
+      object.runtime->geometry_set_eval = new GeometrySet(std::move(geometry));
+      if (const Mesh *mesh_deform = deform_geometry.get_mesh()) {
+        object.runtime->mesh_deform_eval = BKE_mesh_copy_for_eval(*mesh_deform);
+      }
+      object.runtime->last_data_mask = last_mesh_masks;
+      object.runtime->last_need_mapping = need_mapping;
+      mesh_eval->key = mesh->key;
+      if (DEG_get_eval_flags_for_id(&depsgraph, &object.id) & DAG_EVAL_NEED_SHRINKWRAP_BOUNDARY) {
+        shrinkwrap::boundary_cache_ensure(*mesh_eval);
+      }
+      break;
+    }
+    case OB_CURVES: {
+      Curves *curves_eval;
+      if (const Curves *curves = geometry.get_curves()) {
+        curves_eval = BKE_curves_copy_for_eval(curves);
+        geometry.remove<CurveComponent>();
+        geometry.get_component_for_write<CurveComponent>().replace(
+            curves_eval, GeometryOwnershipType::Editable);
+      }
+      else {
+        curves_eval = curves_new_nomain(0, 0);
+      }
+      BKE_object_eval_assign_data(&object, &curves_eval->id, true);
+      object.runtime->geometry_set_eval = new GeometrySet(std::move(geometry));
+      break;
+    }
+    case OB_POINTCLOUD: {
+      PointCloud *pointcloud_eval;
+      if (const PointCloud *pointcloud = geometry.get_pointcloud()) {
+        pointcloud_eval = BKE_pointcloud_copy_for_eval(pointcloud);
+        geometry.remove<PointCloudComponent>();
+        geometry.get_component_for_write<PointCloudComponent>().replace(
+            pointcloud_eval, GeometryOwnershipType::ReadOnly);
+      }
+      else {
+        pointcloud_eval = BKE_pointcloud_new_nomain(0);
+      }
+      BKE_object_eval_assign_data(&object, &pointcloud_eval->id, true);
+      object.runtime->geometry_set_eval = new GeometrySet(std::move(geometry));
+      break;
+    }
+    default:
+      BLI_assert_unreachable();
+      break;
+  }
+  return true;
+}
+
+/**
+ * Replace the component of the object's own data type with an owned copy. The evaluated geometry
+ * of the object may reference its data without owning it, which is freed with the object.
+ */
+static void replace_with_owned_copy(GeometrySet &geometry, const Object &object)
+{
+  switch (object.type) {
+    case OB_MESH:
+      if (const Mesh *mesh = geometry.get_mesh()) {
+        Mesh *mesh_copy = BKE_mesh_copy_for_eval(*mesh);
+        geometry.remove<MeshComponent>();
+        geometry.replace_mesh(mesh_copy);
+      }
+      break;
+    case OB_CURVES:
+      if (const Curves *curves = geometry.get_curves()) {
+        Curves *curves_copy = BKE_curves_copy_for_eval(curves);
+        geometry.remove<CurveComponent>();
+        geometry.replace_curves(curves_copy);
+      }
+      break;
+    case OB_POINTCLOUD:
+      if (const PointCloud *pointcloud = geometry.get_pointcloud()) {
+        PointCloud *pointcloud_copy = BKE_pointcloud_copy_for_eval(pointcloud);
+        geometry.remove<PointCloudComponent>();
+        geometry.replace_pointcloud(pointcloud_copy);
+      }
+      break;
+  }
+}
+
+static int64_t count_entry_memory(memory_counter::MemoryCount &memory,
+                                  const PlaybackGeometryCache::Entry &entry)
+{
+  const int64_t old_bytes = memory.total_bytes;
+  memory_counter::MemoryCounter counter{memory};
+  entry.geometry.count_memory(counter);
+  entry.deform_geometry.count_memory(counter);
+  return memory.total_bytes - old_bytes;
+}
+
+void PlaybackGeometryCache::store(const Depsgraph &depsgraph,
+                                  const Object &object,
+                                  const CustomData_MeshMasks &mesh_masks)
+{
+  const GeometrySet *geometry_eval = object.runtime->geometry_set_eval;
+  if (geometry_eval == nullptr) {
+    return;
+  }
+  auto entry = std::make_unique<Entry>();
+  entry->geometry = *geometry_eval;
+  replace_with_owned_copy(entry->geometry, object);
+  if (object.type == OB_MESH) {
+    if (const Mesh *mesh_deform = object.runtime->mesh_deform_eval) {
+      entry->deform_geometry = GeometrySet::from_mesh(BKE_mesh_copy_for_eval(*mesh_deform));
+    }
+    entry->requested_mesh_masks = mesh_masks;
+    entry->mesh_masks = object.runtime->last_data_mask;
+    entry->need_mapping = object.runtime->last_need_mapping;
+  }
+
+  const Key key{object.id.session_uid, DEG_get_ctime(&depsgraph)};
+  const int64_t max_bytes = int64_t(U.memcachelimit) * 1024 * 1024;
+
+  std::lock_guard lock{mutex_};
+  entry->last_used = ++usage_clock_;
+  entry->memory_bytes = count_entry_memory(memory_, *entry);
+  if (const std::optional<std::unique_ptr<Entry>> old_entry = entries_.pop_try(key)) {
+    memory_.total_bytes -= (*old_entry)->memory_bytes;
+  }
+  entries_.add_new(key, std::move(entry));
+  is_empty_.store(false, std::memory_order_relaxed);
+  this->remove_least_recently_used(max_bytes);
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Memory Management
+ * \{ */
+
+void PlaybackGeometryCache::remove_least_recently_used(const int64_t max_bytes)
+{
+  if (memory_.total_bytes <= max_bytes) {
+    return;
+  }
+  Vector<std::pair<uint64_t, Key>> usage;
+  usage.reserve(entries_.size());
+  for (const auto item : entries_.items()) {
+    usage.append({item.value->last_used, item.key});
+  }
+  std::sort(usage.begin(), usage.end(), [](const auto &a, const auto &b) {
+    return a.first < b.first;
+  });
+
+  int64_t bytes = memory_.total_bytes;
+  for (const auto &[last_used, key] : usage) {
+    if (bytes <= max_bytes) {
+      break;
+    }
+    bytes -= entries_.pop(key)->memory_bytes;
+  }
+
+  /* Data that was shared with removed entries may only have been counted for them, so the
+   * remaining entries are counted again. */
+  memory_.reset();
+  for (const auto &[last_used, key] : usage) {
+    if (std::unique_ptr<Entry> *entry = entries_.lookup_ptr(key)) {
+      (*entry)->memory_bytes = count_entry_memory(memory_, **entry);
+    }
+  }
+  is_empty_.store(entries_.is_empty(), std::memory_order_relaxed);
+}
+
+void PlaybackGeometryCache::clear()
+{
+  if (is_empty_.load(std::memory_order_relaxed)) {
+    return;
+  }
+  std::lock_guard lock{mutex_};
+  entries_.clear();
+  memory_.reset();
+  is_empty_.store(true, std::memory_order_relaxed);
+}
+
+int64_t PlaybackGeometryCache::memory_bytes()
+{
+  std::lock_guard lock{mutex_};
+  return memory_.total_bytes;
+}
+
+/** \} */
+
+}  // namespace blender::bke
@@ -35,7 +35,7 @@
 #include "DNA_scene_types.h"
 
 #include "BKE_collection.hh"
-#include "BKE_effect.h"
+#include "BKE_effect.hh"
 #include "BKE_global.hh"
 #include "BKE_layer.hh"
 #include "BKE_lib_id.hh"
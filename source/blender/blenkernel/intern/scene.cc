@@ -62,7 +62,7 @@
 #include "BKE_curveprofile.h"
 #include "BKE_duplilist.hh"
 #include "BKE_editmesh.hh"
-#include "BKE_effect.h"
+#include "BKE_effect.hh"
 #include "BKE_fcurve.hh"
 #include "BKE_idprop.hh"
 #include "BKE_idtype.hh"
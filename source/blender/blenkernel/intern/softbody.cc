@@ -42,6 +42,7 @@
 #include "DNA_object_types.h"
 #include "DNA_scene_types.h"
 
+#include "BLI_array.hh"
 #include "BLI_ghash.h"
 #include "BLI_listbase.h"
 #include "BLI_math_geom.h"
@@ -50,12 +51,13 @@
 #include "BLI_threads.h"
 #include "BLI_time.h"
 #include "BLI_utildefines.h"
+#include "BLI_vector.hh"
 
 #include "BKE_collision.h"
 #include "BKE_curve.hh"
 #include "BKE_customdata.hh"
 #include "BKE_deform.hh"
-#include "BKE_effect.h"
+#include "BKE_effect.hh"
 #include "BKE_global.hh"
 #include "BKE_layer.hh"
 #include "BKE_mesh.hh"
@@ -118,7 +120,9 @@ struct SB_thread_context {
   float timenow;
   int ifirst;
   int ilast;
-  ListBase *effectors;
+  /** Effector results per body point or spring, null when there are no effectors. */
+  const blender::float3 *effector_forces;
+  const blender::float3 *effector_speeds;
   int do_deflector;
   float fieldfactor;
   float windfactor;
@@ -1427,8 +1431,84 @@ static int sb_detect_edge_collisionCached(const float edge_v1[3],
   return deflected;
 }
 
-static void _scan_for_ext_spring_forces(
-    Scene *scene, Object *ob, float timenow, int ifirst, int ilast, ListBase *effectors)
+/**
+ * Evaluate the effectors for the centers of all edge springs at once. Only the wind speed is used
+ * by #_scan_for_ext_spring_forces.
+ */
+static void sb_effectors_apply_springs(Scene *scene,
+                                       Object *ob,
+                                       ListBase *effectors,
+                                       blender::Array<blender::float3> &r_speeds)
+{
+  using namespace blender;
+  SoftBody *sb = ob->soft;
+  r_speeds.reinitialize(sb->totspring);
+  r_speeds.fill(float3(0.0f));
+
+  Vector<int> springs;
+  for (const int a : IndexRange(sb->totspring)) {
+    if (sb->bspring[a].springtype == SB_EDGE) {
+      springs.append(a);
+    }
+  }
+  Array<float3> positions(springs.size());
+  Array<float3> velocities(springs.size());
+  Array<EffectedPoint> points(springs.size());
+  for (const int i : springs.index_range()) {
+    const BodySpring &bs = sb->bspring[springs[i]];
+    mid_v3_v3v3(positions[i], sb->bpoint[bs.v1].pos, sb->bpoint[bs.v2].pos);
+    mid_v3_v3v3(velocities[i], sb->bpoint[bs.v1].vec, sb->bpoint[bs.v2].vec);
+    pd_point_from_soft(scene, positions[i], velocities[i], -1, &points[i]);
+  }
+  Array<float3> forces(springs.size(), float3(0.0f));
+  Array<float3> speeds(springs.size(), float3(0.0f));
+  BKE_effectors_apply_points(effectors, nullptr, sb->effector_weights, points, forces, {}, speeds);
+  for (const int i : springs.index_range()) {
+    r_speeds[springs[i]] = speeds[i];
+  }
+}
+
+/**
+ * Evaluate the effectors for all body points whose forces are computed by
+ * #_softbody_calc_forces_slice_in_a_thread, which skips points that snap to their goal.
+ */
+static void sb_effectors_apply_points(Scene *scene,
+                                      Object *ob,
+                                      ListBase *effectors,
+                                      blender::Array<blender::float3> &r_forces,
+                                      blender::Array<blender::float3> &r_speeds)
+{
+  using namespace blender;
+  SoftBody *sb = ob->soft;
+  r_forces.reinitialize(sb->totpoint);
+  r_forces.fill(float3(0.0f));
+  r_speeds.reinitialize(sb->totpoint);
+  r_speeds.fill(float3(0.0f));
+
+  Vector<int> indices;
+  Vector<EffectedPoint> points;
+  for (const int a : IndexRange(sb->totpoint)) {
+    BodyPoint *bp = &sb->bpoint[a];
+    if (_final_goal(ob, bp) < SOFTGOALSNAP) {
+      points.append({});
+      pd_point_from_soft(scene, bp->pos, bp->vec, sb->bpoint - bp, &points.last());
+      indices.append(a);
+    }
+  }
+  Array<float3> forces(points.size(), float3(0.0f));
+  Array<float3> speeds(points.size(), float3(0.0f));
+  BKE_effectors_apply_points(effectors, nullptr, sb->effector_weights, points, forces, {}, speeds);
+  for (const int i : indices.index_range()) {
+    r_forces[indices[i]] = forces[i];
+    r_speeds[indices[i]] = speeds[i];
+  }
+}
+
+static void _scan_for_ext_spring_forces(Object *ob,
+                                        float timenow,
+                                        int ifirst,
+                                        int ilast,
+                                        const blender::float3 *effector_speeds)
 {
   SoftBody *sb = ob->soft;
   int a;
@@ -1462,15 +1542,10 @@ static void _scan_for_ext_spring_forces(
           float vel[3], sp[3], pr[3], force[3];
           float f, windfactor = 0.25f;
           /* See if we have wind. */
-          if (effectors) {
-            EffectedPoint epoint;
-            float speed[3] = {0.0f, 0.0f, 0.0f};
-            float pos[3];
-            mid_v3_v3v3(pos, sb->bpoint[bs->v1].pos, sb->bpoint[bs->v2].pos);
+          if (effector_speeds) {
+            float speed[3];
             mid_v3_v3v3(vel, sb->bpoint[bs->v1].vec, sb->bpoint[bs->v2].vec);
-            pd_point_from_soft(scene, pos, vel, -1, &epoint);
-            BKE_effectors_apply(
-                effectors, nullptr, sb->effector_weights, &epoint, force, nullptr, speed);
+            copy_v3_v3(speed, effector_speeds[a]);
 
             mul_v3_fl(speed, windfactor);
             add_v3_v3(vel, speed);
@@ -1506,7 +1581,7 @@ static void *exec_scan_for_ext_spring_forces(void *data)
 {
   SB_thread_context *pctx = (SB_thread_context *)data;
   _scan_for_ext_spring_forces(
-      pctx->scene, pctx->ob, pctx->timenow, pctx->ifirst, pctx->ilast, pctx->effectors);
+      pctx->ob, pctx->timenow, pctx->ifirst, pctx->ilast, pctx->effector_speeds);
   return nullptr;
 }
 
@@ -1528,6 +1603,10 @@ static void sb_sfesf_threads_run(Depsgraph *depsgraph,
 
   ListBase *effectors = BKE_effectors_create(
       depsgraph, ob, nullptr, ob->soft->effector_weights, false);
+  blender::Array<blender::float3> effector_speeds;
+  if (effectors && ob->soft->aeroedge) {
+    sb_effectors_apply_springs(scene, ob, effectors, effector_speeds);
+  }
 
   /* figure the number of threads while preventing pretty pointless threading overhead */
   totthread = BKE_scene_num_threads(scene);
@@ -1553,7 +1632,8 @@ static void sb_sfesf_threads_run(Depsgraph *depsgraph,
     else {
       sb_threads[i].ifirst = 0;
     }
-    sb_threads[i].effectors = effectors;
+    sb_threads[i].effector_forces = nullptr; /* not used here */
+    sb_threads[i].effector_speeds = effectors ? effector_speeds.data() : nullptr;
     sb_threads[i].do_deflector = false; /* not used here */
     sb_threads[i].fieldfactor = 0.0f;   /* not used here */
     sb_threads[i].windfactor = 0.0f;    /* not used here */
@@ -1954,7 +2034,8 @@ static int _softbody_calc_forces_slice_in_a_thread(Scene *scene,
                                                    int ifirst,
                                                    int ilast,
                                                    int *ptr_to_break_func(void),
-                                                   ListBase *effectors,
+                                                   const blender::float3 *effector_forces,
+                                                   const blender::float3 *effector_speeds,
                                                    int do_deflector,
                                                    float fieldfactor,
                                                    float windfactor)
@@ -2089,18 +2170,17 @@ static int _softbody_calc_forces_slice_in_a_thread(Scene *scene,
       }
 
       /* particle field & vortex */
-      if (effectors) {
-        EffectedPoint epoint;
+      if (effector_forces) {
         float kd;
-        float force[3] = {0.0f, 0.0f, 0.0f};
-        float speed[3] = {0.0f, 0.0f, 0.0f};
+        float force[3];
+        float speed[3];
 
         /* just for calling function once */
         float eval_sb_fric_force_scale = sb_fric_force_scale(ob);
 
-        pd_point_from_soft(scene, bp->pos, bp->vec, sb->bpoint - bp, &epoint);
-        BKE_effectors_apply(
-            effectors, nullptr, sb->effector_weights, &epoint, force, nullptr, speed);
+        /* Evaluated for all points at once, see #sb_effectors_apply_points. */
+        copy_v3_v3(force, effector_forces[bp - sb->bpoint]);
+        copy_v3_v3(speed, effector_speeds[bp - sb->bpoint]);
 
         /* Apply force-field. */
         mul_v3_fl(force, fieldfactor * eval_sb_fric_force_scale);
@@ -2181,7 +2261,8 @@ static void *exec_softbody_calc_forces(void *data)
                                           pctx->ifirst,
                                           pctx->ilast,
                                           nullptr,
-                                          pctx->effectors,
+                                          pctx->effector_forces,
+                                          pctx->effector_speeds,
                                           pctx->do_deflector,
                                           pctx->fieldfactor,
                                           pctx->windfactor);
@@ -2194,7 +2275,8 @@ static void sb_cf_threads_run(Scene *scene,
                               float timenow,
                               int totpoint,
                               int *ptr_to_break_func(void),
-                              ListBase *effectors,
+                              const blender::float3 *effector_forces,
+                              const blender::float3 *effector_speeds,
                               int do_deflector,
                               float fieldfactor,
                               float windfactor)
@@ -2234,7 +2316,8 @@ static void sb_cf_threads_run(Scene *scene,
     else {
       sb_threads[i].ifirst = 0;
     }
-    sb_threads[i].effectors = effectors;
+    sb_threads[i].effector_forces = effector_forces;
+    sb_threads[i].effector_speeds = effector_speeds;
     sb_threads[i].do_deflector = do_deflector;
     sb_threads[i].fieldfactor = fieldfactor;
     sb_threads[i].windfactor = windfactor;
@@ -2292,6 +2375,11 @@ static void softbody_calc_forces(
 
   /* After spring scan because it uses effectors too. */
   ListBase *effectors = BKE_effectors_create(depsgraph, ob, nullptr, sb->effector_weights, false);
+  blender::Array<blender::float3> effector_forces;
+  blender::Array<blender::float3> effector_speeds;
+  if (effectors) {
+    sb_effectors_apply_points(scene, ob, effectors, effector_forces, effector_speeds);
+  }
 
   if (do_deflector) {
     float defforce[3];
@@ -2304,7 +2392,8 @@ static void softbody_calc_forces(
                     timenow,
                     sb->totpoint,
                     nullptr,
-                    effectors,
+                    effectors ? effector_forces.data() : nullptr,
+                    effectors ? effector_speeds.data() : nullptr,
                     do_deflector,
                     fieldfactor,
                     windfactor);
@@ -16,6 +16,7 @@
 #include "MEM_guardedalloc.h"
 
 #include "subdiv_converter.hh"
+#include "subdiv_topology_refiner_cache.hh"
 
 #include "opensubdiv_capi.hh"
 #include "opensubdiv_converter_capi.hh"
@@ -37,6 +38,7 @@ void init()
 
 void exit()
 {
+  topology_refiner_cache_clear();
   openSubdiv_cleanup();
 }
 
@@ -101,13 +103,10 @@ Subdiv *new_from_converter(const Settings *settings, OpenSubdiv_Converter *conve
   SubdivStats stats;
   stats_init(&stats);
   stats_begin(&stats, SUBDIV_STATS_TOPOLOGY_REFINER_CREATION_TIME);
-  OpenSubdiv_TopologyRefinerSettings topology_refiner_settings;
-  topology_refiner_settings.level = settings->level;
-  topology_refiner_settings.is_adaptive = settings->is_adaptive;
   blender::opensubdiv::TopologyRefinerImpl *osd_topology_refiner = nullptr;
   if (converter->getNumVertices(converter) != 0) {
-    osd_topology_refiner = blender::opensubdiv::TopologyRefinerImpl::createFromConverter(
-        converter, topology_refiner_settings);
+    /* Refiners are shared between subdivision surfaces with the same topology and settings. */
+    osd_topology_refiner = topology_refiner_acquire(settings, converter);
   }
   else {
     /* TODO(sergey): Check whether original geometry had any vertices.
@@ -199,7 +198,7 @@ void free(Subdiv *subdiv)
     }
     delete subdiv->evaluator;
   }
-  delete subdiv->topology_refiner;
+  topology_refiner_release(subdiv->topology_refiner);
   displacement_detach(subdiv);
   if (subdiv->cache_.face_ptex_offset != nullptr) {
     MEM_freeN(subdiv->cache_.face_ptex_offset);
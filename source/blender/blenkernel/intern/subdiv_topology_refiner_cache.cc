@@ -0,0 +1,346 @@
+/* SPDX-FileCopyrightText: 2025 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup bke
+ */
+
+#include "BKE_subdiv.hh"
+
+#include "subdiv_topology_refiner_cache.hh"
+
+#ifdef WITH_OPENSUBDIV
+
+#  include <algorithm>
+#  include <memory>
+#  include <mutex>
+
+#  include "MEM_guardedalloc.h"
+
+#  include "BLI_hash.hh"
+#  include "BLI_map.hh"
+#  include "BLI_vector.hh"
+
+#  include "opensubdiv_converter_capi.hh"
+#  include "opensubdiv_topology_refiner.hh"
+
+namespace blender::bke::subdiv {
+
+struct CachedTopologyRefiner {
+  opensubdiv::TopologyRefinerImpl *topology_refiner;
+  Settings settings;
+  uint64_t topology_hash;
+  int64_t memory_bytes;
+  /** Number of #Subdiv which use the refiner, or are comparing their topology against it. */
+  int users;
+  uint64_t last_used;
+
+  ~CachedTopologyRefiner()
+  {
+    delete topology_refiner;
+  }
+};
+
+struct TopologyRefinerCache {
+  /** Refiners grouped by the hash of their topology and settings. */
+  Map<uint64_t, Vector<std::unique_ptr<CachedTopologyRefiner>>> entries;
+  Map<const opensubdiv::TopologyRefinerImpl *, CachedTopologyRefiner *> entry_by_refiner;
+  int64_t unused_bytes = 0;
+  uint64_t usage_clock = 0;
+};
+
+static std::mutex cache_mutex;
+/** Memory which is allowed to be used by refiners which are not used by any #Subdiv. */
+static int64_t unused_refiners_max_bytes = 256 * 1024 * 1024;
+/** Created on first use, freed by #topology_refiner_cache_clear. */
+static TopologyRefinerCache *cache = nullptr;
+
+/* -------------------------------------------------------------------- */
+/** \name Topology Hash
+ *
+ * Covers the same data as #opensubdiv::TopologyRefinerImpl::isEqualToConverter, except for the
+ * indices of UV coordinates: those are expensive to compute and rarely differ between meshes with
+ * otherwise equal topology. Equal hashes are always verified with a full comparison.
+ * \{ */
+
+static uint64_t topology_hash_from_converter(const Settings &settings,
+                                             const OpenSubdiv_Converter *converter)
+{
+  const int num_vertices = converter->getNumVertices(converter);
+  const int num_edges = converter->getNumEdges ? converter->getNumEdges(converter) : 0;
+  const int num_uv_layers = converter->getNumUVLayers(converter);
+  const OffsetIndices<int> faces = converter->faces;
+
+  uint64_t hash = get_default_hash(settings.is_simple,
+                                   settings.is_adaptive,
+                                   settings.level,
+                                   int(settings.vtx_boundary_interpolation));
+  hash = get_default_hash(hash, int(settings.fvar_linear_interpolation), num_uv_layers);
+  hash = get_default_hash(hash, num_vertices, num_edges, faces.size());
+
+  Vector<int, 16> face_vertices;
+  for (const int face : faces.index_range()) {
+    face_vertices.resize(faces[face].size());
+    converter->getFaceVertices(converter, face, face_vertices.data());
+    hash = get_default_hash(hash, face_vertices.size());
+    for (const int vertex : face_vertices) {
+      hash = get_default_hash(hash, vertex);
+    }
+  }
+
+  for (int vertex = 0; vertex < num_vertices; vertex++) {
+    if (converter->isInfiniteSharpVertex != nullptr &&
+        converter->isInfiniteSharpVertex(converter, vertex))
+    {
+      hash = get_default_hash(hash, vertex, true);
+    }
+    else if (converter->getVertexSharpness != nullptr) {
+      const float sharpness = converter->getVertexSharpness(converter, vertex);
+      if (sharpness != 0.0f) {
+        hash = get_default_hash(hash, vertex, sharpness);
+      }
+    }
+  }
+
+  if (converter->getEdgeSharpness != nullptr) {
+    for (int edge = 0; edge < num_edges; edge++) {
+      const float sharpness = converter->getEdgeSharpness(converter, edge);
+      if (sharpness == 0.0f) {
+        continue;
+      }
+      int edge_vertices[2];
+      converter->getEdgeVertices(converter, edge, edge_vertices);
+      hash = get_default_hash(hash, sharpness, edge_vertices[0], edge_vertices[1]);
+    }
+  }
+
+  return hash;
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Memory Management
+ * \{ */
+
+static void remove_least_recently_used(TopologyRefinerCache &cache, const int64_t max_bytes)
+{
+  if (cache.unused_bytes <= max_bytes) {
+    return;
+  }
+  Vector<const CachedTopologyRefiner *> unused;
+  for (const Vector<std::unique_ptr<CachedTopologyRefiner>> &group : cache.entries.values()) {
+    for (const std::unique_ptr<CachedTopologyRefiner> &entry : group) {
+      if (entry->users == 0) {
+        unused.append(entry.get());
+      }
+    }
+  }
+  std::sort(unused.begin(), unused.end(), [](const auto *a, const auto *b) {
+    return a->last_used < b->last_used;
+  });
+
+  for (const CachedTopologyRefiner *entry : unused) {
+    if (cache.unused_bytes <= max_bytes) {
+      break;
+    }
+    cache.unused_bytes -= entry->memory_bytes;
+    cache.entry_by_refiner.remove(entry->topology_refiner);
+    const uint64_t topology_hash = entry->topology_hash;
+    Vector<std::unique_ptr<CachedTopologyRefiner>> &group = cache.entries.lookup(topology_hash);
+    for (const int64_t i : group.index_range()) {
+      if (group[i].get() == entry) {
+        group.remove_and_reorder(i);
+        break;
+      }
+    }
+    if (group.is_empty()) {
+      cache.entries.remove(topology_hash);
+    }
+  }
+}
+
+/** Decrement the users of the entry, the cache mutex is to be locked. */
+static void remove_user(TopologyRefinerCache &cache, CachedTopologyRefiner &entry)
+{
+  BLI_assert(entry.users > 0);
+  entry.users--;
+  if (entry.users == 0) {
+    entry.last_used = ++cache.usage_clock;
+    cache.unused_bytes += entry.memory_bytes;
+    remove_least_recently_used(cache, unused_refiners_max_bytes);
+  }
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Public API
+ * \{ */
+
+opensubdiv::TopologyRefinerImpl *topology_refiner_acquire(const Settings *settings,
+                                                          OpenSubdiv_Converter *converter)
+{
+  const uint64_t topology_hash = topology_hash_from_converter(*settings, converter);
+
+  /* Add a user to all candidates, so that they stay alive while their topology is compared with
+   * the converter outside of the lock. */
+  Vector<CachedTopologyRefiner *> candidates;
+  {
+    std::lock_guard lock{cache_mutex};
+    if (cache != nullptr) {
+      if (const auto *group = cache->entries.lookup_ptr(topology_hash)) {
+        for (const std::unique_ptr<CachedTopologyRefiner> &entry : *group) {
+          if (!settings_equal(&entry->settings, settings)) {
+            continue;
+          }
+          if (entry->users == 0) {
+            cache->unused_bytes -= entry->memory_bytes;
+          }
+          entry->users++;
+          candidates.append(entry.get());
+        }
+      }
+    }
+  }
+
+  CachedTopologyRefiner *found = nullptr;
+  for (CachedTopologyRefiner *entry : candidates) {
+    if (entry->topology_refiner->isEqualToConverter(converter)) {
+      found = entry;
+      break;
+    }
+  }
+  if (!candidates.is_empty()) {
+    std::lock_guard lock{cache_mutex};
+    for (CachedTopologyRefiner *entry : candidates) {
+      if (entry != found) {
+        remove_user(*cache, *entry);
+      }
+    }
+  }
+  if (found != nullptr) {
+    return found->topology_refiner;
+  }
+
+  OpenSubdiv_TopologyRefinerSettings topology_refiner_settings;
+  topology_refiner_settings.level = settings->level;
+  topology_refiner_settings.is_adaptive = settings->is_adaptive;
+  opensubdiv::TopologyRefinerImpl *topology_refiner =
+      opensubdiv::TopologyRefinerImpl::createFromConverter(converter, topology_refiner_settings);
+  if (topology_refiner == nullptr) {
+    return nullptr;
+  }
+  /* Create the tables for evaluation before the refiner is shared, as that refines the topology
+   * in-place. */
+  if (!topology_refiner->ensureEvaluatorTables()) {
+    return topology_refiner;
+  }
+
+  auto entry = std::make_unique<CachedTopologyRefiner>();
+  entry->topology_refiner = topology_refiner;
+  entry->settings = *settings;
+  entry->topology_hash = topology_hash;
+  entry->memory_bytes = topology_refiner->estimateMemoryBytes();
+  entry->users = 1;
+  entry->last_used = 0;
+
+  std::lock_guard lock{cache_mutex};
+  if (cache == nullptr) {
+    cache = MEM_new<TopologyRefinerCache>(__func__);
+  }
+  cache->entry_by_refiner.add_new(topology_refiner, entry.get());
+  cache->entries.lookup_or_add_default(topology_hash).append(std::move(entry));
+  return topology_refiner;
+}
+
+void topology_refiner_release(opensubdiv::TopologyRefinerImpl *topology_refiner)
+{
+  if (topology_refiner == nullptr) {
+    return;
+  }
+  {
+    std::lock_guard lock{cache_mutex};
+    if (cache != nullptr) {
+      if (CachedTopologyRefiner *entry = cache->entry_by_refiner.lookup_default(topology_refiner,
+                                                                                nullptr))
+      {
+        remove_user(*cache, *entry);
+        return;
+      }
+    }
+  }
+  /* The refiner was not added to the cache. */
+  delete topology_refiner;
+}
+
+void topology_refiner_cache_set_limit(const int64_t max_bytes)
+{
+  std::lock_guard lock{cache_mutex};
+  unused_refiners_max_bytes = max_bytes;
+  if (cache != nullptr) {
+    remove_least_recently_used(*cache, max_bytes);
+  }
+}
+
+void topology_refiner_cache_clear()
+{
+  std::lock_guard lock{cache_mutex};
+  if (cache == nullptr) {
+    return;
+  }
+  remove_least_recently_used(*cache, 0);
+  if (cache->entries.is_empty()) {
+    MEM_delete(cache);
+    cache = nullptr;
+  }
+}
+
+TopologyRefinerCacheStats topology_refiner_cache_stats()
+{
+  std::lock_guard lock{cache_mutex};
+  TopologyRefinerCacheStats stats;
+  if (cache == nullptr) {
+    return stats;
+  }
+  for (const Vector<std::unique_ptr<CachedTopologyRefiner>> &group : cache->entries.values()) {
+    for (const std::unique_ptr<CachedTopologyRefiner> &entry : group) {
+      stats.refiners_num++;
+      if (entry->users == 0) {
+        stats.unused_refiners_num++;
+      }
+    }
+  }
+  stats.unused_bytes = cache->unused_bytes;
+  return stats;
+}
+
+/** \} */
+
+}  // namespace blender::bke::subdiv
+
+#else
+
+namespace blender::bke::subdiv {
+
+opensubdiv::TopologyRefinerImpl *topology_refiner_acquire(const Settings * /*settings*/,
+                                                          OpenSubdiv_Converter * /*converter*/)
+{
+  return nullptr;
+}
+
+void topology_refiner_release(opensubdiv::TopologyRefinerImpl * /*topology_refiner*/) {}
+
+void topology_refiner_cache_set_limit(const int64_t /*max_bytes*/) {}
+
+void topology_refiner_cache_clear() {}
+
+TopologyRefinerCacheStats topology_refiner_cache_stats()
+{
+  return {};
+}
+
+}  // namespace blender::bke::subdiv
+
+#endif
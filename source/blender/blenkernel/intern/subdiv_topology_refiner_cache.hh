@@ -0,0 +1,60 @@
+/* SPDX-FileCopyrightText: 2025 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+/** \file
+ * \ingroup bke
+ *
+ * Topology refiners are expensive to create: the topology is refined and the stencil and patch
+ * tables for the limit surface evaluation are computed from scratch. Objects which use the same
+ * base mesh with the same subdivision settings (instanced or linked duplicates, for example) can
+ * share a single refiner, which is what this cache is for.
+ *
+ * Shared refiners are never modified after they have been added to the cache: the evaluator tables
+ * are created before a refiner is handed out.
+ */
+
+#include <cstdint>
+
+struct OpenSubdiv_Converter;
+namespace blender::opensubdiv {
+class TopologyRefinerImpl;
+}
+
+namespace blender::bke::subdiv {
+
+struct Settings;
+
+/**
+ * Get a topology refiner for the topology of the converter, creating it when there is none in the
+ * cache yet. Returns nullptr when the topology can not be handled by OpenSubdiv.
+ *
+ * The refiner is to be released with #topology_refiner_release.
+ */
+opensubdiv::TopologyRefinerImpl *topology_refiner_acquire(const Settings *settings,
+                                                          OpenSubdiv_Converter *converter);
+
+/**
+ * Release a refiner which was acquired with #topology_refiner_acquire. Refiners which are no
+ * longer used are kept in the cache for a while, so that they can be reused when an equal
+ * topology is subdivided again. Passing nullptr is allowed.
+ */
+void topology_refiner_release(opensubdiv::TopologyRefinerImpl *topology_refiner);
+
+/** Free all refiners which are not used anymore. */
+void topology_refiner_cache_clear();
+
+struct TopologyRefinerCacheStats {
+  /** Refiners in the cache, including the ones which are in use. */
+  int refiners_num = 0;
+  /** Refiners which are not used by any #Subdiv. */
+  int unused_refiners_num = 0;
+  int64_t unused_bytes = 0;
+};
+
+/** The current state of the cache, for tests. */
+TopologyRefinerCacheStats topology_refiner_cache_stats();
+
+}  // namespace blender::bke::subdiv
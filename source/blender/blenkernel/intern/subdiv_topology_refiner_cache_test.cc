@@ -0,0 +1,201 @@
+/* SPDX-FileCopyrightText: 2025 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include "testing/testing.h"
+
+#include "BLI_math_vector.hh"
+#include "BLI_offset_indices.hh"
+
+#include "BKE_idtype.hh"
+#include "BKE_lib_id.hh"
+#include "BKE_mesh.hh"
+#include "BKE_subdiv.hh"
+#include "BKE_subdiv_eval.hh"
+
+#include "DNA_mesh_types.h"
+
+#include "subdiv_topology_refiner_cache.hh"
+
+#ifdef WITH_OPENSUBDIV
+
+namespace blender::bke::subdiv::tests {
+
+class TopologyRefinerCacheTest : public testing::Test {
+ public:
+  static void SetUpTestSuite()
+  {
+    BKE_idtype_init();
+    subdiv::init();
+  }
+
+  static void TearDownTestSuite()
+  {
+    subdiv::exit();
+  }
+
+  void SetUp() override
+  {
+    topology_refiner_cache_set_limit(256 * 1024 * 1024);
+  }
+
+  void TearDown() override
+  {
+    topology_refiner_cache_clear();
+  }
+};
+
+/** A grid of `size * size` quads. */
+static Mesh *create_grid(const int size, const float3 &offset)
+{
+  const int verts_per_side = size + 1;
+  const int faces_num = size * size;
+  Mesh *mesh = BKE_mesh_new_nomain(verts_per_side * verts_per_side, 0, faces_num, faces_num * 4);
+  MutableSpan<float3> positions = mesh->vert_positions_for_write();
+  for (const int y : IndexRange(verts_per_side)) {
+    for (const int x : IndexRange(verts_per_side)) {
+      positions[y * verts_per_side + x] = float3(x, y, (x * y) % 3) + offset;
+    }
+  }
+  offset_indices::fill_constant_group_size(4, 0, mesh->face_offsets_for_write());
+  MutableSpan<int> corner_verts = mesh->corner_verts_for_write();
+  for (const int y : IndexRange(size)) {
+    for (const int x : IndexRange(size)) {
+      const int face = y * size + x;
+      const int v = y * verts_per_side + x;
+      corner_verts[face * 4 + 0] = v;
+      corner_verts[face * 4 + 1] = v + 1;
+      corner_verts[face * 4 + 2] = v + verts_per_side + 1;
+      corner_verts[face * 4 + 3] = v + verts_per_side;
+    }
+  }
+  mesh_calc_edges(*mesh, false, false);
+  return mesh;
+}
+
+static Settings create_settings(const int level)
+{
+  Settings settings{};
+  settings.is_simple = false;
+  settings.is_adaptive = true;
+  settings.level = level;
+  settings.use_creases = false;
+  settings.vtx_boundary_interpolation = SUBDIV_VTX_BOUNDARY_EDGE_ONLY;
+  settings.fvar_linear_interpolation = SUBDIV_FVAR_LINEAR_INTERPOLATION_ALL;
+  return settings;
+}
+
+TEST_F(TopologyRefinerCacheTest, HitForEqualTopology)
+{
+  Mesh *mesh_a = create_grid(4, float3(0.0f));
+  /* Only the positions differ, which are not part of the topology. */
+  Mesh *mesh_b = create_grid(4, float3(10.0f, 0.0f, 0.0f));
+  const Settings settings = create_settings(2);
+
+  Subdiv *subdiv_a = new_from_mesh(&settings, mesh_a);
+  Subdiv *subdiv_b = new_from_mesh(&settings, mesh_b);
+  ASSERT_NE(subdiv_a->topology_refiner, nullptr);
+  EXPECT_EQ(subdiv_a->topology_refiner, subdiv_b->topology_refiner);
+  EXPECT_EQ(topology_refiner_cache_stats().refiners_num, 1);
+
+  /* Evaluators of a shared refiner still evaluate their own mesh. */
+  ASSERT_TRUE(eval_begin_from_mesh(subdiv_a, mesh_a, {}, SUBDIV_EVALUATOR_TYPE_CPU, nullptr));
+  ASSERT_TRUE(eval_begin_from_mesh(subdiv_b, mesh_b, {}, SUBDIV_EVALUATOR_TYPE_CPU, nullptr));
+  for (const int ptex_face : IndexRange(16)) {
+    float3 position_a;
+    float3 position_b;
+    eval_limit_point(subdiv_a, ptex_face, 0.25f, 0.75f, position_a);
+    eval_limit_point(subdiv_b, ptex_face, 0.25f, 0.75f, position_b);
+    const float3 offset = position_b - position_a;
+    EXPECT_V3_NEAR(offset, float3(10.0f, 0.0f, 0.0f), 1e-5f);
+  }
+
+  free(subdiv_a);
+  /* The refiner is still used by the other subdivision surface. */
+  EXPECT_EQ(topology_refiner_cache_stats().unused_refiners_num, 0);
+  free(subdiv_b);
+  EXPECT_EQ(topology_refiner_cache_stats().unused_refiners_num, 1);
+
+  BKE_id_free(nullptr, mesh_a);
+  BKE_id_free(nullptr, mesh_b);
+}
+
+TEST_F(TopologyRefinerCacheTest, MissForDifferentTopologyOrSettings)
+{
+  Mesh *mesh_a = create_grid(4, float3(0.0f));
+  Mesh *mesh_b = create_grid(5, float3(0.0f));
+  const Settings settings_low = create_settings(2);
+  const Settings settings_high = create_settings(3);
+
+  Subdiv *subdiv_a = new_from_mesh(&settings_low, mesh_a);
+  Subdiv *subdiv_b = new_from_mesh(&settings_low, mesh_b);
+  Subdiv *subdiv_c = new_from_mesh(&settings_high, mesh_a);
+  EXPECT_NE(subdiv_a->topology_refiner, subdiv_b->topology_refiner);
+  EXPECT_NE(subdiv_a->topology_refiner, subdiv_c->topology_refiner);
+  EXPECT_EQ(topology_refiner_cache_stats().refiners_num, 3);
+
+  free(subdiv_a);
+  free(subdiv_b);
+  free(subdiv_c);
+  BKE_id_free(nullptr, mesh_a);
+  BKE_id_free(nullptr, mesh_b);
+}
+
+TEST_F(TopologyRefinerCacheTest, UnusedRefinersAreReused)
+{
+  Mesh *mesh = create_grid(4, float3(0.0f));
+  const Settings settings = create_settings(2);
+
+  free(new_from_mesh(&settings, mesh));
+  const TopologyRefinerCacheStats stats = topology_refiner_cache_stats();
+  EXPECT_EQ(stats.refiners_num, 1);
+  EXPECT_EQ(stats.unused_refiners_num, 1);
+  EXPECT_GT(stats.unused_bytes, 0);
+
+  Subdiv *subdiv = new_from_mesh(&settings, mesh);
+  EXPECT_EQ(topology_refiner_cache_stats().refiners_num, 1);
+  EXPECT_EQ(topology_refiner_cache_stats().unused_refiners_num, 0);
+  EXPECT_EQ(topology_refiner_cache_stats().unused_bytes, 0);
+
+  free(subdiv);
+  BKE_id_free(nullptr, mesh);
+}
+
+TEST_F(TopologyRefinerCacheTest, EvictLeastRecentlyUsed)
+{
+  Mesh *mesh_a = create_grid(4, float3(0.0f));
+  Mesh *mesh_b = create_grid(5, float3(0.0f));
+  const Settings settings = create_settings(2);
+
+  Subdiv *subdiv_a = new_from_mesh(&settings, mesh_a);
+  Subdiv *subdiv_b = new_from_mesh(&settings, mesh_b);
+  free(subdiv_a);
+  const int64_t bytes_a = topology_refiner_cache_stats().unused_bytes;
+  free(subdiv_b);
+  const int64_t bytes_b = topology_refiner_cache_stats().unused_bytes - bytes_a;
+  EXPECT_EQ(topology_refiner_cache_stats().unused_refiners_num, 2);
+
+  /* Only the refiner that was used last fits into the limit. */
+  topology_refiner_cache_set_limit(bytes_b);
+  EXPECT_EQ(topology_refiner_cache_stats().refiners_num, 1);
+  EXPECT_EQ(topology_refiner_cache_stats().unused_bytes, bytes_b);
+
+  subdiv_b = new_from_mesh(&settings, mesh_b);
+  EXPECT_EQ(topology_refiner_cache_stats().refiners_num, 1);
+  subdiv_a = new_from_mesh(&settings, mesh_a);
+  EXPECT_EQ(topology_refiner_cache_stats().refiners_num, 2);
+
+  /* Refiners which are in use are never freed. */
+  topology_refiner_cache_set_limit(0);
+  EXPECT_EQ(topology_refiner_cache_stats().refiners_num, 2);
+  free(subdiv_a);
+  free(subdiv_b);
+  EXPECT_EQ(topology_refiner_cache_stats().refiners_num, 0);
+
+  BKE_id_free(nullptr, mesh_a);
+  BKE_id_free(nullptr, mesh_b);
+}
+
+}  // namespace blender::bke::subdiv::tests
+
+#endif
@@ -0,0 +1,109 @@
+/* SPDX-FileCopyrightText: 2025 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+/** \file
+ * \ingroup bli
+ *
+ * A boolean solver for triangle meshes whose operands are closed, manifold and free of
+ * self-intersections, which is the common case for hard-surface modeling.
+ *
+ * Unlike the solver in `BLI_mesh_boolean.hh`, it does not build a full mesh arrangement with
+ * exact rational coordinates. All geometric decisions are made with exact orientation predicates
+ * on the double precision input coordinates. Degenerate configurations (e.g. coplanar faces or a
+ * vertex lying on a face of another operand) are resolved with symbolic perturbation: every
+ * operand is translated by a different infinitesimal amount along a fixed direction, so that the
+ * operands are always in general position. Intersection points are never used for decisions,
+ * they are only represented implicitly by the edge and triangle that define them.
+ *
+ * Intersecting triangle pairs are found with a BVH and tested in parallel, then every
+ * intersected triangle is re-triangulated independently. Where intersections with two other
+ * operands cross inside of a triangle, a vertex is created that is shared by all three operands.
+ * Which parts of the operands are kept is decided per connected patch of triangles, so only very
+ * few inside/outside tests are needed.
+ *
+ * When the input does not satisfy the requirements or a configuration can't be resolved
+ * consistently, the solver reports failure instead of producing a broken mesh, so that the caller
+ * can fall back to a more general solver.
+ *
+ * Breaking ties exactly requires `WITH_GMP`. Without it, the perturbation terms are evaluated
+ * with doubles and only trusted when they are larger than their rounding error, so degenerate
+ * input that can't be decided reliably makes the solver report failure.
+ */
+
+#include "BLI_array.hh"
+#include "BLI_math_vector_types.hh"
+#include "BLI_span.hh"
+#include "BLI_vector.hh"
+
+namespace blender::meshintersect::manifold {
+
+/** Aligned with #BoolOpType. */
+enum class Operation : int8_t {
+  Intersect = 0,
+  Union = 1,
+  Difference = 2,
+};
+
+struct TriMesh {
+  /** Positions of the vertices of all operands. Operands must not share vertices. */
+  Span<double3> positions;
+  /** Vertex indices of every triangle, counter-clockwise when seen from the outside. */
+  Span<int3> tris;
+  /** The operand every triangle belongs to, in the range `[0, shapes_num)`. */
+  Span<int> tri_shapes;
+  int shapes_num = 0;
+};
+
+enum class TriResult : int8_t {
+  /** The triangle is not part of the result. */
+  Removed = 0,
+  /** The triangle is part of the result unchanged. */
+  Kept = 1,
+  /** The triangle is part of the result with flipped orientation. */
+  KeptFlipped = 2,
+  /** The triangle was intersected. The kept parts are in #BooleanResult::split_tris. */
+  Split = 3,
+};
+
+struct BooleanResult {
+  /**
+   * False when the input is not supported by this solver. All other members are empty then.
+   */
+  bool success = false;
+  /** What happened to every input triangle. */
+  Array<TriResult> tri_results;
+  /**
+   * Positions of the vertices created at intersections. Their indices follow the input vertices,
+   * i.e. the first new vertex has the index `positions.size()`.
+   */
+  Vector<double3> new_positions;
+  /**
+   * Three input vertices and weights for every new vertex, used to interpolate attributes.
+   * Vertices where an edge crosses a triangle are interpolated from the two vertices of the edge.
+   * Vertices where three operands meet are interpolated from a triangle that contains them.
+   */
+  Vector<int3> new_vert_interp_verts;
+  Vector<float3> new_vert_interp_weights;
+  /** The indices of all input triangles with #TriResult::Split, sorted. */
+  Vector<int> split_tri_indices;
+  /**
+   * Offsets into #split_tris for every triangle in #split_tri_indices. The triangles are oriented
+   * correctly for the result already.
+   */
+  Vector<int> split_tri_offsets;
+  Vector<int3> split_tris;
+  /** Vertex pairs of the edges along the intersections between operands. */
+  Vector<int2> intersection_edges;
+};
+
+/**
+ * Compute the boolean operation on the operands in \a mesh.
+ * For #Operation::Difference, the first operand is the minuend and all others are subtracted
+ * from it. For the other operations, all operands are treated the same.
+ */
+BooleanResult boolean_trimesh(const TriMesh &mesh, Operation operation);
+
+}  // namespace blender::meshintersect::manifold
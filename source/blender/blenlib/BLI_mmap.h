@@ -32,6 +32,11 @@ BLI_mmap_file *BLI_mmap_open(int fd) ATTR_MALLOC ATTR_WARN_UNUSED_RESULT;
 bool BLI_mmap_read(BLI_mmap_file *file, void *dest, size_t offset, size_t length)
     ATTR_WARN_UNUSED_RESULT ATTR_NONNULL(1);
 
+/* Hints the operating system that the given range of the file will be read soon, so that it can
+ * be read from disk in the background. Does not block, and does nothing if the range is outside
+ * of the file or the platform does not support it. */
+void BLI_mmap_prefetch(BLI_mmap_file *file, size_t offset, size_t length) ATTR_NONNULL(1);
+
 void *BLI_mmap_get_pointer(BLI_mmap_file *file) ATTR_WARN_UNUSED_RESULT;
 size_t BLI_mmap_get_length(const BLI_mmap_file *file) ATTR_WARN_UNUSED_RESULT;
 
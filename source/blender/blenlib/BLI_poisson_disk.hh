@@ -0,0 +1,43 @@
+/* SPDX-FileCopyrightText: 2025 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+/** \file
+ * \ingroup bli
+ *
+ * Utilities for Poisson disk sampling by elimination: a dense set of candidate points is thinned
+ * out so that no two remaining points are closer than a minimum distance.
+ */
+
+#include "BLI_math_vector_types.hh"
+#include "BLI_span.hh"
+
+namespace blender::poisson_disk {
+
+/**
+ * Eliminate points that are closer than \a minimum_distance to a point that is kept, giving
+ * priority to points with a lower index. The result is the same as when iterating over all points
+ * in order and eliminating all points within the distance of every point that was not eliminated
+ * yet. Points that are eliminated in \a elimination_mask already are ignored.
+ *
+ * Points are found with a spatial hash grid, and many points are decided in parallel. The result
+ * is deterministic and does not depend on the number of threads.
+ */
+void eliminate_close_points(Span<float3> positions,
+                            float minimum_distance,
+                            MutableSpan<bool> elimination_mask);
+
+/**
+ * Same as above, and additionally find the point every point was eliminated by: the kept point
+ * with the lowest index within the distance. Points which are kept or were eliminated already get
+ * -1. This gives the same result as #BLI_kdtree_3d_calc_duplicates_fast with index order, which
+ * makes it usable to find points to merge.
+ */
+void eliminate_close_points(Span<float3> positions,
+                            float minimum_distance,
+                            MutableSpan<bool> elimination_mask,
+                            MutableSpan<int> r_eliminated_by);
+
+}  // namespace blender::poisson_disk
@@ -36,6 +36,7 @@
 #include "BLI_index_range.hh"
 #include "BLI_lazy_threading.hh"
 #include "BLI_task_size_hints.hh"
+#include "BLI_task_trace.hh"
 
 namespace blender {
 
@@ -68,7 +69,8 @@ namespace detail {
 void parallel_for_impl(IndexRange range,
                        int64_t grain_size,
                        FunctionRef<void(IndexRange)> function,
-                       const TaskSizeHints &size_hints);
+                       const TaskSizeHints &size_hints,
+                       const trace::SourceLocation &location);
 void memory_bandwidth_bound_task_impl(FunctionRef<void()> function);
 }  // namespace detail
 
@@ -88,12 +90,16 @@ void memory_bandwidth_bound_task_impl(FunctionRef<void()> function);
  *   can use `threading::individual_task_sizes(...)` or `threading::accumulated_task_sizes(...)`.
  *   If the grain size is e.g. 200 and each task has the size 100, then only two tasks will be
  *   scheduled at once.
+ * \param location: Identifies the caller when the task scheduler is traced, see
+ *   #BLI_task_trace.hh. Should not be passed explicitly.
  */
 template<typename Function>
-inline void parallel_for(const IndexRange range,
-                         const int64_t grain_size,
-                         const Function &function,
-                         const TaskSizeHints &size_hints = detail::TaskSizeHints_Static(1))
+inline void parallel_for(
+    const IndexRange range,
+    const int64_t grain_size,
+    const Function &function,
+    const TaskSizeHints &size_hints = detail::TaskSizeHints_Static(1),
+    const trace::SourceLocation &location = trace::SourceLocation::current())
 {
   if (range.is_empty()) {
     return;
@@ -103,7 +109,7 @@ inline void parallel_for(const IndexRange range,
     function(range);
     return;
   }
-  detail::parallel_for_impl(range, grain_size, function, size_hints);
+  detail::parallel_for_impl(range, grain_size, function, size_hints, location);
 }
 
 /**
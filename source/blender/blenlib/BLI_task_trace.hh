@@ -0,0 +1,144 @@
+/* SPDX-FileCopyrightText: 2025 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+/** \file
+ * \ingroup bli
+ *
+ * Opt-in tracing of the task scheduler. When enabled, every parallel loop, every task it is split
+ * into and every task of task pools and task graphs records an event with its time range in a
+ * buffer of the thread that runs it. The events can be written as Chrome trace JSON, which can be
+ * opened with `chrome://tracing` or https://ui.perfetto.dev to find idle threads, tasks that are
+ * too small and parallel regions that don't scale.
+ *
+ * Every thread has its own ring buffer which only that thread writes to, so recording doesn't lock.
+ * When a buffer is full, the oldest events of that thread are overwritten. When tracing is
+ * disabled, the overhead is reading a global flag.
+ *
+ * Tracing is enabled with the `--debug-task-trace` command line argument.
+ */
+
+#include <atomic>
+#include <cstdint>
+
+#include "BLI_string_ref.hh"
+#include "BLI_utility_mixins.hh"
+
+namespace blender::threading::trace {
+
+/**
+ * The location in the source code that started a parallel region. It is captured automatically
+ * with a default argument when the compiler supports it.
+ */
+struct SourceLocation {
+  const char *function = nullptr;
+  const char *file = nullptr;
+  int line = 0;
+
+#if defined(__GNUC__) || defined(__clang__) || (defined(_MSC_VER) && _MSC_VER >= 1926)
+  static constexpr SourceLocation current(const char *function = __builtin_FUNCTION(),
+                                          const char *file = __builtin_FILE(),
+                                          const int line = __builtin_LINE())
+  {
+    return {function, file, line};
+  }
+#else
+  static constexpr SourceLocation current()
+  {
+    return {};
+  }
+#endif
+};
+
+enum class EventType : uint8_t {
+  /** A call to #threading::parallel_for on the thread that started it. */
+  ParallelFor,
+  /** A sub-range of a #threading::parallel_for. */
+  ParallelForTask,
+  /** A sub-range of #BLI_task_parallel_range. */
+  ParallelRangeTask,
+  /** A task pushed to a #TaskPool. */
+  TaskPoolTask,
+  /** Waiting for the tasks of a #TaskPool, other tasks may be executed in the meantime. */
+  TaskPoolWait,
+  /** A node of a #TaskGraph. */
+  TaskGraphNode,
+};
+
+namespace detail {
+extern std::atomic<bool> is_enabled;
+}
+
+inline bool is_enabled()
+{
+  return detail::is_enabled.load(std::memory_order_relaxed);
+}
+
+/**
+ * Start recording events, previously recorded events are removed.
+ * \param events_per_thread: The capacity of the ring buffer of every thread.
+ */
+void enable(int64_t events_per_thread = 1 << 16);
+/** Stop recording events, the recorded events are kept until tracing is enabled again. */
+void disable();
+
+/**
+ * Write the recorded events in the Chrome trace event format. Tracing should be disabled or no
+ * tasks should run while writing, otherwise events may be missing.
+ * \return False if the file could not be written.
+ */
+bool write_chrome_trace(StringRefNull filepath);
+
+/** Records an event for the lifetime of the object if tracing is enabled. */
+class ScopedEvent : NonCopyable, NonMovable {
+ private:
+  bool is_enabled_;
+  EventType type_;
+  SourceLocation location_;
+  /** The function that runs the task, when there is no source location. */
+  const void *function_;
+  int64_t size_;
+  int64_t grain_size_;
+  int64_t start_ns_;
+
+ public:
+  /**
+   * \param size: The number of elements processed by the parallel region or the task.
+   */
+  ScopedEvent(const EventType type,
+              const SourceLocation &location,
+              const int64_t size,
+              const int64_t grain_size)
+      : is_enabled_(trace::is_enabled())
+  {
+    if (is_enabled_) {
+      this->begin(type, location, nullptr, size, grain_size);
+    }
+  }
+
+  ScopedEvent(const EventType type, const void *function) : is_enabled_(trace::is_enabled())
+  {
+    if (is_enabled_) {
+      this->begin(type, {}, function, 0, 0);
+    }
+  }
+
+  ~ScopedEvent()
+  {
+    if (is_enabled_) {
+      this->end();
+    }
+  }
+
+ private:
+  void begin(EventType type,
+             const SourceLocation &location,
+             const void *function,
+             int64_t size,
+             int64_t grain_size);
+  void end();
+};
+
+}  // namespace blender::threading::trace
@@ -208,6 +208,30 @@ bool BLI_mmap_read(BLI_mmap_file *file, void *dest, size_t offset, size_t length
   return !file->io_error;
 }
 
+void BLI_mmap_prefetch(BLI_mmap_file *file, size_t offset, size_t length)
+{
+  if (file->io_error || offset >= file->length) {
+    return;
+  }
+  if (offset + length > file->length) {
+    length = file->length - offset;
+  }
+
+#ifndef WIN32
+  /* The range has to start at a page boundary. */
+  const size_t page_size = (size_t)sysconf(_SC_PAGESIZE);
+  const size_t aligned_offset = offset - (offset % page_size);
+  posix_madvise(file->memory + aligned_offset,
+                length + (offset - aligned_offset),
+                POSIX_MADV_WILLNEED);
+#else
+  WIN32_MEMORY_RANGE_ENTRY range;
+  range.VirtualAddress = file->memory + offset;
+  range.NumberOfBytes = length;
+  PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+#endif
+}
+
 void *BLI_mmap_get_pointer(BLI_mmap_file *file)
 {
   return file->memory;
@@ -0,0 +1,1382 @@
+/* SPDX-FileCopyrightText: 2025 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup bli
+ */
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cfloat>
+#include <cmath>
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_atomic_disjoint_set.hh"
+#include "BLI_delaunay_2d.hh"
+#include "BLI_enumerable_thread_specific.hh"
+#include "BLI_kdopbvh.hh"
+#include "BLI_map.hh"
+#include "BLI_math_boolean.hh"
+#include "BLI_math_geom.h"
+#include "BLI_math_vector.hh"
+#include "BLI_mesh_boolean_manifold.hh"
+#include "BLI_offset_indices.hh"
+#include "BLI_ordered_edge.hh"
+#include "BLI_set.hh"
+#include "BLI_sort.hh"
+#include "BLI_task.hh"
+#include "BLI_vector_set.hh"
+
+#ifdef WITH_GMP
+#  include "BLI_math_mpq.hh"
+#  include "BLI_math_vector_mpq_types.hh"
+#endif
+
+namespace blender::meshintersect::manifold {
+
+/* -------------------------------------------------------------------- */
+/** \name Topology
+ * \{ */
+
+static bool tri_has_directed_edge(const int3 &tri, const int v1, const int v2)
+{
+  return (tri[0] == v1 && tri[1] == v2) || (tri[1] == v1 && tri[2] == v2) ||
+         (tri[2] == v1 && tri[0] == v2);
+}
+
+/**
+ * Find the neighbor triangle across every edge, where the edge starting at corner `i` is stored
+ * in `r_neighbors[tri][i]`. Returns false if the operands are not closed, consistently oriented
+ * manifolds, or if triangles are degenerate topologically.
+ */
+static bool find_tri_neighbors(const TriMesh &mesh, MutableSpan<int3> r_neighbors)
+{
+  const int verts_num = mesh.positions.size();
+  Array<int> vert_to_tri_offsets(verts_num + 1, 0);
+  for (const int3 &tri : mesh.tris) {
+    for (const int i : IndexRange(3)) {
+      if (tri[i] < 0 || tri[i] >= verts_num) {
+        return false;
+      }
+      vert_to_tri_offsets[tri[i]]++;
+    }
+  }
+  const OffsetIndices<int> vert_to_tri = offset_indices::accumulate_counts_to_offsets(
+      vert_to_tri_offsets);
+  Array<int> vert_tris(vert_to_tri.total_size());
+  {
+    Array<int> fill_counts(verts_num, 0);
+    for (const int tri_i : mesh.tris.index_range()) {
+      for (const int i : IndexRange(3)) {
+        const int vert = mesh.tris[tri_i][i];
+        vert_tris[vert_to_tri[vert][fill_counts[vert]++]] = tri_i;
+      }
+    }
+  }
+
+  std::atomic<bool> valid = true;
+  threading::parallel_for(mesh.tris.index_range(), 2048, [&](const IndexRange range) {
+    for (const int tri_i : range) {
+      const int3 &tri = mesh.tris[tri_i];
+      for (const int i : IndexRange(3)) {
+        const int v1 = tri[i];
+        const int v2 = tri[(i + 1) % 3];
+        if (v1 == v2) {
+          valid.store(false, std::memory_order_relaxed);
+          return;
+        }
+        int same_direction_num = 0;
+        int neighbor = -1;
+        int opposite_direction_num = 0;
+        for (const int other_tri_i : vert_tris.as_span().slice(vert_to_tri[v1])) {
+          const int3 &other_tri = mesh.tris[other_tri_i];
+          if (tri_has_directed_edge(other_tri, v1, v2)) {
+            same_direction_num++;
+          }
+          if (tri_has_directed_edge(other_tri, v2, v1)) {
+            opposite_direction_num++;
+            neighbor = other_tri_i;
+          }
+        }
+        if (same_direction_num != 1 || opposite_direction_num != 1 ||
+            mesh.tri_shapes[neighbor] != mesh.tri_shapes[tri_i])
+        {
+          valid.store(false, std::memory_order_relaxed);
+          return;
+        }
+        r_neighbors[tri_i][i] = neighbor;
+      }
+    }
+  });
+  return valid;
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Perturbed Predicates
+ *
+ * Every operand is translated by `ε_s * (1, δ, δ²)`, where `s` is the index of the operand and
+ * `0 = ε_0 < ε_1 < ...` and all epsilons are infinitesimally small compared to `δ²`. Since the
+ * predicates only ever involve two operands, only the points of the operand with the higher
+ * index have to be considered as moved. When the exact orientation is zero, its sign is decided
+ * by the first order term of the perturbation, which is the dot product of the summed gradients
+ * of the orientation with respect to the moved points and the perturbation direction.
+ * \{ */
+
+#ifdef WITH_GMP
+static int sign_of_lexicographic(const double x, const double y, const double z)
+{
+  for (const double value : {x, y, z}) {
+    if (value > 0.0) {
+      return 1;
+    }
+    if (value < 0.0) {
+      return -1;
+    }
+  }
+  return 0;
+}
+
+/**
+ * The gradients of `orient3d(a, b, c, d) = det[a - d; b - d; c - d]` with respect to the
+ * individual points, summed over the points that are perturbed.
+ */
+template<typename T>
+static VecBase<T, 3> orient3d_gradient_sum(const VecBase<T, 3> &a,
+                                           const VecBase<T, 3> &b,
+                                           const VecBase<T, 3> &c,
+                                           const VecBase<T, 3> &d,
+                                           const bool perturbed[4])
+{
+  VecBase<T, 3> sum(T(0), T(0), T(0));
+  if (perturbed[0]) {
+    sum += math::cross(b - d, c - d);
+  }
+  if (perturbed[1]) {
+    sum += math::cross(d - a, c - a);
+  }
+  if (perturbed[2]) {
+    sum += math::cross(b - a, d - a);
+  }
+  if (perturbed[3]) {
+    sum -= math::cross(b - a, c - a);
+  }
+  return sum;
+}
+#else
+/**
+ * A double that keeps track of whether it was computed without any rounding. Otherwise its
+ * rounding error is bounded by a small multiple of the magnitude of the terms it was computed
+ * from.
+ */
+struct CheckedDouble {
+  double value;
+  double magnitude;
+  bool exact;
+};
+
+static CheckedDouble checked_add(const CheckedDouble &a, const CheckedDouble &b)
+{
+  /* The error of the sum is computed exactly, see Knuth's "two sum". */
+  const double sum = a.value + b.value;
+  const double b_virtual = sum - a.value;
+  const double error = (a.value - (sum - b_virtual)) + (b.value - b_virtual);
+  return {sum, a.magnitude + b.magnitude, a.exact && b.exact && error == 0.0};
+}
+
+static CheckedDouble checked_sub(const CheckedDouble &a, const CheckedDouble &b)
+{
+  return checked_add(a, {-b.value, b.magnitude, b.exact});
+}
+
+static CheckedDouble checked_mul(const CheckedDouble &a, const CheckedDouble &b)
+{
+  const double product = a.value * b.value;
+  const bool exact = std::fma(a.value, b.value, -product) == 0.0;
+  return {product, a.magnitude * b.magnitude, a.exact && b.exact && exact};
+}
+
+using CheckedDouble3 = std::array<CheckedDouble, 3>;
+
+static CheckedDouble3 checked_diff(const double3 &a, const double3 &b)
+{
+  CheckedDouble3 result;
+  for (const int i : IndexRange(3)) {
+    result[i] = checked_sub({a[i], std::abs(a[i]), true}, {b[i], std::abs(b[i]), true});
+  }
+  return result;
+}
+
+static void checked_add_cross(const CheckedDouble3 &a, const CheckedDouble3 &b, CheckedDouble3 &r)
+{
+  for (const int i : IndexRange(3)) {
+    const int j = (i + 1) % 3;
+    const int k = (i + 2) % 3;
+    r[i] = checked_add(r[i], checked_sub(checked_mul(a[j], b[k]), checked_mul(a[k], b[j])));
+  }
+}
+
+/**
+ * The lexicographic sign of #orient3d_gradient_sum computed with doubles. Components whose sign
+ * can't be trusted because of rounding errors make the result zero.
+ */
+static int orient3d_gradient_sum_sign_checked(const double3 &a,
+                                              const double3 &b,
+                                              const double3 &c,
+                                              const double3 &d,
+                                              const bool perturbed[4])
+{
+  CheckedDouble3 sum;
+  sum.fill({0.0, 0.0, true});
+  if (perturbed[0]) {
+    checked_add_cross(checked_diff(b, d), checked_diff(c, d), sum);
+  }
+  if (perturbed[1]) {
+    checked_add_cross(checked_diff(d, a), checked_diff(c, a), sum);
+  }
+  if (perturbed[2]) {
+    checked_add_cross(checked_diff(b, a), checked_diff(d, a), sum);
+  }
+  if (perturbed[3]) {
+    checked_add_cross(checked_diff(c, a), checked_diff(b, a), sum);
+  }
+  for (const CheckedDouble &value : sum) {
+    if (value.exact) {
+      if (value.value != 0.0) {
+        return value.value > 0.0 ? 1 : -1;
+      }
+      continue;
+    }
+    if (std::abs(value.value) > value.magnitude * (16.0 * DBL_EPSILON)) {
+      return value.value > 0.0 ? 1 : -1;
+    }
+    return 0;
+  }
+  return 0;
+}
+#endif
+
+static int orient3d_perturbed(const double3 &a,
+                              const double3 &b,
+                              const double3 &c,
+                              const double3 &d,
+                              const bool perturbed[4])
+{
+  const int orient = orient3d(a, b, c, d);
+  if (orient != 0) {
+    return orient;
+  }
+#ifdef WITH_GMP
+  const mpq3 gradient = orient3d_gradient_sum(mpq3(a.x, a.y, a.z),
+                                              mpq3(b.x, b.y, b.z),
+                                              mpq3(c.x, c.y, c.z),
+                                              mpq3(d.x, d.y, d.z),
+                                              perturbed);
+  return sign_of_lexicographic(sgn(gradient.x), sgn(gradient.y), sgn(gradient.z));
+#else
+  /* Without exact arithmetic, the tie is only broken when the rounding errors can't change the
+   * result. Otherwise the orientation is reported as degenerate, which makes the solver fail
+   * instead of deciding the topology from a sign that may be wrong. */
+  return orient3d_gradient_sum_sign_checked(a, b, c, d, perturbed);
+#endif
+}
+
+/**
+ * Side of \a point relative to the plane of the triangle \a tri_i, where the point is moved
+ * together with the operand \a point_shape.
+ */
+static int point_tri_orient(const TriMesh &mesh,
+                            const int tri_i,
+                            const double3 &point,
+                            const int point_shape)
+{
+  const int3 &tri = mesh.tris[tri_i];
+  const bool point_moved = point_shape > mesh.tri_shapes[tri_i];
+  const bool perturbed[4] = {!point_moved, !point_moved, !point_moved, point_moved};
+  return orient3d_perturbed(mesh.positions[tri[0]],
+                            mesh.positions[tri[1]],
+                            mesh.positions[tri[2]],
+                            point,
+                            perturbed);
+}
+
+/** Orientation of the tetrahedron spanned by two segments of different operands. */
+static int segment_segment_orient(const double3 &a0,
+                                  const double3 &a1,
+                                  const int shape_a,
+                                  const double3 &b0,
+                                  const double3 &b1,
+                                  const int shape_b)
+{
+  const bool b_moved = shape_b > shape_a;
+  const bool perturbed[4] = {!b_moved, !b_moved, b_moved, b_moved};
+  return orient3d_perturbed(a0, a1, b0, b1, perturbed);
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Triangle Intersection
+ * \{ */
+
+/** An intersection point, defined by an edge of one operand crossing a triangle of another. */
+struct ImplicitPoint {
+  OrderedEdge edge = {0, 0};
+  int tri = -1;
+
+  uint64_t hash() const
+  {
+    return get_default_hash(this->edge, this->tri);
+  }
+
+  friend bool operator==(const ImplicitPoint &a, const ImplicitPoint &b)
+  {
+    return a.edge == b.edge && a.tri == b.tri;
+  }
+};
+
+struct Segment {
+  int tri_a;
+  int tri_b;
+  ImplicitPoint points[2];
+};
+
+enum class EdgeCrossing : int8_t { None, Crosses, Degenerate };
+
+/**
+ * Whether the segment crosses the interior of the triangle, given that its end points are on
+ * different sides of the plane of the triangle.
+ */
+static EdgeCrossing segment_crosses_tri(const TriMesh &mesh,
+                                        const double3 &p0,
+                                        const double3 &p1,
+                                        const int segment_shape,
+                                        const int tri_i)
+{
+  const int3 &tri = mesh.tris[tri_i];
+  const int tri_shape = mesh.tri_shapes[tri_i];
+  int orients[3];
+  for (const int i : IndexRange(3)) {
+    orients[i] = segment_segment_orient(p0,
+                                        p1,
+                                        segment_shape,
+                                        mesh.positions[tri[i]],
+                                        mesh.positions[tri[(i + 1) % 3]],
+                                        tri_shape);
+    if (orients[i] == 0) {
+      return EdgeCrossing::Degenerate;
+    }
+  }
+  return (orients[0] == orients[1] && orients[1] == orients[2]) ? EdgeCrossing::Crosses :
+                                                                  EdgeCrossing::None;
+}
+
+/**
+ * Find the edge-triangle crossings that bound the intersection segment of the two triangles.
+ * \return The number of points (zero or two), or -1 if the configuration is degenerate.
+ */
+static int intersect_tri_pair(const TriMesh &mesh,
+                              const int tri_a,
+                              const int tri_b,
+                              ImplicitPoint r_points[2])
+{
+  const int shape_a = mesh.tri_shapes[tri_a];
+  const int shape_b = mesh.tri_shapes[tri_b];
+  const int3 &verts_a = mesh.tris[tri_a];
+  const int3 &verts_b = mesh.tris[tri_b];
+
+  int orients_b[3];
+  for (const int i : IndexRange(3)) {
+    orients_b[i] = point_tri_orient(mesh, tri_a, mesh.positions[verts_b[i]], shape_b);
+    if (orients_b[i] == 0) {
+      return -1;
+    }
+  }
+  if (orients_b[0] == orients_b[1] && orients_b[1] == orients_b[2]) {
+    return 0;
+  }
+  int orients_a[3];
+  for (const int i : IndexRange(3)) {
+    orients_a[i] = point_tri_orient(mesh, tri_b, mesh.positions[verts_a[i]], shape_a);
+    if (orients_a[i] == 0) {
+      return -1;
+    }
+  }
+  if (orients_a[0] == orients_a[1] && orients_a[1] == orients_a[2]) {
+    return 0;
+  }
+
+  int points_num = 0;
+  auto add_crossings = [&](const int3 &verts,
+                           const int orients[3],
+                           const int shape,
+                           const int other_tri) {
+    for (const int i : IndexRange(3)) {
+      const int next = (i + 1) % 3;
+      if (orients[i] == orients[next]) {
+        continue;
+      }
+      const int2 edge(verts[i], verts[next]);
+      switch (segment_crosses_tri(
+          mesh, mesh.positions[edge[0]], mesh.positions[edge[1]], shape, other_tri))
+      {
+        case EdgeCrossing::None:
+          break;
+        case EdgeCrossing::Crosses:
+          if (points_num == 2) {
+            return false;
+          }
+          r_points[points_num++] = {OrderedEdge(edge), other_tri};
+          break;
+        case EdgeCrossing::Degenerate:
+          return false;
+      }
+    }
+    return true;
+  };
+  if (!add_crossings(verts_a, orients_a, shape_a, tri_b)) {
+    return -1;
+  }
+  if (!add_crossings(verts_b, orients_b, shape_b, tri_a)) {
+    return -1;
+  }
+  if (points_num == 1) {
+    return -1;
+  }
+  return points_num;
+}
+
+static float3 min_float_bound(const double3 &co)
+{
+  return float3(nextafterf(float(co.x), -FLT_MAX),
+                nextafterf(float(co.y), -FLT_MAX),
+                nextafterf(float(co.z), -FLT_MAX));
+}
+
+static float3 max_float_bound(const double3 &co)
+{
+  return float3(nextafterf(float(co.x), FLT_MAX),
+                nextafterf(float(co.y), FLT_MAX),
+                nextafterf(float(co.z), FLT_MAX));
+}
+
+static std::unique_ptr<BVHTree, BVHTreeDeleter> build_tri_bvh(const TriMesh &mesh)
+{
+  std::unique_ptr<BVHTree, BVHTreeDeleter> tree(BLI_bvhtree_new(mesh.tris.size(), 0.0f, 4, 6));
+  for (const int tri_i : mesh.tris.index_range()) {
+    const int3 &tri = mesh.tris[tri_i];
+    double3 min = mesh.positions[tri[0]];
+    double3 max = min;
+    math::min_max(mesh.positions[tri[1]], min, max);
+    math::min_max(mesh.positions[tri[2]], min, max);
+    /* Round the bounds outwards, so that no overlap is missed. */
+    const float3 bounds[2] = {min_float_bound(min), max_float_bound(max)};
+    BLI_bvhtree_insert(tree.get(), tri_i, &bounds[0].x, 2);
+  }
+  BLI_bvhtree_balance(tree.get());
+  return tree;
+}
+
+struct OverlapData {
+  Span<int> tri_shapes;
+};
+
+static bool overlap_different_shapes_cb(void *userdata,
+                                        const int index_a,
+                                        const int index_b,
+                                        const int /*thread*/)
+{
+  const OverlapData &data = *static_cast<const OverlapData *>(userdata);
+  return data.tri_shapes[index_a] != data.tri_shapes[index_b];
+}
+
+/**
+ * Find all intersection segments between triangles of different operands. The result is sorted
+ * so that it does not depend on the order in which the pairs were processed.
+ */
+static bool find_segments(const TriMesh &mesh, const BVHTree &tree, Vector<Segment> &r_segments)
+{
+  OverlapData data{mesh.tri_shapes};
+  uint overlaps_num = 0;
+  BVHTreeOverlap *overlaps = BLI_bvhtree_overlap_self(
+      &tree, &overlaps_num, overlap_different_shapes_cb, &data);
+  const Span<BVHTreeOverlap> overlap_span(overlaps, overlaps_num);
+
+  std::atomic<bool> valid = true;
+  threading::EnumerableThreadSpecific<Vector<Segment>> all_segments;
+  threading::parallel_for(overlap_span.index_range(), 256, [&](const IndexRange range) {
+    Vector<Segment> &segments = all_segments.local();
+    for (const BVHTreeOverlap &overlap : overlap_span.slice(range)) {
+      const int tri_a = std::min(overlap.indexA, overlap.indexB);
+      const int tri_b = std::max(overlap.indexA, overlap.indexB);
+      Segment segment;
+      const int points_num = intersect_tri_pair(mesh, tri_a, tri_b, segment.points);
+      if (points_num == -1) {
+        valid.store(false, std::memory_order_relaxed);
+        return;
+      }
+      if (points_num == 2) {
+        segment.tri_a = tri_a;
+        segment.tri_b = tri_b;
+        segments.append(segment);
+      }
+    }
+  });
+  if (overlaps) {
+    MEM_freeN(overlaps);
+  }
+  if (!valid) {
+    return false;
+  }
+
+  for (Vector<Segment> &segments : all_segments) {
+    r_segments.extend(segments);
+  }
+  parallel_sort(r_segments.begin(), r_segments.end(), [](const Segment &a, const Segment &b) {
+    return a.tri_a < b.tri_a || (a.tri_a == b.tri_a && a.tri_b < b.tri_b);
+  });
+  return true;
+}
+
+/**
+ * The symbolic perturbation is also applied to the coordinates used for the triangulation with a
+ * small but finite magnitude. Otherwise points that coincide geometrically at the unperturbed
+ * position (e.g. where coplanar faces touch) could not be triangulated. The offsets of all
+ * operands together stay within the perturbation scale, and they are never used for the output
+ * positions, which are computed from the unperturbed coordinates.
+ */
+static double3 shape_offset(const double perturbation_scale, const int shape)
+{
+  return double(shape) * perturbation_scale * double3(1.0, 1e-1, 1e-2);
+}
+
+static double calc_max_abs_coordinate(const Span<double3> positions)
+{
+  double max_abs = 0.0;
+  for (const double3 &co : positions) {
+    max_abs = std::max({max_abs, std::abs(co.x), std::abs(co.y), std::abs(co.z)});
+  }
+  return max_abs;
+}
+
+/**
+ * Factor of the intersection point along its edge, starting at the lower vertex index, where the
+ * edge is moved by \a offset relative to the triangle. The factors are only used for the
+ * coordinates of the new vertices, the topology is decided by the exact predicates.
+ */
+static double calc_point_factor(const TriMesh &mesh,
+                                const ImplicitPoint &point,
+                                const double3 &offset)
+{
+  const int3 &tri = mesh.tris[point.tri];
+  const double3 &a = mesh.positions[tri[0]];
+  const double3 normal = math::cross(mesh.positions[tri[1]] - a, mesh.positions[tri[2]] - a);
+  const double dist_low = math::dot(normal, mesh.positions[point.edge.v_low] + offset - a);
+  const double dist_high = math::dot(normal, mesh.positions[point.edge.v_high] + offset - a);
+  const double denominator = dist_low - dist_high;
+  if (denominator == 0.0) {
+    return 0.5;
+  }
+  return std::clamp(dist_low / denominator, 0.0, 1.0);
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Re-Triangulation
+ * \{ */
+
+struct SplitContext {
+  const TriMesh &mesh;
+  Span<Segment> segments;
+  /** Index of the first new vertex. */
+  int new_verts_start;
+  const VectorSet<ImplicitPoint> &points;
+  /** Factors of the points along their edges with the finite perturbation. */
+  Span<double> perturbed_point_factors;
+  Span<int> vert_shapes;
+  double perturbation_scale;
+  /** Points on every edge that has intersections, sorted by their factor. */
+  const Map<OrderedEdge, Vector<int>> &edge_points;
+};
+
+/** The re-triangulation of one intersected triangle. */
+struct SplitTriResult {
+  /**
+   * Triangles with vertex indices in the result. Triple points are not known globally yet, so
+   * they are encoded as `-1 - i`, where `i` is an index into #triple_points.
+   */
+  Vector<int3> tris;
+  /**
+   * The sorted indices of the three triangles of different operands that meet at every point
+   * where two segments inside of this triangle cross.
+   */
+  Vector<int3> triple_points;
+  /** Sub-edges of the intersection segments, with the same encoding as #tris. */
+  Vector<int2> intersection_edges;
+};
+
+static int segment_other_tri(const Segment &segment, const int tri_i)
+{
+  return segment.tri_a == tri_i ? segment.tri_b : segment.tri_a;
+}
+
+/**
+ * Triangulate the triangle with the intersection segments as constraints. Segments with
+ * different operands may cross, which creates a triple point.
+ * Returns false if the triangulation is not consistent with the topology of the intersection,
+ * which can happen when intersection points are extremely close together.
+ */
+static bool split_tri(const SplitContext &ctx,
+                      const int tri_i,
+                      const Span<int> tri_segments,
+                      SplitTriResult &r_result)
+{
+  const TriMesh &mesh = ctx.mesh;
+  const int3 &tri = mesh.tris[tri_i];
+
+  /* Project to the axis aligned plane where the triangle has the largest area, keeping the
+   * counter-clockwise orientation. */
+  const double3 normal = math::cross(mesh.positions[tri[1]] - mesh.positions[tri[0]],
+                                     mesh.positions[tri[2]] - mesh.positions[tri[0]]);
+  const int axis = math::dominant_axis(normal);
+  int axis_u = (axis + 1) % 3;
+  int axis_v = (axis + 2) % 3;
+  if (normal[axis] < 0.0) {
+    std::swap(axis_u, axis_v);
+  }
+
+  Vector<int, 16> local_to_global;
+  Vector<double2, 16> coords;
+  auto add_vert = [&](const int global) {
+    const int local = local_to_global.first_index_of_try(global);
+    if (local != -1) {
+      return local;
+    }
+    double3 co;
+    if (global < ctx.new_verts_start) {
+      co = mesh.positions[global] + shape_offset(ctx.perturbation_scale, ctx.vert_shapes[global]);
+    }
+    else {
+      const int point_i = global - ctx.new_verts_start;
+      const OrderedEdge &edge = ctx.points[point_i].edge;
+      co = math::interpolate(mesh.positions[edge.v_low],
+                             mesh.positions[edge.v_high],
+                             ctx.perturbed_point_factors[point_i]) +
+           shape_offset(ctx.perturbation_scale, ctx.vert_shapes[edge.v_low]);
+    }
+    local_to_global.append(global);
+    coords.append(double2(co[axis_u], co[axis_v]));
+    return int(local_to_global.size() - 1);
+  };
+
+  Vector<int, 16> boundary;
+  for (const int i : IndexRange(3)) {
+    const int v1 = tri[i];
+    const int v2 = tri[(i + 1) % 3];
+    boundary.append(add_vert(v1));
+    if (const Vector<int> *edge_points = ctx.edge_points.lookup_ptr(OrderedEdge(v1, v2))) {
+      if (v1 < v2) {
+        for (const int point : *edge_points) {
+          boundary.append(add_vert(ctx.new_verts_start + point));
+        }
+      }
+      else {
+        for (int i = edge_points->size() - 1; i >= 0; i--) {
+          boundary.append(add_vert(ctx.new_verts_start + (*edge_points)[i]));
+        }
+      }
+    }
+  }
+
+  Vector<std::pair<int, int>, 16> constraints;
+  for (const int segment_i : tri_segments) {
+    const Segment &segment = ctx.segments[segment_i];
+    const int v1 = ctx.new_verts_start + int(ctx.points.index_of(segment.points[0]));
+    const int v2 = ctx.new_verts_start + int(ctx.points.index_of(segment.points[1]));
+    constraints.append({add_vert(v1), add_vert(v2)});
+  }
+
+  double extent = 0.0;
+  for (const double2 &co : coords) {
+    extent = std::max({extent, std::abs(co.x), std::abs(co.y)});
+  }
+
+  CDT_input<double> input;
+  input.vert = coords.as_span();
+  input.edge = constraints.as_span();
+  input.face = Array<Vector<int>>(1, Vector<int>(boundary.as_span()));
+  input.epsilon = std::max(extent * 1e-12, DBL_MIN);
+  input.need_ids = true;
+  const CDT_result<double> result = delaunay_2d_calc(input, CDT_INSIDE);
+
+  /* Output vertices that don't correspond to an input vertex have to be crossings of exactly
+   * two segments. */
+  Array<Vector<int, 2>> vert_constraints(result.vert.size());
+  for (const int i : result.edge.index_range()) {
+    for (const int orig : result.edge_orig[i]) {
+      if (orig < result.face_edge_offset) {
+        vert_constraints[result.edge[i].first].append_non_duplicates(orig);
+        vert_constraints[result.edge[i].second].append_non_duplicates(orig);
+      }
+    }
+  }
+
+  /* Every output vertex has to be an input vertex or a triple point, otherwise the triangulation
+   * is not consistent with the neighboring triangles anymore. */
+  Array<int> result_to_global(result.vert.size());
+  Array<int, 16> constraint_crossings(constraints.size(), 0);
+  for (const int i : result.vert.index_range()) {
+    if (result.vert_orig[i].size() == 1) {
+      result_to_global[i] = local_to_global[result.vert_orig[i][0]];
+      continue;
+    }
+    if (!result.vert_orig[i].is_empty() || vert_constraints[i].size() != 2) {
+      return false;
+    }
+    const int other_tri_a = segment_other_tri(ctx.segments[tri_segments[vert_constraints[i][0]]],
+                                              tri_i);
+    const int other_tri_b = segment_other_tri(ctx.segments[tri_segments[vert_constraints[i][1]]],
+                                              tri_i);
+    if (mesh.tri_shapes[other_tri_a] == mesh.tri_shapes[other_tri_b]) {
+      return false;
+    }
+    int3 key(tri_i, other_tri_a, other_tri_b);
+    std::sort(&key[0], &key[0] + 3);
+    result_to_global[i] = -1 - int(r_result.triple_points.append_and_get_index(key));
+    constraint_crossings[vert_constraints[i][0]]++;
+    constraint_crossings[vert_constraints[i][1]]++;
+  }
+
+  for (const Vector<int> &face : result.face) {
+    if (face.size() != 3) {
+      return false;
+    }
+    r_result.tris.append(
+        {result_to_global[face[0]], result_to_global[face[1]], result_to_global[face[2]]});
+  }
+
+  /* Every segment has to be in the triangulation, split only where it crosses other segments. */
+  Array<int, 16> constraint_edges_num(constraints.size(), 0);
+  for (const int i : result.edge.index_range()) {
+    bool is_intersection = false;
+    for (const int orig : result.edge_orig[i]) {
+      if (orig < result.face_edge_offset) {
+        constraint_edges_num[orig]++;
+        is_intersection = true;
+      }
+    }
+    if (is_intersection) {
+      r_result.intersection_edges.append(
+          {result_to_global[result.edge[i].first], result_to_global[result.edge[i].second]});
+    }
+  }
+  for (const int i : constraints.index_range()) {
+    if (constraint_edges_num[i] != constraint_crossings[i] + 1) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * Position of the point where the planes of three triangles of different operands meet. Returns
+ * false when the planes don't meet in a single point.
+ */
+static bool calc_plane_intersection(const TriMesh &mesh,
+                                    const double perturbation_scale,
+                                    const int3 &tris,
+                                    double3 &r_position)
+{
+  double3 normals[3];
+  double distances[3];
+  for (const int i : IndexRange(3)) {
+    const int3 &tri = mesh.tris[tris[i]];
+    const double3 &a = mesh.positions[tri[0]];
+    normals[i] = math::cross(mesh.positions[tri[1]] - a, mesh.positions[tri[2]] - a);
+    distances[i] = math::dot(
+        normals[i], a + shape_offset(perturbation_scale, mesh.tri_shapes[tris[i]]));
+  }
+  const double3 cross_12 = math::cross(normals[1], normals[2]);
+  const double det = math::dot(normals[0], cross_12);
+  if (det == 0.0) {
+    return false;
+  }
+  r_position = (distances[0] * cross_12 + distances[1] * math::cross(normals[2], normals[0]) +
+                distances[2] * math::cross(normals[0], normals[1])) /
+               det;
+  return true;
+}
+
+/**
+ * Position of the point where three triangles of different operands meet. The unperturbed planes
+ * are used, unless they only meet in a line, where the perturbation decides the position.
+ */
+static double3 calc_triple_point_position(const TriMesh &mesh,
+                                          const double perturbation_scale,
+                                          const int3 &tris)
+{
+  double3 position;
+  if (calc_plane_intersection(mesh, 0.0, tris, position)) {
+    return position;
+  }
+  if (calc_plane_intersection(mesh, perturbation_scale, tris, position)) {
+    return position;
+  }
+  const int3 &tri = mesh.tris[tris[0]];
+  return (mesh.positions[tri[0]] + mesh.positions[tri[1]] + mesh.positions[tri[2]]) / 3.0;
+}
+
+/** Weights of the point, which lies in the plane of the triangle, clamped to the triangle. */
+static float3 calc_barycentric_weights(const double3 &a,
+                                       const double3 &b,
+                                       const double3 &c,
+                                       const double3 &point)
+{
+  const double3 normal = math::cross(b - a, c - a);
+  double3 weights(math::dot(normal, math::cross(c - b, point - b)),
+                  math::dot(normal, math::cross(a - c, point - c)),
+                  math::dot(normal, math::cross(b - a, point - a)));
+  weights = math::max(weights, double3(0.0));
+  const double sum = weights.x + weights.y + weights.z;
+  if (sum == 0.0) {
+    return float3(1.0f / 3.0f);
+  }
+  return float3(weights / sum);
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Classification
+ * \{ */
+
+struct RayCastData {
+  const TriMesh &mesh;
+  double3 start;
+  double3 end;
+  int shape;
+  MutableSpan<int> crossings_per_shape;
+  bool degenerate;
+};
+
+static void count_ray_crossings_cb(void *userdata,
+                                   const int index,
+                                   const BVHTreeRay * /*ray*/,
+                                   BVHTreeRayHit * /*hit*/)
+{
+  RayCastData &data = *static_cast<RayCastData *>(userdata);
+  const int shape = data.mesh.tri_shapes[index];
+  if (shape == data.shape || data.degenerate) {
+    return;
+  }
+  const int start_orient = point_tri_orient(data.mesh, index, data.start, data.shape);
+  const int end_orient = point_tri_orient(data.mesh, index, data.end, data.shape);
+  if (start_orient == 0 || end_orient == 0) {
+    data.degenerate = true;
+    return;
+  }
+  if (start_orient == end_orient) {
+    return;
+  }
+  switch (segment_crosses_tri(data.mesh, data.start, data.end, data.shape, index)) {
+    case EdgeCrossing::None:
+      break;
+    case EdgeCrossing::Crosses:
+      data.crossings_per_shape[shape]++;
+      break;
+    case EdgeCrossing::Degenerate:
+      data.degenerate = true;
+      break;
+  }
+}
+
+/**
+ * Find which operands contain the input vertex by counting the crossings of a segment from the
+ * vertex to a point outside of all operands. The crossings are found with the same perturbed
+ * predicates as the intersections, so the result is consistent with them even when the vertex
+ * lies on the surface of another operand. This is only done once per connected component,
+ * everything else is derived from the intersection topology.
+ */
+static bool calc_vert_inside_shapes(const TriMesh &mesh,
+                                    const BVHTree &tree,
+                                    const double max_abs_coordinate,
+                                    const int vert,
+                                    const int vert_shape,
+                                    MutableSpan<bool> r_inside)
+{
+  /* Arbitrary directions that are unlikely to be parallel to edges of typical meshes. */
+  const float3 directions[3] = {math::normalize(float3(0.3125f, 0.6875f, 0.6542f)),
+                                math::normalize(float3(-0.7213f, 0.2749f, 0.5126f)),
+                                math::normalize(float3(0.4471f, -0.5839f, -0.1683f))};
+  const double3 &start = mesh.positions[vert];
+  const double length = 4.0 * max_abs_coordinate + 1.0;
+  /* The BVH is only used to find candidates, so account for the imprecision of the float ray. */
+  const float radius = float(max_abs_coordinate * 1e-5 + FLT_MIN);
+  Array<int> crossings_per_shape(mesh.shapes_num);
+  for (const float3 &dir : directions) {
+    crossings_per_shape.fill(0);
+    RayCastData data{
+        mesh, start, start + double3(dir) * length, vert_shape, crossings_per_shape, false};
+    BLI_bvhtree_ray_cast_all(
+        &tree, float3(start), dir, radius, BVH_RAYCAST_DIST_MAX, count_ray_crossings_cb, &data);
+    if (data.degenerate) {
+      continue;
+    }
+    for (const int shape : IndexRange(mesh.shapes_num)) {
+      r_inside[shape] = crossings_per_shape[shape] % 2 == 1;
+    }
+    return true;
+  }
+  return false;
+}
+
+static bool keep_piece(const Operation operation,
+                       const int shape,
+                       const Span<bool> inside,
+                       bool &r_flip)
+{
+  r_flip = false;
+  switch (operation) {
+    case Operation::Union:
+      return !inside.contains(true);
+    case Operation::Intersect:
+      for (const int other : inside.index_range()) {
+        if (other != shape && !inside[other]) {
+          return false;
+        }
+      }
+      return true;
+    case Operation::Difference:
+      if (shape == 0) {
+        return !inside.contains(true);
+      }
+      r_flip = true;
+      for (const int other : inside.index_range().drop_front(1)) {
+        if (inside[other]) {
+          return false;
+        }
+      }
+      return inside[0];
+  }
+  BLI_assert_unreachable();
+  return false;
+}
+
+/** \} */
+
+BooleanResult boolean_trimesh(const TriMesh &mesh, const Operation operation)
+{
+  BooleanResult result;
+  const int tris_num = mesh.tris.size();
+  const int verts_num = mesh.positions.size();
+  if (mesh.shapes_num < 1 || mesh.tri_shapes.size() != tris_num) {
+    return result;
+  }
+
+  Array<int3> neighbors(tris_num);
+  if (!find_tri_neighbors(mesh, neighbors)) {
+    return result;
+  }
+
+  const std::unique_ptr<BVHTree, BVHTreeDeleter> tree = build_tri_bvh(mesh);
+  Vector<Segment> segments;
+  if (!find_segments(mesh, *tree, segments)) {
+    return result;
+  }
+
+  /* Deduplicate the intersection points, which become the new vertices. */
+  VectorSet<ImplicitPoint> points;
+  for (const Segment &segment : segments) {
+    points.add(segment.points[0]);
+    points.add(segment.points[1]);
+  }
+  Array<int> vert_shapes(verts_num, 0);
+  for (const int tri_i : mesh.tris.index_range()) {
+    for (const int i : IndexRange(3)) {
+      vert_shapes[mesh.tris[tri_i][i]] = mesh.tri_shapes[tri_i];
+    }
+  }
+  const double max_abs_coordinate = calc_max_abs_coordinate(mesh.positions);
+  const double perturbation_scale = max_abs_coordinate * 1e-7 / std::max(mesh.shapes_num - 1, 1);
+  Array<double> perturbed_point_factors(points.size());
+  Array<double> point_factors(points.size());
+  threading::parallel_for(points.index_range(), 1024, [&](const IndexRange range) {
+    for (const int i : range) {
+      const ImplicitPoint &point = points[i];
+      const double3 offset = shape_offset(perturbation_scale, vert_shapes[point.edge.v_low]) -
+                             shape_offset(perturbation_scale, mesh.tri_shapes[point.tri]);
+      perturbed_point_factors[i] = calc_point_factor(mesh, point, offset);
+      point_factors[i] = calc_point_factor(mesh, point, double3(0.0));
+    }
+  });
+  Map<OrderedEdge, Vector<int>> edge_points;
+  for (const int i : points.index_range()) {
+    edge_points.lookup_or_add_default(points[i].edge).append(i);
+  }
+  for (Vector<int> &edge_point_indices : edge_points.values()) {
+    std::sort(edge_point_indices.begin(), edge_point_indices.end(), [&](const int a, const int b) {
+      return perturbed_point_factors[a] < perturbed_point_factors[b];
+    });
+    /* Points that coincide without the perturbation may be ordered differently. Keep the output
+     * positions in the order of the triangulation, so that no triangle is flipped. */
+    for (const int i : edge_point_indices.index_range().drop_front(1)) {
+      double &factor = point_factors[edge_point_indices[i]];
+      factor = std::max(factor, point_factors[edge_point_indices[i - 1]]);
+    }
+  }
+
+  /* Group the segments by the triangles they lie in. */
+  Vector<int2> tri_segment_pairs;
+  tri_segment_pairs.reserve(segments.size() * 2);
+  for (const int segment_i : segments.index_range()) {
+    tri_segment_pairs.append({segments[segment_i].tri_a, segment_i});
+    tri_segment_pairs.append({segments[segment_i].tri_b, segment_i});
+  }
+  parallel_sort(
+      tri_segment_pairs.begin(), tri_segment_pairs.end(), [](const int2 a, const int2 b) {
+        return a[0] < b[0] || (a[0] == b[0] && a[1] < b[1]);
+      });
+  Vector<int> split_tris;
+  Vector<int> split_tri_segment_offsets;
+  Array<int> segment_indices(tri_segment_pairs.size());
+  for (const int i : tri_segment_pairs.index_range()) {
+    if (split_tris.is_empty() || split_tris.last() != tri_segment_pairs[i][0]) {
+      split_tris.append(tri_segment_pairs[i][0]);
+      split_tri_segment_offsets.append(i);
+    }
+    segment_indices[i] = tri_segment_pairs[i][1];
+  }
+  split_tri_segment_offsets.append(tri_segment_pairs.size());
+  const OffsetIndices<int> split_tri_segments(split_tri_segment_offsets);
+
+  Array<int> split_index_by_tri(tris_num, -1);
+  for (const int i : split_tris.index_range()) {
+    split_index_by_tri[split_tris[i]] = i;
+  }
+
+  /* Re-triangulate all intersected triangles independently. */
+  const SplitContext split_context{mesh,
+                                   segments,
+                                   verts_num,
+                                   points,
+                                   perturbed_point_factors,
+                                   vert_shapes,
+                                   perturbation_scale,
+                                   edge_points};
+  Array<SplitTriResult> split_results(split_tris.size());
+  std::atomic<bool> valid = true;
+  threading::parallel_for(split_tris.index_range(), 16, [&](const IndexRange range) {
+    for (const int i : range) {
+      if (!split_tri(split_context,
+                     split_tris[i],
+                     segment_indices.as_span().slice(split_tri_segments[i]),
+                     split_results[i]))
+      {
+        valid.store(false, std::memory_order_relaxed);
+        return;
+      }
+    }
+  });
+  if (!valid) {
+    return result;
+  }
+
+  /* Give the triple points their final indices. Every triple point has to be found in all three
+   * triangles that define it. */
+  const int triple_verts_start = verts_num + points.size();
+  VectorSet<int3> triple_points;
+  Vector<int> triple_point_users;
+  for (SplitTriResult &split_result : split_results) {
+    if (split_result.triple_points.is_empty()) {
+      continue;
+    }
+    Array<int, 16> local_to_global(split_result.triple_points.size());
+    for (const int i : split_result.triple_points.index_range()) {
+      const int index = triple_points.index_of_or_add(split_result.triple_points[i]);
+      if (index == triple_point_users.size()) {
+        triple_point_users.append(0);
+      }
+      triple_point_users[index]++;
+      local_to_global[i] = triple_verts_start + index;
+    }
+    auto resolve = [&](int &vert) {
+      if (vert < 0) {
+        vert = local_to_global[-1 - vert];
+      }
+    };
+    for (int3 &tri : split_result.tris) {
+      resolve(tri[0]);
+      resolve(tri[1]);
+      resolve(tri[2]);
+    }
+    for (int2 &edge : split_result.intersection_edges) {
+      resolve(edge[0]);
+      resolve(edge[1]);
+    }
+  }
+  if (std::any_of(triple_point_users.begin(), triple_point_users.end(), [](const int users) {
+        return users != 3;
+      }))
+  {
+    return result;
+  }
+
+  /* Pieces are the unchanged triangles, followed by the triangles created by the splitting. */
+  Array<int> split_result_offsets_data(split_tris.size() + 1);
+  for (const int i : split_tris.index_range()) {
+    split_result_offsets_data[i] = split_results[i].tris.size();
+  }
+  const OffsetIndices<int> split_result_offsets = offset_indices::accumulate_counts_to_offsets(
+      split_result_offsets_data);
+  const int pieces_num = tris_num + split_result_offsets.total_size();
+  Array<int> split_piece_tris(split_result_offsets.total_size());
+  Array<int3> split_piece_verts(split_result_offsets.total_size());
+  for (const int i : split_tris.index_range()) {
+    split_piece_tris.as_mutable_span().slice(split_result_offsets[i]).fill(split_tris[i]);
+    split_piece_verts.as_mutable_span()
+        .slice(split_result_offsets[i])
+        .copy_from(split_results[i].tris);
+  }
+  auto piece_orig_tri = [&](const int piece) {
+    return piece < tris_num ? piece : split_piece_tris[piece - tris_num];
+  };
+  auto piece_verts = [&](const int piece) {
+    return piece < tris_num ? mesh.tris[piece] : split_piece_verts[piece - tris_num];
+  };
+
+  /* Join pieces that are connected without crossing an intersection. */
+  AtomicDisjointSet patch_set(pieces_num);
+  threading::parallel_for(IndexRange(tris_num), 4096, [&](const IndexRange range) {
+    for (const int tri_i : range) {
+      if (split_index_by_tri[tri_i] != -1) {
+        continue;
+      }
+      for (const int i : IndexRange(3)) {
+        const int neighbor = neighbors[tri_i][i];
+        if (neighbor > tri_i && split_index_by_tri[neighbor] == -1) {
+          patch_set.join(tri_i, neighbor);
+        }
+      }
+    }
+  });
+
+  Map<OrderedEdge, Vector<int, 4>> split_edge_pieces;
+  for (const int i : split_piece_verts.index_range()) {
+    const int3 &tri = split_piece_verts[i];
+    for (const int k : IndexRange(3)) {
+      split_edge_pieces.lookup_or_add_default({tri[k], tri[(k + 1) % 3]}).append(tris_num + i);
+    }
+  }
+  Set<OrderedEdge> intersection_edges;
+  for (const SplitTriResult &split_result : split_results) {
+    for (const int2 &edge : split_result.intersection_edges) {
+      intersection_edges.add({edge[0], edge[1]});
+    }
+  }
+
+  /* Crossing an intersection edge toggles whether a piece is inside of the other operand. */
+  struct PatchLink {
+    int piece_a;
+    int piece_b;
+    int toggled_shape;
+  };
+  Vector<PatchLink> links;
+  for (const auto item : split_edge_pieces.items()) {
+    const OrderedEdge &edge = item.key;
+    const Span<int> pieces = item.value;
+    if (intersection_edges.contains(edge)) {
+      /* Two pieces of each of the two intersecting operands meet at the edge. */
+      if (pieces.size() != 4) {
+        return result;
+      }
+      const int shape = mesh.tri_shapes[piece_orig_tri(pieces[0])];
+      Vector<int, 2> same_shape;
+      Vector<int, 2> other_shape;
+      int other = -1;
+      for (const int piece : pieces) {
+        const int piece_shape = mesh.tri_shapes[piece_orig_tri(piece)];
+        if (piece_shape == shape) {
+          same_shape.append(piece);
+        }
+        else {
+          other_shape.append(piece);
+          other = piece_shape;
+        }
+      }
+      if (same_shape.size() != 2 || other_shape.size() != 2 ||
+          mesh.tri_shapes[piece_orig_tri(other_shape[1])] != other)
+      {
+        return result;
+      }
+      links.append({same_shape[0], same_shape[1], other});
+      links.append({other_shape[0], other_shape[1], shape});
+      continue;
+    }
+    if (pieces.size() == 2) {
+      patch_set.join(pieces[0], pieces[1]);
+      continue;
+    }
+    if (pieces.size() != 1) {
+      return result;
+    }
+    /* The edge is on the boundary of the split triangle, shared with an unchanged neighbor. */
+    const int tri_i = piece_orig_tri(pieces[0]);
+    const int3 &tri = mesh.tris[tri_i];
+    bool found = false;
+    for (const int k : IndexRange(3)) {
+      if (OrderedEdge(tri[k], tri[(k + 1) % 3]) == edge) {
+        const int neighbor = neighbors[tri_i][k];
+        if (split_index_by_tri[neighbor] != -1) {
+          return result;
+        }
+        patch_set.join(pieces[0], neighbor);
+        found = true;
+      }
+    }
+    if (!found) {
+      return result;
+    }
+  }
+
+  Array<int> piece_patches(pieces_num);
+  const int patches_num = patch_set.calc_reduced_ids(piece_patches);
+  Array<Vector<std::pair<int, int>>> patch_links(patches_num);
+  for (const PatchLink &link : links) {
+    const int patch_a = piece_patches[link.piece_a];
+    const int patch_b = piece_patches[link.piece_b];
+    patch_links[patch_a].append({patch_b, link.toggled_shape});
+    patch_links[patch_b].append({patch_a, link.toggled_shape});
+  }
+
+  /* Classify one patch per connected component and propagate the result to all other patches.
+   * Every component contains whole operand surfaces, so it always has a piece with an input
+   * vertex that can be classified exactly. */
+  const int shapes_num = mesh.shapes_num;
+  Array<bool> patch_inside(patches_num * shapes_num, false);
+  Array<bool> patch_visited(patches_num, false);
+  Vector<int> stack;
+  for (const int piece : IndexRange(pieces_num)) {
+    const int seed = piece_patches[piece];
+    if (patch_visited[seed]) {
+      continue;
+    }
+    const int3 verts = piece_verts(piece);
+    const int *seed_vert = std::find_if(
+        &verts[0], &verts[0] + 3, [&](const int vert) { return vert < verts_num; });
+    if (seed_vert == &verts[0] + 3) {
+      continue;
+    }
+    if (!calc_vert_inside_shapes(
+            mesh,
+            *tree,
+            max_abs_coordinate,
+            *seed_vert,
+            mesh.tri_shapes[piece_orig_tri(piece)],
+            patch_inside.as_mutable_span().slice(seed * shapes_num, shapes_num)))
+    {
+      return result;
+    }
+    patch_visited[seed] = true;
+    stack.append(seed);
+    while (!stack.is_empty()) {
+      const int patch = stack.pop_last();
+      const Span<bool> inside = patch_inside.as_span().slice(patch * shapes_num, shapes_num);
+      for (const auto &[other_patch, toggled_shape] : patch_links[patch]) {
+        MutableSpan<bool> other_inside = patch_inside.as_mutable_span().slice(
+            other_patch * shapes_num, shapes_num);
+        if (!patch_visited[other_patch]) {
+          other_inside.copy_from(inside);
+          other_inside[toggled_shape] = !inside[toggled_shape];
+          patch_visited[other_patch] = true;
+          stack.append(other_patch);
+          continue;
+        }
+        for (const int shape : IndexRange(shapes_num)) {
+          if (other_inside[shape] != (inside[shape] != (shape == toggled_shape))) {
+            return result;
+          }
+        }
+      }
+    }
+  }
+  if (patch_visited.as_span().contains(false)) {
+    return result;
+  }
+
+  /* Decide which pieces are kept. */
+  result.tri_results.reinitialize(tris_num);
+  threading::parallel_for(IndexRange(tris_num), 4096, [&](const IndexRange range) {
+    for (const int tri_i : range) {
+      if (split_index_by_tri[tri_i] != -1) {
+        result.tri_results[tri_i] = TriResult::Split;
+        continue;
+      }
+      const int patch = piece_patches[tri_i];
+      bool flip;
+      const bool keep = keep_piece(operation,
+                                   mesh.tri_shapes[tri_i],
+                                   patch_inside.as_span().slice(patch * shapes_num, shapes_num),
+                                   flip);
+      result.tri_results[tri_i] = keep ? (flip ? TriResult::KeptFlipped : TriResult::Kept) :
+                                         TriResult::Removed;
+    }
+  });
+
+  result.split_tri_indices = std::move(split_tris);
+  result.split_tri_offsets.append(0);
+  for (const int i : result.split_tri_indices.index_range()) {
+    const int shape = mesh.tri_shapes[result.split_tri_indices[i]];
+    for (const int piece_i : split_result_offsets[i]) {
+      const int patch = piece_patches[tris_num + piece_i];
+      bool flip;
+      if (keep_piece(operation,
+                     shape,
+                     patch_inside.as_span().slice(patch * shapes_num, shapes_num),
+                     flip))
+      {
+        const int3 &tri = split_piece_verts[piece_i];
+        result.split_tris.append(flip ? int3(tri[0], tri[2], tri[1]) : tri);
+      }
+    }
+    result.split_tri_offsets.append(result.split_tris.size());
+  }
+
+  const int new_verts_num = points.size() + triple_points.size();
+  result.new_positions.resize(new_verts_num);
+  result.new_vert_interp_verts.resize(new_verts_num);
+  result.new_vert_interp_weights.resize(new_verts_num);
+  threading::parallel_for(points.index_range(), 1024, [&](const IndexRange range) {
+    for (const int i : range) {
+      const OrderedEdge &edge = points[i].edge;
+      const float factor = float(point_factors[i]);
+      result.new_positions[i] = math::interpolate(
+          mesh.positions[edge.v_low], mesh.positions[edge.v_high], point_factors[i]);
+      result.new_vert_interp_verts[i] = int3(edge.v_low, edge.v_high, edge.v_high);
+      result.new_vert_interp_weights[i] = float3(1.0f - factor, factor, 0.0f);
+    }
+  });
+  threading::parallel_for(triple_points.index_range(), 1024, [&](const IndexRange range) {
+    for (const int i : range) {
+      const int new_vert = points.size() + i;
+      const double3 position = calc_triple_point_position(
+          mesh, perturbation_scale, triple_points[i]);
+      const int3 &tri = mesh.tris[triple_points[i][0]];
+      result.new_positions[new_vert] = position;
+      result.new_vert_interp_verts[new_vert] = tri;
+      result.new_vert_interp_weights[new_vert] = calc_barycentric_weights(
+          mesh.positions[tri[0]], mesh.positions[tri[1]], mesh.positions[tri[2]], position);
+    }
+  });
+  for (const OrderedEdge &edge : intersection_edges) {
+    result.intersection_edges.append({edge.v_low, edge.v_high});
+  }
+  result.success = true;
+  return result;
+}
+
+}  // namespace blender::meshintersect::manifold
@@ -0,0 +1,346 @@
+/* SPDX-FileCopyrightText: 2025 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup bli
+ */
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <memory>
+
+#include "BLI_array.hh"
+#include "BLI_index_mask.hh"
+#include "BLI_math_base.h"
+#include "BLI_math_vector.hh"
+#include "BLI_offset_indices.hh"
+#include "BLI_poisson_disk.hh"
+#include "BLI_task.hh"
+
+#include "atomic_ops.h"
+
+namespace blender::poisson_disk {
+
+/* -------------------------------------------------------------------- */
+/** \name Spatial Hash Grid
+ *
+ * Points are sorted into cells whose size is twice the minimum distance, so all points within the
+ * distance of a point are in the eight cells closest to it. Cells are not stored explicitly,
+ * instead they are hashed into a fixed number of buckets that is proportional to the number of
+ * points.
+ * Different cells that end up in the same bucket only result in more candidates to check.
+ * \{ */
+
+struct HashGrid {
+  double inv_cell_size;
+  int buckets_mask;
+  /** Offsets into the arrays below for every bucket. */
+  Array<int> bucket_offsets;
+  /**
+   * The indices of the points in every bucket, sorted to give a deterministic order. The
+   * positions are stored in the same order, so that iterating over a bucket is cache friendly.
+   */
+  Array<int> indices;
+  Array<float3> positions;
+  /** The inverse of #indices, the position of every point in the arrays above. */
+  Array<int> point_slots;
+
+  int3 cell(const float3 &position) const
+  {
+    /* Clamping is fine for correctness, because it does not increase the distance between cells.
+     * It only avoids overflow for very small distances compared to the positions. */
+    const double limit = double(1 << 30);
+    return int3(std::clamp(std::floor(double(position.x) * this->inv_cell_size), -limit, limit),
+                std::clamp(std::floor(double(position.y) * this->inv_cell_size), -limit, limit),
+                std::clamp(std::floor(double(position.z) * this->inv_cell_size), -limit, limit));
+  }
+
+  int bucket(const int3 &cell) const
+  {
+    const uint32_t hash = uint32_t(cell.x) * 73856093u ^ uint32_t(cell.y) * 19349663u ^
+                          uint32_t(cell.z) * 83492791u;
+    return int(hash & uint32_t(this->buckets_mask));
+  }
+
+  IndexRange bucket_slots(const int bucket) const
+  {
+    return OffsetIndices<int>(this->bucket_offsets)[bucket];
+  }
+};
+
+static void build_hash_grid(const Span<float3> positions,
+                            const float minimum_distance,
+                            HashGrid &grid)
+{
+  /* Make the cells slightly larger to account for floating point precision when comparing the
+   * distance. */
+  grid.inv_cell_size = 1.0 / (double(minimum_distance) * 2.002);
+  const int64_t buckets_num = std::clamp<int64_t>(positions.size(), 1, 1 << 30);
+  grid.buckets_mask = int(power_of_2_max_u(uint32_t(buckets_num))) - 1;
+
+  Array<int> point_buckets(positions.size());
+  threading::parallel_for(positions.index_range(), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      point_buckets[i] = grid.bucket(grid.cell(positions[i]));
+    }
+  });
+
+  grid.bucket_offsets.reinitialize(grid.buckets_mask + 2);
+  grid.bucket_offsets.fill(0);
+  offset_indices::build_reverse_offsets(point_buckets, grid.bucket_offsets);
+  const OffsetIndices<int> offsets(grid.bucket_offsets);
+
+  Array<int> counts(offsets.size(), 0);
+  grid.indices.reinitialize(positions.size());
+  threading::parallel_for(positions.index_range(), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      const int bucket = point_buckets[i];
+      const int index_in_bucket = atomic_fetch_and_add_int32(&counts[bucket], 1);
+      grid.indices[offsets[bucket][index_in_bucket]] = i;
+    }
+  });
+
+  grid.positions.reinitialize(positions.size());
+  grid.point_slots.reinitialize(positions.size());
+  threading::parallel_for(offsets.index_range(), 1024, [&](const IndexRange range) {
+    for (const int bucket : range) {
+      const IndexRange slots = offsets[bucket];
+      MutableSpan<int> indices = grid.indices.as_mutable_span().slice(slots);
+      std::sort(indices.begin(), indices.end());
+      for (const int slot : slots) {
+        const int point_i = grid.indices[slot];
+        grid.positions[slot] = positions[point_i];
+        grid.point_slots[point_i] = slot;
+      }
+    }
+  });
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Elimination
+ *
+ * Whether a point is kept only depends on the points with a lower index within the distance: it
+ * is eliminated when one of them is kept, and kept when all of them are eliminated. So instead of
+ * deciding all points in order, many points can be decided in parallel, as long as the points
+ * they depend on are decided already. Points that can't be decided yet are processed again in
+ * another round, which always decides at least the undecided point with the lowest index. Since
+ * every thread processes its points in order, most points are decided in the first round.
+ *
+ * Like in the serial algorithm, kept points eliminate the points around them. That way, the
+ * points that are eliminated (which is most of them when the candidates are dense) are decided
+ * without searching for a kept point. A point only becomes kept after it eliminated the points
+ * around it, so once all points a point depends on are decided, its own state is final too.
+ * \{ */
+
+enum class PointState : int8_t {
+  Undecided = 0,
+  Kept = 1,
+  Eliminated = 2,
+};
+
+struct EliminationData {
+  const HashGrid &grid;
+  float minimum_distance_sq;
+  /** The state of every point, in the same order as the points in the grid. */
+  MutableSpan<std::atomic<PointState>> states;
+  /**
+   * For every bucket, a slot before which all slots are decided. It is advanced lazily when
+   * the bucket is searched, so that the decided points are not searched again.
+   */
+  MutableSpan<std::atomic<int>> first_undecided_slots;
+};
+
+static int find_first_undecided_slot(EliminationData &data, const int bucket)
+{
+  const IndexRange slots = data.grid.bucket_slots(bucket);
+  std::atomic<int> &first_undecided_slot = data.first_undecided_slots[bucket];
+  const int start_slot = first_undecided_slot.load(std::memory_order_acquire);
+  int slot = start_slot;
+  while (slot < slots.one_after_last() &&
+         data.states[slot].load(std::memory_order_acquire) != PointState::Undecided)
+  {
+    slot++;
+  }
+  /* Only ever move forward, other threads may have advanced further in the meantime. */
+  int expected = start_slot;
+  while (expected < slot && !first_undecided_slot.compare_exchange_weak(
+                                expected, slot, std::memory_order_release))
+  {
+  }
+  return slot;
+}
+
+/** The (up to) eight buckets that may contain points within the distance of the position. */
+static void neighbor_buckets(const HashGrid &grid,
+                             const float3 &position,
+                             MutableSpan<int> r_buckets)
+{
+  /* The cells are twice as large as the distance, so only the cells on the side of the cell
+   * center that the point is on can contain points within the distance. */
+  const int3 cell = grid.cell(position);
+  const double3 cell_position = double3(position) * grid.inv_cell_size;
+  const int3 cell_dir(cell_position.x - double(cell.x) < 0.5 ? -1 : 1,
+                      cell_position.y - double(cell.y) < 0.5 ? -1 : 1,
+                      cell_position.z - double(cell.z) < 0.5 ? -1 : 1);
+  for (const int i : r_buckets.index_range()) {
+    const int3 offset(
+        (i & 1) ? cell_dir.x : 0, (i & 2) ? cell_dir.y : 0, (i & 4) ? cell_dir.z : 0);
+    r_buckets[i] = grid.bucket(cell + offset);
+  }
+}
+
+static void decide_point(EliminationData &data, const int point_i)
+{
+  const HashGrid &grid = data.grid;
+  const int point_slot = grid.point_slots[point_i];
+  const float3 &position = grid.positions[point_slot];
+  if (data.states[point_slot].load(std::memory_order_acquire) != PointState::Undecided) {
+    return;
+  }
+
+  std::array<int, 8> buckets;
+  neighbor_buckets(grid, position, buckets);
+
+  /* Check that all points with a lower index within the distance are decided. */
+  for (const int bucket : buckets) {
+    const IndexRange slots = grid.bucket_slots(bucket);
+    for (int slot = find_first_undecided_slot(data, bucket); slot < slots.one_after_last(); slot++)
+    {
+      if (grid.indices[slot] >= point_i) {
+        break;
+      }
+      if (data.states[slot].load(std::memory_order_acquire) == PointState::Undecided &&
+          math::distance_squared(position, grid.positions[slot]) <= data.minimum_distance_sq)
+      {
+        return;
+      }
+    }
+  }
+
+  /* A kept point within the distance would have eliminated this point already. */
+  if (data.states[point_slot].load(std::memory_order_acquire) == PointState::Eliminated) {
+    return;
+  }
+
+  for (const int bucket : buckets) {
+    const IndexRange slots = grid.bucket_slots(bucket);
+    for (int slot = find_first_undecided_slot(data, bucket); slot < slots.one_after_last(); slot++)
+    {
+      if (grid.indices[slot] <= point_i) {
+        continue;
+      }
+      if (math::distance_squared(position, grid.positions[slot]) <= data.minimum_distance_sq) {
+        /* The other point can't be kept before this point is decided, because it depends on it.
+         * So it's fine to overwrite its state. */
+        data.states[slot].store(PointState::Eliminated, std::memory_order_relaxed);
+      }
+    }
+  }
+  data.states[point_slot].store(PointState::Kept, std::memory_order_release);
+}
+
+/**
+ * Find the kept point with the lowest index within the distance of an eliminated point. Since
+ * points are only eliminated by kept points with a lower index, only those have to be checked.
+ */
+static int find_eliminating_point(const EliminationData &data, const int point_i)
+{
+  const HashGrid &grid = data.grid;
+  const float3 &position = grid.positions[grid.point_slots[point_i]];
+
+  std::array<int, 8> buckets;
+  neighbor_buckets(grid, position, buckets);
+
+  int eliminated_by = -1;
+  for (const int bucket : buckets) {
+    for (const int slot : grid.bucket_slots(bucket)) {
+      const int other_i = grid.indices[slot];
+      if (other_i >= point_i || (eliminated_by != -1 && other_i >= eliminated_by)) {
+        break;
+      }
+      if (data.states[slot].load(std::memory_order_relaxed) == PointState::Kept &&
+          math::distance_squared(position, grid.positions[slot]) <= data.minimum_distance_sq)
+      {
+        /* Slots are sorted by index, so this is the lowest index in the bucket. */
+        eliminated_by = other_i;
+        break;
+      }
+    }
+  }
+  return eliminated_by;
+}
+
+void eliminate_close_points(const Span<float3> positions,
+                            const float minimum_distance,
+                            MutableSpan<bool> elimination_mask)
+{
+  eliminate_close_points(positions, minimum_distance, elimination_mask, {});
+}
+
+void eliminate_close_points(const Span<float3> positions,
+                            const float minimum_distance,
+                            MutableSpan<bool> elimination_mask,
+                            MutableSpan<int> r_eliminated_by)
+{
+  BLI_assert(positions.size() == elimination_mask.size());
+  BLI_assert(r_eliminated_by.is_empty() || r_eliminated_by.size() == positions.size());
+  r_eliminated_by.fill(-1);
+  if (minimum_distance <= 0.0f || positions.is_empty()) {
+    return;
+  }
+
+  HashGrid grid;
+  build_hash_grid(positions, minimum_distance, grid);
+
+  Array<std::atomic<PointState>> states(positions.size());
+  Array<std::atomic<int>> first_undecided_slots(grid.bucket_offsets.size() - 1);
+  EliminationData data{grid, minimum_distance * minimum_distance, states, first_undecided_slots};
+  threading::parallel_for(positions.index_range(), 4096, [&](const IndexRange range) {
+    for (const int slot : range) {
+      states[slot].store(elimination_mask[grid.indices[slot]] ? PointState::Eliminated :
+                                                                 PointState::Undecided,
+                         std::memory_order_relaxed);
+    }
+  });
+  threading::parallel_for(first_undecided_slots.index_range(), 4096, [&](const IndexRange range) {
+    for (const int bucket : range) {
+      first_undecided_slots[bucket].store(grid.bucket_offsets[bucket], std::memory_order_relaxed);
+    }
+  });
+
+  auto memory = std::make_unique<IndexMaskMemory>();
+  IndexMask undecided = IndexMask::from_bools_inverse(
+      positions.index_range(), elimination_mask, *memory);
+  while (!undecided.is_empty()) {
+    undecided.foreach_index(GrainSize(1024), [&](const int i) { decide_point(data, i); });
+    auto new_memory = std::make_unique<IndexMaskMemory>();
+    undecided = IndexMask::from_predicate(
+        undecided, GrainSize(4096), *new_memory, [&](const int i) {
+          return states[grid.point_slots[i]].load(std::memory_order_relaxed) ==
+                 PointState::Undecided;
+        });
+    memory = std::move(new_memory);
+  }
+
+  threading::parallel_for(positions.index_range(), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      if (elimination_mask[i]) {
+        continue;
+      }
+      if (states[grid.point_slots[i]].load(std::memory_order_relaxed) == PointState::Eliminated) {
+        elimination_mask[i] = true;
+        if (!r_eliminated_by.is_empty()) {
+          r_eliminated_by[i] = find_eliminating_point(data, i);
+        }
+      }
+    }
+  });
+}
+
+/** \} */
+
+}  // namespace blender::poisson_disk
@@ -11,6 +11,7 @@
 #include "MEM_guardedalloc.h"
 
 #include "BLI_task.h"
+#include "BLI_task_trace.hh"
 
 #include <memory>
 #include <vector>
@@ -77,6 +78,8 @@ struct TaskNode {
 #ifdef WITH_TBB
   tbb::flow::continue_msg run(const tbb::flow::continue_msg /*input*/)
   {
+    const blender::threading::trace::ScopedEvent trace_event{
+        blender::threading::trace::EventType::TaskGraphNode, reinterpret_cast<void *>(run_func)};
     run_func(task_data);
     return tbb::flow::continue_msg();
   }
@@ -19,6 +19,7 @@
 
 #include "BLI_mempool.h"
 #include "BLI_task.h"
+#include "BLI_task_trace.hh"
 #include "BLI_threads.h"
 
 #ifdef WITH_TBB
@@ -169,6 +170,8 @@ struct TaskPool {
 /* Execute task. */
 void Task::operator()() const
 {
+  const blender::threading::trace::ScopedEvent trace_event{
+      blender::threading::trace::EventType::TaskPoolTask, reinterpret_cast<void *>(run)};
   run(pool, taskdata);
 }
 
@@ -471,6 +474,8 @@ void BLI_task_pool_push(TaskPool *pool,
 
 void BLI_task_pool_work_and_wait(TaskPool *pool)
 {
+  const blender::threading::trace::ScopedEvent trace_event{
+      blender::threading::trace::EventType::TaskPoolWait, nullptr};
   switch (pool->type) {
     case TASK_POOL_TBB:
     case TASK_POOL_TBB_SUSPENDED:
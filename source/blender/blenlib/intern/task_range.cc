@@ -17,6 +17,7 @@
 #include "BLI_offset_indices.hh"
 #include "BLI_task.h"
 #include "BLI_task.hh"
+#include "BLI_task_trace.hh"
 #include "BLI_threads.h"
 #include "BLI_vector.hh"
 
@@ -81,6 +82,8 @@ struct RangeTask {
 
   void operator()(const tbb::blocked_range<int> &r) const
   {
+    const blender::threading::trace::ScopedEvent trace_event{
+        blender::threading::trace::EventType::ParallelRangeTask, reinterpret_cast<void *>(func)};
     TaskParallelTLS tls;
     tls.userdata_chunk = userdata_chunk;
     for (int i = r.begin(); i != r.end(); ++i) {
@@ -246,13 +249,12 @@ static void parallel_for_impl_accumulated_size_lookup(
       });
 }
 
-void parallel_for_impl(const IndexRange range,
-                       const int64_t grain_size,
-                       const FunctionRef<void(IndexRange)> function,
-                       const TaskSizeHints &size_hints)
+static void parallel_for_impl_dispatch(const IndexRange range,
+                                       const int64_t grain_size,
+                                       const FunctionRef<void(IndexRange)> function,
+                                       const TaskSizeHints &size_hints)
 {
 #ifdef WITH_TBB
-  lazy_threading::send_hint();
   switch (size_hints.type) {
     case TaskSizeHints::Type::Static: {
       const int64_t task_size = static_cast<const detail::TaskSizeHints_Static &>(size_hints).size;
@@ -286,6 +288,32 @@ void parallel_for_impl(const IndexRange range,
 #endif
 }
 
+void parallel_for_impl(const IndexRange range,
+                       const int64_t grain_size,
+                       const FunctionRef<void(IndexRange)> function,
+                       const TaskSizeHints &size_hints,
+                       const trace::SourceLocation &location)
+{
+#ifdef WITH_TBB
+  lazy_threading::send_hint();
+#endif
+  if (trace::is_enabled()) {
+    const trace::ScopedEvent trace_event{
+        trace::EventType::ParallelFor, location, range.size(), grain_size};
+    parallel_for_impl_dispatch(
+        range,
+        grain_size,
+        [&](const IndexRange sub_range) {
+          const trace::ScopedEvent task_trace_event{
+              trace::EventType::ParallelForTask, location, sub_range.size(), grain_size};
+          function(sub_range);
+        },
+        size_hints);
+    return;
+  }
+  parallel_for_impl_dispatch(range, grain_size, function, size_hints);
+}
+
 void memory_bandwidth_bound_task_impl(const FunctionRef<void()> function)
 {
 #ifdef WITH_TBB
@@ -0,0 +1,330 @@
+/* SPDX-FileCopyrightText: 2025 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup bli
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "BLI_fileops.hh"
+#include "BLI_path_utils.hh"
+#include "BLI_task_trace.hh"
+
+namespace blender::threading::trace {
+
+namespace detail {
+std::atomic<bool> is_enabled = false;
+}
+
+/* -------------------------------------------------------------------- */
+/** \name Per-Thread Ring Buffers
+ * \{ */
+
+struct Event {
+  int64_t start_ns;
+  int64_t end_ns;
+  SourceLocation location;
+  const void *function;
+  int64_t size;
+  int64_t grain_size;
+  EventType type;
+};
+
+/**
+ * The events recorded by one thread since tracing was enabled. Only the thread that owns the block
+ * writes to it, so recording doesn't need a lock. The export reads the events concurrently and
+ * uses the event counters like a sequence lock to detect the ones that were overwritten in the
+ * meantime.
+ */
+struct EventBlock {
+  /** The #TraceState::epoch in which the block was allocated. */
+  uint64_t epoch = 0;
+  int64_t capacity = 0;
+  std::unique_ptr<Event[]> events;
+  /** Number of events whose recording started, may be larger than capacity. */
+  std::atomic<int64_t> started = 0;
+  /** Number of events that were recorded completely. */
+  std::atomic<int64_t> written = 0;
+};
+
+/**
+ * The buffers are never freed, because the threads keep a pointer to them.
+ * The standard allocator is used on purpose, the buffers are not freed before the memory leak
+ * detection runs.
+ */
+struct ThreadBuffer {
+  /** Read without locking, only replaced by the owning thread with #TraceState::mutex locked. */
+  std::atomic<EventBlock *> block = nullptr;
+  std::unique_ptr<EventBlock> block_owner;
+};
+
+struct TraceState {
+  /** Protects the list of buffers, replacing blocks and freeing the retired ones. */
+  std::mutex mutex;
+  std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+  /**
+   * Blocks that were replaced by their thread. They may still be read by an export, so they are
+   * only freed when tracing is enabled again.
+   */
+  std::vector<std::unique_ptr<EventBlock>> retired_blocks;
+  /** Incremented by #enable, blocks of previous epochs are replaced on the next event. */
+  std::atomic<uint64_t> epoch = 0;
+  /** Read by all threads without locking, only changed by #enable. */
+  std::atomic<int64_t> begin_time_ns = 0;
+  std::atomic<int64_t> events_per_thread = 0;
+};
+
+static TraceState &get_trace_state()
+{
+  static TraceState state;
+  return state;
+}
+
+static int64_t steady_clock_ns()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+static int64_t now_ns()
+{
+  return steady_clock_ns() - get_trace_state().begin_time_ns.load(std::memory_order_relaxed);
+}
+
+static thread_local ThreadBuffer *thread_buffer = nullptr;
+
+static ThreadBuffer &ensure_thread_buffer()
+{
+  if (thread_buffer == nullptr) {
+    TraceState &state = get_trace_state();
+    std::lock_guard lock{state.mutex};
+    state.buffers.push_back(std::make_unique<ThreadBuffer>());
+    thread_buffer = state.buffers.back().get();
+  }
+  return *thread_buffer;
+}
+
+/**
+ * Get the block of the current epoch. The block is allocated lazily, so that threads that don't
+ * run tasks don't use memory.
+ */
+static EventBlock &ensure_event_block(ThreadBuffer &buffer)
+{
+  TraceState &state = get_trace_state();
+  EventBlock *block = buffer.block.load(std::memory_order_relaxed);
+  if (block != nullptr && block->epoch == state.epoch.load(std::memory_order_relaxed)) {
+    return *block;
+  }
+  std::lock_guard lock{state.mutex};
+  std::unique_ptr<EventBlock> new_block = std::make_unique<EventBlock>();
+  new_block->epoch = state.epoch.load(std::memory_order_acquire);
+  new_block->capacity = state.events_per_thread.load(std::memory_order_relaxed);
+  new_block->events = std::make_unique<Event[]>(size_t(new_block->capacity));
+  if (buffer.block_owner) {
+    state.retired_blocks.push_back(std::move(buffer.block_owner));
+  }
+  buffer.block_owner = std::move(new_block);
+  buffer.block.store(buffer.block_owner.get(), std::memory_order_release);
+  return *buffer.block_owner;
+}
+
+void ScopedEvent::begin(const EventType type,
+                        const SourceLocation &location,
+                        const void *function,
+                        const int64_t size,
+                        const int64_t grain_size)
+{
+  type_ = type;
+  location_ = location;
+  function_ = function;
+  size_ = size;
+  grain_size_ = grain_size;
+  start_ns_ = now_ns();
+}
+
+void ScopedEvent::end()
+{
+  const int64_t end_ns = now_ns();
+  EventBlock &block = ensure_event_block(ensure_thread_buffer());
+  const int64_t written = block.written.load(std::memory_order_relaxed);
+  /* Announce the write before changing the event, so that a concurrent export can detect that
+   * the slot was overwritten while copying it. */
+  block.started.store(written + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  Event &event = block.events[written % block.capacity];
+  event.start_ns = start_ns_;
+  event.end_ns = end_ns;
+  event.location = location_;
+  event.function = function_;
+  event.size = size_;
+  event.grain_size = grain_size_;
+  event.type = type_;
+  block.written.store(written + 1, std::memory_order_release);
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Recording Control
+ * \{ */
+
+void enable(const int64_t events_per_thread)
+{
+  TraceState &state = get_trace_state();
+  std::lock_guard lock{state.mutex};
+  state.events_per_thread.store(std::max<int64_t>(events_per_thread, 1),
+                                std::memory_order_relaxed);
+  state.begin_time_ns.store(steady_clock_ns(), std::memory_order_relaxed);
+  /* The previous events are removed by replacing the blocks of all threads on their next event,
+   * possibly with a different capacity. No export runs concurrently, so the blocks which were
+   * replaced since the last call can be freed. */
+  state.epoch.fetch_add(1, std::memory_order_release);
+  state.retired_blocks.clear();
+  detail::is_enabled.store(true, std::memory_order_relaxed);
+}
+
+void disable()
+{
+  detail::is_enabled.store(false, std::memory_order_relaxed);
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Chrome Trace Export
+ * \{ */
+
+static const char *event_type_name(const EventType type)
+{
+  switch (type) {
+    case EventType::ParallelFor:
+      return "parallel_for";
+    case EventType::ParallelForTask:
+      return "parallel_for task";
+    case EventType::ParallelRangeTask:
+      return "parallel_range task";
+    case EventType::TaskPoolTask:
+      return "task_pool task";
+    case EventType::TaskPoolWait:
+      return "task_pool wait";
+    case EventType::TaskGraphNode:
+      return "task_graph node";
+  }
+  BLI_assert_unreachable();
+  return "";
+}
+
+static std::string escape_json(const StringRef str)
+{
+  std::string result;
+  result.reserve(str.size());
+  for (const char c : str) {
+    if (c == '"' || c == '\\') {
+      result += '\\';
+      result += c;
+    }
+    else if (uint8_t(c) < 0x20) {
+      result += fmt::format("\\u{:04x}", int(c));
+    }
+    else {
+      result += c;
+    }
+  }
+  return result;
+}
+
+static std::string event_name(const Event &event)
+{
+  if (event.location.function) {
+    return escape_json(fmt::format("{} ({}:{})",
+                                   event.location.function,
+                                   BLI_path_basename(event.location.file),
+                                   event.location.line));
+  }
+  return event_type_name(event.type);
+}
+
+bool write_chrome_trace(const StringRefNull filepath)
+{
+  TraceState &state = get_trace_state();
+  std::lock_guard lock{state.mutex};
+
+  fstream stream(filepath, std::ios::out | std::ios::trunc);
+  if (!stream.is_open()) {
+    return false;
+  }
+  stream << "{\"traceEvents\":[\n";
+  bool is_first = true;
+  std::vector<Event> events;
+  for (const int thread_i : IndexRange(int64_t(state.buffers.size()))) {
+    const EventBlock *block = state.buffers[thread_i]->block.load(std::memory_order_acquire);
+    if (block == nullptr || block->epoch != state.epoch.load(std::memory_order_relaxed)) {
+      continue;
+    }
+    /* Copy the events, so that the thread isn't blocked while the file is written. The thread
+     * keeps recording in the meantime, so events which it started to overwrite while they were
+     * copied are dropped afterwards. */
+    const int64_t written = block->written.load(std::memory_order_acquire);
+    const int64_t copied_num = std::min(written, block->capacity);
+    events.clear();
+    for (const int64_t i : IndexRange(written - copied_num, copied_num)) {
+      events.push_back(block->events[i % block->capacity]);
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    const int64_t started_after_copy = block->started.load(std::memory_order_relaxed);
+    const int64_t overwritten_num = std::clamp<int64_t>(
+        started_after_copy - block->capacity - (written - copied_num), 0, copied_num);
+    events.erase(events.begin(), events.begin() + overwritten_num);
+    if (events.empty()) {
+      continue;
+    }
+    stream << (is_first ? "" : ",\n")
+           << fmt::format(
+                  "{{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":{0},"
+                  "\"args\":{{\"name\":\"Thread {0}\"}}}}",
+                  thread_i);
+    is_first = false;
+
+    for (const Event &event : events) {
+      stream << fmt::format(
+          ",\n{{\"name\":\"{}\",\"cat\":\"{}\",\"ph\":\"X\",\"pid\":1,\"tid\":{},"
+          "\"ts\":{:.3f},\"dur\":{:.3f},\"args\":{{",
+          event_name(event),
+          event_type_name(event.type),
+          thread_i,
+          double(event.start_ns) / 1000.0,
+          double(event.end_ns - event.start_ns) / 1000.0);
+      if (event.function) {
+        stream << fmt::format("\"function\":\"{}\"", fmt::ptr(event.function));
+      }
+      else if (event.location.function) {
+        stream << fmt::format("\"size\":{},\"grain_size\":{}", event.size, event.grain_size);
+      }
+      stream << "}}";
+    }
+    if (written > int64_t(events.size())) {
+      /* The ring buffer overwrote the oldest events. */
+      stream << fmt::format(
+          ",\n{{\"name\":\"{} events dropped\",\"ph\":\"i\",\"s\":\"t\",\"pid\":1,\"tid\":{},"
+          "\"ts\":{:.3f}}}",
+          written - int64_t(events.size()),
+          thread_i,
+          double(events.front().start_ns) / 1000.0);
+    }
+  }
+  stream << "\n],\"displayTimeUnit\":\"ms\"}\n";
+  return !stream.fail();
+}
+
+/** \} */
+
+}  // namespace blender::threading::trace
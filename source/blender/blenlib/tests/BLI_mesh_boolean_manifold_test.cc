@@ -0,0 +1,291 @@
+/* SPDX-FileCopyrightText: 2025 Blender Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#include "testing/testing.h"
+
+#include "BLI_map.hh"
+#include "BLI_math_base.hh"
+#include "BLI_math_vector.hh"
+#include "BLI_mesh_boolean_manifold.hh"
+#include "BLI_timeit.hh"
+#include "BLI_vector.hh"
+
+#define DO_PERF_TESTS 0
+
+namespace blender::meshintersect::manifold::tests {
+
+struct TestMesh {
+  Vector<double3> positions;
+  Vector<int3> tris;
+  Vector<int> tri_shapes;
+  int shapes_num = 0;
+
+  void add_cube(const double3 &min, const double size)
+  {
+    const int start = this->positions.size();
+    for (const int i : IndexRange(8)) {
+      this->positions.append(min + size * double3(i & 1, (i >> 1) & 1, (i >> 2) & 1));
+    }
+    const int3 cube_tris[12] = {{0, 2, 3},
+                                {0, 3, 1},
+                                {4, 5, 7},
+                                {4, 7, 6},
+                                {0, 1, 5},
+                                {0, 5, 4},
+                                {2, 6, 7},
+                                {2, 7, 3},
+                                {0, 4, 6},
+                                {0, 6, 2},
+                                {1, 3, 7},
+                                {1, 7, 5}};
+    for (const int3 &tri : cube_tris) {
+      this->tris.append(tri + int3(start));
+      this->tri_shapes.append(this->shapes_num);
+    }
+    this->shapes_num++;
+  }
+
+  /** A UV sphere with `2 * segments * (rings - 1)` triangles. */
+  void add_sphere(const double3 &center,
+                  const double radius,
+                  const int rings,
+                  const int segments)
+  {
+    const int start = this->positions.size();
+    for (const int ring : IndexRange(1, rings - 1)) {
+      const double theta = M_PI * ring / rings;
+      for (const int segment : IndexRange(segments)) {
+        const double phi = 2.0 * M_PI * segment / segments;
+        this->positions.append(
+            center + radius * double3(std::sin(theta) * std::cos(phi),
+                                      std::sin(theta) * std::sin(phi),
+                                      std::cos(theta)));
+      }
+    }
+    const int top = this->positions.append_and_get_index(center + double3(0.0, 0.0, radius));
+    const int bottom = this->positions.append_and_get_index(center - double3(0.0, 0.0, radius));
+    auto vert = [&](const int ring, const int segment) {
+      return start + (ring - 1) * segments + segment % segments;
+    };
+    auto add_tri = [&](const int3 &tri) {
+      this->tris.append(tri);
+      this->tri_shapes.append(this->shapes_num);
+    };
+    for (const int segment : IndexRange(segments)) {
+      add_tri({top, vert(1, segment), vert(1, segment + 1)});
+      for (const int ring : IndexRange(1, rings - 2)) {
+        const int a = vert(ring, segment);
+        const int b = vert(ring + 1, segment);
+        const int c = vert(ring + 1, segment + 1);
+        const int d = vert(ring, segment + 1);
+        add_tri({a, b, c});
+        add_tri({a, c, d});
+      }
+      add_tri({bottom, vert(rings - 1, segment + 1), vert(rings - 1, segment)});
+    }
+    this->shapes_num++;
+  }
+
+  TriMesh as_tri_mesh() const
+  {
+    return {this->positions, this->tris, this->tri_shapes, this->shapes_num};
+  }
+};
+
+/** Collect the result triangles, oriented as in the result. */
+static Vector<int3> result_tris(const TestMesh &mesh, const BooleanResult &result)
+{
+  Vector<int3> tris;
+  for (const int tri_i : mesh.tris.index_range()) {
+    const int3 &tri = mesh.tris[tri_i];
+    switch (result.tri_results[tri_i]) {
+      case TriResult::Removed:
+      case TriResult::Split:
+        break;
+      case TriResult::Kept:
+        tris.append(tri);
+        break;
+      case TriResult::KeptFlipped:
+        tris.append({tri[0], tri[2], tri[1]});
+        break;
+    }
+  }
+  tris.extend(result.split_tris);
+  return tris;
+}
+
+static double result_volume(const TestMesh &mesh, const BooleanResult &result)
+{
+  auto position = [&](const int vert) {
+    return vert < mesh.positions.size() ? mesh.positions[vert] :
+                                          result.new_positions[vert - mesh.positions.size()];
+  };
+  double volume = 0.0;
+  for (const int3 &tri : result_tris(mesh, result)) {
+    volume += math::dot(position(tri[0]), math::cross(position(tri[1]), position(tri[2])));
+  }
+  return volume / 6.0;
+}
+
+/** Every directed edge has to be matched by exactly one edge in the opposite direction. */
+static bool result_is_closed_manifold(const TestMesh &mesh, const BooleanResult &result)
+{
+  Map<int2, int> directed_edges;
+  for (const int3 &tri : result_tris(mesh, result)) {
+    for (const int i : IndexRange(3)) {
+      directed_edges.lookup_or_add(int2(tri[i], tri[(i + 1) % 3]), 0)++;
+    }
+  }
+  for (const auto item : directed_edges.items()) {
+    if (item.value != 1 || directed_edges.lookup_default(int2(item.key[1], item.key[0]), 0) != 1)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+static void test_operations(const TestMesh &mesh,
+                            const double union_volume,
+                            const double intersect_volume,
+                            const double difference_volume)
+{
+  const std::pair<Operation, double> expected[3] = {{Operation::Union, union_volume},
+                                                    {Operation::Intersect, intersect_volume},
+                                                    {Operation::Difference, difference_volume}};
+  for (const auto &[operation, volume] : expected) {
+    const BooleanResult result = boolean_trimesh(mesh.as_tri_mesh(), operation);
+    EXPECT_TRUE(result.success);
+    EXPECT_NEAR(result_volume(mesh, result), volume, 1e-5);
+    EXPECT_TRUE(result_is_closed_manifold(mesh, result));
+  }
+}
+
+TEST(mesh_boolean_manifold, CubesGeneralPosition)
+{
+  TestMesh mesh;
+  mesh.add_cube({0.0, 0.0, 0.0}, 1.0);
+  mesh.add_cube({0.5, 0.25, 0.375}, 1.0);
+  const double overlap = 0.5 * 0.75 * 0.625;
+  test_operations(mesh, 2.0 - overlap, overlap, 1.0 - overlap);
+}
+
+TEST(mesh_boolean_manifold, CubesCoplanarFaces)
+{
+  TestMesh mesh;
+  mesh.add_cube({0.0, 0.0, 0.0}, 1.0);
+  mesh.add_cube({0.5, 0.0, 0.0}, 1.0);
+  test_operations(mesh, 1.5, 0.5, 0.5);
+}
+
+TEST(mesh_boolean_manifold, CubesDisjoint)
+{
+  TestMesh mesh;
+  mesh.add_cube({0.0, 0.0, 0.0}, 1.0);
+  mesh.add_cube({3.0, 0.0, 0.0}, 1.0);
+  test_operations(mesh, 2.0, 0.0, 1.0);
+}
+
+TEST(mesh_boolean_manifold, CubesNested)
+{
+  TestMesh mesh;
+  mesh.add_cube({0.0, 0.0, 0.0}, 3.0);
+  mesh.add_cube({1.0, 1.0, 1.0}, 1.0);
+  test_operations(mesh, 27.0, 1.0, 26.0);
+}
+
+TEST(mesh_boolean_manifold, ThreeCubes)
+{
+  TestMesh mesh;
+  mesh.add_cube({0.0, 0.0, 0.0}, 2.0);
+  mesh.add_cube({1.5, 0.5, 0.5}, 1.0);
+  mesh.add_cube({-0.5, 0.5, 0.5}, 1.0);
+  /* Both small cubes stick out of the big one by half their volume. */
+  test_operations(mesh, 9.0, 0.0, 7.0);
+}
+
+TEST(mesh_boolean_manifold, ThreeCubesTriplePoints)
+{
+  TestMesh mesh;
+  mesh.add_cube({0.0, 0.0, 0.0}, 1.0);
+  mesh.add_cube({0.5, 0.25, 0.125}, 1.0);
+  mesh.add_cube({0.25, 0.5, 0.375}, 1.0);
+  /* Faces of all three cubes meet in single points, so the intersections cross. */
+  const double overlap_01 = 0.5 * 0.75 * 0.875;
+  const double overlap_02 = 0.75 * 0.5 * 0.625;
+  const double overlap_12 = 0.75 * 0.75 * 0.75;
+  const double overlap_012 = 0.5 * 0.5 * 0.625;
+  test_operations(mesh,
+                  3.0 - overlap_01 - overlap_02 - overlap_12 + overlap_012,
+                  overlap_012,
+                  1.0 - overlap_01 - overlap_02 + overlap_012);
+}
+
+/**
+ * The new vertices of cubes with coordinates on a grid have to lie on the grid as well. The
+ * perturbation used to resolve the coplanar faces must not move them.
+ */
+static void expect_positions_on_grid(const TestMesh &mesh, const double grid_size)
+{
+  for (const Operation operation : {Operation::Union, Operation::Intersect, Operation::Difference})
+  {
+    const BooleanResult result = boolean_trimesh(mesh.as_tri_mesh(), operation);
+    EXPECT_TRUE(result.success);
+    for (const double3 &position : result.new_positions) {
+      for (const int i : IndexRange(3)) {
+        const double value = position[i] / grid_size;
+        EXPECT_NEAR(value, math::round(value), 1e-12) << position;
+      }
+    }
+  }
+}
+
+TEST(mesh_boolean_manifold, PositionsUnperturbed)
+{
+  TestMesh coplanar;
+  coplanar.add_cube({0.0, 0.0, 0.0}, 1.0);
+  coplanar.add_cube({0.5, 0.0, 0.0}, 1.0);
+  coplanar.add_cube({0.25, 0.5, 0.0}, 1.0);
+  expect_positions_on_grid(coplanar, 0.25);
+
+  TestMesh triple_points;
+  triple_points.add_cube({0.0, 0.0, 0.0}, 1.0);
+  triple_points.add_cube({0.5, 0.25, 0.125}, 1.0);
+  triple_points.add_cube({0.25, 0.5, 0.375}, 1.0);
+  expect_positions_on_grid(triple_points, 0.125);
+}
+
+TEST(mesh_boolean_manifold, NonManifoldFails)
+{
+  TestMesh mesh;
+  mesh.add_cube({0.0, 0.0, 0.0}, 1.0);
+  mesh.add_cube({0.5, 0.5, 0.5}, 1.0);
+  mesh.tris.remove_last();
+  mesh.tri_shapes.remove_last();
+  const BooleanResult result = boolean_trimesh(mesh.as_tri_mesh(), Operation::Union);
+  EXPECT_FALSE(result.success);
+}
+
+#if DO_PERF_TESTS
+/** Two overlapping spheres with about a million triangles in total. */
+TEST(mesh_boolean_manifold, PerfSpheres)
+{
+  TestMesh mesh;
+  mesh.add_sphere({0.0, 0.0, 0.0}, 1.0, 354, 708);
+  mesh.add_sphere({0.5, 0.25, 0.125}, 1.0, 354, 708);
+  std::cout << "Triangles: " << mesh.tris.size() << "\n";
+  for (const Operation operation : {Operation::Union, Operation::Intersect, Operation::Difference})
+  {
+    BooleanResult result;
+    {
+      SCOPED_TIMER("boolean_trimesh");
+      result = boolean_trimesh(mesh.as_tri_mesh(), operation);
+    }
+    EXPECT_TRUE(result.success);
+    EXPECT_TRUE(result_is_closed_manifold(mesh, result));
+  }
+}
+#endif
+
+}  // namespace blender::meshintersect::manifold::tests
@@ -0,0 +1,151 @@
+/* SPDX-FileCopyrightText: 2025 Blender Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#include "testing/testing.h"
+
+#include "BLI_array.hh"
+#include "BLI_kdtree.h"
+#include "BLI_math_vector.hh"
+#include "BLI_poisson_disk.hh"
+#include "BLI_rand.hh"
+
+namespace blender::poisson_disk::tests {
+
+/** The serial elimination that #eliminate_close_points has to give the same result as. */
+static void eliminate_close_points_serial(const Span<float3> positions,
+                                          const float minimum_distance,
+                                          MutableSpan<bool> elimination_mask)
+{
+  KDTree_3d *kdtree = BLI_kdtree_3d_new(positions.size());
+  for (const int i : positions.index_range()) {
+    BLI_kdtree_3d_insert(kdtree, i, positions[i]);
+  }
+  BLI_kdtree_3d_balance(kdtree);
+  for (const int i : positions.index_range()) {
+    if (elimination_mask[i]) {
+      continue;
+    }
+    KDTreeNearest_3d *nearest = nullptr;
+    const int nearest_num = BLI_kdtree_3d_range_search(
+        kdtree, positions[i], &nearest, minimum_distance);
+    for (const int nearest_i : IndexRange(nearest_num)) {
+      if (nearest[nearest_i].index != i) {
+        elimination_mask[nearest[nearest_i].index] = true;
+      }
+    }
+    if (nearest) {
+      MEM_freeN(nearest);
+    }
+  }
+  BLI_kdtree_3d_free(kdtree);
+}
+
+static Array<float3> random_points_on_plane(const int num, const float size, const int seed)
+{
+  RandomNumberGenerator rng(seed);
+  Array<float3> positions(num);
+  for (float3 &position : positions) {
+    position = float3(rng.get_float() * size, rng.get_float() * size, 0.0f);
+  }
+  return positions;
+}
+
+static void test_matches_serial(const Span<float3> positions, const float minimum_distance)
+{
+  Array<bool> expected(positions.size(), false);
+  eliminate_close_points_serial(positions, minimum_distance, expected);
+  Array<bool> result(positions.size(), false);
+  eliminate_close_points(positions, minimum_distance, result);
+  EXPECT_EQ_ARRAY(expected.data(), result.data(), positions.size());
+}
+
+TEST(poisson_disk, MatchesSerialOnPlane)
+{
+  const Array<float3> positions = random_points_on_plane(20000, 1.0f, 5);
+  test_matches_serial(positions, 0.001f);
+  test_matches_serial(positions, 0.01f);
+  test_matches_serial(positions, 0.1f);
+}
+
+TEST(poisson_disk, MatchesSerialInVolume)
+{
+  RandomNumberGenerator rng(3);
+  Array<float3> positions(20000);
+  for (float3 &position : positions) {
+    position = float3(rng.get_float(), rng.get_float(), rng.get_float()) * 10.0f - 5.0f;
+  }
+  test_matches_serial(positions, 0.5f);
+}
+
+TEST(poisson_disk, MinimumDistance)
+{
+  const Array<float3> positions = random_points_on_plane(5000, 1.0f, 7);
+  const float minimum_distance = 0.05f;
+  Array<bool> elimination_mask(positions.size(), false);
+  eliminate_close_points(positions, minimum_distance, elimination_mask);
+  for (const int i : positions.index_range()) {
+    if (elimination_mask[i]) {
+      continue;
+    }
+    for (const int j : positions.index_range().drop_front(i + 1)) {
+      if (!elimination_mask[j]) {
+        EXPECT_GT(math::distance(positions[i], positions[j]), minimum_distance);
+      }
+    }
+  }
+}
+
+TEST(poisson_disk, AlreadyEliminated)
+{
+  const Array<float3> positions = {{0.0f, 0.0f, 0.0f}, {0.5f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}};
+  Array<bool> elimination_mask = {true, false, false};
+  eliminate_close_points(positions, 0.6f, elimination_mask);
+  EXPECT_TRUE(elimination_mask[0]);
+  EXPECT_FALSE(elimination_mask[1]);
+  EXPECT_TRUE(elimination_mask[2]);
+}
+
+TEST(poisson_disk, SmallDistanceFarFromOrigin)
+{
+  Array<float3> positions = random_points_on_plane(2000, 1e-3f, 11);
+  for (float3 &position : positions) {
+    position += float3(1e5f, -1e5f, 1e5f);
+  }
+  test_matches_serial(positions, 1e-5f);
+}
+
+TEST(poisson_disk, EliminatedByMatchesDuplicates)
+{
+  RandomNumberGenerator rng(13);
+  Array<float3> positions(20000);
+  for (float3 &position : positions) {
+    position = float3(rng.get_float(), rng.get_float(), rng.get_float());
+  }
+  const float distance = 0.02f;
+
+  KDTree_3d *kdtree = BLI_kdtree_3d_new(positions.size());
+  for (const int i : positions.index_range()) {
+    BLI_kdtree_3d_insert(kdtree, i, positions[i]);
+  }
+  BLI_kdtree_3d_balance(kdtree);
+  Array<int> duplicates(positions.size(), -1);
+  BLI_kdtree_3d_calc_duplicates_fast(kdtree, distance, true, duplicates.data());
+  BLI_kdtree_3d_free(kdtree);
+
+  Array<bool> elimination_mask(positions.size(), false);
+  Array<int> eliminated_by(positions.size());
+  eliminate_close_points(positions, distance, elimination_mask, eliminated_by);
+  for (const int i : positions.index_range()) {
+    if (ELEM(duplicates[i], -1, i)) {
+      EXPECT_FALSE(elimination_mask[i]);
+      EXPECT_EQ(eliminated_by[i], -1);
+    }
+    else {
+      EXPECT_TRUE(elimination_mask[i]);
+      EXPECT_EQ(eliminated_by[i], duplicates[i]);
+    }
+  }
+}
+
+}  // namespace blender::poisson_disk::tests
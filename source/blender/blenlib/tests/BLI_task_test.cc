@@ -5,15 +5,22 @@
 #include "testing/testing.h"
 #include <atomic>
 #include <cstring>
+#include <sstream>
+#include <thread>
 
 #include "atomic_ops.h"
 
 #include "MEM_guardedalloc.h"
 
+#include "BLI_fileops.h"
+#include "BLI_fileops.hh"
 #include "BLI_listbase.h"
 #include "BLI_mempool.h"
+#include "BLI_path_utils.hh"
 #include "BLI_task.h"
 #include "BLI_task.hh"
+#include "BLI_task_trace.hh"
+#include "BLI_tempfile.h"
 
 #define ITEMS_NUM 10000
 
@@ -243,3 +250,76 @@ TEST(task, ParallelInvoke)
                                       [&]() { counter++; });
   EXPECT_EQ(counter, 6);
 }
+
+TEST(task, TraceParallelFor)
+{
+  using namespace blender;
+  std::atomic<int> counter = 0;
+  threading::trace::enable();
+  threading::parallel_for(IndexRange(ITEMS_NUM), 100, [&](const IndexRange range) {
+    counter += int(range.size());
+  });
+  threading::trace::disable();
+  EXPECT_EQ(counter, ITEMS_NUM);
+
+  /* Not recorded anymore. */
+  threading::parallel_for(IndexRange(ITEMS_NUM), 100, [&](const IndexRange /*range*/) {});
+
+  char filepath[FILE_MAX];
+  BLI_temp_directory_path_get(filepath, sizeof(filepath));
+  BLI_path_append(filepath, sizeof(filepath), "blender_task_trace_test.json");
+  EXPECT_TRUE(threading::trace::write_chrome_trace(filepath));
+
+  std::stringstream buffer;
+  {
+    fstream stream(filepath, std::ios::in);
+    buffer << stream.rdbuf();
+  }
+  BLI_delete(filepath, false, false);
+  const std::string trace = buffer.str();
+
+  EXPECT_EQ(trace.find("{\"traceEvents\":["), 0);
+  EXPECT_NE(trace.find("\"cat\":\"parallel_for\""), std::string::npos);
+  EXPECT_NE(trace.find("\"grain_size\":100"), std::string::npos);
+  EXPECT_NE(trace.find("BLI_task_test.cc"), std::string::npos);
+  /* The first loop is split into many tasks, but is only recorded once. */
+  int tasks_num = 0;
+  int loops_num = 0;
+  for (size_t pos = trace.find("\"cat\":"); pos != std::string::npos;
+       pos = trace.find("\"cat\":", pos + 1))
+  {
+    if (trace.compare(pos, 20, "\"cat\":\"parallel_for\"") == 0) {
+      loops_num++;
+    }
+    else if (trace.compare(pos, 25, "\"cat\":\"parallel_for task\"") == 0) {
+      tasks_num++;
+    }
+  }
+  EXPECT_EQ(loops_num, 1);
+  EXPECT_GE(tasks_num, 1);
+}
+
+TEST(task, TraceEnableWhileRunning)
+{
+  using namespace blender;
+  /* Enabling tracing again and writing the trace must be safe while other threads record events,
+   * even when the capacity of the buffers changes. */
+  std::atomic<bool> stop = false;
+  std::thread worker([&]() {
+    while (!stop) {
+      threading::parallel_for(IndexRange(ITEMS_NUM), 100, [&](const IndexRange /*range*/) {});
+    }
+  });
+
+  char filepath[FILE_MAX];
+  BLI_temp_directory_path_get(filepath, sizeof(filepath));
+  BLI_path_append(filepath, sizeof(filepath), "blender_task_trace_running_test.json");
+  for (const int i : IndexRange(20)) {
+    threading::trace::enable(16 + i);
+    EXPECT_TRUE(threading::trace::write_chrome_trace(filepath));
+  }
+  stop = true;
+  worker.join();
+  threading::trace::disable();
+  BLI_delete(filepath, false, false);
+}
@@ -0,0 +1,115 @@
+/* SPDX-FileCopyrightText: 2025 Blender Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#include "testing/testing.h"
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_array.hh"
+#include "BLI_kdtree.h"
+#include "BLI_poisson_disk.hh"
+#include "BLI_rand.hh"
+#include "BLI_timeit.hh"
+
+using namespace blender;
+
+/* Run the tests with the largest number of points. */
+// #define USE_BIG_TESTS
+
+/** The KD-tree based elimination that was used before #poisson_disk::eliminate_close_points. */
+static void eliminate_close_points_kdtree(const Span<float3> positions,
+                                          const float minimum_distance,
+                                          MutableSpan<bool> elimination_mask)
+{
+  KDTree_3d *kdtree = BLI_kdtree_3d_new(positions.size());
+  for (const int i : positions.index_range()) {
+    BLI_kdtree_3d_insert(kdtree, i, positions[i]);
+  }
+  BLI_kdtree_3d_balance(kdtree);
+
+  struct CallbackData {
+    int index;
+    MutableSpan<bool> elimination_mask;
+  };
+  for (const int i : positions.index_range()) {
+    if (elimination_mask[i]) {
+      continue;
+    }
+    CallbackData callback_data = {i, elimination_mask};
+    BLI_kdtree_3d_range_search_cb(
+        kdtree,
+        positions[i],
+        minimum_distance,
+        [](void *user_data, int index, const float * /*co*/, float /*dist_sq*/) {
+          CallbackData &callback_data = *static_cast<CallbackData *>(user_data);
+          if (index != callback_data.index) {
+            callback_data.elimination_mask[index] = true;
+          }
+          return true;
+        },
+        &callback_data);
+  }
+  BLI_kdtree_3d_free(kdtree);
+}
+
+/**
+ * Candidates are distributed on a unit square in rows of small patches, similar to how points
+ * are generated for the triangles of a grid mesh.
+ */
+static Array<float3> create_candidates(const int points_num)
+{
+  const int patches_per_side = 256;
+  const int points_per_patch = std::max(points_num / (patches_per_side * patches_per_side), 1);
+  Array<float3> positions(points_per_patch * patches_per_side * patches_per_side);
+  RandomNumberGenerator rng(0);
+  int point_i = 0;
+  for (const int y : IndexRange(patches_per_side)) {
+    for (const int x : IndexRange(patches_per_side)) {
+      for ([[maybe_unused]] const int i : IndexRange(points_per_patch)) {
+        positions[point_i++] = float3(float(x) + rng.get_float(), float(y) + rng.get_float(), 0) /
+                               float(patches_per_side);
+      }
+    }
+  }
+  return positions;
+}
+
+static void test_elimination(const int points_num, const float minimum_distance)
+{
+  const Array<float3> positions = create_candidates(points_num);
+  printf("%d candidates, minimum distance %f\n", int(positions.size()), minimum_distance);
+
+  Array<bool> kdtree_mask(positions.size(), false);
+  {
+    SCOPED_TIMER("  kdtree");
+    eliminate_close_points_kdtree(positions, minimum_distance, kdtree_mask);
+  }
+  Array<bool> grid_mask(positions.size(), false);
+  {
+    SCOPED_TIMER("  hash grid");
+    poisson_disk::eliminate_close_points(positions, minimum_distance, grid_mask);
+  }
+  EXPECT_EQ_ARRAY(kdtree_mask.data(), grid_mask.data(), positions.size());
+}
+
+TEST(poisson_disk, EliminationLowDensity)
+{
+  test_elimination(100'000, 0.01f);
+  test_elimination(100'000, 0.001f);
+}
+
+TEST(poisson_disk, EliminationHighDensity)
+{
+  test_elimination(1'000'000, 0.01f);
+  test_elimination(1'000'000, 0.001f);
+  test_elimination(1'000'000, 0.0001f);
+}
+
+#ifdef USE_BIG_TESTS
+TEST(poisson_disk, EliminationHugeDensity)
+{
+  test_elimination(50'000'000, 0.001f);
+  test_elimination(50'000'000, 0.0001f);
+}
+#endif
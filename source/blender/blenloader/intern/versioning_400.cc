@@ -66,7 +66,7 @@
 #include "BKE_context.hh"
 #include "BKE_curve.hh"
 #include "BKE_customdata.hh"
-#include "BKE_effect.h"
+#include "BKE_effect.hh"
 #include "BKE_fcurve.hh"
 #include "BKE_file_handler.hh"
 #include "BKE_grease_pencil.hh"
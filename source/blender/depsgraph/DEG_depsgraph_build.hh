@@ -71,6 +71,17 @@ void DEG_graph_relations_update(Depsgraph *graph);
 /** Tag all relations in the database for update. */
 void DEG_relations_tag_update(Main *bmain);
 
+/**
+ * Bracket an operator which only adds objects to or removes objects from view layers, without
+ * changing any other data-block. Relations which are tagged for update in between are updated
+ * incrementally where possible, instead of rebuilding the whole graph.
+ *
+ * Graphs which already needed a full update of relations before the call to `begin` are still
+ * fully rebuilt.
+ */
+void DEG_relations_tag_update_objects_begin(Main *bmain);
+void DEG_relations_tag_update_objects_end(Main *bmain);
+
 /* Add Dependencies  ----------------------------- */
 
 /**
@@ -33,6 +33,9 @@ struct PointerRNA;
 struct Scene;
 struct ViewLayer;
 struct ViewerPath;
+namespace blender::bke {
+class PlaybackGeometryCache;
+}
 
 /* -------------------------------------------------------------------- */
 /** \name DEG input data
@@ -53,6 +56,9 @@ eEvaluationMode DEG_get_mode(const Depsgraph *graph);
 /** Get time that depsgraph is being evaluated or was last evaluated at. */
 float DEG_get_ctime(const Depsgraph *graph);
 
+/** Get the cache of evaluated geometry that is used to speed up animation playback. */
+blender::bke::PlaybackGeometryCache &DEG_get_playback_geometry_cache(const Depsgraph *graph);
+
 /** \} */
 
 /* -------------------------------------------------------------------- */
@@ -19,6 +19,7 @@
 #include "BLI_string.h"
 
 #include "BKE_action.hh"
+#include "BKE_anim_eval_plan.hh"
 #include "BKE_collection.hh"
 #include "BKE_lib_id.hh"
 
@@ -178,6 +179,9 @@ void deg_graph_build_finalize(Main *bmain, Depsgraph *graph)
   deg_graph_flush_visibility_flags(graph);
   deg_graph_remove_unused_noops(graph);
 
+  /* Animated properties may have been removed or moved, together with the relations. */
+  bke::anim_eval_plans_invalidate_all();
+
   /* Re-tag IDs for update if it was tagged before the relations
    * update tag. */
   for (IDNode *id_node : graph->id_nodes) {
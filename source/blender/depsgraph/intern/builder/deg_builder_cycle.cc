@@ -56,6 +56,8 @@ struct CyclesSolverState {
   Depsgraph *graph;
   BLI_Stack *traversal_stack;
   int num_cycles = 0;
+  /* Relations which were marked as cyclic by a previous check are not followed. */
+  bool skip_cyclic_relations = false;
 };
 
 inline void set_node_visited_state(Node *node, eCyclicCheckVisitedState state)
@@ -161,6 +163,9 @@ void solve_cycles(CyclesSolverState *state)
     const int num_visited = get_node_num_visited_children(node);
     for (int i = num_visited; i < node->outlinks.size(); i++) {
       Relation *rel = node->outlinks[i];
+      if (state->skip_cyclic_relations && (rel->flag & RELATION_FLAG_CYCLIC)) {
+        continue;
+      }
       if (rel->to->type == NodeType::OPERATION) {
         OperationNode *to = (OperationNode *)rel->to;
         eCyclicCheckVisitedState to_state = get_node_visited_state(to);
@@ -216,4 +221,21 @@ void deg_graph_detect_cycles(Depsgraph *graph)
   }
 }
 
+void deg_graph_detect_cycles(Depsgraph *graph, Span<OperationNode *> operations)
+{
+  CyclesSolverState state(graph);
+  state.skip_cyclic_relations = true;
+  for (OperationNode *node : graph->operations) {
+    node->custom_flags = 0;
+  }
+  /* Any new cycle goes through one of the given operations, so it is enough to only start the
+   * traversal from them. */
+  for (OperationNode *node : operations) {
+    if (get_node_visited_state(node) == NODE_NOT_VISITED) {
+      schedule_node_to_stack(&state, node);
+      solve_cycles(&state);
+    }
+  }
+}
+
 }  // namespace blender::deg
@@ -8,11 +8,19 @@
 
 #pragma once
 
+#include "BLI_span.hh"
+
 namespace blender::deg {
 
 struct Depsgraph;
+struct OperationNode;
 
 /* Detect and solve dependency cycles. */
 void deg_graph_detect_cycles(Depsgraph *graph);
 
+/* Detect and solve dependency cycles which go through any of the given operations, ignoring the
+ * relations which are already marked as cyclic. Used when operations are added to a graph which
+ * had its cycles solved already. */
+void deg_graph_detect_cycles(Depsgraph *graph, Span<OperationNode *> operations);
+
 }  // namespace blender::deg
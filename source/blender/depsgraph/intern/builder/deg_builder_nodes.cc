@@ -57,7 +57,7 @@
 #include "BKE_collection.hh"
 #include "BKE_constraint.h"
 #include "BKE_curve.hh"
-#include "BKE_effect.h"
+#include "BKE_effect.hh"
 #include "BKE_fcurve_driver.h"
 #include "BKE_gpencil_legacy.h"
 #include "BKE_gpencil_modifier_legacy.h"
@@ -477,7 +477,7 @@ static int foreach_id_cow_detect_need_for_update_callback(LibraryIDLinkCallbackD
   return builder->foreach_id_cow_detect_need_for_update_callback(id_cow_self, id);
 }
 
-void DepsgraphNodeBuilder::update_invalid_cow_pointers()
+void DepsgraphNodeBuilder::update_invalid_cow_pointers(Span<IDNode *> id_nodes)
 {
   /* NOTE: Currently the only ID types that depsgraph may decide to not evaluate/generate evaluated
    * copies for, even though they are referenced by other data-blocks, are Collections and Objects
@@ -489,7 +489,7 @@ void DepsgraphNodeBuilder::update_invalid_cow_pointers()
    * some cases. This is slightly unfortunate (as it may hide issues in other parts of Blender
    * code), but cannot really be avoided currently. */
 
-  for (const IDNode *id_node : graph_->id_nodes) {
+  for (const IDNode *id_node : id_nodes) {
     if (id_node->previously_visible_components_mask == 0) {
       /* Newly added node/ID, no need to check it. */
       continue;
@@ -555,7 +555,19 @@ void DepsgraphNodeBuilder::end_build()
 {
   graph_->light_linking_cache.end_build(*graph_->scene);
   tag_previously_tagged_nodes();
-  update_invalid_cow_pointers();
+  update_invalid_cow_pointers(graph_->id_nodes);
+}
+
+void DepsgraphNodeBuilder::begin_build_incremental()
+{
+  /* Nodes which are already in the graph are kept as-is, including their evaluated copies and
+   * update tags. Only the nodes of new IDs are built. */
+  for (IDNode *id_node : graph_->id_nodes) {
+    built_map_.tagBuild(id_node->id_orig);
+    id_node->previously_visible_components_mask = id_node->visible_components_mask;
+    id_node->previous_eval_flags = id_node->eval_flags;
+    id_node->previous_customdata_masks = id_node->customdata_masks;
+  }
 }
 
 void DepsgraphNodeBuilder::build_id(ID *id, const bool force_be_visible)
@@ -892,19 +904,24 @@ void DepsgraphNodeBuilder::build_object_flags(int base_index,
   if (base_index == -1) {
     return;
   }
+  /* TODO(sergey): Is this really best component to be used? */
+  add_operation_node(&object->id,
+                     NodeType::OBJECT_FROM_LAYER,
+                     OperationCode::OBJECT_BASE_FLAGS,
+                     object_base_flags_eval_function(base_index, object, linked_state));
+}
+
+DepsEvalOperationCb DepsgraphNodeBuilder::object_base_flags_eval_function(
+    int base_index, Object *object, eDepsNode_LinkedState_Type linked_state)
+{
   Scene *scene_cow = get_cow_datablock(scene_);
   Object *object_cow = get_cow_datablock(object);
   const bool is_from_set = (linked_state == DEG_ID_LINKED_VIA_SET);
-  /* TODO(sergey): Is this really best component to be used? */
-  add_operation_node(
-      &object->id,
-      NodeType::OBJECT_FROM_LAYER,
-      OperationCode::OBJECT_BASE_FLAGS,
-      [view_layer_index = view_layer_index_, scene_cow, object_cow, base_index, is_from_set](
-          ::Depsgraph *depsgraph) {
-        BKE_object_eval_eval_base_flags(
-            depsgraph, scene_cow, view_layer_index, object_cow, base_index, is_from_set);
-      });
+  return [view_layer_index = view_layer_index_, scene_cow, object_cow, base_index, is_from_set](
+             ::Depsgraph *depsgraph) {
+    BKE_object_eval_eval_base_flags(
+        depsgraph, scene_cow, view_layer_index, object_cow, base_index, is_from_set);
+  };
 }
 
 void DepsgraphNodeBuilder::build_object_instance_collection(Object *object, bool is_object_visible)
@@ -8,6 +8,9 @@
 
 #pragma once
 
+#include "BLI_set.hh"
+#include "BLI_span.hh"
+
 #include "BKE_lib_query.hh" /* For LibraryForeachIDCallbackFlag enum. */
 
 #include "DNA_armature_types.h"
@@ -91,6 +94,16 @@ class DepsgraphNodeBuilder : public DepsgraphBuilder {
   virtual void begin_build();
   virtual void end_build();
 
+  /* Begin building of new IDs into an already built graph. The IDs which are already in the graph
+   * are considered built and are not visited again. */
+  virtual void begin_build_incremental();
+
+  /**
+   * Check for IDs that need to be flushed (copy-on-eval-updated)
+   * because the depsgraph itself created or removed some of their evaluated dependencies.
+   */
+  void update_invalid_cow_pointers(Span<IDNode *> id_nodes);
+
   /**
    * `id_cow_self` is the user of `id_pointer`,
    * see also `LibraryIDLinkCallbackData` struct definition.
@@ -176,6 +189,11 @@ class DepsgraphNodeBuilder : public DepsgraphBuilder {
   virtual void build_view_layer(Scene *scene,
                                 ViewLayer *view_layer,
                                 eDepsNode_LinkedState_Type linked_state);
+  /* Build objects which were added to the view layer of an already built graph, and update the
+   * base index used by the other objects of the view layer. */
+  virtual void build_view_layer_objects(Scene *scene,
+                                        ViewLayer *view_layer,
+                                        const Set<Object *> &added_objects);
   virtual void build_collection(LayerCollection *from_layer_collection, Collection *collection);
   virtual void build_object(int base_index,
                             Object *object,
@@ -320,11 +338,9 @@ class DepsgraphNodeBuilder : public DepsgraphBuilder {
                               void *user_data);
 
   void tag_previously_tagged_nodes();
-  /**
-   * Check for IDs that need to be flushed (copy-on-eval-updated)
-   * because the depsgraph itself created or removed some of their evaluated dependencies.
-   */
-  void update_invalid_cow_pointers();
+  DepsEvalOperationCb object_base_flags_eval_function(int base_index,
+                                                      Object *object,
+                                                      eDepsNode_LinkedState_Type linked_state);
 
   /* State which demotes currently built entities. */
   Scene *scene_;
@@ -164,4 +164,39 @@ void DepsgraphNodeBuilder::build_view_layer(Scene *scene,
   }
 }
 
+void DepsgraphNodeBuilder::build_view_layer_objects(Scene *scene,
+                                                    ViewLayer *view_layer,
+                                                    const Set<Object *> &added_objects)
+{
+  view_layer_index_ = 0;
+  scene_ = scene;
+  view_layer_ = view_layer;
+  /* Base indices are used by the base flags evaluation of every object, and they shift when an
+   * object is added or removed. Walk over all bases in the same way as the full build does. */
+  int base_index = 0;
+  BKE_view_layer_synced_ensure(scene, view_layer);
+  LISTBASE_FOREACH (Base *, base, BKE_view_layer_object_bases_get(view_layer)) {
+    if (!need_pull_base_into_graph(base)) {
+      continue;
+    }
+    Object *object = base->object;
+    if (added_objects.contains(object)) {
+      build_object(base_index, object, DEG_ID_LINKED_DIRECTLY, true);
+      if (!graph_->has_animated_visibility) {
+        graph_->has_animated_visibility |= is_object_visibility_animated(object);
+      }
+    }
+    else {
+      const IDNode *id_node = find_id_node(&object->id);
+      OperationNode *op_node = find_operation_node(
+          &object->id, NodeType::OBJECT_FROM_LAYER, OperationCode::OBJECT_BASE_FLAGS);
+      if (op_node != nullptr) {
+        op_node->evaluate = object_base_flags_eval_function(
+            base_index, object, id_node->linked_state);
+      }
+    }
+    base_index++;
+  }
+}
+
 }  // namespace blender::deg
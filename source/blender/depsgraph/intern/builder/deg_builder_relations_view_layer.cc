@@ -160,4 +160,52 @@ void DepsgraphRelationBuilder::build_view_layer(Scene *scene,
   }
 }
 
+void DepsgraphRelationBuilder::build_layer_collection_objects(
+    LayerCollection *layer_collection, const Set<Object *> &added_objects)
+{
+  const int hide_flag = (graph_->mode == DAG_EVAL_VIEWPORT) ? COLLECTION_HIDE_VIEWPORT :
+                                                              COLLECTION_HIDE_RENDER;
+
+  Collection *collection = layer_collection->collection;
+  if ((collection->flag & hide_flag) || (layer_collection->flag & LAYER_COLLECTION_EXCLUDE)) {
+    return;
+  }
+
+  /* Same relations as #build_collection() creates for a layer collection, but only for the added
+   * objects. An object is linked to a collection only once, so the relations are all new. */
+  const ComponentKey collection_hierarchy_key{&collection->id, NodeType::HIERARCHY};
+  LISTBASE_FOREACH (CollectionObject *, cob, &collection->gobject) {
+    if (!added_objects.contains(cob->ob)) {
+      continue;
+    }
+    const ComponentKey object_hierarchy_key{&cob->ob->id, NodeType::HIERARCHY};
+    if (has_node(object_hierarchy_key)) {
+      add_relation(
+          collection_hierarchy_key, object_hierarchy_key, "Collection -> Object hierarchy");
+    }
+  }
+
+  LISTBASE_FOREACH (
+      LayerCollection *, child_layer_collection, &layer_collection->layer_collections)
+  {
+    build_layer_collection_objects(child_layer_collection, added_objects);
+  }
+}
+
+void DepsgraphRelationBuilder::build_view_layer_objects(Scene *scene,
+                                                        ViewLayer *view_layer,
+                                                        const Set<Object *> &added_objects)
+{
+  scene_ = scene;
+  BKE_view_layer_synced_ensure(scene, view_layer);
+  LISTBASE_FOREACH (Base *, base, BKE_view_layer_object_bases_get(view_layer)) {
+    if (added_objects.contains(base->object) && need_pull_base_into_graph(base)) {
+      build_object_from_view_layer_base(base->object);
+    }
+  }
+  LISTBASE_FOREACH (LayerCollection *, layer_collection, &view_layer->layer_collections) {
+    build_layer_collection_objects(layer_collection, added_objects);
+  }
+}
+
 }  // namespace blender::deg
@@ -0,0 +1,438 @@
+/* SPDX-FileCopyrightText: 2025 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include "pipeline_view_layer_incremental.h"
+
+#include <cstdio>
+#include <string>
+
+#include "BLI_listbase.h"
+#include "BLI_time.h"
+
+#include "BKE_global.hh"
+#include "BKE_layer.hh"
+
+#include "DNA_collection_types.h"
+#include "DNA_layer_types.h"
+#include "DNA_object_types.h"
+#include "DNA_scene_types.h"
+
+#include "DEG_depsgraph.hh"
+
+#include "intern/builder/deg_builder.h"
+#include "intern/builder/deg_builder_cycle.h"
+#include "intern/builder/deg_builder_nodes.h"
+#include "intern/builder/deg_builder_relations.h"
+#include "intern/builder/pipeline_view_layer.h"
+#include "intern/depsgraph.hh"
+#include "intern/depsgraph_relation.hh"
+#include "intern/node/deg_node.hh"
+#include "intern/node/deg_node_component.hh"
+#include "intern/node/deg_node_id.hh"
+#include "intern/node/deg_node_operation.hh"
+
+namespace blender::deg {
+
+namespace {
+
+IDNode *get_owner_id_node(Node *node)
+{
+  switch (node->get_class()) {
+    case NodeClass::OPERATION:
+      return static_cast<OperationNode *>(node)->owner->owner;
+    case NodeClass::COMPONENT:
+      return static_cast<ComponentNode *>(node)->owner;
+    case NodeClass::GENERIC:
+      break;
+  }
+  return nullptr;
+}
+
+template<typename Func> void foreach_operation(const IDNode *id_node, const Func &func)
+{
+  for (ComponentNode *comp_node : id_node->components.values()) {
+    for (OperationNode *op_node : comp_node->operations) {
+      func(op_node);
+    }
+  }
+}
+
+/* IDs which are pulled into the graph by the view layer itself, regardless of the objects which
+ * are using them. */
+bool is_view_layer_id_type(const ID_Type id_type)
+{
+  return ELEM(id_type, ID_SCE, ID_WO, ID_LS, ID_CF, ID_MSK, ID_MC);
+}
+
+/* Collections which are built from the layer collections of the view layer, in the same way as
+ * #DepsgraphNodeBuilder::build_layer_collections() visits them. */
+void collect_layer_collections(const ListBase *layer_collections,
+                               const int visibility_flag,
+                               Vector<Collection *> &r_collections)
+{
+  LISTBASE_FOREACH (const LayerCollection *, layer_collection, layer_collections) {
+    if (layer_collection->collection->flag & visibility_flag) {
+      continue;
+    }
+    if ((layer_collection->flag & LAYER_COLLECTION_EXCLUDE) == 0) {
+      r_collections.append(layer_collection->collection);
+    }
+    collect_layer_collections(
+        &layer_collection->layer_collections, visibility_flag, r_collections);
+  }
+}
+
+bool object_needs_full_build(const Scene &scene, const Object &object)
+{
+  if (&object == scene.camera) {
+    /* Relations of other objects might depend on the scene camera. */
+    return true;
+  }
+  if (object.light_linking != nullptr) {
+    return true;
+  }
+  if (object.rigidbody_object != nullptr || object.rigidbody_constraint != nullptr) {
+    return true;
+  }
+  if (object.instance_collection != nullptr && (object.transflag & OB_DUPLICOLLECTION)) {
+    return true;
+  }
+  return false;
+}
+
+std::string node_identifier(const Node *node)
+{
+  if (node->get_class() != NodeClass::OPERATION) {
+    return node->identifier();
+  }
+  const OperationNode *op_node = static_cast<const OperationNode *>(node);
+  const ComponentNode *comp_node = op_node->owner;
+  return comp_node->owner->name + "/" + nodeTypeAsString(comp_node->type) + "/" +
+         comp_node->name + "/" + op_node->identifier();
+}
+
+void collect_graph_identifiers(const Depsgraph &graph,
+                               Set<const ID *> &r_ids,
+                               Set<std::string> &r_relations)
+{
+  for (const IDNode *id_node : graph.id_nodes) {
+    r_ids.add(id_node->id_orig);
+    foreach_operation(id_node, [&](const OperationNode *op_node) {
+      for (const Relation *rel : op_node->inlinks) {
+        r_relations.add(node_identifier(rel->from) + " -> " + node_identifier(rel->to) + " '" +
+                        rel->name + "'");
+      }
+    });
+  }
+}
+
+}  // namespace
+
+ViewLayerIncrementalBuilderPipeline::ViewLayerIncrementalBuilderPipeline(::Depsgraph *graph)
+    : deg_graph_(reinterpret_cast<Depsgraph *>(graph)),
+      bmain_(deg_graph_->bmain),
+      scene_(deg_graph_->scene),
+      view_layer_(deg_graph_->view_layer)
+{
+}
+
+bool ViewLayerIncrementalBuilderPipeline::build()
+{
+  double start_time = 0.0;
+  if (G.debug & (G_DEBUG_DEPSGRAPH_BUILD | G_DEBUG_DEPSGRAPH_TIME)) {
+    start_time = BLI_time_now_seconds();
+  }
+
+  if (!build_step_find_changes()) {
+    if (G.debug & G_DEBUG_DEPSGRAPH_BUILD) {
+      printf("Depsgraph can not be updated incrementally, doing full build.\n");
+    }
+    return false;
+  }
+  build_step_update_graph();
+  build_step_finalize();
+
+  if (G.debug & (G_DEBUG_DEPSGRAPH_BUILD | G_DEBUG_DEPSGRAPH_TIME)) {
+    printf("Depsgraph updated in %f seconds (%d objects added, %d IDs removed).\n",
+           BLI_time_now_seconds() - start_time,
+           int(added_objects_.size()),
+           int(removed_id_nodes_.size()));
+  }
+
+  if ((G.debug & G_DEBUG_DEPSGRAPH_VALIDATE) && !validate_against_full_build()) {
+    printf("Incrementally updated depsgraph does not match full build, doing full build.\n");
+    return false;
+  }
+  return true;
+}
+
+bool ViewLayerIncrementalBuilderPipeline::build_step_find_changes()
+{
+  if (deg_graph_->id_nodes.is_empty() || deg_graph_->is_render_pipeline_depsgraph) {
+    return false;
+  }
+  /* Objects of set scenes, rigid body simulation and light linking need state which is gathered
+   * from the whole view layer during the build. */
+  if (scene_->set != nullptr || scene_->rigidbody_world != nullptr ||
+      deg_graph_->light_linking_cache.has_light_linking())
+  {
+    return false;
+  }
+  /* Cached collision and effector relations would need to be updated for the changed objects. */
+  for (const Map<const ID *, ListBase *> *relations : deg_graph_->physics_relations) {
+    if (relations != nullptr && !relations->is_empty()) {
+      return false;
+    }
+  }
+  /* Transitive reduction is only done for the full build. */
+  if (G.debug_value == 799) {
+    return false;
+  }
+
+  DepsgraphNodeBuilder node_builder(bmain_, deg_graph_, &builder_cache_);
+
+  /* Find objects which were added to the view layer. */
+  Set<IDNode *> based_id_nodes;
+  BKE_view_layer_synced_ensure(scene_, view_layer_);
+  LISTBASE_FOREACH (Base *, base, BKE_view_layer_object_bases_get(view_layer_)) {
+    if (!node_builder.need_pull_base_into_graph(base)) {
+      continue;
+    }
+    Object *object = base->object;
+    IDNode *id_node = deg_graph_->find_id_node(&object->id);
+    if (id_node == nullptr) {
+      if (object_needs_full_build(*scene_, *object)) {
+        return false;
+      }
+      added_objects_.add(object);
+      continue;
+    }
+    if (id_node->id_orig_session_uid != object->id.session_uid) {
+      /* The node belongs to a freed object whose memory is used by the new object. */
+      return false;
+    }
+    if (!id_node->has_base) {
+      /* Object which was pulled in indirectly now has a base. */
+      return false;
+    }
+    based_id_nodes.add(id_node);
+  }
+
+  /* Collections of the view layer are not expected to change. */
+  const int visibility_flag = (deg_graph_->mode == DAG_EVAL_VIEWPORT) ? COLLECTION_HIDE_VIEWPORT :
+                                                                        COLLECTION_HIDE_RENDER;
+  Vector<Collection *> collections;
+  collect_layer_collections(&view_layer_->layer_collections, visibility_flag, collections);
+  Set<IDNode *> layer_collection_id_nodes;
+  for (Collection *collection : collections) {
+    IDNode *id_node = deg_graph_->find_id_node(&collection->id);
+    if (id_node == nullptr) {
+      return false;
+    }
+    if (!id_node->is_collection_fully_expanded) {
+      layer_collection_id_nodes.add(id_node);
+    }
+  }
+  for (IDNode *id_node : deg_graph_->id_nodes) {
+    if (id_node->id_type != ID_GR) {
+      continue;
+    }
+    if (id_node->is_collection_fully_expanded) {
+      /* Collections which are instanced or used by modifiers have relations to all their objects,
+       * which are not handled for the added objects. */
+      const Collection *collection = reinterpret_cast<const Collection *>(id_node->id_orig);
+      LISTBASE_FOREACH (const CollectionObject *, cob, &collection->gobject) {
+        if (added_objects_.contains(cob->ob)) {
+          return false;
+        }
+      }
+    }
+    else if (!layer_collection_id_nodes.contains(id_node)) {
+      return false;
+    }
+  }
+
+  if (!find_removed_id_nodes(based_id_nodes, layer_collection_id_nodes)) {
+    return false;
+  }
+  return !added_objects_.is_empty() || !removed_id_nodes_.is_empty();
+}
+
+bool ViewLayerIncrementalBuilderPipeline::find_removed_id_nodes(
+    const Set<IDNode *> &based_id_nodes, const Set<IDNode *> &layer_collection_id_nodes)
+{
+  /* NOTE: The original ID of removed objects might be freed already, only the data stored in the
+   * nodes is accessed. */
+  Vector<IDNode *> queue;
+  for (IDNode *id_node : deg_graph_->id_nodes) {
+    if (id_node->id_type == ID_OB && id_node->has_base && !based_id_nodes.contains(id_node)) {
+      removed_id_nodes_.add_new(id_node);
+      queue.append(id_node);
+    }
+  }
+
+  const IDNode *scene_id_node = deg_graph_->find_id_node(&scene_->id);
+
+  /* Check whether any ID which is kept in the graph depends on the given one. */
+  auto is_used_by_kept_id = [&](const IDNode *id_node) {
+    bool is_used = false;
+    foreach_operation(id_node, [&](const OperationNode *op_node) {
+      for (const Relation *rel : op_node->outlinks) {
+        IDNode *to_id_node = get_owner_id_node(rel->to);
+        if (to_id_node != nullptr && to_id_node != id_node &&
+            !removed_id_nodes_.contains(to_id_node))
+        {
+          is_used = true;
+        }
+      }
+    });
+    return is_used;
+  };
+
+  bool is_supported = true;
+  while (!queue.is_empty() && is_supported) {
+    IDNode *id_node = queue.pop_last();
+    foreach_operation(id_node, [&](OperationNode *op_node) {
+      /* Evaluation of the IDs which are kept in the graph is not to depend on the removed IDs.
+       * Such relations only exist when the kept IDs reference the removed ones, which changes
+       * their relations as well. */
+      for (Relation *rel : op_node->outlinks) {
+        IDNode *to_id_node = get_owner_id_node(rel->to);
+        if (to_id_node == nullptr || to_id_node == id_node || to_id_node == scene_id_node ||
+            removed_id_nodes_.contains(to_id_node))
+        {
+          continue;
+        }
+        is_supported = false;
+      }
+      /* IDs which are only used by the removed IDs are removed as well. */
+      for (Relation *rel : op_node->inlinks) {
+        IDNode *from_id_node = get_owner_id_node(rel->from);
+        if (from_id_node == nullptr || from_id_node == id_node ||
+            removed_id_nodes_.contains(from_id_node))
+        {
+          continue;
+        }
+        if (from_id_node->id_type == ID_GR) {
+          if (!layer_collection_id_nodes.contains(from_id_node)) {
+            is_supported = false;
+          }
+          continue;
+        }
+        if (is_view_layer_id_type(from_id_node->id_type) ||
+            (from_id_node->id_type == ID_OB && from_id_node->has_base) ||
+            is_used_by_kept_id(from_id_node))
+        {
+          continue;
+        }
+        removed_id_nodes_.add_new(from_id_node);
+        queue.append(from_id_node);
+      }
+    });
+  }
+  return is_supported;
+}
+
+void ViewLayerIncrementalBuilderPipeline::build_step_update_graph()
+{
+  deg_graph_->detach_id_nodes(removed_id_nodes_);
+
+  const int64_t num_kept_id_nodes = deg_graph_->id_nodes.size();
+  const int64_t num_kept_operations = deg_graph_->operations.size();
+
+  /* Collections which were only built from the view layer might be expanded to all their objects
+   * when the added objects use them, in which case their relations are built as well. */
+  Vector<IDNode *> relations_built_id_nodes;
+  for (IDNode *id_node : deg_graph_->id_nodes) {
+    if (id_node->id_type == ID_GR && !id_node->is_collection_fully_expanded) {
+      continue;
+    }
+    relations_built_id_nodes.append(id_node);
+  }
+
+  DepsgraphNodeBuilder node_builder(bmain_, deg_graph_, &builder_cache_);
+  node_builder.begin_build_incremental();
+  node_builder.build_view_layer_objects(scene_, view_layer_, added_objects_);
+  node_builder.update_invalid_cow_pointers(deg_graph_->id_nodes);
+
+  DepsgraphRelationBuilder relation_builder(bmain_, deg_graph_, &builder_cache_);
+  relation_builder.begin_build_incremental(relations_built_id_nodes);
+  relation_builder.build_view_layer_objects(scene_, view_layer_, added_objects_);
+  for (IDNode *id_node : deg_graph_->id_nodes.as_span().drop_front(num_kept_id_nodes)) {
+    relation_builder.build_copy_on_write_relations(id_node);
+    relation_builder.build_driver_relations(id_node);
+  }
+
+  /* Any new dependency cycle goes through one of the added operations. */
+  deg_graph_detect_cycles(deg_graph_,
+                          deg_graph_->operations.as_span().drop_front(num_kept_operations));
+
+  /* The evaluated copies of the removed IDs are only freed now, after the pointers to them were
+   * detected. Free particle settings last, in the same way as #Depsgraph::clear_id_nodes(). */
+  for (IDNode *id_node : removed_id_nodes_) {
+    if (id_node->id_type != ID_PA) {
+      delete id_node;
+    }
+  }
+  for (IDNode *id_node : removed_id_nodes_) {
+    if (id_node->id_type == ID_PA) {
+      delete id_node;
+    }
+  }
+}
+
+void ViewLayerIncrementalBuilderPipeline::build_step_finalize()
+{
+  /* Flush visibility and re-schedule nodes for update, existing nodes are only re-tagged when
+   * their evaluation requirements have changed. */
+  deg_graph_build_finalize(bmain_, deg_graph_);
+  DEG_graph_tag_on_visible_update(reinterpret_cast<::Depsgraph *>(deg_graph_), false);
+  /* Relations are up to date. */
+  deg_graph_->need_update_relations = false;
+  deg_graph_->need_update_relations_objects_only = false;
+}
+
+bool ViewLayerIncrementalBuilderPipeline::validate_against_full_build()
+{
+  Depsgraph *full_graph = new Depsgraph(bmain_, scene_, view_layer_, deg_graph_->mode);
+  full_graph->use_visibility_optimization = deg_graph_->use_visibility_optimization;
+  ViewLayerBuilderPipeline builder(reinterpret_cast<::Depsgraph *>(full_graph));
+  builder.build();
+
+  Set<const ID *> ids, full_ids;
+  Set<std::string> relations, full_relations;
+  collect_graph_identifiers(*deg_graph_, ids, relations);
+  collect_graph_identifiers(*full_graph, full_ids, full_relations);
+
+  bool is_valid = true;
+  for (const IDNode *id_node : deg_graph_->id_nodes) {
+    if (!full_ids.contains(id_node->id_orig)) {
+      printf("Depsgraph validation: unexpected ID %s\n", id_node->name.c_str());
+      is_valid = false;
+    }
+  }
+  for (const IDNode *id_node : full_graph->id_nodes) {
+    if (!ids.contains(id_node->id_orig)) {
+      printf("Depsgraph validation: missing ID %s\n", id_node->name.c_str());
+      is_valid = false;
+    }
+  }
+  for (const std::string &relation : relations) {
+    if (!full_relations.contains(relation)) {
+      printf("Depsgraph validation: unexpected relation %s\n", relation.c_str());
+      is_valid = false;
+    }
+  }
+  for (const std::string &relation : full_relations) {
+    if (!relations.contains(relation)) {
+      printf("Depsgraph validation: missing relation %s\n", relation.c_str());
+      is_valid = false;
+    }
+  }
+
+  delete full_graph;
+  return is_valid;
+}
+
+}  // namespace blender::deg
@@ -0,0 +1,64 @@
+/* SPDX-FileCopyrightText: 2025 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup depsgraph
+ */
+
+#pragma once
+
+#include "BLI_set.hh"
+#include "BLI_vector.hh"
+
+#include "deg_builder_cache.h"
+
+struct Depsgraph;
+struct Main;
+struct Object;
+struct Scene;
+struct ViewLayer;
+
+namespace blender::deg {
+
+struct Depsgraph;
+struct IDNode;
+
+/* Update of a graph which was built for a view layer, after objects were added to or removed from
+ * the view layer. Only nodes and relations of the added and removed objects are built or removed,
+ * the rest of the graph is kept as-is.
+ *
+ * Only simple cases are handled: objects which are not involved in physics, rigid body, light
+ * linking or collection instancing, and which are not referenced by other objects. When any of
+ * the changes can not be handled the graph is not modified, and is to be fully rebuilt. */
+class ViewLayerIncrementalBuilderPipeline {
+ public:
+  ViewLayerIncrementalBuilderPipeline(::Depsgraph *graph);
+
+  /* Returns false when the graph can not be updated incrementally. */
+  bool build();
+
+ protected:
+  Depsgraph *deg_graph_;
+  Main *bmain_;
+  Scene *scene_;
+  ViewLayer *view_layer_;
+  DepsgraphBuilderCache builder_cache_;
+
+  /* Objects which have a base in the view layer, but have no node in the graph yet. */
+  Set<Object *> added_objects_;
+  /* Nodes of objects which no longer have a base in the view layer, together with the nodes of
+   * IDs which were only used by them. */
+  Set<IDNode *> removed_id_nodes_;
+
+  bool build_step_find_changes();
+  bool find_removed_id_nodes(const Set<IDNode *> &based_id_nodes,
+                             const Set<IDNode *> &layer_collection_id_nodes);
+  void build_step_update_graph();
+  void build_step_finalize();
+
+  /* Compare the graph against a graph which is built from scratch, printing the differences. */
+  bool validate_against_full_build();
+};
+
+}  // namespace blender::deg
@@ -16,6 +16,7 @@
 
 #include "BKE_global.hh"
 #include "BKE_idtype.hh"
+#include "BKE_playback_geometry_cache.hh"
 #include "BKE_scene.hh"
 
 #include "DEG_depsgraph.hh"
@@ -42,6 +43,8 @@ Depsgraph::Depsgraph(Main *bmain, Scene *scene, ViewLayer *view_layer, eEvaluati
     : time_source(nullptr),
       has_animated_visibility(false),
       need_update_relations(true),
+      need_update_relations_objects_only(false),
+      is_objects_update_candidate(false),
       need_update_nodes_visibility(true),
       need_tag_id_on_graph_visibility_update(true),
       need_tag_id_on_graph_visibility_time_update(false),
@@ -57,6 +60,7 @@ Depsgraph::Depsgraph(Main *bmain, Scene *scene, ViewLayer *view_layer, eEvaluati
       is_evaluating(false),
       is_render_pipeline_depsgraph(false),
       use_editors_update(false),
+      playback_geometry_cache(std::make_unique<bke::PlaybackGeometryCache>()),
       update_count(0)
 {
   BLI_spin_init(&lock);
@@ -166,6 +170,53 @@ void Depsgraph::clear_id_nodes()
   clear_physics_relations(this);
 
   light_linking_cache.clear();
+  playback_geometry_cache->clear();
+}
+
+void Depsgraph::detach_id_nodes(const Set<IDNode *> &detached_id_nodes)
+{
+  if (detached_id_nodes.is_empty()) {
+    return;
+  }
+
+  auto is_detached = [&](const Node *node) {
+    if (node->get_class() != NodeClass::OPERATION) {
+      return false;
+    }
+    const OperationNode *op_node = static_cast<const OperationNode *>(node);
+    return detached_id_nodes.contains(op_node->owner->owner);
+  };
+
+  for (IDNode *id_node : detached_id_nodes) {
+    for (ComponentNode *comp_node : id_node->components.values()) {
+      for (OperationNode *op_node : comp_node->operations) {
+        /* Relations within the detached nodes are freed together with the nodes. Relations to the
+         * rest of the graph are unlinked from it here. Make a copy of the links since unlinking
+         * modifies them. */
+        const Vector<Relation *> inlinks = op_node->inlinks;
+        for (Relation *rel : inlinks) {
+          if (!is_detached(rel->from)) {
+            rel->unlink();
+            delete rel;
+          }
+        }
+        const Vector<Relation *> outlinks = op_node->outlinks;
+        for (Relation *rel : outlinks) {
+          if (!is_detached(rel->to)) {
+            rel->unlink();
+            delete rel;
+          }
+        }
+        entry_tags.remove(op_node);
+      }
+    }
+    id_hash.remove(id_node->id_orig);
+  }
+
+  id_nodes.remove_if([&](IDNode *id_node) { return detached_id_nodes.contains(id_node); });
+  operations.remove_if([&](const OperationNode *op_node) { return is_detached(op_node); });
+
+  playback_geometry_cache->clear();
 }
 
 Relation *Depsgraph::add_new_relation(Node *from, Node *to, const char *description, int flags)
@@ -16,6 +16,7 @@
 
 #include <cstdlib>
 #include <functional>
+#include <memory>
 #include <mutex>
 
 #include "MEM_guardedalloc.h"
@@ -35,6 +36,10 @@ struct ID;
 struct Scene;
 struct ViewLayer;
 
+namespace blender::bke {
+class PlaybackGeometryCache;
+}
+
 namespace blender::deg {
 
 struct IDNode;
@@ -59,6 +64,12 @@ struct Depsgraph {
   IDNode *add_id_node(ID *id, ID *id_cow_hint = nullptr);
   void clear_id_nodes();
 
+  /* Remove given ID nodes from the graph, together with their operations and all relations which
+   * connect them to the rest of the graph. The nodes are not freed, since evaluated copies of the
+   * remaining IDs might still point to their evaluated copies. It is up to the caller to delete
+   * them. The playback geometry cache is cleared. */
+  void detach_id_nodes(const Set<IDNode *> &detached_id_nodes);
+
   /** Add new relationship between two nodes. */
   Relation *add_new_relation(Node *from, Node *to, const char *description, int flags = 0);
 
@@ -98,6 +109,14 @@ struct Depsgraph {
   /* Indicates whether relations needs to be updated. */
   bool need_update_relations;
 
+  /* The only change which requires relations update is addition or removal of objects to/from the
+   * view layer, which allows to update the graph incrementally.
+   * See #DEG_relations_tag_update_objects_begin(). */
+  bool need_update_relations_objects_only;
+  /* Relations of the graph were up to date (or were only out of date because of added and removed
+   * objects) when the current objects addition or removal has began. */
+  bool is_objects_update_candidate;
+
   /* Indicates whether indirect effect of nodes on a directly visible ones needs to be updated. */
   bool need_update_nodes_visibility;
 
@@ -175,6 +194,9 @@ struct Depsgraph {
 
   light_linking::Cache light_linking_cache;
 
+  /* Evaluated geometry of previously evaluated frames, used to speed up animation playback. */
+  std::unique_ptr<bke::PlaybackGeometryCache> playback_geometry_cache;
+
   /* The number of times this graph has been evaluated. */
   uint64_t update_count;
 
@@ -33,6 +33,7 @@
 #include "builder/pipeline_from_ids.h"
 #include "builder/pipeline_render.h"
 #include "builder/pipeline_view_layer.h"
+#include "builder/pipeline_view_layer_incremental.h"
 
 #include "intern/debug/deg_debug.h"
 
@@ -284,6 +285,7 @@ void DEG_graph_tag_relations_update(Depsgraph *graph)
   DEG_DEBUG_PRINTF(graph, TAG, "%s: Tagging relations for update.\n", __func__);
   deg::Depsgraph *deg_graph = reinterpret_cast<deg::Depsgraph *>(graph);
   deg_graph->need_update_relations = true;
+  deg_graph->need_update_relations_objects_only = false;
 
   /* NOTE: When relations are updated, it's quite possible that we've got new bases in the scene.
    * This means, we need to re-create flat array of bases in view layer. */
@@ -307,6 +309,12 @@ void DEG_graph_relations_update(Depsgraph *graph)
     /* Graph is up to date, nothing to do. */
     return;
   }
+  if (deg_graph->need_update_relations_objects_only) {
+    deg::ViewLayerIncrementalBuilderPipeline builder(graph);
+    if (builder.build()) {
+      return;
+    }
+  }
   DEG_graph_build_from_view_layer(graph);
 }
 
@@ -317,3 +325,21 @@ void DEG_relations_tag_update(Main *bmain)
     DEG_graph_tag_relations_update(reinterpret_cast<Depsgraph *>(depsgraph));
   }
 }
+
+void DEG_relations_tag_update_objects_begin(Main *bmain)
+{
+  for (deg::Depsgraph *depsgraph : deg::get_all_registered_graphs(bmain)) {
+    depsgraph->is_objects_update_candidate = !depsgraph->need_update_relations ||
+                                             depsgraph->need_update_relations_objects_only;
+  }
+}
+
+void DEG_relations_tag_update_objects_end(Main *bmain)
+{
+  for (deg::Depsgraph *depsgraph : deg::get_all_registered_graphs(bmain)) {
+    if (depsgraph->is_objects_update_candidate && depsgraph->need_update_relations) {
+      depsgraph->need_update_relations_objects_only = true;
+    }
+    depsgraph->is_objects_update_candidate = false;
+  }
+}
@@ -13,7 +13,7 @@
 #include "BLI_listbase.h"
 
 #include "BKE_collision.h"
-#include "BKE_effect.h"
+#include "BKE_effect.hh"
 #include "BKE_modifier.hh"
 
 #include "DNA_collection_types.h"
@@ -106,6 +106,12 @@ float DEG_get_ctime(const Depsgraph *graph)
   return deg_graph->ctime;
 }
 
+blender::bke::PlaybackGeometryCache &DEG_get_playback_geometry_cache(const Depsgraph *graph)
+{
+  const deg::Depsgraph *deg_graph = reinterpret_cast<const deg::Depsgraph *>(graph);
+  return *deg_graph->playback_geometry_cache;
+}
+
 bool DEG_id_type_updated(const Depsgraph *graph, short id_type)
 {
   const deg::Depsgraph *deg_graph = reinterpret_cast<const deg::Depsgraph *>(graph);
@@ -28,6 +28,7 @@
 #include "BKE_idtype.hh"
 #include "BKE_lib_override.hh"
 #include "BKE_node.hh"
+#include "BKE_playback_geometry_cache.hh"
 #include "BKE_scene.hh"
 #include "BKE_workspace.hh"
 
@@ -167,6 +168,9 @@ void depsgraph_tag_to_component_opcode(const ID *id,
     case ID_RECALC_SYNC_TO_EVAL:
       *component_type = NodeType::COPY_ON_EVAL;
       break;
+    case ID_RECALC_SYNC_VALUES_TO_EVAL:
+      /* Handled separately, see #graph_id_tag_update_single_flag(). */
+      break;
     case ID_RECALC_SHADING:
       *component_type = NodeType::SHADING;
       break;
@@ -290,6 +294,7 @@ void depsgraph_tag_component(Depsgraph *graph,
   }
   /* If component depends on copy-on-evaluation, tag it as well. */
   if (component_node->need_tag_cow_before_update(IDRecalcFlag(id_node->id_cow->recalc))) {
+    id_node->is_cow_full_copy_tagged = true;
     depsgraph_id_tag_copy_on_write(graph, id_node, update_source);
   }
   if (component_type == NodeType::COPY_ON_EVAL) {
@@ -367,6 +372,15 @@ void graph_id_tag_update_single_flag(Main *bmain,
     }
     return;
   }
+  if (tag == ID_RECALC_SYNC_VALUES_TO_EVAL) {
+    /* Unlike #ID_RECALC_SYNC_TO_EVAL this doesn't mark the copy-on-evaluation as needing a full
+     * copy, the values are synchronized in-place when nothing else requested it. */
+    if (id_node != nullptr) {
+      id_node->is_cow_values_sync_tagged = true;
+      depsgraph_id_tag_copy_on_write(graph, id_node, update_source);
+    }
+    return;
+  }
   /* Get description of what is to be tagged. */
   NodeType component_type;
   OperationCode operation_code;
@@ -706,10 +720,17 @@ void graph_id_tag_update(
   IDNode *id_node = (graph != nullptr) ? graph->find_id_node(id) : nullptr;
   if (graph != nullptr) {
     DEG_graph_id_type_tag(reinterpret_cast<::Depsgraph *>(graph), GS(id->name));
+    /* Any edit may change the geometry of other frames, which can't be detected reliably. */
+    if (update_source != DEG_UPDATE_SOURCE_TIME &&
+        bke::PlaybackGeometryCache::is_invalidated_by_recalc(flags))
+    {
+      graph->playback_geometry_cache->clear();
+    }
   }
   if (flags == 0) {
     deg_graph_node_tag_zero(bmain, graph, id_node, update_source);
   }
+  const bool was_cow_full_copy_tagged = (id_node != nullptr) && id_node->is_cow_full_copy_tagged;
   /* Store original flag in the ID.
    * Allows to have more granularity than a node-factory based flags. */
   if (id_node != nullptr) {
@@ -741,6 +762,11 @@ void graph_id_tag_update(
         bmain, graph, id, id_node, ID_RECALC_POINT_CACHE, update_source);
   }
   deg_graph_tag_parameters_if_needed(bmain, graph, id, id_node, flags, update_source);
+  /* Other tags which are passed together with a values synchronization are caused by the same
+   * change of values, so they don't require a full copy of the data-block on their own. */
+  if (id_node != nullptr && (flags & ID_RECALC_SYNC_VALUES_TO_EVAL)) {
+    id_node->is_cow_full_copy_tagged = was_cow_full_copy_tagged;
+  }
 }
 
 }  // namespace blender::deg
@@ -794,6 +820,8 @@ const char *DEG_update_tag_as_string(IDRecalcFlag flag)
       return "AUDIO";
     case ID_RECALC_PARAMETERS:
       return "PARAMETERS";
+    case ID_RECALC_SYNC_VALUES_TO_EVAL:
+      return "SYNC_VALUES_TO_EVAL";
     case ID_RECALC_SOURCE:
       return "SOURCE";
     case ID_RECALC_ALL:
@@ -955,6 +983,8 @@ void DEG_ids_clear_recalc(Depsgraph *depsgraph, const bool backup)
      * the recalc flag. */
     id_node->is_user_modified = false;
     id_node->is_cow_explicitly_tagged = false;
+    id_node->is_cow_values_sync_tagged = false;
+    id_node->is_cow_full_copy_tagged = false;
     deg_graph_clear_id_recalc_flags(id_node->id_cow);
     if (deg_graph->is_active) {
       deg_graph_clear_id_recalc_flags(id_node->id_orig);
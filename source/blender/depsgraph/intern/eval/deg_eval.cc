@@ -16,9 +16,11 @@
 #include "BLI_time.h"
 
 #include "BKE_global.hh"
+#include "BKE_playback_geometry_cache.hh"
 
 #include "DNA_object_types.h"
 #include "DNA_scene_types.h"
+#include "DNA_userdef_types.h"
 
 #include "DEG_depsgraph.hh"
 #include "DEG_depsgraph_query.hh"
@@ -384,6 +386,11 @@ void deg_evaluate_on_refresh(Depsgraph *graph)
 
   graph->update_count++;
 
+  if (!USER_EXPERIMENTAL_TEST(&U, use_playback_geometry_cache)) {
+    /* Free the memory when the cache has been disabled. */
+    graph->playback_geometry_cache->clear();
+  }
+
   graph->debug.begin_graph_evaluation();
 
 #ifdef WITH_PYTHON
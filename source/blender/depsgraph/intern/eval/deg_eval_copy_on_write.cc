@@ -21,6 +21,7 @@
 #include <cstring>
 
 #include "BLI_listbase.h"
+#include "BLI_math_vector.h"
 #include "BLI_utildefines.h"
 
 #include "BKE_curve.hh"
@@ -40,6 +41,7 @@
 #include "DNA_armature_types.h"
 #include "DNA_mesh_types.h"
 #include "DNA_modifier_types.h"
+#include "DNA_node_types.h"
 #include "DNA_object_types.h"
 #include "DNA_particle_types.h"
 #include "DNA_scene_types.h"
@@ -60,12 +62,14 @@
 #endif
 
 #include "BKE_anim_data.hh"
+#include "BKE_anim_eval_plan.hh"
 #include "BKE_animsys.h"
 #include "BKE_armature.hh"
 #include "BKE_editmesh.hh"
 #include "BKE_lib_query.hh"
 #include "BKE_mesh_types.hh"
 #include "BKE_modifier.hh"
+#include "BKE_node_runtime.hh"
 #include "BKE_object.hh"
 #include "BKE_pointcache.h"
 #include "BKE_sound.h"
@@ -723,6 +727,10 @@ void update_id_after_copy(const Depsgraph *depsgraph,
   }
   update_edit_mode_pointers(depsgraph, id_orig, id_cow);
   BKE_animsys_update_driver_array(id_cow);
+  if (GS(id_cow->name) == ID_AC) {
+    /* Evaluation plans of animated IDs point to the F-Curves of the evaluated Action. */
+    bke::anim_eval_plans_invalidate_all();
+  }
 }
 
 /* This callback is used to validate that all nested ID data-blocks are
@@ -835,6 +843,221 @@ ID *deg_expand_eval_copy_datablock(const Depsgraph *depsgraph, const IDNode *id_
   return id_cow;
 }
 
+/* Check whether the evaluated copy of an ID pointer corresponds to the original pointer. */
+bool id_pointers_match(const ID *id_orig, const ID *id_cow)
+{
+  if (id_orig == id_cow) {
+    return true;
+  }
+  return id_cow != nullptr && id_cow->orig_id == id_orig;
+}
+
+/* Copy a buffer of the original data which has the same allocation as the evaluated one. */
+bool sync_allocated_buffer(const void *orig, void *cow)
+{
+  if (orig == nullptr || cow == nullptr) {
+    return orig == cow;
+  }
+  const size_t size = MEM_allocN_len(orig);
+  if (MEM_allocN_len(cow) != size) {
+    return false;
+  }
+  memcpy(cow, orig, size);
+  return true;
+}
+
+/* Copy values of ID properties in-place. Returns false when the structure of the properties
+ * differs, in which case the values are partially synchronized and a full copy is needed. */
+bool id_property_sync_values(const IDProperty *prop_orig, IDProperty *prop_cow)
+{
+  if (prop_orig == nullptr || prop_cow == nullptr) {
+    return prop_orig == prop_cow;
+  }
+  if (prop_orig->type != prop_cow->type || prop_orig->subtype != prop_cow->subtype ||
+      prop_orig->len != prop_cow->len || !STREQ(prop_orig->name, prop_cow->name))
+  {
+    return false;
+  }
+  switch (prop_orig->type) {
+    case IDP_INT:
+    case IDP_FLOAT:
+    case IDP_DOUBLE:
+    case IDP_BOOLEAN:
+      prop_cow->data.val = prop_orig->data.val;
+      prop_cow->data.val2 = prop_orig->data.val2;
+      return true;
+    case IDP_STRING:
+      return sync_allocated_buffer(prop_orig->data.pointer, prop_cow->data.pointer);
+    case IDP_ARRAY:
+      if (prop_orig->subtype == IDP_GROUP) {
+        return false;
+      }
+      return sync_allocated_buffer(prop_orig->data.pointer, prop_cow->data.pointer);
+    case IDP_ID:
+      return id_pointers_match(static_cast<const ID *>(prop_orig->data.pointer),
+                               static_cast<const ID *>(prop_cow->data.pointer));
+    case IDP_GROUP: {
+      const IDProperty *child_orig = static_cast<const IDProperty *>(prop_orig->data.group.first);
+      IDProperty *child_cow = static_cast<IDProperty *>(prop_cow->data.group.first);
+      for (; child_orig && child_cow; child_orig = child_orig->next, child_cow = child_cow->next) {
+        if (!id_property_sync_values(child_orig, child_cow)) {
+          return false;
+        }
+      }
+      return child_orig == nullptr && child_cow == nullptr;
+    }
+    case IDP_IDPARRAY: {
+      const IDProperty *array_orig = static_cast<const IDProperty *>(prop_orig->data.pointer);
+      IDProperty *array_cow = static_cast<IDProperty *>(prop_cow->data.pointer);
+      for (int i = 0; i < prop_orig->len; i++) {
+        if (!id_property_sync_values(&array_orig[i], &array_cow[i])) {
+          return false;
+        }
+      }
+      return true;
+    }
+  }
+  return false;
+}
+
+void object_sync_transform_values(const Object *object_orig, Object *object_cow)
+{
+  copy_v3_v3(object_cow->loc, object_orig->loc);
+  copy_v3_v3(object_cow->dloc, object_orig->dloc);
+  copy_v3_v3(object_cow->rot, object_orig->rot);
+  copy_v3_v3(object_cow->drot, object_orig->drot);
+  copy_v4_v4(object_cow->quat, object_orig->quat);
+  copy_v4_v4(object_cow->dquat, object_orig->dquat);
+  copy_v3_v3(object_cow->rotAxis, object_orig->rotAxis);
+  copy_v3_v3(object_cow->drotAxis, object_orig->drotAxis);
+  object_cow->rotAngle = object_orig->rotAngle;
+  object_cow->drotAngle = object_orig->drotAngle;
+  copy_v3_v3(object_cow->scale, object_orig->scale);
+  copy_v3_v3(object_cow->dscale, object_orig->dscale);
+  object_cow->rotmode = object_orig->rotmode;
+}
+
+void scene_sync_frame_values(const Scene *scene_orig, Scene *scene_cow)
+{
+  scene_cow->r.cfra = scene_orig->r.cfra;
+  scene_cow->r.subframe = scene_orig->r.subframe;
+  scene_cow->r.sfra = scene_orig->r.sfra;
+  scene_cow->r.efra = scene_orig->r.efra;
+  scene_cow->r.frame_step = scene_orig->r.frame_step;
+  scene_cow->r.psfra = scene_orig->r.psfra;
+  scene_cow->r.pefra = scene_orig->r.pefra;
+  SET_FLAG_FROM_TEST(scene_cow->r.flag, scene_orig->r.flag & SCER_PRV_RANGE, SCER_PRV_RANGE);
+}
+
+bool node_socket_sync_default_value(const bNodeSocket *socket_orig, bNodeSocket *socket_cow)
+{
+  if (socket_orig->type != socket_cow->type || socket_orig->flag != socket_cow->flag ||
+      !STREQ(socket_orig->identifier, socket_cow->identifier) ||
+      !STREQ(socket_orig->idname, socket_cow->idname))
+  {
+    return false;
+  }
+  const void *value_orig = socket_orig->default_value;
+  void *value_cow = socket_cow->default_value;
+  if (value_orig == nullptr || value_cow == nullptr) {
+    return value_orig == value_cow;
+  }
+  switch (eNodeSocketDatatype(socket_orig->type)) {
+    case SOCK_FLOAT:
+    case SOCK_INT:
+    case SOCK_BOOLEAN:
+    case SOCK_VECTOR:
+    case SOCK_RGBA:
+    case SOCK_ROTATION:
+    case SOCK_STRING:
+      return sync_allocated_buffer(value_orig, value_cow);
+    case SOCK_OBJECT:
+    case SOCK_IMAGE:
+    case SOCK_COLLECTION:
+    case SOCK_TEXTURE:
+    case SOCK_MATERIAL:
+      /* All of these store a single ID pointer. */
+      return id_pointers_match(*static_cast<const ID *const *>(value_orig),
+                               *static_cast<const ID *const *>(value_cow));
+    case SOCK_MENU:
+      /* The enum items are shared with the evaluated copy when it is created. */
+      return static_cast<const bNodeSocketValueMenu *>(value_orig)->value ==
+             static_cast<const bNodeSocketValueMenu *>(value_cow)->value;
+    default:
+      break;
+  }
+  const size_t size = MEM_allocN_len(value_orig);
+  return MEM_allocN_len(value_cow) == size && memcmp(value_orig, value_cow, size) == 0;
+}
+
+bool node_sockets_sync_default_values(const ListBase &sockets_orig, ListBase &sockets_cow)
+{
+  const bNodeSocket *socket_orig = static_cast<const bNodeSocket *>(sockets_orig.first);
+  bNodeSocket *socket_cow = static_cast<bNodeSocket *>(sockets_cow.first);
+  for (; socket_orig && socket_cow; socket_orig = socket_orig->next, socket_cow = socket_cow->next)
+  {
+    if (!node_socket_sync_default_value(socket_orig, socket_cow)) {
+      return false;
+    }
+  }
+  return socket_orig == nullptr && socket_cow == nullptr;
+}
+
+bool ntree_sync_socket_values(const bNodeTree *ntree_orig, bNodeTree *ntree_cow)
+{
+  if (ntree_orig->type == NTREE_TEXTURE) {
+    /* Texture nodes are executed with data prepared when the tree is copied. */
+    return false;
+  }
+  const bNode *node_orig = static_cast<const bNode *>(ntree_orig->nodes.first);
+  bNode *node_cow = static_cast<bNode *>(ntree_cow->nodes.first);
+  for (; node_orig && node_cow; node_orig = node_orig->next, node_cow = node_cow->next) {
+    if (node_orig->identifier != node_cow->identifier ||
+        !node_sockets_sync_default_values(node_orig->inputs, node_cow->inputs) ||
+        !node_sockets_sync_default_values(node_orig->outputs, node_cow->outputs))
+    {
+      return false;
+    }
+  }
+  if (node_orig != nullptr || node_cow != nullptr) {
+    return false;
+  }
+  /* The lazy-function graph of geometry nodes is rebuilt by the pre-processing operation, other
+   * caches depending on the default values of sockets are invalidated here. */
+  ntree_cow->runtime->inferenced_input_socket_usage_mutex.tag_dirty();
+  return true;
+}
+
+/* Synchronize values which were tagged with #ID_RECALC_SYNC_VALUES_TO_EVAL to the evaluated copy
+ * without copying the whole data-block. Returns false if the data-block changed in a way which
+ * can't be handled in-place, the evaluated copy then has to be fully copied again. */
+bool sync_eval_copy_values(const ID *id_orig, ID *id_cow)
+{
+  if (!id_property_sync_values(id_orig->properties, id_cow->properties)) {
+    return false;
+  }
+  switch (GS(id_orig->name)) {
+    case ID_OB: {
+      const Object *object_orig = reinterpret_cast<const Object *>(id_orig);
+      Object *object_cow = reinterpret_cast<Object *>(id_cow);
+      if (object_orig->type != object_cow->type) {
+        return false;
+      }
+      object_sync_transform_values(object_orig, object_cow);
+      return true;
+    }
+    case ID_SCE:
+      scene_sync_frame_values(reinterpret_cast<const Scene *>(id_orig),
+                              reinterpret_cast<Scene *>(id_cow));
+      return true;
+    case ID_NT:
+      return ntree_sync_socket_values(reinterpret_cast<const bNodeTree *>(id_orig),
+                                      reinterpret_cast<bNodeTree *>(id_cow));
+    default:
+      return true;
+  }
+}
+
 }  // namespace
 
 ID *deg_update_eval_copy_datablock(const Depsgraph *depsgraph, const IDNode *id_node)
@@ -870,6 +1093,14 @@ ID *deg_update_eval_copy_datablock(const Depsgraph *depsgraph, const IDNode *id_
     }
   }
 
+  /* When only values were changed the evaluated copy is kept and the values are synchronized. */
+  if (check_datablock_expanded(id_cow) && id_node->is_cow_values_sync_tagged &&
+      !id_node->is_cow_explicitly_tagged && !id_node->is_cow_full_copy_tagged &&
+      sync_eval_copy_values(id_orig, id_cow))
+  {
+    return id_cow;
+  }
+
   RuntimeBackup backup(depsgraph);
   backup.init_from_id(id_cow);
   deg_free_eval_copy_datablock(id_cow);
@@ -0,0 +1,313 @@
+/* SPDX-FileCopyrightText: 2025 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup depsgraph
+ */
+
+#include "testing/testing.h"
+#include "tests/blendfile_loading_base_test.h"
+
+#include "BLI_function_ref.hh"
+#include "BLI_listbase.h"
+#include "BLI_math_matrix_types.hh"
+#include "BLI_math_vector_types.hh"
+
+#include "BKE_collection.hh"
+#include "BKE_global.hh"
+#include "BKE_idprop.hh"
+#include "BKE_layer.hh"
+#include "BKE_main.hh"
+#include "BKE_main_invariants.hh"
+#include "BKE_node.hh"
+#include "BKE_node_legacy_types.hh"
+#include "BKE_node_tree_update.hh"
+#include "BKE_object.hh"
+#include "BKE_scene.hh"
+
+#include "DEG_depsgraph.hh"
+#include "DEG_depsgraph_build.hh"
+#include "DEG_depsgraph_query.hh"
+
+#include "DNA_node_types.h"
+#include "DNA_object_types.h"
+#include "DNA_scene_types.h"
+
+#include "RNA_access.hh"
+
+namespace blender::deg::tests {
+
+/**
+ * Evaluated copies keep their address when they are copied again, so the tests change a value on
+ * the evaluated copy only. It is kept when values are synchronized in-place and overwritten by a
+ * full copy.
+ */
+static constexpr float eval_only_value = 123.0f;
+static constexpr int eval_only_int = 4321;
+
+class SyncEvalCopyValuesTest : public BlendfileLoadingBaseTest {
+ protected:
+  Main *bmain = nullptr;
+  Main *bmain_backup = nullptr;
+  Scene *scene = nullptr;
+  Object *object = nullptr;
+  bNodeTree *ntree = nullptr;
+  bNode *node = nullptr;
+
+  void SetUp() override
+  {
+    BlendfileLoadingBaseTest::SetUp();
+    /* RNA updates and node tree updates tag the global main database. */
+    bmain = BKE_main_new();
+    bmain_backup = G_MAIN;
+    G_MAIN = bmain;
+
+    scene = BKE_scene_add(bmain, "Scene");
+    object = BKE_object_add_only_object(bmain, OB_EMPTY, "Empty");
+    BKE_collection_object_add(bmain, scene->master_collection, object);
+
+    ntree = bke::node_tree_add_tree(bmain, "Nodes", "GeometryNodeTree");
+    node = bke::node_add_static_node(nullptr, ntree, SH_NODE_MATH);
+    BKE_main_ensure_invariants(*bmain);
+
+    IDProperty *group = IDP_EnsureProperties(&object->id);
+    IDP_AddToGroup(group, bke::idprop::create("value", 1.0f).release());
+    IDP_AddToGroup(group, bke::idprop::create("array", Span<int32_t>({1, 2, 3})).release());
+    /* The node tree is part of the depsgraph through this property. */
+    IDP_AddToGroup(group, bke::idprop::create("tree", &ntree->id).release());
+
+    depsgraph = create_evaluated_depsgraph();
+    mark_eval_copies();
+  }
+
+  void TearDown() override
+  {
+    BlendfileLoadingBaseTest::TearDown();
+    G_MAIN = bmain_backup;
+    BKE_main_free(bmain);
+  }
+
+  Depsgraph *create_evaluated_depsgraph()
+  {
+    ViewLayer *view_layer = BKE_view_layer_default_view(scene);
+    BKE_view_layer_synced_ensure(scene, view_layer);
+    Depsgraph *new_depsgraph = DEG_graph_new(bmain, scene, view_layer, DAG_EVAL_VIEWPORT);
+    DEG_graph_build_from_view_layer(new_depsgraph);
+    BKE_scene_graph_update_tagged(new_depsgraph, bmain);
+    return new_depsgraph;
+  }
+
+  Object *object_eval(const Depsgraph *graph)
+  {
+    return DEG_get_evaluated_object(graph, object);
+  }
+
+  Scene *scene_eval(const Depsgraph *graph)
+  {
+    return DEG_get_evaluated_scene(graph);
+  }
+
+  bNodeTree *ntree_eval(const Depsgraph *graph)
+  {
+    return reinterpret_cast<bNodeTree *>(DEG_get_evaluated_id(graph, &ntree->id));
+  }
+
+  void mark_eval_copies()
+  {
+    object_eval(depsgraph)->empty_drawsize = eval_only_value;
+    scene_eval(depsgraph)->r.xsch = eval_only_int;
+    ntree_eval(depsgraph)->view_center[0] = eval_only_value;
+  }
+
+  bool object_was_copied()
+  {
+    return object_eval(depsgraph)->empty_drawsize != eval_only_value;
+  }
+
+  bool scene_was_copied()
+  {
+    return scene_eval(depsgraph)->r.xsch != eval_only_int;
+  }
+
+  bool ntree_was_copied()
+  {
+    return ntree_eval(depsgraph)->view_center[0] != eval_only_value;
+  }
+
+  /** Change a property through RNA, which tags the data-block like user edits do. */
+  void rna_update(ID *id, const char *identifier, const FunctionRef<void(PointerRNA &)> set_fn)
+  {
+    PointerRNA ptr = RNA_id_pointer_create(id);
+    PropertyRNA *prop = RNA_struct_find_property(&ptr, identifier);
+    ASSERT_NE(prop, nullptr) << identifier;
+    set_fn(ptr);
+    RNA_property_update_main(bmain, scene, &ptr, prop);
+  }
+
+  void evaluate()
+  {
+    BKE_scene_graph_update_tagged(depsgraph, bmain);
+  }
+
+  /** Compare the synchronized evaluated copies with the ones of a newly built depsgraph. */
+  void expect_matches_full_copy()
+  {
+    Depsgraph *full_depsgraph = create_evaluated_depsgraph();
+
+    const Object *object_a = object_eval(depsgraph);
+    const Object *object_b = object_eval(full_depsgraph);
+    EXPECT_EQ(float3(object_a->loc), float3(object_b->loc));
+    EXPECT_EQ(float3(object_a->rot), float3(object_b->rot));
+    EXPECT_EQ(float3(object_a->scale), float3(object_b->scale));
+    EXPECT_EQ(object_a->object_to_world(), object_b->object_to_world());
+    for (const char *name : {"value", "array"}) {
+      const IDProperty *prop_a = IDP_GetPropertyFromGroup(object_a->id.properties, name);
+      const IDProperty *prop_b = IDP_GetPropertyFromGroup(object_b->id.properties, name);
+      ASSERT_NE(prop_a, nullptr);
+      ASSERT_NE(prop_b, nullptr);
+      EXPECT_TRUE(IDP_EqualsProperties(prop_a, prop_b)) << name;
+    }
+
+    const Scene *scene_a = scene_eval(depsgraph);
+    const Scene *scene_b = scene_eval(full_depsgraph);
+    EXPECT_EQ(scene_a->r.cfra, scene_b->r.cfra);
+    EXPECT_EQ(scene_a->r.sfra, scene_b->r.sfra);
+    EXPECT_EQ(scene_a->r.efra, scene_b->r.efra);
+
+    const bNode *node_a = static_cast<const bNode *>(ntree_eval(depsgraph)->nodes.first);
+    const bNode *node_b = static_cast<const bNode *>(ntree_eval(full_depsgraph)->nodes.first);
+    const bNodeSocket *socket_a = static_cast<const bNodeSocket *>(node_a->inputs.first);
+    const bNodeSocket *socket_b = static_cast<const bNodeSocket *>(node_b->inputs.first);
+    for (; socket_a && socket_b; socket_a = socket_a->next, socket_b = socket_b->next) {
+      EXPECT_EQ(socket_a->default_value_typed<bNodeSocketValueFloat>()->value,
+                socket_b->default_value_typed<bNodeSocketValueFloat>()->value);
+    }
+    EXPECT_EQ(socket_a, nullptr);
+    EXPECT_EQ(socket_b, nullptr);
+
+    DEG_graph_free(full_depsgraph);
+  }
+};
+
+TEST_F(SyncEvalCopyValuesTest, TransformInPlace)
+{
+  rna_update(&object->id, "location", [](PointerRNA &ptr) {
+    const float location[3] = {1.0f, 2.0f, 3.0f};
+    RNA_float_set_array(&ptr, "location", location);
+  });
+  rna_update(&object->id, "rotation_euler", [](PointerRNA &ptr) {
+    const float rotation[3] = {0.5f, 0.0f, -0.25f};
+    RNA_float_set_array(&ptr, "rotation_euler", rotation);
+  });
+  rna_update(&object->id, "scale", [](PointerRNA &ptr) {
+    const float scale[3] = {2.0f, 2.0f, 0.5f};
+    RNA_float_set_array(&ptr, "scale", scale);
+  });
+  evaluate();
+
+  EXPECT_FALSE(object_was_copied());
+  EXPECT_EQ(float3(object_eval(depsgraph)->loc), float3(1.0f, 2.0f, 3.0f));
+  EXPECT_EQ(object_eval(depsgraph)->object_to_world().location(), float3(1.0f, 2.0f, 3.0f));
+  expect_matches_full_copy();
+}
+
+TEST_F(SyncEvalCopyValuesTest, CustomPropertyInPlace)
+{
+  rna_update(&object->id, "[\"value\"]", [](PointerRNA &ptr) {
+    RNA_float_set(&ptr, "[\"value\"]", 2.5f);
+  });
+  rna_update(&object->id, "[\"array\"]", [](PointerRNA &ptr) {
+    const int values[3] = {4, 5, 6};
+    RNA_int_set_array(&ptr, "[\"array\"]", values);
+  });
+  evaluate();
+
+  EXPECT_FALSE(object_was_copied());
+  const IDProperty *value = IDP_GetPropertyFromGroup(object_eval(depsgraph)->id.properties,
+                                                     "value");
+  ASSERT_NE(value, nullptr);
+  EXPECT_EQ(IDP_Float(value), 2.5f);
+  expect_matches_full_copy();
+}
+
+TEST_F(SyncEvalCopyValuesTest, FrameInPlace)
+{
+  rna_update(&scene->id, "frame_current", [](PointerRNA &ptr) {
+    RNA_int_set(&ptr, "frame_current", 10);
+  });
+  rna_update(&scene->id, "frame_end", [](PointerRNA &ptr) {
+    RNA_int_set(&ptr, "frame_end", 50);
+  });
+  evaluate();
+
+  EXPECT_FALSE(scene_was_copied());
+  EXPECT_EQ(scene_eval(depsgraph)->r.cfra, 10);
+  EXPECT_EQ(scene_eval(depsgraph)->r.efra, 50);
+  expect_matches_full_copy();
+}
+
+TEST_F(SyncEvalCopyValuesTest, SocketValueInPlace)
+{
+  bNodeSocket *socket = static_cast<bNodeSocket *>(node->inputs.first);
+  socket->default_value_typed<bNodeSocketValueFloat>()->value = 0.25f;
+  BKE_ntree_update_tag_socket_property(ntree, socket);
+  BKE_main_ensure_invariants(*bmain, ntree->id);
+  evaluate();
+
+  EXPECT_FALSE(ntree_was_copied());
+  const bNode *node_eval = static_cast<const bNode *>(ntree_eval(depsgraph)->nodes.first);
+  const bNodeSocket *socket_eval = static_cast<const bNodeSocket *>(node_eval->inputs.first);
+  EXPECT_EQ(socket_eval->default_value_typed<bNodeSocketValueFloat>()->value, 0.25f);
+  expect_matches_full_copy();
+}
+
+TEST_F(SyncEvalCopyValuesTest, NewCustomPropertyFullCopy)
+{
+  IDP_AddToGroup(object->id.properties, bke::idprop::create("new", 1).release());
+  DEG_id_tag_update_ex(bmain, &object->id, ID_RECALC_SYNC_VALUES_TO_EVAL);
+  evaluate();
+
+  EXPECT_TRUE(object_was_copied());
+  EXPECT_NE(IDP_GetPropertyFromGroup(object_eval(depsgraph)->id.properties, "new"), nullptr);
+  expect_matches_full_copy();
+}
+
+TEST_F(SyncEvalCopyValuesTest, NewNodeFullCopy)
+{
+  /* Tagged as a value change, the different nodes are detected while synchronizing. */
+  bke::node_add_static_node(nullptr, ntree, SH_NODE_MATH);
+  DEG_id_tag_update_ex(bmain, &ntree->id, ID_RECALC_SYNC_VALUES_TO_EVAL);
+  evaluate();
+
+  EXPECT_TRUE(ntree_was_copied());
+  EXPECT_EQ(BLI_listbase_count(&ntree_eval(depsgraph)->nodes), 2);
+
+  /* Tagged by the node tree update. */
+  mark_eval_copies();
+  bke::node_add_static_node(nullptr, ntree, SH_NODE_MATH);
+  BKE_main_ensure_invariants(*bmain, ntree->id);
+  evaluate();
+
+  EXPECT_TRUE(ntree_was_copied());
+  EXPECT_EQ(BLI_listbase_count(&ntree_eval(depsgraph)->nodes), 3);
+  expect_matches_full_copy();
+}
+
+TEST_F(SyncEvalCopyValuesTest, SeparateTagFullCopy)
+{
+  rna_update(&object->id, "location", [](PointerRNA &ptr) {
+    const float location[3] = {1.0f, 0.0f, 0.0f};
+    RNA_float_set_array(&ptr, "location", location);
+  });
+  /* Another change of the same object which isn't covered by synchronizing values. */
+  object->empty_drawtype = OB_CUBE;
+  DEG_id_tag_update_ex(bmain, &object->id, ID_RECALC_SYNC_TO_EVAL);
+  evaluate();
+
+  EXPECT_TRUE(object_was_copied());
+  EXPECT_EQ(object_eval(depsgraph)->empty_drawtype, OB_CUBE);
+  expect_matches_full_copy();
+}
+
+}  // namespace blender::deg::tests
@@ -183,6 +183,13 @@ inline OperationNode *flush_schedule_children(OperationNode *op_node, FlushQueue
     /* Always flush flushable flags, so children always know what happened
      * to their parents. */
     to_node->flag |= (op_node->flag & DEPSOP_FLAG_FLUSH);
+    /* An update flushed from another data-block can not be handled by only synchronizing values
+     * of the evaluated copy. */
+    if (to_node->opcode == OperationCode::COPY_ON_EVAL &&
+        to_node->owner->owner != op_node->owner->owner)
+    {
+      to_node->owner->owner->is_cow_full_copy_tagged = true;
+    }
     /* Flush update over the relation, if it was not flushed yet. */
     if (to_node->scheduled) {
       continue;
@@ -0,0 +1,243 @@
+/* SPDX-FileCopyrightText: 2025 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup depsgraph
+ */
+
+#include "testing/testing.h"
+#include "tests/blendfile_loading_base_test.h"
+
+#include "BLI_array.hh"
+#include "BLI_listbase.h"
+#include "BLI_math_vector_types.hh"
+
+#include "BKE_collection.hh"
+#include "BKE_global.hh"
+#include "BKE_layer.hh"
+#include "BKE_lib_id.hh"
+#include "BKE_main.hh"
+#include "BKE_main_invariants.hh"
+#include "BKE_mesh.hh"
+#include "BKE_modifier.hh"
+#include "BKE_node.hh"
+#include "BKE_object.hh"
+#include "BKE_playback_geometry_cache.hh"
+#include "BKE_scene.hh"
+
+#include "DEG_depsgraph.hh"
+#include "DEG_depsgraph_build.hh"
+#include "DEG_depsgraph_query.hh"
+
+#include "DNA_mesh_types.h"
+#include "DNA_modifier_types.h"
+#include "DNA_node_types.h"
+#include "DNA_object_types.h"
+#include "DNA_scene_types.h"
+#include "DNA_userdef_types.h"
+
+#include "MOD_nodes.hh"
+
+namespace blender::deg::tests {
+
+/**
+ * A mesh object with a nodes modifier that translates the mesh by the scene frame, so every frame
+ * has different evaluated positions.
+ */
+class PlaybackGeometryCacheTest : public BlendfileLoadingBaseTest {
+ protected:
+  Main *bmain = nullptr;
+  Main *bmain_backup = nullptr;
+  char use_cache_backup = 0;
+  int memcachelimit_backup = 0;
+  Scene *scene = nullptr;
+  Object *object = nullptr;
+  Mesh *mesh = nullptr;
+
+  void SetUp() override
+  {
+    BlendfileLoadingBaseTest::SetUp();
+    use_cache_backup = U.experimental.use_playback_geometry_cache;
+    memcachelimit_backup = U.memcachelimit;
+    U.experimental.use_playback_geometry_cache = 1;
+    U.memcachelimit = 1024;
+    /* Node tree updates tag the global main database. */
+    bmain = BKE_main_new();
+    bmain_backup = G_MAIN;
+    G_MAIN = bmain;
+
+    scene = BKE_scene_add(bmain, "Scene");
+    scene->r.cfra = 1;
+    mesh = BKE_mesh_new_nomain(4, 0, 0, 0);
+    MutableSpan<float3> positions = mesh->vert_positions_for_write();
+    for (const int i : positions.index_range()) {
+      positions[i] = float3(i, 0.0f, 0.0f);
+    }
+    BKE_libblock_management_main_add(bmain, mesh);
+    object = BKE_object_add_only_object(bmain, OB_MESH, "Object");
+    object->data = mesh;
+    BKE_collection_object_add(bmain, scene->master_collection, object);
+    add_modifier();
+    BKE_main_ensure_invariants(*bmain);
+
+    depsgraph = create_evaluated_depsgraph();
+    /* The cache is only used by the active depsgraph. */
+    DEG_make_active(depsgraph);
+  }
+
+  void TearDown() override
+  {
+    BlendfileLoadingBaseTest::TearDown();
+    G_MAIN = bmain_backup;
+    BKE_main_free(bmain);
+    U.experimental.use_playback_geometry_cache = use_cache_backup;
+    U.memcachelimit = memcachelimit_backup;
+  }
+
+  void add_modifier()
+  {
+    bNodeTree *ntree = bke::node_tree_add_tree(bmain, "Nodes", "GeometryNodeTree");
+    ntree->tree_interface.add_socket(
+        "Geometry", "", "NodeSocketGeometry", NODE_INTERFACE_SOCKET_OUTPUT, nullptr);
+    ntree->tree_interface.add_socket(
+        "Geometry", "", "NodeSocketGeometry", NODE_INTERFACE_SOCKET_INPUT, nullptr);
+    bNode *group_input = bke::node_add_node(nullptr, ntree, "NodeGroupInput");
+    bNode *scene_time = bke::node_add_node(nullptr, ntree, "GeometryNodeInputSceneTime");
+    bNode *transform = bke::node_add_node(nullptr, ntree, "GeometryNodeTransform");
+    bNode *group_output = bke::node_add_node(nullptr, ntree, "NodeGroupOutput");
+    bke::node_add_link(ntree,
+                       group_input,
+                       bke::node_find_socket(group_input, SOCK_OUT, "Socket_1"),
+                       transform,
+                       bke::node_find_socket(transform, SOCK_IN, "Geometry"));
+    /* The frame is converted to a vector with the same value in every component. */
+    bke::node_add_link(ntree,
+                       scene_time,
+                       bke::node_find_socket(scene_time, SOCK_OUT, "Frame"),
+                       transform,
+                       bke::node_find_socket(transform, SOCK_IN, "Translation"));
+    bke::node_add_link(ntree,
+                       transform,
+                       bke::node_find_socket(transform, SOCK_OUT, "Geometry"),
+                       group_output,
+                       bke::node_find_socket(group_output, SOCK_IN, "Socket_0"));
+
+    auto *nmd = reinterpret_cast<NodesModifierData *>(BKE_modifier_new(eModifierType_Nodes));
+    BLI_addtail(&object->modifiers, nmd);
+    BKE_modifier_unique_name(&object->modifiers, &nmd->modifier);
+    BKE_modifiers_persistent_uid_init(*object, nmd->modifier);
+    nmd->node_group = ntree;
+    id_us_plus(&ntree->id);
+    MOD_nodes_update_interface(object, nmd);
+  }
+
+  Depsgraph *create_evaluated_depsgraph()
+  {
+    ViewLayer *view_layer = BKE_view_layer_default_view(scene);
+    BKE_view_layer_synced_ensure(scene, view_layer);
+    Depsgraph *new_depsgraph = DEG_graph_new(bmain, scene, view_layer, DAG_EVAL_VIEWPORT);
+    DEG_graph_build_from_view_layer(new_depsgraph);
+    BKE_scene_graph_update_tagged(new_depsgraph, bmain);
+    return new_depsgraph;
+  }
+
+  void set_frame(const int frame)
+  {
+    scene->r.cfra = frame;
+    BKE_scene_graph_update_for_newframe(depsgraph);
+  }
+
+  bke::PlaybackGeometryCache &cache()
+  {
+    return DEG_get_playback_geometry_cache(depsgraph);
+  }
+
+  Span<float3> evaluated_positions(const Depsgraph *graph)
+  {
+    const Object *object_eval = DEG_get_evaluated_object(graph, object);
+    return BKE_object_get_evaluated_mesh(object_eval)->vert_positions();
+  }
+
+  /** Compare the result with an evaluation in a depsgraph that does not use the cache. */
+  void expect_matches_fresh_evaluation()
+  {
+    Depsgraph *fresh_depsgraph = create_evaluated_depsgraph();
+    EXPECT_EQ(evaluated_positions(depsgraph), evaluated_positions(fresh_depsgraph));
+    DEG_graph_free(fresh_depsgraph);
+  }
+
+  void expect_positions(const float3 &offset)
+  {
+    const Span<float3> positions = evaluated_positions(depsgraph);
+    const Span<float3> orig_positions = mesh->vert_positions();
+    ASSERT_EQ(positions.size(), orig_positions.size());
+    for (const int i : positions.index_range()) {
+      const float3 expected = orig_positions[i] + offset;
+      EXPECT_V3_NEAR(positions[i], expected, 1e-6f);
+    }
+  }
+};
+
+TEST_F(PlaybackGeometryCacheTest, HitMatchesFreshEvaluation)
+{
+  set_frame(1);
+  const float3 *frame_1_positions = evaluated_positions(depsgraph).data();
+  expect_positions(float3(1.0f));
+  EXPECT_GT(cache().memory_bytes(), 0);
+
+  set_frame(2);
+  expect_positions(float3(2.0f));
+
+  set_frame(1);
+  /* The restored mesh shares its data with the mesh that was stored for the frame. */
+  EXPECT_EQ(evaluated_positions(depsgraph).data(), frame_1_positions);
+  expect_positions(float3(1.0f));
+  expect_matches_fresh_evaluation();
+}
+
+TEST_F(PlaybackGeometryCacheTest, DataEditInvalidates)
+{
+  set_frame(1);
+  set_frame(2);
+  ASSERT_GT(cache().memory_bytes(), 0);
+
+  mesh->vert_positions_for_write()[3] = float3(3.0f, 4.0f, 0.0f);
+  mesh->tag_positions_changed();
+  DEG_id_tag_update_ex(bmain, &mesh->id, ID_RECALC_GEOMETRY);
+  EXPECT_EQ(cache().memory_bytes(), 0);
+  BKE_scene_graph_update_tagged(depsgraph, bmain);
+  expect_positions(float3(2.0f));
+
+  /* The frame that was cached before the edit is evaluated again. */
+  set_frame(1);
+  expect_positions(float3(1.0f));
+  expect_matches_fresh_evaluation();
+}
+
+TEST_F(PlaybackGeometryCacheTest, SelectionDoesNotInvalidate)
+{
+  set_frame(1);
+  const float3 *frame_1_positions = evaluated_positions(depsgraph).data();
+  set_frame(2);
+
+  DEG_id_tag_update_ex(bmain, &object->id, ID_RECALC_SELECT);
+  BKE_scene_graph_update_tagged(depsgraph, bmain);
+  set_frame(1);
+  EXPECT_EQ(evaluated_positions(depsgraph).data(), frame_1_positions);
+  expect_matches_fresh_evaluation();
+}
+
+TEST_F(PlaybackGeometryCacheTest, DisablingClearsCache)
+{
+  set_frame(1);
+  ASSERT_GT(cache().memory_bytes(), 0);
+
+  U.experimental.use_playback_geometry_cache = 0;
+  set_frame(2);
+  EXPECT_EQ(cache().memory_bytes(), 0);
+  expect_positions(float3(2.0f));
+  expect_matches_fresh_evaluation();
+}
+
+}  // namespace blender::deg::tests
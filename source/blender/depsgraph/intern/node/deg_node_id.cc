@@ -69,6 +69,8 @@ void IDNode::init(const ID *id, const char * /*subdata*/)
   is_collection_fully_expanded = false;
   has_base = false;
   is_user_modified = false;
+  is_cow_values_sync_tagged = false;
+  is_cow_full_copy_tagged = false;
   id_cow_recalc_backup = 0;
 
   visible_components_mask = 0;
@@ -163,6 +165,7 @@ ComponentNode *IDNode::add_component(NodeType type, const char *name)
 
 void IDNode::tag_update(Depsgraph *graph, eUpdateSource source)
 {
+  is_cow_full_copy_tagged = true;
   for (ComponentNode *comp_node : components.values()) {
     /* Relations update does explicit animation update when needed. Here we ignore animation
      * component to avoid loss of possible unkeyed changes. */
@@ -123,6 +123,14 @@ struct IDNode : public Node {
   /* Copy-on-Write component has been explicitly tagged for update. */
   bool is_cow_explicitly_tagged;
 
+  /* Copy-on-Write component has been tagged for update with #ID_RECALC_SYNC_VALUES_TO_EVAL, and
+   * values can be synchronized in-place unless #is_cow_full_copy_tagged is set. */
+  bool is_cow_values_sync_tagged;
+
+  /* Copy-on-Write component has been tagged for update for changes which require a full copy of
+   * the data-block, as part of a tag which did not request values synchronization. */
+  bool is_cow_full_copy_tagged;
+
   /* Accumulate recalc flags from multiple update passes. */
   int id_cow_recalc_backup;
 
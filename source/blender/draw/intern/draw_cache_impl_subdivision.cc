@@ -857,13 +857,10 @@ static void draw_subdiv_invalidate_evaluator_for_orco(bke::subdiv::Subdiv *subdi
   const bool has_orco = CustomData_has_layer(&mesh->vert_data, CD_ORCO);
   if (has_orco && !subdiv->evaluator->eval_output->hasVertexData()) {
     /* If we suddenly have/need original coordinates, recreate the evaluator if the extra
-     * source was not created yet. The refiner also has to be recreated as refinement for source
-     * and vertex data is done only once. */
+     * source was not created yet. The refiner can be kept, its stencil and patch tables are
+     * reused by the new evaluator. */
     delete subdiv->evaluator;
     subdiv->evaluator = nullptr;
-
-    delete subdiv->topology_refiner;
-    subdiv->topology_refiner = nullptr;
   }
 }
 
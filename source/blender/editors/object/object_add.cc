@@ -59,7 +59,7 @@
 #include "BKE_customdata.hh"
 #include "BKE_displist.h"
 #include "BKE_duplilist.hh"
-#include "BKE_effect.h"
+#include "BKE_effect.hh"
 #include "BKE_geometry_set.hh"
 #include "BKE_geometry_set_instances.hh"
 #include "BKE_gpencil_geom_legacy.h"
@@ -2197,6 +2197,9 @@ static int object_delete_exec(bContext *C, wmOperator *op)
 
   BKE_main_id_tag_all(bmain, ID_TAG_DOIT, false);
 
+  /* Only objects are removed, allow the relations to be updated incrementally. */
+  DEG_relations_tag_update_objects_begin(bmain);
+
   CTX_DATA_BEGIN (C, Object *, ob, selected_objects) {
     if (ob->id.tag & ID_TAG_INDIRECT) {
       /* Can this case ever happen? */
@@ -2241,6 +2244,7 @@ static int object_delete_exec(bContext *C, wmOperator *op)
   CTX_DATA_END;
 
   if ((changed_count + tagged_count) == 0) {
+    DEG_relations_tag_update_objects_end(bmain);
     return OPERATOR_CANCELLED;
   }
 
@@ -2268,6 +2272,8 @@ static int object_delete_exec(bContext *C, wmOperator *op)
     }
   }
 
+  DEG_relations_tag_update_objects_end(bmain);
+
   return OPERATOR_FINISHED;
 }
 
@@ -4346,6 +4352,9 @@ static int duplicate_exec(bContext *C, wmOperator *op)
   }
   CTX_DATA_END;
 
+  /* Only objects and their data are added, allow the relations to be updated incrementally. */
+  DEG_relations_tag_update_objects_begin(bmain);
+
   bool new_objects_created = false;
   for (DuplicateObjectLink &link : object_base_links) {
     object_add_duplicate_internal(bmain,
@@ -4359,6 +4368,7 @@ static int duplicate_exec(bContext *C, wmOperator *op)
   }
 
   if (!new_objects_created) {
+    DEG_relations_tag_update_objects_end(bmain);
     return OPERATOR_CANCELLED;
   }
 
@@ -4401,6 +4411,7 @@ static int duplicate_exec(bContext *C, wmOperator *op)
   ED_outliner_select_sync_from_object_tag(C);
 
   DEG_relations_tag_update(bmain);
+  DEG_relations_tag_update_objects_end(bmain);
   DEG_id_tag_update(&scene->id, ID_RECALC_SYNC_TO_EVAL | ID_RECALC_SELECT);
 
   WM_event_add_notifier(C, NC_SCENE | ND_OB_SELECT, scene);
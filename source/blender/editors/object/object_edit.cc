@@ -40,7 +40,7 @@
 #include "BKE_curve.hh"
 #include "BKE_editlattice.h"
 #include "BKE_editmesh.hh"
-#include "BKE_effect.h"
+#include "BKE_effect.hh"
 #include "BKE_global.hh"
 #include "BKE_idprop.hh"
 #include "BKE_image.hh"
@@ -26,6 +26,7 @@
 #include "BLI_math_rotation.h"
 #include "BLI_rect.h"
 #include "BLI_set.hh"
+#include "BLI_simd.hh"
 #include "BLI_span.hh"
 #include "BLI_task.h"
 #include "BLI_task.hh"
@@ -88,6 +89,7 @@
 #include "sculpt_intern.hh"
 #include "sculpt_islands.hh"
 #include "sculpt_pose.hh"
+#include "sculpt_simd.hh"
 #include "sculpt_undo.hh"
 
 #include "RNA_access.hh"
@@ -6734,21 +6736,36 @@ void fill_factor_from_hide_and_mask(const Span<bool> hide_vert,
 {
   BLI_assert(verts.size() == r_factors.size());
 
-  if (!mask.is_empty()) {
-    for (const int i : verts.index_range()) {
+  /* Handle the combinations separately, so that each is a single pass over the vertices. */
+  if (!mask.is_empty() && !hide_vert.is_empty()) {
+    int i = 0;
+#if BLI_HAVE_SSE2
+    for (; i + 4 <= verts.size(); i += 4) {
+      const __m128 factor = _mm_sub_ps(_mm_set1_ps(1.0f),
+                                       simd::gather_float4(mask.data(), &verts[i]));
+      const __m128 hidden = simd::gather_bool4(hide_vert.data(), &verts[i]);
+      _mm_storeu_ps(&r_factors[i], _mm_andnot_ps(hidden, factor));
+    }
+#endif
+    for (; i < verts.size(); i++) {
+      const int vert = verts[i];
+      r_factors[i] = hide_vert[vert] ? 0.0f : 1.0f - mask[vert];
+    }
+  }
+  else if (!mask.is_empty()) {
+    int i = 0;
+#if BLI_HAVE_SSE2
+    for (; i + 4 <= verts.size(); i += 4) {
+      _mm_storeu_ps(&r_factors[i],
+                    _mm_sub_ps(_mm_set1_ps(1.0f), simd::gather_float4(mask.data(), &verts[i])));
+    }
+#endif
+    for (; i < verts.size(); i++) {
       r_factors[i] = 1.0f - mask[verts[i]];
     }
   }
   else {
-    r_factors.fill(1.0f);
-  }
-
-  if (!hide_vert.is_empty()) {
-    for (const int i : verts.index_range()) {
-      if (hide_vert[verts[i]]) {
-        r_factors[i] = 0.0f;
-      }
-    }
+    fill_factor_from_hide(hide_vert, verts, r_factors);
   }
 }
 
@@ -6931,6 +6948,51 @@ void filter_region_clip_factors(const SculptSession &ss,
   }
 }
 
+#if BLI_HAVE_SSE2
+/** The same as #math::distance_squared for four positions. */
+static __m128 distances_squared_simd(const simd::Float3x4 &positions, const float3 &location)
+{
+  const __m128 x = _mm_sub_ps(_mm_set1_ps(location.x), positions.x);
+  const __m128 y = _mm_sub_ps(_mm_set1_ps(location.y), positions.y);
+  const __m128 z = _mm_sub_ps(_mm_set1_ps(location.z), positions.z);
+  return _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y)), _mm_mul_ps(z, z));
+}
+
+/** Squared distances of four positions projected on the plane, like the tube falloff shape. */
+static __m128 distances_squared_to_plane_simd(const simd::Float3x4 &positions,
+                                              const float4 &plane,
+                                              const float3 &location)
+{
+  /* The same operations as #closest_to_plane_normalized_v3. */
+  const __m128 normal_x = _mm_set1_ps(plane.x);
+  const __m128 normal_y = _mm_set1_ps(plane.y);
+  const __m128 normal_z = _mm_set1_ps(plane.z);
+  const __m128 side = _mm_add_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(normal_x, positions.x),
+                                                       _mm_mul_ps(normal_y, positions.y)),
+                                            _mm_mul_ps(normal_z, positions.z)),
+                                 _mm_set1_ps(plane.w));
+  const __m128 side_neg = _mm_sub_ps(_mm_setzero_ps(), side);
+  simd::Float3x4 projected;
+  projected.x = _mm_add_ps(positions.x, _mm_mul_ps(normal_x, side_neg));
+  projected.y = _mm_add_ps(positions.y, _mm_mul_ps(normal_y, side_neg));
+  projected.z = _mm_add_ps(positions.z, _mm_mul_ps(normal_z, side_neg));
+  return distances_squared_simd(projected, location);
+}
+#endif
+
+static void sqrt_distances(const MutableSpan<float> distances)
+{
+  int i = 0;
+#if BLI_HAVE_SSE2
+  for (; i + 4 <= distances.size(); i += 4) {
+    _mm_storeu_ps(&distances[i], _mm_sqrt_ps(_mm_loadu_ps(&distances[i])));
+  }
+#endif
+  for (; i < distances.size(); i++) {
+    distances[i] = std::sqrt(distances[i]);
+  }
+}
+
 void calc_brush_distances_squared(const SculptSession &ss,
                                   const Span<float3> positions,
                                   const Span<int> verts,
@@ -6946,14 +7008,32 @@ void calc_brush_distances_squared(const SculptSession &ss,
                                            ss.filter_cache->view_normal;
     float4 test_plane;
     plane_from_point_normal_v3(test_plane, test_location, view_normal);
-    for (const int i : verts.index_range()) {
+    int i = 0;
+#if BLI_HAVE_SSE2
+    for (; i + 4 <= verts.size(); i += 4) {
+      _mm_storeu_ps(&r_distances[i],
+                    distances_squared_to_plane_simd(
+                        simd::gather_float3x4(positions.data(), &verts[i]),
+                        test_plane,
+                        test_location));
+    }
+#endif
+    for (; i < verts.size(); i++) {
       float3 projected;
       closest_to_plane_normalized_v3(projected, test_plane, positions[verts[i]]);
       r_distances[i] = math::distance_squared(projected, test_location);
     }
   }
   else {
-    for (const int i : verts.index_range()) {
+    int i = 0;
+#if BLI_HAVE_SSE2
+    for (; i + 4 <= verts.size(); i += 4) {
+      _mm_storeu_ps(&r_distances[i],
+                    distances_squared_simd(simd::gather_float3x4(positions.data(), &verts[i]),
+                                           test_location));
+    }
+#endif
+    for (; i < verts.size(); i++) {
       r_distances[i] = math::distance_squared(test_location, positions[verts[i]]);
     }
   }
@@ -6966,9 +7046,7 @@ void calc_brush_distances(const SculptSession &ss,
                           const MutableSpan<float> r_distances)
 {
   calc_brush_distances_squared(ss, positions, verts, falloff_shape, r_distances);
-  for (float &value : r_distances) {
-    value = std::sqrt(value);
-  }
+  sqrt_distances(r_distances);
 }
 
 void calc_brush_distances_squared(const SculptSession &ss,
@@ -6985,14 +7063,29 @@ void calc_brush_distances_squared(const SculptSession &ss,
                                            ss.filter_cache->view_normal;
     float4 test_plane;
     plane_from_point_normal_v3(test_plane, test_location, view_normal);
-    for (const int i : positions.index_range()) {
+    int i = 0;
+#if BLI_HAVE_SSE2
+    for (; i + 4 <= positions.size(); i += 4) {
+      _mm_storeu_ps(&r_distances[i],
+                    distances_squared_to_plane_simd(
+                        simd::load_float3x4(&positions[i]), test_plane, test_location));
+    }
+#endif
+    for (; i < positions.size(); i++) {
       float3 projected;
       closest_to_plane_normalized_v3(projected, test_plane, positions[i]);
       r_distances[i] = math::distance_squared(projected, test_location);
     }
   }
   else {
-    for (const int i : positions.index_range()) {
+    int i = 0;
+#if BLI_HAVE_SSE2
+    for (; i + 4 <= positions.size(); i += 4) {
+      _mm_storeu_ps(&r_distances[i],
+                    distances_squared_simd(simd::load_float3x4(&positions[i]), test_location));
+    }
+#endif
+    for (; i < positions.size(); i++) {
       r_distances[i] = math::distance_squared(test_location, positions[i]);
     }
   }
@@ -7004,19 +7097,23 @@ void calc_brush_distances(const SculptSession &ss,
                           const MutableSpan<float> r_distances)
 {
   calc_brush_distances_squared(ss, positions, falloff_shape, r_distances);
-  for (float &value : r_distances) {
-    value = std::sqrt(value);
-  }
+  sqrt_distances(r_distances);
 }
 
 void filter_distances_with_radius(const float radius,
                                   const Span<float> distances,
                                   const MutableSpan<float> factors)
 {
-  for (const int i : distances.index_range()) {
-    if (distances[i] >= radius) {
-      factors[i] = 0.0f;
-    }
+  int i = 0;
+#if BLI_HAVE_SSE2
+  const __m128 radius_v = _mm_set1_ps(radius);
+  for (; i + 4 <= distances.size(); i += 4) {
+    const __m128 inside = _mm_cmplt_ps(_mm_loadu_ps(&distances[i]), radius_v);
+    _mm_storeu_ps(&factors[i], _mm_and_ps(inside, _mm_loadu_ps(&factors[i])));
+  }
+#endif
+  for (; i < distances.size(); i++) {
+    factors[i] = distances[i] < radius ? factors[i] : 0.0f;
   }
 }
 
@@ -7115,14 +7212,22 @@ void apply_hardness_to_distances(const float radius,
   }
   const float radius_inv = math::rcp(radius);
   const float hardness_inv_rcp = math::rcp(1.0f - hardness);
-  for (const int i : distances.index_range()) {
-    if (distances[i] < threshold) {
-      distances[i] = 0.0f;
-    }
-    else {
-      const float radius_factor = (distances[i] * radius_inv - hardness) * hardness_inv_rcp;
-      distances[i] = radius_factor * radius;
-    }
+  int i = 0;
+#if BLI_HAVE_SSE2
+  const __m128 threshold_v = _mm_set1_ps(threshold);
+  for (; i + 4 <= distances.size(); i += 4) {
+    const __m128 distance = _mm_loadu_ps(&distances[i]);
+    const __m128 radius_factor = _mm_mul_ps(
+        _mm_sub_ps(_mm_mul_ps(distance, _mm_set1_ps(radius_inv)), _mm_set1_ps(hardness)),
+        _mm_set1_ps(hardness_inv_rcp));
+    const __m128 outside = _mm_cmpge_ps(distance, threshold_v);
+    _mm_storeu_ps(&distances[i],
+                  _mm_and_ps(outside, _mm_mul_ps(radius_factor, _mm_set1_ps(radius))));
+  }
+#endif
+  for (; i < distances.size(); i++) {
+    const float radius_factor = (distances[i] * radius_inv - hardness) * hardness_inv_rcp;
+    distances[i] = distances[i] < threshold ? 0.0f : radius_factor * radius;
   }
 }
 
@@ -7427,7 +7532,18 @@ void PositionDeformData::deform(MutableSpan<float3> translations, const Span<int
 
 void scale_translations(const MutableSpan<float3> translations, const Span<float> factors)
 {
-  for (const int i : translations.index_range()) {
+  int i = 0;
+#if BLI_HAVE_SSE2
+  for (; i + 4 <= translations.size(); i += 4) {
+    float *data = &translations[i].x;
+    __m128 factor[3];
+    simd::expand_to_float3x4(_mm_loadu_ps(&factors[i]), factor);
+    _mm_storeu_ps(data, _mm_mul_ps(_mm_loadu_ps(data), factor[0]));
+    _mm_storeu_ps(data + 4, _mm_mul_ps(_mm_loadu_ps(data + 4), factor[1]));
+    _mm_storeu_ps(data + 8, _mm_mul_ps(_mm_loadu_ps(data + 8), factor[2]));
+  }
+#endif
+  for (; i < translations.size(); i++) {
     translations[i] *= factors[i];
   }
 }
@@ -7467,7 +7583,20 @@ void translations_from_offset_and_factors(const float3 &offset,
 {
   BLI_assert(r_translations.size() == factors.size());
 
-  for (const int i : factors.index_range()) {
+  int i = 0;
+#if BLI_HAVE_SSE2
+  __m128 offset_v[3];
+  simd::broadcast_to_float3x4(offset, offset_v);
+  for (; i + 4 <= factors.size(); i += 4) {
+    float *data = &r_translations[i].x;
+    __m128 factor[3];
+    simd::expand_to_float3x4(_mm_loadu_ps(&factors[i]), factor);
+    _mm_storeu_ps(data, _mm_mul_ps(offset_v[0], factor[0]));
+    _mm_storeu_ps(data + 4, _mm_mul_ps(offset_v[1], factor[1]));
+    _mm_storeu_ps(data + 8, _mm_mul_ps(offset_v[2], factor[2]));
+  }
+#endif
+  for (; i < factors.size(); i++) {
     r_translations[i] = offset * factors[i];
   }
 }
@@ -7478,7 +7607,19 @@ void translations_from_new_positions(const Span<float3> new_positions,
                                      const MutableSpan<float3> translations)
 {
   BLI_assert(new_positions.size() == verts.size());
-  for (const int i : verts.index_range()) {
+  int i = 0;
+#if BLI_HAVE_SSE2
+  for (; i + 4 <= verts.size(); i += 4) {
+    const simd::Float3x4 new_position = simd::load_float3x4(&new_positions[i]);
+    const simd::Float3x4 old_position = simd::gather_float3x4(old_positions.data(), &verts[i]);
+    simd::Float3x4 translation;
+    translation.x = _mm_sub_ps(new_position.x, old_position.x);
+    translation.y = _mm_sub_ps(new_position.y, old_position.y);
+    translation.z = _mm_sub_ps(new_position.z, old_position.z);
+    simd::store_float3x4(translation, &translations[i]);
+  }
+#endif
+  for (; i < verts.size(); i++) {
     translations[i] = new_positions[i] - old_positions[verts[i]];
   }
 }
@@ -0,0 +1,117 @@
+/* SPDX-FileCopyrightText: 2025 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup edsculpt
+ *
+ * Helpers for the SIMD brush kernels. Node vertex data is stored as arrays of #float3, the
+ * kernels gather four vertices into one register per component (structure of arrays), do the
+ * math for all four at once and scatter the results back to the #float3 layout.
+ */
+
+#pragma once
+
+#include "BLI_math_vector_types.hh"
+#include "BLI_simd.hh"
+
+namespace blender::ed::sculpt_paint::simd {
+
+#if BLI_HAVE_SSE2
+
+/** Four vectors, one register per component. */
+struct Float3x4 {
+  __m128 x;
+  __m128 y;
+  __m128 z;
+};
+
+/** Load four consecutive vectors. */
+inline Float3x4 load_float3x4(const float3 *src)
+{
+  const float *data = &src->x;
+  /* `x0 y0 z0 x1`, `y1 z1 x2 y2` and `z2 x3 y3 z3`. */
+  const __m128 a = _mm_loadu_ps(data);
+  const __m128 b = _mm_loadu_ps(data + 4);
+  const __m128 c = _mm_loadu_ps(data + 8);
+  const __m128 x2y2x3y3 = _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 0, 3, 2));
+  const __m128 y0y0y1y1 = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 0, 2, 1));
+  const __m128 y2y2y3y3 = _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3));
+  const __m128 z0z0z1z1 = _mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2));
+  Float3x4 result;
+  result.x = _mm_shuffle_ps(a, x2y2x3y3, _MM_SHUFFLE(3, 0, 3, 0));
+  result.y = _mm_shuffle_ps(y0y0y1y1, y2y2y3y3, _MM_SHUFFLE(2, 0, 2, 0));
+  result.z = _mm_shuffle_ps(z0z0z1z1, c, _MM_SHUFFLE(3, 0, 2, 0));
+  return result;
+}
+
+/** Gather the vectors at four indices. */
+inline Float3x4 gather_float3x4(const float3 *src, const int *indices)
+{
+  const float3 &a = src[indices[0]];
+  const float3 &b = src[indices[1]];
+  const float3 &c = src[indices[2]];
+  const float3 &d = src[indices[3]];
+  Float3x4 result;
+  result.x = _mm_setr_ps(a.x, b.x, c.x, d.x);
+  result.y = _mm_setr_ps(a.y, b.y, c.y, d.y);
+  result.z = _mm_setr_ps(a.z, b.z, c.z, d.z);
+  return result;
+}
+
+/** Store four vectors consecutively, the inverse of #load_float3x4. */
+inline void store_float3x4(const Float3x4 &value, float3 *dst)
+{
+  float *data = &dst->x;
+  const __m128 xy_low = _mm_unpacklo_ps(value.x, value.y);
+  const __m128 xy_high = _mm_unpackhi_ps(value.x, value.y);
+  const __m128 z0z0x1x1 = _mm_shuffle_ps(value.z, value.x, _MM_SHUFFLE(1, 1, 0, 0));
+  const __m128 y1y1z1z1 = _mm_shuffle_ps(value.y, value.z, _MM_SHUFFLE(1, 1, 1, 1));
+  const __m128 z2z2x3x3 = _mm_shuffle_ps(value.z, value.x, _MM_SHUFFLE(3, 3, 2, 2));
+  const __m128 y3y3z3z3 = _mm_shuffle_ps(value.y, value.z, _MM_SHUFFLE(3, 3, 3, 3));
+  _mm_storeu_ps(data, _mm_shuffle_ps(xy_low, z0z0x1x1, _MM_SHUFFLE(2, 0, 1, 0)));
+  _mm_storeu_ps(data + 4, _mm_shuffle_ps(y1y1z1z1, xy_high, _MM_SHUFFLE(1, 0, 2, 0)));
+  _mm_storeu_ps(data + 8, _mm_shuffle_ps(z2z2x3x3, y3y3z3z3, _MM_SHUFFLE(2, 0, 2, 0)));
+}
+
+/**
+ * Repeat every value three times, so that the registers line up with four consecutive #float3
+ * loaded as three plain registers: `f0 f0 f0 f1`, `f1 f1 f2 f2` and `f2 f3 f3 f3`.
+ */
+inline void expand_to_float3x4(const __m128 value, __m128 r_values[3])
+{
+  r_values[0] = _mm_shuffle_ps(value, value, _MM_SHUFFLE(1, 0, 0, 0));
+  r_values[1] = _mm_shuffle_ps(value, value, _MM_SHUFFLE(2, 2, 1, 1));
+  r_values[2] = _mm_shuffle_ps(value, value, _MM_SHUFFLE(3, 3, 3, 2));
+}
+
+/** A vector repeated to line up with four consecutive #float3, see #expand_to_float3x4. */
+inline void broadcast_to_float3x4(const float3 &value, __m128 r_values[3])
+{
+  r_values[0] = _mm_setr_ps(value.x, value.y, value.z, value.x);
+  r_values[1] = _mm_setr_ps(value.y, value.z, value.x, value.y);
+  r_values[2] = _mm_setr_ps(value.z, value.x, value.y, value.z);
+}
+
+/** Gather the values at four indices. */
+inline __m128 gather_float4(const float *src, const int *indices)
+{
+  return _mm_setr_ps(src[indices[0]], src[indices[1]], src[indices[2]], src[indices[3]]);
+}
+
+/** A lane mask of the booleans at four indices. */
+inline __m128 gather_bool4(const bool *src, const int *indices)
+{
+  return _mm_castsi128_ps(_mm_setr_epi32(
+      -int(src[indices[0]]), -int(src[indices[1]]), -int(src[indices[2]]), -int(src[indices[3]])));
+}
+
+/** Select \a a in the lanes where \a mask is set, and \a b elsewhere. */
+inline __m128 select(const __m128 mask, const __m128 a, const __m128 b)
+{
+  return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+#endif
+
+}  // namespace blender::ed::sculpt_paint::simd
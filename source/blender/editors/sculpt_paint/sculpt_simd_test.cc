@@ -0,0 +1,251 @@
+/* SPDX-FileCopyrightText: 2025 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup edsculpt
+ *
+ * Compare the SIMD brush kernels with the scalar computations they replace. The sizes are not
+ * multiples of four, so that the scalar remainder loops are tested as well.
+ */
+
+#include "BLI_array.hh"
+#include "BLI_math_geom.h"
+#include "BLI_math_vector.hh"
+#include "BLI_rand.hh"
+
+#include "DNA_brush_enums.h"
+
+#include "BKE_brush.hh"
+#include "BKE_paint.hh"
+
+#include "mesh_brush_common.hh"
+#include "sculpt_automask.hh"
+#include "sculpt_cloth.hh"
+#include "sculpt_filter.hh"
+#include "sculpt_simd.hh"
+
+#include "testing/testing.h"
+
+namespace blender::ed::sculpt_paint::tests {
+
+static Array<float3> random_positions(const int size, const uint32_t seed)
+{
+  RandomNumberGenerator rng(seed);
+  Array<float3> positions(size);
+  for (float3 &position : positions) {
+    position = float3(rng.get_float(), rng.get_float(), rng.get_float()) * 2.0f - 1.0f;
+  }
+  return positions;
+}
+
+static Array<float> random_floats(const int size, const uint32_t seed)
+{
+  RandomNumberGenerator rng(seed);
+  Array<float> values(size);
+  for (float &value : values) {
+    value = rng.get_float();
+  }
+  return values;
+}
+
+/** Vertex indices of a node, in a different order than the positions. */
+static Array<int> node_verts(const int size, const int verts_num)
+{
+  Array<int> verts(size);
+  for (const int i : verts.index_range()) {
+    verts[i] = (i * 7919) % verts_num;
+  }
+  return verts;
+}
+
+#if BLI_HAVE_SSE2
+TEST(sculpt_simd, LoadStoreFloat3x4)
+{
+  const Array<float3> src = random_positions(4, 1);
+  const simd::Float3x4 value = simd::load_float3x4(src.data());
+  float x[4], y[4], z[4];
+  _mm_storeu_ps(x, value.x);
+  _mm_storeu_ps(y, value.y);
+  _mm_storeu_ps(z, value.z);
+  for (const int i : IndexRange(4)) {
+    EXPECT_EQ(float3(x[i], y[i], z[i]), src[i]);
+  }
+
+  Array<float3> dst(4);
+  simd::store_float3x4(value, dst.data());
+  EXPECT_EQ(dst.as_span(), src.as_span());
+
+  const int indices[4] = {2, 0, 3, 0};
+  const simd::Float3x4 gathered = simd::gather_float3x4(src.data(), indices);
+  simd::store_float3x4(gathered, dst.data());
+  for (const int i : IndexRange(4)) {
+    EXPECT_EQ(dst[i], src[indices[i]]);
+  }
+}
+
+TEST(sculpt_simd, ExpandFloat3x4)
+{
+  __m128 values[3];
+  simd::expand_to_float3x4(_mm_setr_ps(0.0f, 1.0f, 2.0f, 3.0f), values);
+  float result[12];
+  _mm_storeu_ps(result, values[0]);
+  _mm_storeu_ps(result + 4, values[1]);
+  _mm_storeu_ps(result + 8, values[2]);
+  for (const int i : IndexRange(12)) {
+    EXPECT_EQ(result[i], float(i / 3));
+  }
+
+  simd::broadcast_to_float3x4(float3(4.0f, 5.0f, 6.0f), values);
+  _mm_storeu_ps(result, values[0]);
+  _mm_storeu_ps(result + 4, values[1]);
+  _mm_storeu_ps(result + 8, values[2]);
+  for (const int i : IndexRange(12)) {
+    EXPECT_EQ(result[i], float(4 + i % 3));
+  }
+}
+#endif
+
+TEST(sculpt_simd, BrushDistances)
+{
+  const Array<float3> positions = random_positions(1000, 2);
+  const Array<int> verts = node_verts(103, positions.size());
+  SculptSession ss;
+  ss.cursor_location = float3(0.1f, -0.2f, 0.3f);
+
+  Array<float> distances(verts.size());
+  calc_brush_distances(ss, positions, verts, PAINT_FALLOFF_SHAPE_SPHERE, distances);
+  for (const int i : verts.index_range()) {
+    EXPECT_EQ(distances[i], math::distance(ss.cursor_location, positions[verts[i]]));
+  }
+
+  const Span<float3> node_positions = positions.as_span().take_front(verts.size());
+  calc_brush_distances(ss, node_positions, PAINT_FALLOFF_SHAPE_SPHERE, distances);
+  for (const int i : node_positions.index_range()) {
+    EXPECT_EQ(distances[i], math::distance(ss.cursor_location, node_positions[i]));
+  }
+
+  filter::Cache filter_cache;
+  filter_cache.view_normal = math::normalize(float3(1.0f, 2.0f, -0.5f));
+  ss.filter_cache = &filter_cache;
+  float4 plane;
+  plane_from_point_normal_v3(plane, ss.cursor_location, filter_cache.view_normal);
+  auto tube_distance = [&](const float3 &position) {
+    float3 projected;
+    closest_to_plane_normalized_v3(projected, plane, position);
+    return math::distance(projected, ss.cursor_location);
+  };
+
+  calc_brush_distances(ss, positions, verts, PAINT_FALLOFF_SHAPE_TUBE, distances);
+  for (const int i : verts.index_range()) {
+    EXPECT_FLOAT_EQ(distances[i], tube_distance(positions[verts[i]]));
+  }
+  calc_brush_distances(ss, node_positions, PAINT_FALLOFF_SHAPE_TUBE, distances);
+  for (const int i : node_positions.index_range()) {
+    EXPECT_FLOAT_EQ(distances[i], tube_distance(node_positions[i]));
+  }
+  ss.filter_cache = nullptr;
+}
+
+TEST(sculpt_simd, FilterDistances)
+{
+  const Array<float> distances = random_floats(103, 3);
+  Array<float> factors = random_floats(103, 4);
+  const Array<float> orig_factors = factors;
+  filter_distances_with_radius(0.5f, distances, factors);
+  for (const int i : distances.index_range()) {
+    EXPECT_EQ(factors[i], distances[i] < 0.5f ? orig_factors[i] : 0.0f);
+  }
+}
+
+TEST(sculpt_simd, Hardness)
+{
+  const float radius = 2.0f;
+  const float hardness = 0.3f;
+  const Array<float> orig_distances = random_floats(103, 5);
+  Array<float> distances = orig_distances;
+  apply_hardness_to_distances(radius, hardness, distances);
+  for (const int i : distances.index_range()) {
+    const float distance = orig_distances[i];
+    const float expected = distance < hardness * radius ?
+                               0.0f :
+                               (distance / radius - hardness) / (1.0f - hardness) * radius;
+    EXPECT_NEAR(distances[i], expected, 1e-6f);
+  }
+}
+
+TEST(sculpt_simd, HideAndMask)
+{
+  const int verts_num = 500;
+  const Array<float> mask = random_floats(verts_num, 6);
+  Array<bool> hide_vert(verts_num);
+  for (const int i : hide_vert.index_range()) {
+    hide_vert[i] = i % 5 == 0;
+  }
+  const Array<int> verts = node_verts(103, verts_num);
+
+  Array<float> factors(verts.size());
+  fill_factor_from_hide_and_mask(hide_vert, mask, verts, factors);
+  for (const int i : verts.index_range()) {
+    EXPECT_EQ(factors[i], hide_vert[verts[i]] ? 0.0f : 1.0f - mask[verts[i]]);
+  }
+
+  fill_factor_from_hide_and_mask({}, mask, verts, factors);
+  for (const int i : verts.index_range()) {
+    EXPECT_EQ(factors[i], 1.0f - mask[verts[i]]);
+  }
+}
+
+TEST(sculpt_simd, Translations)
+{
+  const Array<float> factors = random_floats(103, 7);
+  const float3 offset(0.5f, -1.0f, 2.0f);
+  Array<float3> translations(factors.size());
+  translations_from_offset_and_factors(offset, factors, translations);
+  for (const int i : factors.index_range()) {
+    EXPECT_EQ(translations[i], offset * factors[i]);
+  }
+
+  const Array<float3> orig_translations = translations;
+  scale_translations(translations, factors);
+  for (const int i : factors.index_range()) {
+    EXPECT_EQ(translations[i], orig_translations[i] * factors[i]);
+  }
+
+  const Array<float3> old_positions = random_positions(500, 8);
+  const Array<float3> new_positions = random_positions(103, 9);
+  const Array<int> verts = node_verts(103, old_positions.size());
+  translations_from_new_positions(new_positions, verts, old_positions, translations);
+  for (const int i : verts.index_range()) {
+    EXPECT_EQ(translations[i], new_positions[i] - old_positions[verts[i]]);
+  }
+}
+
+TEST(sculpt_simd, CurveFactors)
+{
+  const float radius = 0.8f;
+  const Array<float> distances = random_floats(103, 10);
+  const Array<float> orig_factors = random_floats(103, 11);
+  for (const eBrushCurvePreset preset : {BRUSH_CURVE_SHARP,
+                                         BRUSH_CURVE_SMOOTH,
+                                         BRUSH_CURVE_SMOOTHER,
+                                         BRUSH_CURVE_ROOT,
+                                         BRUSH_CURVE_LIN,
+                                         BRUSH_CURVE_CONSTANT,
+                                         BRUSH_CURVE_SPHERE,
+                                         BRUSH_CURVE_POW4,
+                                         BRUSH_CURVE_INVSQUARE})
+  {
+    Array<float> factors = orig_factors;
+    BKE_brush_calc_curve_factors(preset, nullptr, distances, radius, factors);
+    for (const int i : distances.index_range()) {
+      const float expected = preset == BRUSH_CURVE_CONSTANT ?
+                                 orig_factors[i] :
+                                 orig_factors[i] * BKE_brush_curve_strength(
+                                                       preset, nullptr, distances[i], radius);
+      EXPECT_NEAR(factors[i], expected, 1e-6f) << "preset " << int(preset);
+    }
+  }
+}
+
+}  // namespace blender::ed::sculpt_paint::tests
@@ -29,8 +29,11 @@
  */
 #include "sculpt_undo.hh"
 
+#include <array>
 #include <mutex>
 
+#include <zstd.h>
+
 #include "CLG_log.h"
 
 #include "BLI_array.hh"
@@ -38,6 +41,8 @@
 #include "BLI_listbase.h"
 #include "BLI_map.hh"
 #include "BLI_string.h"
+#include "BLI_task.h"
+#include "BLI_task.hh"
 #include "BLI_utildefines.h"
 #include "BLI_vector.hh"
 
@@ -85,6 +90,7 @@
 #include "sculpt_dyntopo.hh"
 #include "sculpt_face_set.hh"
 #include "sculpt_intern.hh"
+#include "sculpt_undo_node.hh"
 
 static CLG_LogRef LOG = {"ed.sculpt.undo"};
 
@@ -124,40 +130,6 @@ namespace blender::ed::sculpt_paint::undo {
 
 #define NO_ACTIVE_LAYER bke::AttrDomain::Auto
 
-struct Node {
-  Array<float3, 0> position;
-  Array<float3, 0> orig_position;
-  Array<float3, 0> normal;
-  Array<float4, 0> col;
-  Array<float, 0> mask;
-
-  Array<float4, 0> loop_col;
-
-  /* Mesh. */
-
-  Array<int, 0> vert_indices;
-  int unique_verts_num;
-
-  /**
-   * \todo Storing corners rather than faces is unnecessary.
-   */
-  Vector<int, 0> corner_indices;
-
-  BitVector<0> vert_hidden;
-  BitVector<0> face_hidden;
-
-  /* Multires. */
-
-  /** Indices of grids in the pbvh::Tree node. */
-  Array<int, 0> grids;
-  BitGroupVector<0> grid_hidden;
-
-  /* Sculpt Face Sets */
-  Array<int, 0> face_sets;
-
-  Vector<int> face_indices;
-};
-
 struct SculptAttrRef {
   bke::AttrDomain domain;
   eCustomDataType type;
@@ -250,6 +222,12 @@ struct StepData {
   Vector<std::unique_ptr<Node>> nodes;
 
   size_t undo_size;
+
+  /**
+   * Compresses the node data again in the background after the step was undone or redone, see
+   * #compress_nodes_in_background. The nodes must not be accessed while it is running.
+   */
+  TaskPool *compress_task_pool = nullptr;
 };
 
 struct SculptUndoStep {
@@ -264,10 +242,230 @@ struct SculptUndoStep {
   SculptAttrRef active_color_end;
 };
 
+/* -------------------------------------------------------------------- */
+/** \name Node Data Compression
+ *
+ * Every stroke can store a copy of a large part of the mesh, so the data arrays of undo nodes are
+ * compressed when the undo step is finished, and only decompressed while the step is undone or
+ * redone. All arrays consist of 32 bit components. Before compression, each component is XOR-ed
+ * with the same component of the previous element and the bytes are grouped by significance.
+ * Neighboring elements usually have similar values, which gives long runs of zero bytes that
+ * compress well. The encoding is lossless.
+ * \{ */
+
+/** Compressing very small nodes isn't worth the overhead. */
+static constexpr int64_t compress_min_bytes = 1024;
+
+template<typename Fn> static void foreach_compressed_array(Node &node, const Fn &fn)
+{
+  fn(node.position);
+  fn(node.orig_position);
+  fn(node.col);
+  fn(node.mask);
+  fn(node.loop_col);
+  fn(node.face_sets);
+  fn(node.vert_indices);
+}
+
+template<typename T> static void encode_array(const Span<T> src, MutableSpan<std::byte> dst)
+{
+  static_assert(sizeof(T) % sizeof(uint32_t) == 0);
+  constexpr int64_t stride = sizeof(T) / sizeof(uint32_t);
+  const Span<uint32_t> words(reinterpret_cast<const uint32_t *>(src.data()), src.size() * stride);
+  const int64_t words_num = words.size();
+  for (const int64_t i : words.index_range()) {
+    const uint32_t word = i < stride ? words[i] : words[i] ^ words[i - stride];
+    for (const int64_t byte : IndexRange(sizeof(uint32_t))) {
+      dst[byte * words_num + i] = std::byte((word >> (byte * 8)) & 0xff);
+    }
+  }
+}
+
+template<typename T> static void decode_array(const Span<std::byte> src, MutableSpan<T> dst)
+{
+  constexpr int64_t stride = sizeof(T) / sizeof(uint32_t);
+  MutableSpan<uint32_t> words(reinterpret_cast<uint32_t *>(dst.data()), dst.size() * stride);
+  const int64_t words_num = words.size();
+  for (const int64_t i : words.index_range()) {
+    uint32_t word = 0;
+    for (const int64_t byte : IndexRange(sizeof(uint32_t))) {
+      word |= uint32_t(src[byte * words_num + i]) << (byte * 8);
+    }
+    words[i] = i < stride ? word : word ^ words[i - stride];
+  }
+}
+
+static int64_t compressed_arrays_size_in_bytes(Node &node)
+{
+  int64_t size = 0;
+  foreach_compressed_array(node, [&](const auto &array) {
+    size += array.as_span().size_in_bytes();
+  });
+  return size;
+}
+
+void compress_node_data(Node &node)
+{
+  const int64_t size = compressed_arrays_size_in_bytes(node);
+  if (size < compress_min_bytes) {
+    return;
+  }
+  Array<std::byte> encoded(size);
+  int64_t offset = 0;
+  int array_index = 0;
+  foreach_compressed_array(node, [&](const auto &array) {
+    const int64_t array_size = array.as_span().size_in_bytes();
+    encode_array(array.as_span(), encoded.as_mutable_span().slice(offset, array_size));
+    node.compressed_sizes[array_index++] = array.size();
+    offset += array_size;
+  });
+
+  Array<std::byte> compressed(ZSTD_compressBound(size));
+  const size_t compressed_size = ZSTD_compress(
+      compressed.data(), compressed.size(), encoded.data(), encoded.size(), 1);
+  if (ZSTD_isError(compressed_size)) {
+    CLOG_WARN(&LOG, "Failed to compress undo node: %s", ZSTD_getErrorName(compressed_size));
+    return;
+  }
+  node.compressed_data.reinitialize(compressed_size);
+  node.compressed_data.as_mutable_span().copy_from(
+      compressed.as_span().take_front(compressed_size));
+  foreach_compressed_array(node, [&](auto &array) { array = {}; });
+}
+
+void decompress_node_data(Node &node)
+{
+  if (node.compressed_data.is_empty()) {
+    return;
+  }
+  int64_t size = 0;
+  int array_index = 0;
+  foreach_compressed_array(node, [&](auto &array) {
+    array.reinitialize(node.compressed_sizes[array_index++]);
+    size += array.as_span().size_in_bytes();
+  });
+
+  Array<std::byte> encoded(size);
+  const size_t decompressed_size = ZSTD_decompress(
+      encoded.data(), encoded.size(), node.compressed_data.data(), node.compressed_data.size());
+  BLI_assert(!ZSTD_isError(decompressed_size) && decompressed_size == size_t(size));
+  UNUSED_VARS_NDEBUG(decompressed_size);
+
+  int64_t offset = 0;
+  foreach_compressed_array(node, [&](auto &array) {
+    const int64_t array_size = array.as_span().size_in_bytes();
+    decode_array(encoded.as_span().slice(offset, array_size), array.as_mutable_span());
+    offset += array_size;
+  });
+  node.compressed_data = {};
+}
+
+static void compress_nodes(const Span<std::unique_ptr<Node>> nodes)
+{
+  threading::parallel_for(nodes.index_range(), 1, [&](const IndexRange range) {
+    for (const int i : range) {
+      compress_node_data(*nodes[i]);
+    }
+  });
+}
+
+static void decompress_nodes(const Span<std::unique_ptr<Node>> nodes)
+{
+  threading::parallel_for(nodes.index_range(), 1, [&](const IndexRange range) {
+    for (const int i : range) {
+      decompress_node_data(*nodes[i]);
+    }
+  });
+}
+
+static size_t node_size_in_bytes(const Node &node)
+{
+  size_t size = sizeof(Node);
+  size += node.position.as_span().size_in_bytes();
+  size += node.orig_position.as_span().size_in_bytes();
+  size += node.normal.as_span().size_in_bytes();
+  size += node.col.as_span().size_in_bytes();
+  size += node.mask.as_span().size_in_bytes();
+  size += node.loop_col.as_span().size_in_bytes();
+  size += node.vert_indices.as_span().size_in_bytes();
+  size += node.corner_indices.as_span().size_in_bytes();
+  size += node.vert_hidden.size() / 8;
+  size += node.face_hidden.size() / 8;
+  size += node.grids.as_span().size_in_bytes();
+  size += node.grid_hidden.all_bits().size() / 8;
+  size += node.face_sets.as_span().size_in_bytes();
+  size += node.face_indices.as_span().size_in_bytes();
+  size += node.compressed_data.as_span().size_in_bytes();
+  return size;
+}
+
+static size_t nodes_size_in_bytes(const Span<std::unique_ptr<Node>> nodes)
+{
+  return threading::parallel_reduce(
+      nodes.index_range(),
+      16,
+      size_t(0),
+      [&](const IndexRange range, size_t size) {
+        for (const int i : range) {
+          size += node_size_in_bytes(*nodes[i]);
+        }
+        return size;
+      },
+      std::plus<size_t>());
+}
+
+static void compress_nodes_task(TaskPool *__restrict pool, void * /*taskdata*/)
+{
+  StepData &step_data = *static_cast<StepData *>(BLI_task_pool_user_data(pool));
+  compress_nodes(step_data.nodes);
+  step_data.undo_size = nodes_size_in_bytes(step_data.nodes);
+}
+
+/**
+ * Restoring a step swaps the data of its nodes with the mesh, so the nodes have to be compressed
+ * again afterwards. That is done in the background to keep undo and redo responsive, the size of
+ * the step is updated by #wait_for_compression.
+ */
+static void compress_nodes_in_background(SculptUndoStep &us)
+{
+  StepData &step_data = us.data;
+  BLI_assert(step_data.compress_task_pool == nullptr);
+  us.step.data_size = nodes_size_in_bytes(step_data.nodes);
+  step_data.compress_task_pool = BLI_task_pool_create_background(&step_data, TASK_PRIORITY_LOW);
+  BLI_task_pool_push(step_data.compress_task_pool, compress_nodes_task, nullptr, false, nullptr);
+}
+
+/** Finish the background compression of the step, if any, and update its size. */
+static void wait_for_compression(SculptUndoStep &us)
+{
+  if (us.data.compress_task_pool == nullptr) {
+    return;
+  }
+  BLI_task_pool_work_and_wait(us.data.compress_task_pool);
+  BLI_task_pool_free(us.data.compress_task_pool);
+  us.data.compress_task_pool = nullptr;
+  us.step.data_size = us.data.undo_size;
+}
+
+/** Make sure the sizes of all sculpt steps are final before the undo memory limit is applied. */
+static void wait_for_compression_all(UndoStack &ustack)
+{
+  LISTBASE_FOREACH (UndoStep *, us, &ustack.steps) {
+    if (us->type == BKE_UNDOSYS_TYPE_SCULPT) {
+      wait_for_compression(*reinterpret_cast<SculptUndoStep *>(us));
+    }
+  }
+}
+
+/** \} */
+
 static SculptUndoStep *get_active_step()
 {
   UndoStack *ustack = ED_undo_stack_get();
   UndoStep *us = BKE_undosys_stack_init_or_active_with_type(ustack, BKE_UNDOSYS_TYPE_SCULPT);
+  if (us && us != ustack->step_init) {
+    wait_for_compression(*reinterpret_cast<SculptUndoStep *>(us));
+  }
   return reinterpret_cast<SculptUndoStep *>(us);
 }
 
@@ -836,6 +1034,10 @@ static void restore_list(bContext *C, Depsgraph *depsgraph, StepData &step_data)
     return;
   }
 
+  /* The data of the nodes is swapped with the mesh, so it has to be compressed again afterwards
+   * to store the other state, see #compress_nodes_in_background. */
+  decompress_nodes(step_data.nodes);
+
   const bool tag_update = ID_REAL_USERS(object.data) > 1 ||
                           !BKE_sculptsession_use_pbvh_draw(&object, rv3d) || ss.shapekey_active ||
                           ss.deform_modifiers_active;
@@ -1753,26 +1955,6 @@ void push_enter_sculpt_mode(const Scene & /*scene*/, Object &ob, const wmOperato
   save_common_data(ob, us);
 }
 
-static size_t node_size_in_bytes(const Node &node)
-{
-  size_t size = sizeof(Node);
-  size += node.position.as_span().size_in_bytes();
-  size += node.orig_position.as_span().size_in_bytes();
-  size += node.normal.as_span().size_in_bytes();
-  size += node.col.as_span().size_in_bytes();
-  size += node.mask.as_span().size_in_bytes();
-  size += node.loop_col.as_span().size_in_bytes();
-  size += node.vert_indices.as_span().size_in_bytes();
-  size += node.corner_indices.as_span().size_in_bytes();
-  size += node.vert_hidden.size() / 8;
-  size += node.face_hidden.size() / 8;
-  size += node.grids.as_span().size_in_bytes();
-  size += node.grid_hidden.all_bits().size() / 8;
-  size += node.face_sets.as_span().size_in_bytes();
-  size += node.face_indices.as_span().size_in_bytes();
-  return size;
-}
-
 void push_end_ex(Object &ob, const bool use_nested_undo)
 {
   StepData *step_data = get_step_data();
@@ -1793,17 +1975,8 @@ void push_end_ex(Object &ob, const bool use_nested_undo)
    * just one positions array that has a different semantic meaning depending on whether there are
    * deform modifiers. */
 
-  step_data->undo_size = threading::parallel_reduce(
-      step_data->nodes.index_range(),
-      16,
-      0,
-      [&](const IndexRange range, size_t size) {
-        for (const int i : range) {
-          size += node_size_in_bytes(*step_data->nodes[i]);
-        }
-        return size;
-      },
-      std::plus<size_t>());
+  compress_nodes(step_data->nodes);
+  step_data->undo_size = nodes_size_in_bytes(step_data->nodes);
 
   /* We could remove this and enforce all callers run in an operator using 'OPTYPE_UNDO'. */
   wmWindowManager *wm = static_cast<wmWindowManager *>(G_MAIN->wm.first);
@@ -1892,6 +2065,7 @@ static bool step_encode(bContext * /*C*/, Main *bmain, UndoStep *us_p)
    * to the current 'SculptUndoStep' added by encode_init. */
   SculptUndoStep *us = reinterpret_cast<SculptUndoStep *>(us_p);
   us->step.data_size = us->data.undo_size;
+  wait_for_compression_all(*ED_undo_stack_get());
 
   Node *unode = us->data.nodes.is_empty() ? nullptr : us->data.nodes.last().get();
   if (unode && us->data.type == Type::DyntopoEnd) {
@@ -1910,7 +2084,9 @@ static void step_decode_undo_impl(bContext *C, Depsgraph *depsgraph, SculptUndoS
 {
   BLI_assert(us->step.is_applied == true);
 
+  wait_for_compression(*us);
   restore_list(C, depsgraph, us->data);
+  compress_nodes_in_background(*us);
   us->step.is_applied = false;
 }
 
@@ -1918,7 +2094,9 @@ static void step_decode_redo_impl(bContext *C, Depsgraph *depsgraph, SculptUndoS
 {
   BLI_assert(us->step.is_applied == false);
 
+  wait_for_compression(*us);
   restore_list(C, depsgraph, us->data);
+  compress_nodes_in_background(*us);
   us->step.is_applied = true;
 }
 
@@ -2032,6 +2210,7 @@ static void step_decode(
 static void step_free(UndoStep *us_p)
 {
   SculptUndoStep *us = reinterpret_cast<SculptUndoStep *>(us_p);
+  wait_for_compression(*us);
   free_step_data(us->data);
 }
 
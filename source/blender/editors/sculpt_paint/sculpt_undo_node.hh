@@ -0,0 +1,75 @@
+/* SPDX-FileCopyrightText: 2025 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup edsculpt
+ *
+ * Storage of the sculpt undo data of a single #bke::pbvh::Node. Only meant to be used by the
+ * sculpt undo system and its tests.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+#include "BLI_array.hh"
+#include "BLI_bit_group_vector.hh"
+#include "BLI_bit_vector.hh"
+#include "BLI_math_vector_types.hh"
+#include "BLI_vector.hh"
+
+namespace blender::ed::sculpt_paint::undo {
+
+struct Node {
+  Array<float3, 0> position;
+  Array<float3, 0> orig_position;
+  Array<float3, 0> normal;
+  Array<float4, 0> col;
+  Array<float, 0> mask;
+
+  Array<float4, 0> loop_col;
+
+  /* Mesh. */
+
+  Array<int, 0> vert_indices;
+  int unique_verts_num;
+
+  /**
+   * \todo Storing corners rather than faces is unnecessary.
+   */
+  Vector<int, 0> corner_indices;
+
+  BitVector<0> vert_hidden;
+  BitVector<0> face_hidden;
+
+  /* Multires. */
+
+  /** Indices of grids in the pbvh::Tree node. */
+  Array<int, 0> grids;
+  BitGroupVector<0> grid_hidden;
+
+  /* Sculpt Face Sets */
+  Array<int, 0> face_sets;
+
+  Vector<int> face_indices;
+
+  /**
+   * While the undo step is stored in the undo stack, the data arrays above are freed and kept in
+   * this buffer in compressed form instead. See #compress_node_data.
+   */
+  Array<std::byte, 0> compressed_data;
+  /** The sizes of the compressed arrays, in the order of #foreach_compressed_array. */
+  std::array<int64_t, 7> compressed_sizes;
+};
+
+/**
+ * Replace the position, color, mask, face set and vertex index arrays of the node with a single
+ * compressed buffer. Small nodes are left unchanged.
+ */
+void compress_node_data(Node &node);
+/** Restore the arrays compressed by #compress_node_data. */
+void decompress_node_data(Node &node);
+
+}  // namespace blender::ed::sculpt_paint::undo
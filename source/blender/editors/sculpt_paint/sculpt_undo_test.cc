@@ -0,0 +1,94 @@
+/* SPDX-FileCopyrightText: 2025 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup edsculpt
+ */
+
+#include <cmath>
+#include <cstring>
+
+#include "sculpt_undo_node.hh"
+
+#include "BLI_math_base.h"
+
+#include "testing/testing.h"
+
+namespace blender::ed::sculpt_paint::undo::tests {
+
+static Node create_node(const int verts_num)
+{
+  Node node;
+  node.position.reinitialize(verts_num);
+  node.orig_position.reinitialize(verts_num);
+  node.mask.reinitialize(verts_num);
+  node.vert_indices.reinitialize(verts_num);
+  for (const int i : IndexRange(verts_num)) {
+    const float f = float(i);
+    node.position[i] = float3(std::sin(f), std::cos(f * 0.5f), f * 1e-3f);
+    node.orig_position[i] = node.position[i] + float3(-0.0f, 1e-7f, float(M_PI));
+    node.mask[i] = (i % 3) / 2.0f;
+    node.vert_indices[i] = i * 7 - 100;
+  }
+  node.face_sets = {1, 2, 2, -5};
+  node.grids = {3, 4};
+  return node;
+}
+
+static void expect_bitwise_eq(const Span<float3> a, const Span<float3> b)
+{
+  ASSERT_EQ(a.size(), b.size());
+  EXPECT_EQ(memcmp(a.data(), b.data(), a.size_in_bytes()), 0);
+}
+
+TEST(sculpt_undo, CompressRoundtrip)
+{
+  Node node = create_node(1000);
+  const Node expected = create_node(1000);
+
+  compress_node_data(node);
+  EXPECT_FALSE(node.compressed_data.is_empty());
+  EXPECT_TRUE(node.position.is_empty());
+  EXPECT_TRUE(node.orig_position.is_empty());
+  EXPECT_TRUE(node.mask.is_empty());
+  EXPECT_TRUE(node.vert_indices.is_empty());
+  EXPECT_TRUE(node.face_sets.is_empty());
+  /* Arrays that aren't compressed are kept. */
+  EXPECT_EQ(node.grids.as_span(), expected.grids.as_span());
+
+  decompress_node_data(node);
+  EXPECT_TRUE(node.compressed_data.is_empty());
+  expect_bitwise_eq(node.position, expected.position);
+  expect_bitwise_eq(node.orig_position, expected.orig_position);
+  EXPECT_EQ(node.mask.as_span(), expected.mask.as_span());
+  EXPECT_EQ(node.vert_indices.as_span(), expected.vert_indices.as_span());
+  EXPECT_EQ(node.face_sets.as_span(), expected.face_sets.as_span());
+  EXPECT_TRUE(node.col.is_empty());
+  EXPECT_TRUE(node.loop_col.is_empty());
+}
+
+TEST(sculpt_undo, CompressRepeated)
+{
+  /* Restoring a step decompresses and compresses its nodes again, possibly many times. */
+  Node node = create_node(500);
+  const Node expected = create_node(500);
+  for ([[maybe_unused]] const int i : IndexRange(3)) {
+    compress_node_data(node);
+    decompress_node_data(node);
+  }
+  expect_bitwise_eq(node.position, expected.position);
+  EXPECT_EQ(node.vert_indices.as_span(), expected.vert_indices.as_span());
+}
+
+TEST(sculpt_undo, CompressSmallNode)
+{
+  Node node = create_node(4);
+  compress_node_data(node);
+  EXPECT_TRUE(node.compressed_data.is_empty());
+  EXPECT_EQ(node.position.size(), 4);
+  decompress_node_data(node);
+  EXPECT_EQ(node.vert_indices.as_span(), create_node(4).vert_indices.as_span());
+}
+
+}  // namespace blender::ed::sculpt_paint::undo::tests
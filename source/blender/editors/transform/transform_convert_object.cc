@@ -867,7 +867,7 @@ static void recalcData_objects(TransInfo *t)
 
       /* Sets recalc flags fully, instead of flushing existing ones
        * otherwise proxies don't function correctly. */
-      DEG_id_tag_update(&ob->id, ID_RECALC_TRANSFORM);
+      DEG_id_tag_update(&ob->id, ID_RECALC_TRANSFORM | ID_RECALC_SYNC_VALUES_TO_EVAL);
     }
   }
 
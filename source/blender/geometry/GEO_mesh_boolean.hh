@@ -22,6 +22,11 @@ enum class Solver {
   MeshArr = 0,
   /** The original BMesh floating point solver. */
   Float = 1,
+  /**
+   * A fast solver for operands that are closed manifolds without self-intersections, see
+   * `BLI_mesh_boolean_manifold.hh`. Falls back to #Solver::MeshArr for other input.
+   */
+  Manifold = 2,
 };
 
 enum class Operation {
@@ -5,7 +5,9 @@
 #include <iostream>
 
 #include "BKE_attribute.hh"
+#include "BKE_attribute_math.hh"
 #include "BKE_customdata.hh"
+#include "BKE_geometry_set.hh"
 #include "BKE_lib_id.hh"
 #include "BKE_mesh.hh"
 
@@ -16,7 +18,9 @@
 #include "BLI_math_matrix.hh"
 #include "BLI_math_vector.h"
 #include "BLI_mesh_boolean.hh"
+#include "BLI_mesh_boolean_manifold.hh"
 #include "BLI_mesh_intersect.hh"
+#include "BLI_ordered_edge.hh"
 #include "BLI_span.hh"
 #include "BLI_string.h"
 #include "BLI_task.hh"
@@ -24,6 +28,7 @@
 
 #include "DNA_node_types.h"
 
+#include "GEO_join_geometries.hh"
 #include "GEO_mesh_boolean.hh"
 
 #include "bmesh.hh"
@@ -1143,6 +1148,512 @@ static Mesh *mesh_boolean_float(Span<const Mesh *> meshes,
 
 /** \} */
 
+/* -------------------------------------------------------------------- */
+/** \name Manifold Boolean
+ * \{ */
+
+static meshintersect::manifold::Operation operation_to_manifold_mode(const Operation operation)
+{
+  switch (operation) {
+    case Operation::Intersect:
+      return meshintersect::manifold::Operation::Intersect;
+    case Operation::Union:
+      return meshintersect::manifold::Operation::Union;
+    case Operation::Difference:
+      return meshintersect::manifold::Operation::Difference;
+  }
+  BLI_assert_unreachable();
+  return meshintersect::manifold::Operation::Union;
+}
+
+/**
+ * Join all operands into one mesh in the space of the target, so that the solver and the
+ * attribute propagation only have to deal with a single mesh. The faces of every operand stay a
+ * contiguous range, in the order of the operands.
+ */
+static Mesh *join_operands(Span<const Mesh *> meshes,
+                           Span<float4x4> transforms,
+                           const float4x4 &target_transform,
+                           Span<Array<short>> material_remaps)
+{
+  const float4x4 inv_target_mat = math::invert(target_transform);
+  const bool first_is_negative = !transforms.is_empty() && math::is_negative(transforms[0]);
+  Vector<bke::GeometrySet> geometries;
+  for (const int mesh_i : meshes.index_range()) {
+    Mesh *mesh = BKE_mesh_copy_for_eval(*meshes[mesh_i]);
+    const float4x4 transform = transforms.is_empty() ? float4x4::identity() :
+                                                       transforms[mesh_i];
+    const float4x4 to_target = inv_target_mat * transform;
+    if (to_target != float4x4::identity()) {
+      MutableSpan<float3> positions = mesh->vert_positions_for_write();
+      threading::parallel_for(positions.index_range(), 2048, [&](const IndexRange range) {
+        for (float3 &position : positions.slice(range)) {
+          position = math::transform_point(to_target, position);
+        }
+      });
+      mesh->tag_positions_changed();
+    }
+    /* Keep the historical behavior of the other solvers, see #meshes_to_imesh. */
+    if (math::is_negative(transform) != first_is_negative) {
+      bke::mesh_flip_faces(*mesh, IndexMask(mesh->faces_num));
+    }
+    if (!material_remaps.is_empty() && !material_remaps[mesh_i].is_empty()) {
+      const Span<short> material_remap = material_remaps[mesh_i];
+      bke::SpanAttributeWriter<int> material_indices =
+          mesh->attributes_for_write().lookup_or_add_for_write_span<int>("material_index",
+                                                                         bke::AttrDomain::Face);
+      for (int &material_index : material_indices.span) {
+        if (material_remap.index_range().contains(material_index)) {
+          const int remapped_index = material_remap[material_index];
+          material_index = remapped_index >= 0 ? remapped_index : material_index;
+        }
+      }
+      material_indices.finish();
+    }
+    geometries.append(bke::GeometrySet::from_mesh(mesh));
+  }
+  bke::GeometrySet joined = join_geometries(geometries, {});
+  geometries.clear();
+  if (!joined.has_mesh()) {
+    return nullptr;
+  }
+  return joined.get_component_for_write<bke::MeshComponent>().release();
+}
+
+/**
+ * Fill the attributes on one domain of the result by mixing up to three source elements for
+ * every result element. Source elements with a zero weight are ignored.
+ */
+static void interpolate_attributes(const bke::AttributeAccessor src_attributes,
+                                   const bke::AttrDomain domain,
+                                   const Span<StringRef> skip_names,
+                                   const Span<int3> src_indices,
+                                   const Span<float3> src_weights,
+                                   bke::MutableAttributeAccessor dst_attributes)
+{
+  src_attributes.foreach_attribute([&](const bke::AttributeIter &iter) {
+    if (iter.domain != domain || iter.data_type == CD_PROP_STRING ||
+        skip_names.contains(iter.name))
+    {
+      return;
+    }
+    const GVArraySpan src = *iter.get();
+    bke::GSpanAttributeWriter dst = dst_attributes.lookup_or_add_for_write_only_span(
+        iter.name, domain, iter.data_type);
+    if (!dst) {
+      return;
+    }
+    bke::attribute_math::convert_to_static_type(src.type(), [&](auto dummy) {
+      using T = decltype(dummy);
+      const Span<T> src_typed = src.typed<T>();
+      MutableSpan<T> dst_typed = dst.span.typed<T>();
+      threading::parallel_for(dst_typed.index_range(), 2048, [&](const IndexRange range) {
+        if constexpr (std::is_void_v<bke::attribute_math::DefaultMixer<T>>) {
+          for (const int i : range) {
+            const float3 &weights = src_weights[i];
+            const int max_i = weights[0] >= weights[1] ?
+                                  (weights[0] >= weights[2] ? 0 : 2) :
+                                  (weights[1] >= weights[2] ? 1 : 2);
+            dst_typed[i] = weights[max_i] > 0.0f ? src_typed[src_indices[i][max_i]] : T();
+          }
+        }
+        else {
+          bke::attribute_math::DefaultMixer<T> mixer{dst_typed.slice(range)};
+          for (const int i : range) {
+            for (const int j : IndexRange(3)) {
+              if (src_weights[i][j] > 0.0f) {
+                mixer.mix_in(i - range.start(), src_typed[src_indices[i][j]], src_weights[i][j]);
+              }
+            }
+          }
+          mixer.finalize();
+        }
+      });
+    });
+    dst.finish();
+  });
+}
+
+enum class FaceResult : int8_t {
+  Removed,
+  Kept,
+  KeptFlipped,
+  /** Parts of the face are kept, they are added as separate triangles. */
+  Pieces,
+};
+
+/**
+ * Build the result mesh from the triangles kept by the solver. Faces that are kept entirely stay
+ * unchanged, all other faces are replaced by the kept triangles.
+ */
+static Mesh *manifold_result_to_mesh(const Mesh &joined,
+                                     const meshintersect::manifold::BooleanResult &result,
+                                     Vector<int> *r_intersecting_edges)
+{
+  using meshintersect::manifold::TriResult;
+  const Span<float3> src_positions = joined.vert_positions();
+  const OffsetIndices src_faces = joined.faces();
+  const Span<int> src_corner_verts = joined.corner_verts();
+  const Span<int3> corner_tris = joined.corner_tris();
+  const int src_verts_num = joined.verts_num;
+
+  Array<int> tri_split_index(corner_tris.size(), -1);
+  for (const int i : result.split_tri_indices.index_range()) {
+    tri_split_index[result.split_tri_indices[i]] = i;
+  }
+  const OffsetIndices<int> split_tri_pieces(result.split_tri_offsets);
+
+  Array<FaceResult> face_results(src_faces.size());
+  Array<int> dst_face_offsets_data(src_faces.size() + 1);
+  Array<int> dst_corner_offsets_data(src_faces.size() + 1);
+  threading::parallel_for(src_faces.index_range(), 1024, [&](const IndexRange range) {
+    for (const int face_i : range) {
+      const IndexRange tris = bke::mesh::face_triangles_range(src_faces, face_i);
+      const TriResult first = result.tri_results[tris.first()];
+      bool all_same = first != TriResult::Split;
+      int pieces_num = 0;
+      for (const int tri_i : tris) {
+        const TriResult tri_result = result.tri_results[tri_i];
+        all_same &= tri_result == first;
+        if (tri_result == TriResult::Split) {
+          pieces_num += split_tri_pieces[tri_split_index[tri_i]].size();
+        }
+        else if (tri_result != TriResult::Removed) {
+          pieces_num++;
+        }
+      }
+      if (all_same) {
+        const bool kept = first != TriResult::Removed;
+        face_results[face_i] = !kept ? FaceResult::Removed :
+                               first == TriResult::Kept ? FaceResult::Kept :
+                                                          FaceResult::KeptFlipped;
+        dst_face_offsets_data[face_i] = kept ? 1 : 0;
+        dst_corner_offsets_data[face_i] = kept ? src_faces[face_i].size() : 0;
+      }
+      else {
+        face_results[face_i] = FaceResult::Pieces;
+        dst_face_offsets_data[face_i] = pieces_num;
+        dst_corner_offsets_data[face_i] = pieces_num * 3;
+      }
+    }
+  });
+  const OffsetIndices<int> dst_faces_by_src = offset_indices::accumulate_counts_to_offsets(
+      dst_face_offsets_data);
+  const OffsetIndices<int> dst_corners_by_src = offset_indices::accumulate_counts_to_offsets(
+      dst_corner_offsets_data);
+  const int dst_faces_num = dst_faces_by_src.total_size();
+  const int dst_corners_num = dst_corners_by_src.total_size();
+
+  /* Vertex indices in the corners refer to the input vertices followed by the new vertices until
+   * the unused vertices are removed. */
+  Array<int> dst_face_sizes(dst_faces_num + 1);
+  Array<int> dst_face_src_faces(dst_faces_num);
+  Array<int> dst_corner_verts(dst_corners_num);
+  Array<int3> dst_corner_src_corners(dst_corners_num);
+  Array<float3> dst_corner_src_weights(dst_corners_num);
+  threading::parallel_for(src_faces.index_range(), 1024, [&](const IndexRange range) {
+    for (const int face_i : range) {
+      const IndexRange src_face = src_faces[face_i];
+      const IndexRange dst_faces = dst_faces_by_src[face_i];
+      const IndexRange dst_corners = dst_corners_by_src[face_i];
+      dst_face_src_faces.as_mutable_span().slice(dst_faces).fill(face_i);
+      switch (face_results[face_i]) {
+        case FaceResult::Removed:
+          break;
+        case FaceResult::Kept:
+        case FaceResult::KeptFlipped: {
+          const bool flip = face_results[face_i] == FaceResult::KeptFlipped;
+          dst_face_sizes[dst_faces.first()] = src_face.size();
+          for (const int i : src_face.index_range()) {
+            /* Flipping keeps the first corner, like #bke::mesh_flip_faces. */
+            const int src_corner = src_face[flip ? (src_face.size() - i) % src_face.size() : i];
+            dst_corner_verts[dst_corners[i]] = src_corner_verts[src_corner];
+            dst_corner_src_corners[dst_corners[i]] = int3(src_corner);
+            dst_corner_src_weights[dst_corners[i]] = float3(1.0f, 0.0f, 0.0f);
+          }
+          break;
+        }
+        case FaceResult::Pieces: {
+          int piece_i = 0;
+          auto add_piece = [&](const int3 &tri_corners, const int3 &verts) {
+            dst_face_sizes[dst_faces[piece_i]] = 3;
+            for (const int i : IndexRange(3)) {
+              const int dst_corner = dst_corners[piece_i * 3 + i];
+              const int vert = verts[i];
+              dst_corner_verts[dst_corner] = vert;
+              if (vert < src_verts_num) {
+                int src_corner = tri_corners[0];
+                for (const int j : IndexRange(3)) {
+                  if (src_corner_verts[tri_corners[j]] == vert) {
+                    src_corner = tri_corners[j];
+                  }
+                }
+                dst_corner_src_corners[dst_corner] = int3(src_corner);
+                dst_corner_src_weights[dst_corner] = float3(1.0f, 0.0f, 0.0f);
+              }
+              else {
+                const float3 position(result.new_positions[vert - src_verts_num]);
+                float3 weights;
+                interp_weights_tri_v3(weights,
+                                      src_positions[src_corner_verts[tri_corners[0]]],
+                                      src_positions[src_corner_verts[tri_corners[1]]],
+                                      src_positions[src_corner_verts[tri_corners[2]]],
+                                      position);
+                dst_corner_src_corners[dst_corner] = tri_corners;
+                dst_corner_src_weights[dst_corner] = math::max(weights, float3(0.0f));
+              }
+            }
+            piece_i++;
+          };
+          for (const int tri_i : bke::mesh::face_triangles_range(src_faces, face_i)) {
+            const int3 &tri_corners = corner_tris[tri_i];
+            const int3 tri_verts(src_corner_verts[tri_corners[0]],
+                                 src_corner_verts[tri_corners[1]],
+                                 src_corner_verts[tri_corners[2]]);
+            switch (result.tri_results[tri_i]) {
+              case TriResult::Removed:
+                break;
+              case TriResult::Kept:
+                add_piece(tri_corners, tri_verts);
+                break;
+              case TriResult::KeptFlipped:
+                add_piece(tri_corners, int3(tri_verts[0], tri_verts[2], tri_verts[1]));
+                break;
+              case TriResult::Split:
+                for (const int3 &piece :
+                     result.split_tris.as_span().slice(split_tri_pieces[tri_split_index[tri_i]]))
+                {
+                  add_piece(tri_corners, piece);
+                }
+                break;
+            }
+          }
+          break;
+        }
+      }
+    }
+  });
+  const OffsetIndices<int> dst_faces = offset_indices::accumulate_counts_to_offsets(
+      dst_face_sizes);
+
+  /* Remove the vertices that are not used anymore. */
+  const int all_verts_num = src_verts_num + result.new_positions.size();
+  Array<int> vert_map(all_verts_num, -1);
+  for (const int vert : dst_corner_verts) {
+    vert_map[vert] = 0;
+  }
+  Vector<int> dst_vert_src_verts;
+  for (const int vert : IndexRange(all_verts_num)) {
+    if (vert_map[vert] == 0) {
+      vert_map[vert] = dst_vert_src_verts.append_and_get_index(vert);
+    }
+  }
+  const int dst_verts_num = dst_vert_src_verts.size();
+
+  Mesh *mesh = BKE_mesh_new_nomain_from_template(
+      &joined, dst_verts_num, 0, dst_faces_num, dst_corners_num);
+  mesh->face_offsets_for_write().copy_from(dst_faces.data());
+  MutableSpan<int> corner_verts = mesh->corner_verts_for_write();
+  threading::parallel_for(corner_verts.index_range(), 4096, [&](const IndexRange range) {
+    for (const int corner : range) {
+      corner_verts[corner] = vert_map[dst_corner_verts[corner]];
+    }
+  });
+
+  const bke::AttributeAccessor src_attributes = joined.attributes();
+  bke::MutableAttributeAccessor dst_attributes = mesh->attributes_for_write();
+
+  Array<int3> dst_vert_src_indices(dst_verts_num);
+  Array<float3> dst_vert_src_weights(dst_verts_num);
+  MutableSpan<float3> positions = mesh->vert_positions_for_write();
+  threading::parallel_for(IndexRange(dst_verts_num), 4096, [&](const IndexRange range) {
+    for (const int vert : range) {
+      const int src_vert = dst_vert_src_verts[vert];
+      if (src_vert < src_verts_num) {
+        positions[vert] = src_positions[src_vert];
+        dst_vert_src_indices[vert] = int3(src_vert);
+        dst_vert_src_weights[vert] = float3(1.0f, 0.0f, 0.0f);
+      }
+      else {
+        const int new_vert = src_vert - src_verts_num;
+        positions[vert] = float3(result.new_positions[new_vert]);
+        dst_vert_src_indices[vert] = result.new_vert_interp_verts[new_vert];
+        dst_vert_src_weights[vert] = result.new_vert_interp_weights[new_vert];
+      }
+    }
+  });
+  interpolate_attributes(src_attributes,
+                         bke::AttrDomain::Point,
+                         {"position"},
+                         dst_vert_src_indices,
+                         dst_vert_src_weights,
+                         dst_attributes);
+  interpolate_attributes(src_attributes,
+                         bke::AttrDomain::Corner,
+                         {".corner_vert", ".corner_edge"},
+                         dst_corner_src_corners,
+                         dst_corner_src_weights,
+                         dst_attributes);
+  bke::gather_attributes(src_attributes,
+                         bke::AttrDomain::Face,
+                         bke::AttrDomain::Face,
+                         {},
+                         dst_face_src_faces,
+                         dst_attributes);
+
+  bke::mesh_calc_edges(*mesh, false, false);
+  const Span<int2> edges = mesh->edges();
+
+  /* Edges of the result that lie on an input edge keep its attributes. A new vertex lies on an
+   * input edge when it is interpolated from only two vertices. */
+  bool has_edge_attributes = false;
+  src_attributes.foreach_attribute([&](const bke::AttributeIter &iter) {
+    if (iter.domain == bke::AttrDomain::Edge && iter.name != ".edge_verts") {
+      has_edge_attributes = true;
+      iter.stop();
+    }
+  });
+  if (has_edge_attributes) {
+    const Span<int2> src_edges = joined.edges();
+    Map<OrderedEdge, int> src_edge_map;
+    src_edge_map.reserve(src_edges.size());
+    for (const int edge_i : src_edges.index_range()) {
+      src_edge_map.add(src_edges[edge_i], edge_i);
+    }
+    auto vert_src_edge = [&](const int vert) -> std::optional<OrderedEdge> {
+      const int src_vert = dst_vert_src_verts[vert];
+      if (src_vert < src_verts_num) {
+        return std::nullopt;
+      }
+      const int3 &interp_verts = result.new_vert_interp_verts[src_vert - src_verts_num];
+      if (interp_verts[1] != interp_verts[2]) {
+        return std::nullopt;
+      }
+      return OrderedEdge(interp_verts[0], interp_verts[1]);
+    };
+    Array<int3> dst_edge_src_indices(edges.size());
+    Array<float3> dst_edge_src_weights(edges.size());
+    threading::parallel_for(edges.index_range(), 2048, [&](const IndexRange range) {
+      for (const int edge_i : range) {
+        const int2 &edge = edges[edge_i];
+        const int src_v1 = dst_vert_src_verts[edge[0]];
+        const int src_v2 = dst_vert_src_verts[edge[1]];
+        const std::optional<OrderedEdge> src_edge_1 = vert_src_edge(edge[0]);
+        const std::optional<OrderedEdge> src_edge_2 = vert_src_edge(edge[1]);
+        std::optional<OrderedEdge> src_edge;
+        if (!src_edge_1 && !src_edge_2) {
+          src_edge = OrderedEdge(src_v1, src_v2);
+        }
+        else if (src_edge_1 && src_edge_2) {
+          src_edge = *src_edge_1 == *src_edge_2 ? src_edge_1 : std::nullopt;
+        }
+        else {
+          const OrderedEdge &new_vert_edge = src_edge_1 ? *src_edge_1 : *src_edge_2;
+          const int other_vert = src_edge_1 ? src_v2 : src_v1;
+          if (ELEM(other_vert, new_vert_edge.v_low, new_vert_edge.v_high)) {
+            src_edge = new_vert_edge;
+          }
+        }
+        const int src_edge_i = src_edge ? src_edge_map.lookup_default(*src_edge, -1) : -1;
+        dst_edge_src_indices[edge_i] = int3(std::max(src_edge_i, 0));
+        dst_edge_src_weights[edge_i] = float3(src_edge_i == -1 ? 0.0f : 1.0f, 0.0f, 0.0f);
+      }
+    });
+    interpolate_attributes(src_attributes,
+                           bke::AttrDomain::Edge,
+                           {".edge_verts"},
+                           dst_edge_src_indices,
+                           dst_edge_src_weights,
+                           dst_attributes);
+  }
+
+  if (r_intersecting_edges != nullptr) {
+    Set<OrderedEdge> intersection_edges;
+    for (const int2 &edge : result.intersection_edges) {
+      intersection_edges.add({vert_map[edge[0]], vert_map[edge[1]]});
+    }
+    for (const int edge_i : edges.index_range()) {
+      if (intersection_edges.contains(edges[edge_i])) {
+        r_intersecting_edges->append(edge_i);
+      }
+    }
+  }
+
+  return mesh;
+}
+
+/**
+ * Returns null when the input is not supported by the manifold solver, e.g. because an operand
+ * is not closed. The caller is expected to fall back to a more general solver then.
+ */
+static Mesh *mesh_boolean_manifold(Span<const Mesh *> meshes,
+                                   Span<float4x4> transforms,
+                                   const float4x4 &target_transform,
+                                   Span<Array<short>> material_remaps,
+                                   const Operation operation,
+                                   Vector<int> *r_intersecting_edges)
+{
+  BLI_assert(transforms.is_empty() || meshes.size() == transforms.size());
+  BLI_assert(material_remaps.is_empty() || material_remaps.size() == meshes.size());
+  if (meshes.is_empty()) {
+    return nullptr;
+  }
+
+  Mesh *joined = join_operands(meshes, transforms, target_transform, material_remaps);
+  if (!joined) {
+    return nullptr;
+  }
+
+  const Span<float3> positions = joined->vert_positions();
+  const Span<int> corner_verts = joined->corner_verts();
+  const Span<int3> corner_tris = joined->corner_tris();
+  const Span<int> tri_faces = joined->corner_tri_faces();
+
+  Array<int> operand_face_offsets_data(meshes.size() + 1);
+  for (const int i : meshes.index_range()) {
+    operand_face_offsets_data[i] = meshes[i]->faces_num;
+  }
+  const OffsetIndices<int> operand_faces = offset_indices::accumulate_counts_to_offsets(
+      operand_face_offsets_data);
+  Array<int> face_shapes(joined->faces_num);
+  for (const int i : meshes.index_range()) {
+    face_shapes.as_mutable_span().slice(operand_faces[i]).fill(i);
+  }
+
+  Array<double3> tri_mesh_positions(positions.size());
+  Array<int3> tri_mesh_tris(corner_tris.size());
+  Array<int> tri_shapes(corner_tris.size());
+  threading::parallel_for(positions.index_range(), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      tri_mesh_positions[i] = double3(positions[i]);
+    }
+  });
+  threading::parallel_for(corner_tris.index_range(), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      const int3 &tri = corner_tris[i];
+      tri_mesh_tris[i] = int3(corner_verts[tri[0]], corner_verts[tri[1]], corner_verts[tri[2]]);
+      tri_shapes[i] = face_shapes[tri_faces[i]];
+    }
+  });
+
+  meshintersect::manifold::TriMesh tri_mesh;
+  tri_mesh.positions = tri_mesh_positions;
+  tri_mesh.tris = tri_mesh_tris;
+  tri_mesh.tri_shapes = tri_shapes;
+  tri_mesh.shapes_num = meshes.size();
+  const meshintersect::manifold::BooleanResult result = meshintersect::manifold::boolean_trimesh(
+      tri_mesh, operation_to_manifold_mode(operation));
+
+  Mesh *mesh = nullptr;
+  if (result.success) {
+    mesh = manifold_result_to_mesh(*joined, result, r_intersecting_edges);
+  }
+  BKE_id_free(nullptr, joined);
+  return mesh;
+}
+
+/** \} */
+
 Mesh *mesh_boolean(Span<const Mesh *> meshes,
                    Span<float4x4> transforms,
                    const float4x4 &target_transform,
@@ -1160,6 +1671,21 @@ Mesh *mesh_boolean(Span<const Mesh *> meshes,
                                 material_remaps,
                                 operation_to_float_mode(op_params.boolean_mode),
                                 r_intersecting_edges);
+    case Solver::Manifold:
+      /* The manifold solver requires closed operands without self-intersections. */
+      if (op_params.no_self_intersections && op_params.watertight) {
+        if (Mesh *result = mesh_boolean_manifold(meshes,
+                                                 transforms,
+                                                 target_transform,
+                                                 material_remaps,
+                                                 op_params.boolean_mode,
+                                                 r_intersecting_edges))
+        {
+          return result;
+        }
+      }
+      /* Fall back to the exact solver for input that is not supported. */
+      ATTR_FALLTHROUGH;
     case Solver::MeshArr:
 #ifdef WITH_GMP
       return mesh_boolean_mesh_arr(meshes,
@@ -6,11 +6,14 @@
 // #define USE_WELD_DEBUG_TIME
 
 #include "BLI_array.hh"
+#include "BLI_array_utils.hh"
 #include "BLI_bit_vector.hh"
 #include "BLI_index_mask.hh"
 #include "BLI_kdtree.h"
 #include "BLI_math_vector.h"
 #include "BLI_offset_indices.hh"
+#include "BLI_poisson_disk.hh"
+#include "BLI_task.hh"
 #include "BLI_vector.hh"
 
 #include "BKE_customdata.hh"
@@ -20,6 +23,8 @@
 #include "GEO_mesh_merge_by_distance.hh"
 #include "GEO_randomize.hh"
 
+#include "atomic_ops.h"
+
 #ifdef USE_WELD_DEBUG_TIME
 #  include "BLI_timeit.hh"
 
@@ -333,33 +338,51 @@ static Vector<WeldEdge> weld_edge_ctx_alloc_and_find_collapsed(Span<int2> edges,
                                                                int *r_edge_collapsed_len)
 {
   /* Edge Context. */
-  int edge_collapsed_len = 0;
-
-  Vector<WeldEdge> wedge;
-  wedge.reserve(edges.size());
-
-  for (const int i : edges.index_range()) {
-    int v1 = edges[i][0];
-    int v2 = edges[i][1];
-    int v_dest_1 = vert_dest_map[v1];
-    int v_dest_2 = vert_dest_map[v2];
-    if (v_dest_1 == OUT_OF_CONTEXT && v_dest_2 == OUT_OF_CONTEXT) {
-      r_edge_dest_map[i] = OUT_OF_CONTEXT;
-      continue;
-    }
-
-    const int vert_a = (v_dest_1 == OUT_OF_CONTEXT) ? v1 : v_dest_1;
-    const int vert_b = (v_dest_2 == OUT_OF_CONTEXT) ? v2 : v_dest_2;
+  auto edge_dest_verts = [&](const int i) {
+    const int2 edge = edges[i];
+    const int v_dest_1 = vert_dest_map[edge[0]];
+    const int v_dest_2 = vert_dest_map[edge[1]];
+    return int2((v_dest_1 == OUT_OF_CONTEXT) ? edge[0] : v_dest_1,
+                (v_dest_2 == OUT_OF_CONTEXT) ? edge[1] : v_dest_2);
+  };
 
-    if (vert_a == vert_b) {
-      r_edge_dest_map[i] = ELEM_COLLAPSED;
-      edge_collapsed_len++;
-    }
-    else {
-      wedge.append({i, vert_a, vert_b});
-      r_edge_dest_map[i] = i;
-    }
-  }
+  const int edge_collapsed_len = threading::parallel_reduce(
+      edges.index_range(),
+      4096,
+      0,
+      [&](const IndexRange range, int collapsed_len) {
+        for (const int i : range) {
+          const int2 edge = edges[i];
+          if (vert_dest_map[edge[0]] == OUT_OF_CONTEXT && vert_dest_map[edge[1]] == OUT_OF_CONTEXT)
+          {
+            r_edge_dest_map[i] = OUT_OF_CONTEXT;
+            continue;
+          }
+          const int2 dest_verts = edge_dest_verts(i);
+          if (dest_verts[0] == dest_verts[1]) {
+            r_edge_dest_map[i] = ELEM_COLLAPSED;
+            collapsed_len++;
+          }
+          else {
+            r_edge_dest_map[i] = i;
+          }
+        }
+        return collapsed_len;
+      },
+      std::plus<>());
+
+  /* Compact the remaining edges of the context, keeping them in ascending order. */
+  IndexMaskMemory memory;
+  const IndexMask wedge_mask = IndexMask::from_predicate(
+      edges.index_range(), GrainSize(4096), memory, [&](const int i) {
+        return r_edge_dest_map[i] == i;
+      });
+
+  Vector<WeldEdge> wedge(wedge_mask.size());
+  wedge_mask.foreach_index(GrainSize(4096), [&](const int i, const int pos) {
+    const int2 dest_verts = edge_dest_verts(i);
+    wedge[pos] = {i, dest_verts[0], dest_verts[1]};
+  });
 
   *r_edge_collapsed_len = edge_collapsed_len;
   return wedge;
@@ -1590,98 +1613,114 @@ static Mesh *create_merged_mesh(const Mesh &mesh,
                        do_mix_data,
                        edge_final_map);
 
-  for (int2 &edge : dst_edges) {
-    edge[0] = vert_final_map[edge[0]];
-    edge[1] = vert_final_map[edge[1]];
-    BLI_assert(edge[0] != edge[1]);
-    BLI_assert(IN_RANGE_INCL(edge[0], 0, result_nverts - 1));
-    BLI_assert(IN_RANGE_INCL(edge[1], 0, result_nverts - 1));
-  }
+  threading::parallel_for(dst_edges.index_range(), 4096, [&](const IndexRange range) {
+    for (int2 &edge : dst_edges.slice(range)) {
+      edge[0] = vert_final_map[edge[0]];
+      edge[1] = vert_final_map[edge[1]];
+      BLI_assert(edge[0] != edge[1]);
+      BLI_assert(IN_RANGE_INCL(edge[0], 0, result_nverts - 1));
+      BLI_assert(IN_RANGE_INCL(edge[1], 0, result_nverts - 1));
+    }
+  });
 
   /* Faces/Loops. */
 
-  int r_i = 0;
-  int loop_cur = 0;
-  Array<int, 64> group_buffer(weld_mesh.max_face_len);
-  for (const int i : src_faces.index_range()) {
-    const int loop_start = loop_cur;
+  /* Faces of the context are removed when they collapse or are merged into another face, and the
+   * faces created by splitting faces are added after the original faces. The corners of every
+   * face of the result are counted first, so that all faces can be written in parallel. */
+  const Span<WeldPoly> new_wpolys = weld_mesh.wpoly.as_span().take_back(weld_mesh.wpoly_new_len);
+  const IndexRange all_faces(src_faces.size() + new_wpolys.size());
+  auto get_wpoly = [&](const int i) -> const WeldPoly * {
+    if (i >= src_faces.size()) {
+      return &new_wpolys[i - src_faces.size()];
+    }
     const int poly_ctx = weld_mesh.face_map[i];
-    if (poly_ctx == OUT_OF_CONTEXT) {
-      int mp_loop_len = src_faces[i].size();
-      CustomData_copy_data(
-          &mesh.corner_data, &result->corner_data, src_faces[i].start(), loop_cur, mp_loop_len);
-      for (; mp_loop_len--; loop_cur++) {
-        dst_corner_verts[loop_cur] = vert_final_map[dst_corner_verts[loop_cur]];
-        dst_corner_edges[loop_cur] = edge_final_map[dst_corner_edges[loop_cur]];
+    return (poly_ctx == OUT_OF_CONTEXT) ? nullptr : &weld_mesh.wpoly[poly_ctx];
+  };
+
+  Array<int> dst_face_offsets_all(all_faces.size() + 1);
+  threading::parallel_for(all_faces, 1024, [&](const IndexRange range) {
+    for (const int i : range) {
+      const WeldPoly *wp = get_wpoly(i);
+      if (wp == nullptr) {
+        dst_face_offsets_all[i] = src_faces[i].size();
+        continue;
       }
-    }
-    else {
-      const WeldPoly &wp = weld_mesh.wpoly[poly_ctx];
+      int loop_len = 0;
       WeldLoopOfPolyIter iter;
-      if (!weld_iter_loop_of_poly_begin(iter,
-                                        wp,
-                                        weld_mesh.wloop,
-                                        src_corner_verts,
-                                        src_corner_edges,
-                                        weld_mesh.loop_map,
-                                        group_buffer.data()))
+      if (wp->poly_dst == OUT_OF_CONTEXT && weld_iter_loop_of_poly_begin(iter,
+                                                                         *wp,
+                                                                         weld_mesh.wloop,
+                                                                         src_corner_verts,
+                                                                         src_corner_edges,
+                                                                         weld_mesh.loop_map,
+                                                                         nullptr))
       {
-        continue;
+        do {
+          loop_len++;
+        } while (weld_iter_loop_of_poly_next(iter));
       }
-
-      if (wp.poly_dst != OUT_OF_CONTEXT) {
-        continue;
+      dst_face_offsets_all[i] = loop_len;
+    }
+  });
+  const OffsetIndices<int> dst_faces_all = offset_indices::accumulate_counts_to_offsets(
+      dst_face_offsets_all);
+  BLI_assert(dst_faces_all.total_size() == result_nloops);
+
+  IndexMaskMemory memory;
+  const IndexMask dst_faces_mask = IndexMask::from_predicate(
+      all_faces, GrainSize(4096), memory, [&](const int i) {
+        return !dst_faces_all[i].is_empty();
+      });
+  BLI_assert(dst_faces_mask.size() == result_nfaces);
+
+  threading::parallel_for(dst_faces_mask.index_range(), 512, [&](const IndexRange range) {
+    Array<int, 64> group_buffer(weld_mesh.max_face_len);
+    dst_faces_mask.slice(range).foreach_index([&](const int i, const int pos) {
+      const int r_i = range.start() + pos;
+      const IndexRange dst_corners = dst_faces_all[i];
+      dst_face_offsets[r_i] = dst_corners.start();
+
+      const WeldPoly *wp = get_wpoly(i);
+      if (wp == nullptr) {
+        CustomData_copy_data(&mesh.corner_data,
+                             &result->corner_data,
+                             src_faces[i].start(),
+                             dst_corners.start(),
+                             dst_corners.size());
+        for (const int corner : dst_corners) {
+          dst_corner_verts[corner] = vert_final_map[dst_corner_verts[corner]];
+          dst_corner_edges[corner] = edge_final_map[dst_corner_edges[corner]];
+        }
+      }
+      else {
+        WeldLoopOfPolyIter iter;
+        weld_iter_loop_of_poly_begin(iter,
+                                     *wp,
+                                     weld_mesh.wloop,
+                                     src_corner_verts,
+                                     src_corner_edges,
+                                     weld_mesh.loop_map,
+                                     group_buffer.data());
+        int loop_cur = dst_corners.start();
+        do {
+          customdata_weld(&mesh.corner_data,
+                          &result->corner_data,
+                          group_buffer.data(),
+                          iter.group_len,
+                          loop_cur);
+          dst_corner_verts[loop_cur] = vert_final_map[iter.v];
+          dst_corner_edges[loop_cur] = edge_final_map[iter.e];
+          loop_cur++;
+        } while (weld_iter_loop_of_poly_next(iter));
+        BLI_assert(loop_cur == dst_corners.one_after_last());
       }
-      do {
-        customdata_weld(&mesh.corner_data,
-                        &result->corner_data,
-                        group_buffer.data(),
-                        iter.group_len,
-                        loop_cur);
-        dst_corner_verts[loop_cur] = vert_final_map[iter.v];
-        dst_corner_edges[loop_cur] = edge_final_map[iter.e];
-        loop_cur++;
-      } while (weld_iter_loop_of_poly_next(iter));
-    }
-
-    CustomData_copy_data(&mesh.face_data, &result->face_data, i, r_i, 1);
-    dst_face_offsets[r_i] = loop_start;
-    r_i++;
-  }
-
-  /* New Polygons. */
-  for (const int i : weld_mesh.wpoly.index_range().take_back(weld_mesh.wpoly_new_len)) {
-    const WeldPoly &wp = weld_mesh.wpoly[i];
-    const int loop_start = loop_cur;
-    WeldLoopOfPolyIter iter;
-    if (!weld_iter_loop_of_poly_begin(iter,
-                                      wp,
-                                      weld_mesh.wloop,
-                                      src_corner_verts,
-                                      src_corner_edges,
-                                      weld_mesh.loop_map,
-                                      group_buffer.data()))
-    {
-      continue;
-    }
-
-    if (wp.poly_dst != OUT_OF_CONTEXT) {
-      continue;
-    }
-    do {
-      customdata_weld(
-          &mesh.corner_data, &result->corner_data, group_buffer.data(), iter.group_len, loop_cur);
-      dst_corner_verts[loop_cur] = vert_final_map[iter.v];
-      dst_corner_edges[loop_cur] = edge_final_map[iter.e];
-      loop_cur++;
-    } while (weld_iter_loop_of_poly_next(iter));
-
-    dst_face_offsets[r_i] = loop_start;
-    r_i++;
-  }
 
-  BLI_assert(int(r_i) == result_nfaces);
-  BLI_assert(loop_cur == result_nloops);
+      if (i < src_faces.size()) {
+        CustomData_copy_data(&mesh.face_data, &result->face_data, i, r_i, 1);
+      }
+    });
+  });
 
   debug_randomize_mesh_order(result);
 
@@ -1694,21 +1733,60 @@ static Mesh *create_merged_mesh(const Mesh &mesh,
 /** \name Merge Map Creation
  * \{ */
 
+/**
+ * Fill \a vert_dest_map like #BLI_kdtree_3d_calc_duplicates_fast with index order: every vertex
+ * is merged into the vertex with the lowest index within the distance, unless that vertex is
+ * merged itself. This is the same as Poisson disk elimination, which finds the vertices in
+ * parallel with a spatial hash grid.
+ *
+ * \return The number of merged vertices.
+ */
+static int find_duplicates_parallel(const Span<float3> positions,
+                                    const IndexMask &selection,
+                                    const float merge_distance,
+                                    MutableSpan<int> vert_dest_map)
+{
+  Array<int> selected_verts(selection.size());
+  selection.to_indices(selected_verts.as_mutable_span());
+  Array<float3> selected_positions(selection.size());
+  array_utils::gather(positions, selection, selected_positions.as_mutable_span());
+
+  Array<bool> is_merged(selection.size(), false);
+  Array<int> merged_into(selection.size());
+  poisson_disk::eliminate_close_points(selected_positions, merge_distance, is_merged, merged_into);
+
+  IndexMaskMemory memory;
+  const IndexMask merged = IndexMask::from_bools(is_merged, memory);
+  merged.foreach_index(GrainSize(4096), [&](const int i) {
+    const int vert_dest = selected_verts[merged_into[i]];
+    vert_dest_map[selected_verts[i]] = vert_dest;
+    /* Many vertices can be merged into the same vertex. */
+    atomic_store_int32(&vert_dest_map[vert_dest], vert_dest);
+  });
+  return int(merged.size());
+}
+
 std::optional<Mesh *> mesh_merge_by_distance_all(const Mesh &mesh,
                                                  const IndexMask &selection,
                                                  const float merge_distance)
 {
   Array<int> vert_dest_map(mesh.verts_num, OUT_OF_CONTEXT);
-
-  KDTree_3d *tree = BLI_kdtree_3d_new(selection.size());
-
   const Span<float3> positions = mesh.vert_positions();
-  selection.foreach_index([&](const int64_t i) { BLI_kdtree_3d_insert(tree, i, positions[i]); });
 
-  BLI_kdtree_3d_balance(tree);
-  const int vert_kill_len = BLI_kdtree_3d_calc_duplicates_fast(
-      tree, merge_distance, true, vert_dest_map.data());
-  BLI_kdtree_3d_free(tree);
+  int vert_kill_len;
+  if (merge_distance > 0.0f) {
+    vert_kill_len = find_duplicates_parallel(positions, selection, merge_distance, vert_dest_map);
+  }
+  else {
+    /* The hash grid needs a cell size, exact duplicates are found with a KD-tree instead. */
+    KDTree_3d *tree = BLI_kdtree_3d_new(selection.size());
+    selection.foreach_index([&](const int64_t i) { BLI_kdtree_3d_insert(tree, i, positions[i]); });
+
+    BLI_kdtree_3d_balance(tree);
+    vert_kill_len = BLI_kdtree_3d_calc_duplicates_fast(
+        tree, merge_distance, true, vert_dest_map.data());
+    BLI_kdtree_3d_free(tree);
+  }
 
   if (vert_kill_len == 0) {
     return std::nullopt;
@@ -18,10 +18,13 @@
 #include "DNA_object_types.h"
 
 #include "BLI_compiler_compat.h"
+#include "BLI_function_ref.hh"
 #include "BLI_listbase.h"
 #include "BLI_map.hh"
 #include "BLI_math_vector.h"
 #include "BLI_ordered_edge.hh"
+#include "BLI_set.hh"
+#include "BLI_task.h"
 
 #include "BLT_translation.hh"
 
@@ -34,6 +37,8 @@
 #include "BKE_object.hh"
 #include "BKE_subdiv.hh"
 
+#include <mutex>
+
 using Alembic::Abc::FloatArraySamplePtr;
 using Alembic::Abc::Int32ArraySamplePtr;
 using Alembic::Abc::P3fArraySamplePtr;
@@ -427,13 +432,17 @@ static bool samples_have_same_topology(const SampleType &sample, const SampleTyp
   return true;
 }
 
+/** Reads the mesh sample for a selector, which allows using samples that were read ahead. */
+using GetMeshSampleFn = FunctionRef<IPolyMeshSchema::Sample(const ISampleSelector &)>;
+
 static void read_mesh_sample(const std::string &iobject_full_name,
                              ImportSettings *settings,
                              const IPolyMeshSchema &schema,
                              const ISampleSelector &selector,
+                             const GetMeshSampleFn get_sample,
                              CDStreamConfig &config)
 {
-  const IPolyMeshSchema::Sample sample = schema.getValue(selector);
+  const IPolyMeshSchema::Sample sample = get_sample(selector);
 
   AbcMeshData abc_mesh_data;
   abc_mesh_data.face_counts = sample.getFaceCounts();
@@ -446,8 +455,8 @@ static void read_mesh_sample(const std::string &iobject_full_name,
 
   const bool use_vertex_interpolation = settings->read_flag & MOD_MESHSEQ_INTERPOLATE_VERTICES;
   if (use_vertex_interpolation && interpolation_settings.has_value()) {
-    Alembic::AbcGeom::IPolyMeshSchema::Sample ceil_sample;
-    schema.get(ceil_sample, Alembic::Abc::ISampleSelector(interpolation_settings->ceil_index));
+    const IPolyMeshSchema::Sample ceil_sample = get_sample(
+        Alembic::Abc::ISampleSelector(interpolation_settings->ceil_index));
     if (samples_have_same_topology(sample, ceil_sample)) {
       /* Only set interpolation data if the samples are compatible. */
       abc_mesh_data.ceil_positions = ceil_sample.getPositions();
@@ -497,6 +506,93 @@ static CDStreamConfig get_config(Mesh *mesh)
   return config;
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Sample Prefetching
+ *
+ * During playback the Mesh Sequence Cache modifier requests one sample after the other, and
+ * reading a sample blocks on the file, which is slow when the archive is on network storage. The
+ * samples following the current one are therefore read by a background thread while the current
+ * frame is evaluated, and kept until they are requested.
+ * \{ */
+
+/** Number of samples after the current one which are read ahead. */
+static constexpr int PREFETCH_SAMPLES_NUM = 3;
+
+using Alembic::AbcCoreAbstract::index_t;
+
+class MeshSamplePrefetcher {
+  IPolyMeshSchema schema_;
+  TaskPool *task_pool_;
+
+  std::mutex mutex_;
+  /** Samples which were read ahead, only samples close to the current one are kept. */
+  Map<index_t, IPolyMeshSchema::Sample> samples_;
+  /** Samples which are waiting to be read, or being read. */
+  Set<index_t> scheduled_;
+
+ public:
+  explicit MeshSamplePrefetcher(const IPolyMeshSchema &schema) : schema_(schema)
+  {
+    /* Reads from a single archive stream are serialized by Alembic, so there is nothing to gain
+     * from reading multiple samples in parallel. */
+    task_pool_ = BLI_task_pool_create_background_serial(this, TASK_PRIORITY_LOW);
+  }
+
+  ~MeshSamplePrefetcher()
+  {
+    BLI_task_pool_cancel(task_pool_);
+    BLI_task_pool_free(task_pool_);
+  }
+
+  std::optional<IPolyMeshSchema::Sample> lookup(const index_t index)
+  {
+    std::lock_guard lock{mutex_};
+    if (const IPolyMeshSchema::Sample *sample = samples_.lookup_ptr(index)) {
+      return *sample;
+    }
+    return std::nullopt;
+  }
+
+  /** Start reading the samples following \a index, and forget samples outside of that range. */
+  void schedule_after(const index_t index)
+  {
+    const index_t last = std::min<index_t>(index + PREFETCH_SAMPLES_NUM,
+                                           index_t(schema_.getNumSamples()) - 1);
+    std::lock_guard lock{mutex_};
+    samples_.remove_if([&](const auto item) { return item.key < index || item.key > last; });
+    for (index_t next = index + 1; next <= last; next++) {
+      if (samples_.contains(next) || !scheduled_.add(next)) {
+        continue;
+      }
+      BLI_task_pool_push(task_pool_, read_sample_task, POINTER_FROM_INT(next), false, nullptr);
+    }
+  }
+
+ private:
+  static void read_sample_task(TaskPool *__restrict pool, void *taskdata)
+  {
+    MeshSamplePrefetcher *prefetcher = static_cast<MeshSamplePrefetcher *>(
+        BLI_task_pool_user_data(pool));
+    const index_t index = POINTER_AS_INT(taskdata);
+
+    IPolyMeshSchema::Sample sample;
+    try {
+      prefetcher->schema_.get(sample, ISampleSelector(index));
+    }
+    catch (const Alembic::Util::Exception & /*ex*/) {
+      /* Errors are reported when the sample is read for evaluation. */
+    }
+
+    std::lock_guard lock{prefetcher->mutex_};
+    prefetcher->scheduled_.remove(index);
+    if (sample.valid()) {
+      prefetcher->samples_.add_overwrite(index, std::move(sample));
+    }
+  }
+};
+
+/** \} */
+
 /* ************************************************************************** */
 
 AbcMeshReader::AbcMeshReader(const IObject &object, ImportSettings &settings)
@@ -510,11 +606,25 @@ AbcMeshReader::AbcMeshReader(const IObject &object, ImportSettings &settings)
   get_min_max_time(m_iobject, m_schema, m_min_time, m_max_time);
 }
 
+AbcMeshReader::~AbcMeshReader() = default;
+
 bool AbcMeshReader::valid() const
 {
   return m_schema.valid();
 }
 
+IPolyMeshSchema::Sample AbcMeshReader::get_sample(const ISampleSelector &sample_sel) const
+{
+  if (m_prefetcher) {
+    const index_t index = sample_sel.getIndex(m_schema.getTimeSampling(),
+                                              m_schema.getNumSamples());
+    if (std::optional<IPolyMeshSchema::Sample> sample = m_prefetcher->lookup(index)) {
+      return *sample;
+    }
+  }
+  return m_schema.getValue(sample_sel);
+}
+
 template<class typedGeomParam>
 bool is_valid_animated(const ICompoundProperty arbGeomParams, const PropertyHeader &prop_header)
 {
@@ -620,7 +730,7 @@ bool AbcMeshReader::topology_changed(const Mesh *existing_mesh, const ISampleSel
 {
   IPolyMeshSchema::Sample sample;
   try {
-    sample = m_schema.getValue(sample_sel);
+    sample = get_sample(sample_sel);
   }
   catch (Alembic::Util::Exception &ex) {
     printf("Alembic: error reading mesh sample for '%s/%s' at time %f: %s\n",
@@ -692,10 +802,20 @@ void AbcMeshReader::read_geometry(bke::GeometrySet &geometry_set,
     return;
   }
 
+  /* Geometry is read for the cache modifier, where reading ahead helps playback. */
+  if (!m_prefetcher && m_schema.getNumSamples() > 1) {
+    m_prefetcher = std::make_unique<MeshSamplePrefetcher>(m_schema);
+  }
+
   Mesh *new_mesh = read_mesh(
       mesh, sample_sel, read_flag, velocity_name, velocity_scale, r_err_str);
 
   geometry_set.replace_mesh(new_mesh);
+
+  if (m_prefetcher) {
+    m_prefetcher->schedule_after(
+        sample_sel.getIndex(m_schema.getTimeSampling(), m_schema.getNumSamples()));
+  }
 }
 
 Mesh *AbcMeshReader::read_mesh(Mesh *existing_mesh,
@@ -707,7 +827,7 @@ Mesh *AbcMeshReader::read_mesh(Mesh *existing_mesh,
 {
   IPolyMeshSchema::Sample sample;
   try {
-    sample = m_schema.getValue(sample_sel);
+    sample = get_sample(sample_sel);
   }
   catch (Alembic::Util::Exception &ex) {
     if (r_err_str != nullptr) {
@@ -776,7 +896,13 @@ Mesh *AbcMeshReader::read_mesh(Mesh *existing_mesh,
   config.time = sample_sel.getRequestedTime();
   config.modifier_error_message = r_err_str;
 
-  read_mesh_sample(m_iobject.getFullName(), &settings, m_schema, sample_sel, config);
+  read_mesh_sample(
+      m_iobject.getFullName(),
+      &settings,
+      m_schema,
+      sample_sel,
+      [&](const ISampleSelector &selector) { return get_sample(selector); },
+      config);
 
   if (new_mesh) {
     /* Here we assume that the number of materials doesn't change, i.e. that
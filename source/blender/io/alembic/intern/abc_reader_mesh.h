@@ -7,6 +7,8 @@
  * \ingroup balembic
  */
 
+#include <memory>
+
 #include "BLI_span.hh"
 
 #include "abc_reader_object.h"
@@ -18,11 +20,16 @@ struct Mesh;
 
 namespace blender::io::alembic {
 
+class MeshSamplePrefetcher;
+
 class AbcMeshReader final : public AbcObjectReader {
   Alembic::AbcGeom::IPolyMeshSchema m_schema;
+  /** Reads the following samples in the background, created when reading animated geometry. */
+  std::unique_ptr<MeshSamplePrefetcher> m_prefetcher;
 
  public:
   AbcMeshReader(const Alembic::Abc::IObject &object, ImportSettings &settings);
+  ~AbcMeshReader() override;
 
   bool valid() const override;
   bool accepts_object_type(const Alembic::AbcCoreAbstract::ObjectHeader &alembic_header,
@@ -48,6 +55,10 @@ class AbcMeshReader final : public AbcObjectReader {
                         const Alembic::Abc::ISampleSelector &sample_sel) override;
 
  private:
+  /** Get the sample from the prefetched samples when possible, or read it from the archive. */
+  Alembic::AbcGeom::IPolyMeshSchema::Sample get_sample(
+      const Alembic::Abc::ISampleSelector &sample_sel) const;
+
   void readFaceSetsSample(Main *bmain,
                           Mesh *mesh,
                           const Alembic::AbcGeom::ISampleSelector &sample_sel);
@@ -1086,6 +1086,16 @@ typedef enum IDRecalcFlag {
    * have to be copied on every update. */
   ID_RECALC_PARAMETERS = (1 << 21),
 
+  /* Only values of simple properties did change, which can be synchronized to the evaluated copy
+   * in-place instead of copying the whole data-block again. Covered are custom properties of the
+   * ID, the transform of objects, the frame range settings of scenes and the default values of
+   * node sockets.
+   *
+   * Other tags passed together with this one are expected to be caused by the same value changes.
+   * When the ID is tagged separately for a change which requires copy-on-evaluation, a full copy
+   * is done. */
+  ID_RECALC_SYNC_VALUES_TO_EVAL = (1 << 22),
+
   /* Input has changed and data-block is to be reload from disk.
    * Applies to movie clips to inform that copy-on-written version is to be refreshed for the new
    * input file or for color space changes. */
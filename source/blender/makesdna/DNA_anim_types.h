@@ -21,6 +21,15 @@
 #  include <type_traits>
 #endif
 
+#ifdef __cplusplus
+namespace blender::bke {
+struct AnimDataEvalPlans;
+}
+using AnimDataEvalPlansHandle = blender::bke::AnimDataEvalPlans;
+#else
+typedef struct AnimDataEvalPlansHandle AnimDataEvalPlansHandle;
+#endif
+
 /* ************************************************ */
 /* F-Curve DataTypes */
 
@@ -1204,6 +1213,8 @@ typedef struct AnimData {
 
   /** Runtime data, for depsgraph evaluation. */
   FCurve **driver_array;
+  /** Runtime data, cached F-Curve evaluation data of evaluated IDs. */
+  AnimDataEvalPlansHandle *eval_plans;
 
   /* settings for animation evaluation */
   /** User-defined settings. */
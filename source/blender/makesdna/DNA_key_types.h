@@ -15,6 +15,15 @@
 #include "DNA_defs.h"
 #include "DNA_listBase.h"
 
+#ifdef __cplusplus
+namespace blender::bke {
+struct KeyRuntime;
+}
+using KeyRuntimeHandle = blender::bke::KeyRuntime;
+#else
+typedef struct KeyRuntimeHandle KeyRuntimeHandle;
+#endif
+
 struct AnimData;
 struct Ipo;
 
@@ -100,6 +109,9 @@ typedef struct Key {
    * current free UID for key-blocks.
    */
   int uidgen;
+
+  /** Runtime data of evaluated copies, null for original data. */
+  KeyRuntimeHandle *runtime;
 } Key;
 
 /* **************** KEY ********************* */
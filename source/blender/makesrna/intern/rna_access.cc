@@ -2377,8 +2377,12 @@ static void rna_property_update(
      * So editing custom properties only causes updates in the UI,
      * keep this exception because it happens to be useful for driving settings.
      * Python developers on the other hand will need to manually 'update_tag', see: #74000. */
-    DEG_id_tag_update(ptr->owner_id,
-                      ID_RECALC_TRANSFORM | ID_RECALC_GEOMETRY | ID_RECALC_PARAMETERS);
+    int recalc = ID_RECALC_TRANSFORM | ID_RECALC_GEOMETRY | ID_RECALC_PARAMETERS;
+    if (ptr->owner_id != nullptr && ptr->data == ptr->owner_id) {
+      /* Properties of the ID itself can be synchronized without copying the whole data-block. */
+      recalc |= ID_RECALC_SYNC_VALUES_TO_EVAL;
+    }
+    DEG_id_tag_update(ptr->owner_id, recalc);
 
     /* When updating an ID pointer property, tag depsgraph for update. */
     if (prop->type == PROP_POINTER && RNA_struct_is_ID(RNA_property_pointer_type(ptr, prop))) {
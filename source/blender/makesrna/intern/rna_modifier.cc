@@ -3522,6 +3522,12 @@ static void rna_def_modifier_boolean(BlenderRNA *brna)
        0,
        "Exact",
        "Advanced solver for the best result"},
+      {eBooleanModifierSolver_Manifold,
+       "MANIFOLD",
+       0,
+       "Manifold",
+       "Fast exact solver for closed manifold meshes without self-intersections, other meshes "
+       "are handled by the exact solver"},
       {0, nullptr, 0, nullptr, nullptr},
   };
 
@@ -8105,6 +8111,15 @@ static void rna_def_modifier_nodes(BlenderRNA *brna)
   RNA_def_property_flag(prop, PROP_NO_DEG_UPDATE);
   RNA_def_property_update(prop, NC_OBJECT | ND_MODIFIER, nullptr);
 
+  prop = RNA_def_property(srna, "use_node_output_cache", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, nullptr, "flag", NODES_MODIFIER_CACHE_NODE_OUTPUTS);
+  RNA_def_property_ui_text(prop,
+                           "Cache Node Outputs",
+                           "Keep the outputs of expensive nodes in memory and reuse them when "
+                           "their inputs did not change, which speeds up interactive tweaking at "
+                           "the cost of memory");
+  RNA_def_property_update(prop, 0, "rna_Modifier_update");
+
   prop = RNA_def_property(srna, "node_warnings", PROP_COLLECTION, PROP_NONE);
   RNA_def_property_collection_funcs(prop,
                                     "rna_NodesModifier_node_warnings_iterator_begin",
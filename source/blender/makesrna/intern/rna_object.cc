@@ -311,7 +311,7 @@ const EnumPropertyItem rna_enum_object_axis_items[] = {
 #  include "BKE_deform.hh"
 #  include "BKE_editlattice.h"
 #  include "BKE_editmesh.hh"
-#  include "BKE_effect.h"
+#  include "BKE_effect.hh"
 #  include "BKE_global.hh"
 #  include "BKE_key.hh"
 #  include "BKE_layer.hh"
@@ -341,6 +341,12 @@ static void rna_Object_internal_update(Main * /*bmain*/, Scene * /*scene*/, Poin
   DEG_id_tag_update(ptr->owner_id, ID_RECALC_TRANSFORM);
 }
 
+static void rna_Object_transform_update(Main * /*bmain*/, Scene * /*scene*/, PointerRNA *ptr)
+{
+  /* Only the transform values changed, which doesn't require a full copy of the object. */
+  DEG_id_tag_update(ptr->owner_id, ID_RECALC_TRANSFORM | ID_RECALC_SYNC_VALUES_TO_EVAL);
+}
+
 static void rna_Object_internal_update_draw(Main * /*bmain*/, Scene * /*scene*/, PointerRNA *ptr)
 {
   DEG_id_tag_update(ptr->owner_id, ID_RECALC_SHADING);
@@ -3066,13 +3072,15 @@ static void rna_def_object(BlenderRNA *brna)
   RNA_def_property_editable_array_func(prop, "rna_Object_location_editable");
   RNA_def_property_ui_text(prop, "Location", "Location of the object");
   RNA_def_property_ui_range(prop, -FLT_MAX, FLT_MAX, 1, RNA_TRANSLATION_PREC_DEFAULT);
-  RNA_def_property_update(prop, NC_OBJECT | ND_TRANSFORM, "rna_Object_internal_update");
+  RNA_def_property_flag(prop, PROP_NO_DEG_UPDATE); /* The update callback does tagging. */
+  RNA_def_property_update(prop, NC_OBJECT | ND_TRANSFORM, "rna_Object_transform_update");
 
   prop = RNA_def_property(srna, "rotation_quaternion", PROP_FLOAT, PROP_QUATERNION);
   RNA_def_property_float_sdna(prop, nullptr, "quat");
   RNA_def_property_editable_array_func(prop, "rna_Object_rotation_4d_editable");
   RNA_def_property_ui_text(prop, "Quaternion Rotation", "Rotation in Quaternions");
-  RNA_def_property_update(prop, NC_OBJECT | ND_TRANSFORM, "rna_Object_internal_update");
+  RNA_def_property_flag(prop, PROP_NO_DEG_UPDATE); /* The update callback does tagging. */
+  RNA_def_property_update(prop, NC_OBJECT | ND_TRANSFORM, "rna_Object_transform_update");
 
   /* XXX: for axis-angle, it would have been nice to have 2 separate fields for UI purposes, but
    * having a single one is better for Keyframing and other property-management situations...
@@ -3085,28 +3093,32 @@ static void rna_def_object(BlenderRNA *brna)
   RNA_def_property_float_array_default(prop, rna_default_axis_angle);
   RNA_def_property_ui_text(
       prop, "Axis-Angle Rotation", "Angle of Rotation for Axis-Angle rotation representation");
-  RNA_def_property_update(prop, NC_OBJECT | ND_TRANSFORM, "rna_Object_internal_update");
+  RNA_def_property_flag(prop, PROP_NO_DEG_UPDATE); /* The update callback does tagging. */
+  RNA_def_property_update(prop, NC_OBJECT | ND_TRANSFORM, "rna_Object_transform_update");
 
   prop = RNA_def_property(srna, "rotation_euler", PROP_FLOAT, PROP_EULER);
   RNA_def_property_float_sdna(prop, nullptr, "rot");
   RNA_def_property_editable_array_func(prop, "rna_Object_rotation_euler_editable");
   RNA_def_property_ui_range(prop, -FLT_MAX, FLT_MAX, 100, RNA_TRANSLATION_PREC_DEFAULT);
   RNA_def_property_ui_text(prop, "Euler Rotation", "Rotation in Eulers");
-  RNA_def_property_update(prop, NC_OBJECT | ND_TRANSFORM, "rna_Object_internal_update");
+  RNA_def_property_flag(prop, PROP_NO_DEG_UPDATE); /* The update callback does tagging. */
+  RNA_def_property_update(prop, NC_OBJECT | ND_TRANSFORM, "rna_Object_transform_update");
 
   prop = RNA_def_property(srna, "rotation_mode", PROP_ENUM, PROP_NONE);
   RNA_def_property_enum_sdna(prop, nullptr, "rotmode");
   RNA_def_property_enum_items(prop, rna_enum_object_rotation_mode_items);
   RNA_def_property_enum_funcs(prop, nullptr, "rna_Object_rotation_mode_set", nullptr);
   RNA_def_property_ui_text(prop, "Rotation Mode", "");
-  RNA_def_property_update(prop, NC_OBJECT | ND_TRANSFORM, "rna_Object_internal_update");
+  RNA_def_property_flag(prop, PROP_NO_DEG_UPDATE); /* The update callback does tagging. */
+  RNA_def_property_update(prop, NC_OBJECT | ND_TRANSFORM, "rna_Object_transform_update");
 
   prop = RNA_def_property(srna, "scale", PROP_FLOAT, PROP_XYZ);
   RNA_def_property_flag(prop, PROP_PROPORTIONAL);
   RNA_def_property_editable_array_func(prop, "rna_Object_scale_editable");
   RNA_def_property_ui_range(prop, -FLT_MAX, FLT_MAX, 1, 3);
   RNA_def_property_ui_text(prop, "Scale", "Scaling of the object");
-  RNA_def_property_update(prop, NC_OBJECT | ND_TRANSFORM, "rna_Object_internal_update");
+  RNA_def_property_flag(prop, PROP_NO_DEG_UPDATE); /* The update callback does tagging. */
+  RNA_def_property_update(prop, NC_OBJECT | ND_TRANSFORM, "rna_Object_transform_update");
 
   prop = RNA_def_property(srna, "dimensions", PROP_FLOAT, PROP_XYZ_LENGTH);
   RNA_def_property_array(prop, 3);
@@ -3130,7 +3142,8 @@ static void rna_def_object(BlenderRNA *brna)
   RNA_def_property_ui_text(
       prop, "Delta Location", "Extra translation added to the location of the object");
   RNA_def_property_ui_range(prop, -FLT_MAX, FLT_MAX, 1, RNA_TRANSLATION_PREC_DEFAULT);
-  RNA_def_property_update(prop, NC_OBJECT | ND_TRANSFORM, "rna_Object_internal_update");
+  RNA_def_property_flag(prop, PROP_NO_DEG_UPDATE); /* The update callback does tagging. */
+  RNA_def_property_update(prop, NC_OBJECT | ND_TRANSFORM, "rna_Object_transform_update");
 
   prop = RNA_def_property(srna, "delta_rotation_euler", PROP_FLOAT, PROP_EULER);
   RNA_def_property_float_sdna(prop, nullptr, "drot");
@@ -3139,7 +3152,8 @@ static void rna_def_object(BlenderRNA *brna)
       "Delta Rotation (Euler)",
       "Extra rotation added to the rotation of the object (when using Euler rotations)");
   RNA_def_property_ui_range(prop, -FLT_MAX, FLT_MAX, 100, RNA_TRANSLATION_PREC_DEFAULT);
-  RNA_def_property_update(prop, NC_OBJECT | ND_TRANSFORM, "rna_Object_internal_update");
+  RNA_def_property_flag(prop, PROP_NO_DEG_UPDATE); /* The update callback does tagging. */
+  RNA_def_property_update(prop, NC_OBJECT | ND_TRANSFORM, "rna_Object_transform_update");
 
   prop = RNA_def_property(srna, "delta_rotation_quaternion", PROP_FLOAT, PROP_QUATERNION);
   RNA_def_property_float_sdna(prop, nullptr, "dquat");
@@ -3147,7 +3161,8 @@ static void rna_def_object(BlenderRNA *brna)
       prop,
       "Delta Rotation (Quaternion)",
       "Extra rotation added to the rotation of the object (when using Quaternion rotations)");
-  RNA_def_property_update(prop, NC_OBJECT | ND_TRANSFORM, "rna_Object_internal_update");
+  RNA_def_property_flag(prop, PROP_NO_DEG_UPDATE); /* The update callback does tagging. */
+  RNA_def_property_update(prop, NC_OBJECT | ND_TRANSFORM, "rna_Object_transform_update");
 
 #  if 0 /* XXX not supported well yet... */
   prop = RNA_def_property(srna, "delta_rotation_axis_angle", PROP_FLOAT, PROP_AXISANGLE);
@@ -3166,7 +3181,8 @@ static void rna_def_object(BlenderRNA *brna)
   RNA_def_property_flag(prop, PROP_PROPORTIONAL);
   RNA_def_property_ui_range(prop, -FLT_MAX, FLT_MAX, 1, 3);
   RNA_def_property_ui_text(prop, "Delta Scale", "Extra scaling added to the scale of the object");
-  RNA_def_property_update(prop, NC_OBJECT | ND_TRANSFORM, "rna_Object_internal_update");
+  RNA_def_property_flag(prop, PROP_NO_DEG_UPDATE); /* The update callback does tagging. */
+  RNA_def_property_update(prop, NC_OBJECT | ND_TRANSFORM, "rna_Object_transform_update");
 
   /* transform locks */
   prop = RNA_def_property(srna, "lock_location", PROP_BOOLEAN, PROP_NONE);
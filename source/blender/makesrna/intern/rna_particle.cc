@@ -137,7 +137,7 @@ static const EnumPropertyItem part_fluid_type_items[] = {
 #  include "BKE_context.hh"
 #  include "BKE_customdata.hh"
 #  include "BKE_deform.hh"
-#  include "BKE_effect.h"
+#  include "BKE_effect.hh"
 #  include "BKE_material.hh"
 #  include "BKE_mesh.hh"
 #  include "BKE_mesh_legacy_convert.hh"
@@ -1114,10 +1114,18 @@ static void rna_Scene_show_subframe_update(Main * /*bmain*/,
 static void rna_Scene_frame_update(Main * /*bmain*/, Scene * /*current_scene*/, PointerRNA *ptr)
 {
   Scene *scene = (Scene *)ptr->owner_id;
-  DEG_id_tag_update(&scene->id, ID_RECALC_FRAME_CHANGE);
+  DEG_id_tag_update(&scene->id, ID_RECALC_FRAME_CHANGE | ID_RECALC_SYNC_VALUES_TO_EVAL);
   WM_main_add_notifier(NC_SCENE | ND_FRAME, scene);
 }
 
+static void rna_Scene_frame_range_update(Main * /*bmain*/,
+                                         Scene * /*current_scene*/,
+                                         PointerRNA *ptr)
+{
+  /* Only the frame range changed, which doesn't require a full copy of the scene. */
+  DEG_id_tag_update(ptr->owner_id, ID_RECALC_SYNC_VALUES_TO_EVAL);
+}
+
 static PointerRNA rna_Scene_active_keying_set_get(PointerRNA *ptr)
 {
   Scene *scene = (Scene *)ptr->data;
@@ -8555,6 +8563,7 @@ void RNA_def_scene(BlenderRNA *brna)
       prop,
       "Current Frame",
       "Current frame, to update animation data from Python frame_set() instead");
+  RNA_def_property_flag(prop, PROP_NO_DEG_UPDATE); /* The update callback does tagging. */
   RNA_def_property_update(prop, NC_SCENE | ND_FRAME, "rna_Scene_frame_update");
 
   prop = RNA_def_property(srna, "frame_subframe", PROP_FLOAT, PROP_TIME);
@@ -8563,6 +8572,7 @@ void RNA_def_scene(BlenderRNA *brna)
   RNA_def_property_clear_flag(prop, PROP_ANIMATABLE);
   RNA_def_property_range(prop, 0.0f, 1.0f);
   RNA_def_property_ui_range(prop, 0.0f, 1.0f, 0.01, 2);
+  RNA_def_property_flag(prop, PROP_NO_DEG_UPDATE); /* The update callback does tagging. */
   RNA_def_property_update(prop, NC_SCENE | ND_FRAME, "rna_Scene_frame_update");
 
   prop = RNA_def_property(srna, "frame_float", PROP_FLOAT, PROP_TIME);
@@ -8572,6 +8582,7 @@ void RNA_def_scene(BlenderRNA *brna)
   RNA_def_property_ui_range(prop, MINAFRAME, MAXFRAME, 0.1, 2);
   RNA_def_property_float_funcs(
       prop, "rna_Scene_frame_float_get", "rna_Scene_frame_float_set", nullptr);
+  RNA_def_property_flag(prop, PROP_NO_DEG_UPDATE); /* The update callback does tagging. */
   RNA_def_property_update(prop, NC_SCENE | ND_FRAME, "rna_Scene_frame_update");
 
   prop = RNA_def_property(srna, "frame_start", PROP_INT, PROP_TIME);
@@ -8580,7 +8591,8 @@ void RNA_def_scene(BlenderRNA *brna)
   RNA_def_property_int_funcs(prop, nullptr, "rna_Scene_start_frame_set", nullptr);
   RNA_def_property_range(prop, MINFRAME, MAXFRAME);
   RNA_def_property_ui_text(prop, "Start Frame", "First frame of the playback/rendering range");
-  RNA_def_property_update(prop, NC_SCENE | ND_FRAME_RANGE, nullptr);
+  RNA_def_property_flag(prop, PROP_NO_DEG_UPDATE); /* The update callback does tagging. */
+  RNA_def_property_update(prop, NC_SCENE | ND_FRAME_RANGE, "rna_Scene_frame_range_update");
 
   prop = RNA_def_property(srna, "frame_end", PROP_INT, PROP_TIME);
   RNA_def_property_clear_flag(prop, PROP_ANIMATABLE);
@@ -8588,7 +8600,8 @@ void RNA_def_scene(BlenderRNA *brna)
   RNA_def_property_int_funcs(prop, nullptr, "rna_Scene_end_frame_set", nullptr);
   RNA_def_property_range(prop, MINFRAME, MAXFRAME);
   RNA_def_property_ui_text(prop, "End Frame", "Final frame of the playback/rendering range");
-  RNA_def_property_update(prop, NC_SCENE | ND_FRAME_RANGE, nullptr);
+  RNA_def_property_flag(prop, PROP_NO_DEG_UPDATE); /* The update callback does tagging. */
+  RNA_def_property_update(prop, NC_SCENE | ND_FRAME_RANGE, "rna_Scene_frame_range_update");
 
   prop = RNA_def_property(srna, "frame_step", PROP_INT, PROP_TIME);
   RNA_def_property_clear_flag(prop, PROP_ANIMATABLE);
@@ -8599,7 +8612,8 @@ void RNA_def_scene(BlenderRNA *brna)
       prop,
       "Frame Step",
       "Number of frames to skip forward while rendering/playing back each frame");
-  RNA_def_property_update(prop, NC_SCENE | ND_FRAME, nullptr);
+  RNA_def_property_flag(prop, PROP_NO_DEG_UPDATE); /* The update callback does tagging. */
+  RNA_def_property_update(prop, NC_SCENE | ND_FRAME, "rna_Scene_frame_range_update");
 
   prop = RNA_def_property(srna, "frame_current_final", PROP_FLOAT, PROP_TIME);
   RNA_def_property_clear_flag(prop, PROP_ANIMATABLE | PROP_EDITABLE);
@@ -8625,7 +8639,8 @@ void RNA_def_scene(BlenderRNA *brna)
       prop,
       "Use Preview Range",
       "Use an alternative start/end frame range for animation playback and view renders");
-  RNA_def_property_update(prop, NC_SCENE | ND_FRAME, nullptr);
+  RNA_def_property_flag(prop, PROP_NO_DEG_UPDATE); /* The update callback does tagging. */
+  RNA_def_property_update(prop, NC_SCENE | ND_FRAME, "rna_Scene_frame_range_update");
   RNA_def_property_ui_icon(prop, ICON_PREVIEW_RANGE, 0);
 
   prop = RNA_def_property(srna, "frame_preview_start", PROP_INT, PROP_TIME);
@@ -8634,7 +8649,8 @@ void RNA_def_scene(BlenderRNA *brna)
   RNA_def_property_int_funcs(prop, nullptr, "rna_Scene_preview_range_start_frame_set", nullptr);
   RNA_def_property_ui_text(
       prop, "Preview Range Start Frame", "Alternative start frame for UI playback");
-  RNA_def_property_update(prop, NC_SCENE | ND_FRAME, nullptr);
+  RNA_def_property_flag(prop, PROP_NO_DEG_UPDATE); /* The update callback does tagging. */
+  RNA_def_property_update(prop, NC_SCENE | ND_FRAME, "rna_Scene_frame_range_update");
 
   prop = RNA_def_property(srna, "frame_preview_end", PROP_INT, PROP_TIME);
   RNA_def_property_clear_flag(prop, PROP_ANIMATABLE);
@@ -8642,7 +8658,8 @@ void RNA_def_scene(BlenderRNA *brna)
   RNA_def_property_int_funcs(prop, nullptr, "rna_Scene_preview_range_end_frame_set", nullptr);
   RNA_def_property_ui_text(
       prop, "Preview Range End Frame", "Alternative end frame for UI playback");
-  RNA_def_property_update(prop, NC_SCENE | ND_FRAME, nullptr);
+  RNA_def_property_flag(prop, PROP_NO_DEG_UPDATE); /* The update callback does tagging. */
+  RNA_def_property_update(prop, NC_SCENE | ND_FRAME, "rna_Scene_frame_range_update");
 
   /* Sub-frame for motion-blur debug. */
   prop = RNA_def_property(srna, "show_subframe", PROP_BOOLEAN, PROP_NONE);
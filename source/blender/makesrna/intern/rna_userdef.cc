@@ -201,6 +201,7 @@ static const EnumPropertyItem rna_enum_preferences_extension_repo_source_type_it
 #  include "BKE_preferences.h"
 #  include "BKE_screen.hh"
 #  include "BKE_sound.h"
+#  include "BKE_subdiv.hh"
 
 #  include "DEG_depsgraph.hh"
 
@@ -902,6 +903,15 @@ static void rna_Userdef_memcache_update(Main * /*bmain*/, Scene * /*scene*/, Poi
   USERDEF_TAG_DIRTY;
 }
 
+static void rna_Userdef_subdiv_cache_update(Main * /*bmain*/,
+                                            Scene * /*scene*/,
+                                            PointerRNA * /*ptr*/)
+{
+  blender::bke::subdiv::topology_refiner_cache_set_limit(int64_t(U.subdiv_cache_limit) * 1024 *
+                                                         1024);
+  USERDEF_TAG_DIRTY;
+}
+
 static void rna_Userdef_disk_cache_dir_update(Main * /*bmain*/,
                                               Scene * /*scene*/,
                                               PointerRNA * /*ptr*/)
@@ -6196,6 +6206,15 @@ static void rna_def_userdef_system(BlenderRNA *brna)
   RNA_def_property_ui_text(prop, "Memory Cache Limit", "Memory cache limit (in megabytes)");
   RNA_def_property_update(prop, 0, "rna_Userdef_memcache_update");
 
+  prop = RNA_def_property(srna, "subdivision_cache_limit", PROP_INT, PROP_NONE);
+  RNA_def_property_int_sdna(prop, nullptr, "subdiv_cache_limit");
+  RNA_def_property_range(prop, 0, max_memory_in_megabytes_int());
+  RNA_def_property_ui_text(prop,
+                           "Subdivision Cache Limit",
+                           "Memory limit for the refined topology of subdivision surfaces that is "
+                           "kept to be reused by meshes with the same topology (in megabytes)");
+  RNA_def_property_update(prop, 0, "rna_Userdef_subdiv_cache_update");
+
   /* Sequencer disk cache */
 
   prop = RNA_def_property(srna, "use_sequencer_disk_cache", PROP_BOOLEAN, PROP_NONE);
@@ -7594,6 +7613,13 @@ static void rna_def_userdef_experimental(BlenderRNA *brna)
       prop, "Shader Node Previews", "Enables previews in the shader node editor");
   RNA_def_property_update(prop, 0, "rna_userdef_ui_update");
 
+  prop = RNA_def_property(srna, "use_playback_geometry_cache", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_ui_text(prop,
+                           "Playback Geometry Cache",
+                           "Keep the evaluated geometry of played frames in memory, so that they "
+                           "don't have to be evaluated again until the scene is changed. The "
+                           "memory is limited by the Memory Cache Limit");
+
   prop = RNA_def_property(srna, "use_extensions_debug", PROP_BOOLEAN, PROP_NONE);
   RNA_def_property_ui_text(
       prop,
@@ -15,6 +15,9 @@ struct NodesModifierBake;
 namespace blender::bke::bake {
 struct ModifierCache;
 }
+namespace blender::nodes {
+class GeoNodesNodeOutputCache;
+}
 namespace blender::nodes::geo_eval_log {
 class GeoModifierLog;
 }
@@ -42,6 +45,12 @@ struct NodesModifierRuntime {
    * used by the evaluated modifier.
    */
   std::shared_ptr<bke::bake::ModifierCache> cache;
+  /**
+   * Outputs of nodes from the previous evaluation that can be reused when their inputs did not
+   * change. Only used when #NODES_MODIFIER_CACHE_NODE_OUTPUTS is enabled. It is shared between the
+   * original and evaluated modifier for the same reason as the simulation cache.
+   */
+  std::shared_ptr<nodes::GeoNodesNodeOutputCache> node_output_cache;
 };
 
 void nodes_modifier_data_block_destruct(NodesModifierDataBlock *data_block, bool do_id_user);
@@ -113,6 +113,20 @@ static void update_depsgraph(ModifierData *md, const ModifierUpdateDepsgraphCont
   DEG_add_depends_on_transform_relation(ctx->node, "Armature Modifier");
 }
 
+static void free_runtime_data(void *runtime_data)
+{
+  blender::bke::armature_deform_skinning_cache_free(
+      static_cast<blender::bke::ArmatureDeformSkinningCache *>(runtime_data));
+}
+
+static blender::bke::ArmatureDeformSkinningCache *skinning_cache_ensure(ModifierData *md)
+{
+  if (md->runtime == nullptr) {
+    md->runtime = blender::bke::armature_deform_skinning_cache_new();
+  }
+  return static_cast<blender::bke::ArmatureDeformSkinningCache *>(md->runtime);
+}
+
 static void deform_verts(ModifierData *md,
                          const ModifierEvalContext *ctx,
                          Mesh *mesh,
@@ -131,7 +145,8 @@ static void deform_verts(ModifierData *md,
                                        amd->deformflag,
                                        amd->vert_coords_prev,
                                        amd->defgrp_name,
-                                       mesh);
+                                       mesh,
+                                       skinning_cache_ensure(md));
 
   /* free cache */
   MEM_SAFE_FREE(amd->vert_coords_prev);
@@ -202,7 +217,8 @@ static void deform_matrices(ModifierData *md,
                                        amd->deformflag,
                                        nullptr,
                                        amd->defgrp_name,
-                                       mesh);
+                                       mesh,
+                                       skinning_cache_ensure(md));
 }
 
 static void panel_draw(const bContext * /*C*/, Panel *panel)
@@ -270,7 +286,7 @@ ModifierTypeInfo modifierType_Armature = {
     /*depends_on_normals*/ nullptr,
     /*foreach_ID_link*/ foreach_ID_link,
     /*foreach_tex_link*/ nullptr,
-    /*free_runtime_data*/ nullptr,
+    /*free_runtime_data*/ free_runtime_data,
     /*panel_register*/ panel_register,
     /*blend_write*/ nullptr,
     /*blend_read*/ blend_read,
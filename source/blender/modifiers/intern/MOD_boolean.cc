@@ -82,7 +82,7 @@ static bool is_disabled(const Scene * /*scene*/, ModifierData *md, bool /*use_re
   }
   if (bmd->flag & eBooleanModifierFlag_Collection) {
     /* The Exact solver tolerates an empty collection. */
-    return !col && bmd->solver != eBooleanModifierSolver_Mesh_Arr;
+    return !col && bmd->solver == eBooleanModifierSolver_Float;
   }
   return false;
 }
@@ -174,7 +174,7 @@ static bool BMD_error_messages(const Object *ob, ModifierData *md)
   bool error_returns_result = false;
 
   const bool operand_collection = (bmd->flag & eBooleanModifierFlag_Collection) != 0;
-  const bool use_exact = bmd->solver == eBooleanModifierSolver_Mesh_Arr;
+  const bool use_exact = bmd->solver != eBooleanModifierSolver_Float;
   const bool operation_intersect = bmd->operation == eBooleanModifierOp_Intersect;
 
 #ifndef WITH_GMP
@@ -485,7 +485,9 @@ static Mesh *exact_boolean_mesh(BooleanModifierData *bmd,
       ctx->object->object_to_world(),
       material_remaps,
       op_params,
-      blender::geometry::boolean::Solver::MeshArr,
+      bmd->solver == eBooleanModifierSolver_Manifold ?
+          blender::geometry::boolean::Solver::Manifold :
+          blender::geometry::boolean::Solver::MeshArr,
       nullptr);
 
   if (material_mode == eBooleanModifierMaterialMode_Transfer) {
@@ -514,7 +516,7 @@ static Mesh *modify_mesh(ModifierData *md, const ModifierEvalContext *ctx, Mesh
   }
 
 #ifdef WITH_GMP
-  if (bmd->solver == eBooleanModifierSolver_Mesh_Arr) {
+  if (bmd->solver != eBooleanModifierSolver_Float) {
     return exact_boolean_mesh(bmd, ctx, mesh);
   }
 #endif
@@ -632,7 +634,7 @@ static void solver_options_panel_draw(const bContext * /*C*/, Panel *panel)
   uiLayout *layout = panel->layout;
   PointerRNA *ptr = modifier_panel_get_property_pointers(panel, nullptr);
 
-  const bool use_exact = RNA_enum_get(ptr, "solver") == eBooleanModifierSolver_Mesh_Arr;
+  const bool use_exact = RNA_enum_get(ptr, "solver") != eBooleanModifierSolver_Float;
 
   uiLayoutSetPropSep(layout, true);
 
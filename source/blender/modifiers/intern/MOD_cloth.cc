@@ -26,7 +26,7 @@
 
 #include "BKE_cloth.hh"
 #include "BKE_customdata.hh"
-#include "BKE_effect.h"
+#include "BKE_effect.hh"
 #include "BKE_global.hh"
 #include "BKE_key.hh"
 #include "BKE_lib_id.hh"
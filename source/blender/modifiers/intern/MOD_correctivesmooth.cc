@@ -8,9 +8,12 @@
  * Method of smoothing deformation, also known as 'delta-mush'.
  */
 
+#include "BLI_array.hh"
 #include "BLI_math_base.hh"
 #include "BLI_math_matrix.h"
 #include "BLI_math_vector.h"
+#include "BLI_math_vector.hh"
+#include "BLI_task.hh"
 #include "BLI_utildefines.h"
 
 #include "BLT_translation.hh"
@@ -25,6 +28,8 @@
 
 #include "BKE_deform.hh"
 #include "BKE_editmesh.hh"
+#include "BKE_mesh.hh"
+#include "BKE_mesh_mapping.hh"
 
 #include "UI_interface.hh"
 #include "UI_resources.hh"
@@ -151,177 +156,106 @@ static void mesh_get_boundaries(Mesh *mesh, float *smooth_weights)
 /* Simple Weighted Smoothing
  *
  * (average of surrounding verts)
+ *
+ * Both smoothing methods are Jacobi iterations: every vertex only reads the positions of the
+ * previous iteration, so vertices are smoothed in parallel, gathering over their edges.
  */
 static void smooth_iter__simple(CorrectiveSmoothModifierData *csmd,
-                                Mesh *mesh,
+                                const blender::Span<blender::int2> edges,
+                                const blender::GroupedSpan<int> vert_to_edge,
                                 blender::MutableSpan<blender::float3> vertexCos,
                                 const float *smooth_weights,
                                 uint iterations)
 {
+  using namespace blender;
   const float lambda = csmd->lambda;
-  int i;
-
-  const int edges_num = mesh->edges_num;
-  const blender::Span<blender::int2> edges = mesh->edges();
-
-  struct SmoothingData_Simple {
-    float delta[3];
-  };
-  SmoothingData_Simple *smooth_data = MEM_cnew_array<SmoothingData_Simple>(
-      size_t(vertexCos.size()), __func__);
-
-  float *vertex_edge_count_div = static_cast<float *>(
-      MEM_calloc_arrayN(size_t(vertexCos.size()), sizeof(float), __func__));
-
-  /* calculate as floats to avoid int->float conversion in #smooth_iter */
-  for (i = 0; i < edges_num; i++) {
-    vertex_edge_count_div[edges[i][0]] += 1.0f;
-    vertex_edge_count_div[edges[i][1]] += 1.0f;
-  }
 
   /* a little confusing, but we can include 'lambda' and smoothing weight
    * here to avoid multiplying for every iteration */
-  if (smooth_weights == nullptr) {
-    for (i = 0; i < vertexCos.size(); i++) {
-      vertex_edge_count_div[i] = lambda * (vertex_edge_count_div[i] ?
-                                               (1.0f / vertex_edge_count_div[i]) :
-                                               1.0f);
-    }
-  }
-  else {
-    for (i = 0; i < vertexCos.size(); i++) {
-      vertex_edge_count_div[i] = smooth_weights[i] * lambda *
-                                 (vertex_edge_count_div[i] ? (1.0f / vertex_edge_count_div[i]) :
-                                                             1.0f);
+  Array<float> vertex_edge_count_div(vertexCos.size());
+  threading::parallel_for(vertexCos.index_range(), 4096, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      /* calculate as floats to avoid int->float conversion in #smooth_iter */
+      const float edge_count = float(vert_to_edge[i].size());
+      const float weight = smooth_weights ? smooth_weights[i] : 1.0f;
+      vertex_edge_count_div[i] = weight * lambda * (edge_count ? (1.0f / edge_count) : 1.0f);
     }
-  }
+  });
 
   /* -------------------------------------------------------------------- */
   /* Main Smoothing Loop */
 
+  Array<float3> next_positions(vertexCos.size());
+  MutableSpan<float3> src = vertexCos;
+  MutableSpan<float3> dst = next_positions;
   while (iterations--) {
-    for (i = 0; i < edges_num; i++) {
-      SmoothingData_Simple *sd_v1;
-      SmoothingData_Simple *sd_v2;
-      float edge_dir[3];
-
-      sub_v3_v3v3(edge_dir, vertexCos[edges[i][1]], vertexCos[edges[i][0]]);
-
-      sd_v1 = &smooth_data[edges[i][0]];
-      sd_v2 = &smooth_data[edges[i][1]];
-
-      add_v3_v3(sd_v1->delta, edge_dir);
-      sub_v3_v3(sd_v2->delta, edge_dir);
-    }
-
-    for (i = 0; i < vertexCos.size(); i++) {
-      SmoothingData_Simple *sd = &smooth_data[i];
-      madd_v3_v3fl(vertexCos[i], sd->delta, vertex_edge_count_div[i]);
-      /* zero for the next iteration (saves memset on entire array) */
-      memset(sd, 0, sizeof(*sd));
-    }
+    threading::parallel_for(src.index_range(), 1024, [&](const IndexRange range) {
+      for (const int64_t i : range) {
+        float3 delta(0.0f);
+        for (const int edge : vert_to_edge[i]) {
+          delta += src[bke::mesh::edge_other_vert(edges[edge], int(i))] - src[i];
+        }
+        dst[i] = src[i] + delta * vertex_edge_count_div[i];
+      }
+    });
+    std::swap(src, dst);
+  }
+  if (src.data() != vertexCos.data()) {
+    vertexCos.copy_from(src);
   }
-
-  MEM_freeN(vertex_edge_count_div);
-  MEM_freeN(smooth_data);
 }
 
 /* -------------------------------------------------------------------- */
 /* Edge-Length Weighted Smoothing
  */
 static void smooth_iter__length_weight(CorrectiveSmoothModifierData *csmd,
-                                       Mesh *mesh,
+                                       const blender::Span<blender::int2> edges,
+                                       const blender::GroupedSpan<int> vert_to_edge,
                                        blender::MutableSpan<blender::float3> vertexCos,
                                        const float *smooth_weights,
                                        uint iterations)
 {
+  using namespace blender;
   const float eps = FLT_EPSILON * 10.0f;
-  const uint edges_num = uint(mesh->edges_num);
   /* NOTE: the way this smoothing method works, its approx half as strong as the simple-smooth,
    * and 2.0 rarely spikes, double the value for consistent behavior. */
   const float lambda = csmd->lambda * 2.0f;
-  const blender::Span<blender::int2> edges = mesh->edges();
-  uint i;
-
-  struct SmoothingData_Weighted {
-    float delta[3];
-    float edge_length_sum;
-  };
-  SmoothingData_Weighted *smooth_data = MEM_cnew_array<SmoothingData_Weighted>(
-      size_t(vertexCos.size()), __func__);
-
-  /* calculate as floats to avoid int->float conversion in #smooth_iter */
-  float *vertex_edge_count = static_cast<float *>(
-      MEM_calloc_arrayN(size_t(vertexCos.size()), sizeof(float), __func__));
-  for (i = 0; i < edges_num; i++) {
-    vertex_edge_count[edges[i][0]] += 1.0f;
-    vertex_edge_count[edges[i][1]] += 1.0f;
-  }
 
   /* -------------------------------------------------------------------- */
   /* Main Smoothing Loop */
 
+  Array<float3> next_positions(vertexCos.size());
+  MutableSpan<float3> src = vertexCos;
+  MutableSpan<float3> dst = next_positions;
   while (iterations--) {
-    for (i = 0; i < edges_num; i++) {
-      SmoothingData_Weighted *sd_v1;
-      SmoothingData_Weighted *sd_v2;
-      float edge_dir[3];
-      float edge_dist;
-
-      sub_v3_v3v3(edge_dir, vertexCos[edges[i][1]], vertexCos[edges[i][0]]);
-      edge_dist = len_v3(edge_dir);
-
-      /* weight by distance */
-      mul_v3_fl(edge_dir, edge_dist);
-
-      sd_v1 = &smooth_data[edges[i][0]];
-      sd_v2 = &smooth_data[edges[i][1]];
-
-      add_v3_v3(sd_v1->delta, edge_dir);
-      sub_v3_v3(sd_v2->delta, edge_dir);
-
-      sd_v1->edge_length_sum += edge_dist;
-      sd_v2->edge_length_sum += edge_dist;
-    }
-
-    if (smooth_weights == nullptr) {
-      /* fast-path */
-      for (i = 0; i < vertexCos.size(); i++) {
-        SmoothingData_Weighted *sd = &smooth_data[i];
+    threading::parallel_for(src.index_range(), 1024, [&](const IndexRange range) {
+      for (const int64_t i : range) {
+        float3 delta(0.0f);
+        float edge_length_sum = 0.0f;
+        for (const int edge : vert_to_edge[i]) {
+          const float3 edge_dir = src[bke::mesh::edge_other_vert(edges[edge], int(i))] - src[i];
+          const float edge_dist = math::length(edge_dir);
+          /* weight by distance */
+          delta += edge_dir * edge_dist;
+          edge_length_sum += edge_dist;
+        }
         /* Divide by sum of all neighbor distances (weighted) and amount of neighbors,
          * (mean average). */
-        const float div = sd->edge_length_sum * vertex_edge_count[i];
+        const float div = edge_length_sum * float(vert_to_edge[i].size());
         if (div > eps) {
-#if 0
-          /* first calculate the new location */
-          mul_v3_fl(sd->delta, 1.0f / div);
-          /* then interpolate */
-          madd_v3_v3fl(vertexCos[i], sd->delta, lambda);
-#else
-          /* do this in one step */
-          madd_v3_v3fl(vertexCos[i], sd->delta, lambda / div);
-#endif
+          const float lambda_w = smooth_weights ? lambda * smooth_weights[i] : lambda;
+          dst[i] = src[i] + delta * (lambda_w / div);
         }
-        /* zero for the next iteration (saves memset on entire array) */
-        memset(sd, 0, sizeof(*sd));
-      }
-    }
-    else {
-      for (i = 0; i < vertexCos.size(); i++) {
-        SmoothingData_Weighted *sd = &smooth_data[i];
-        const float div = sd->edge_length_sum * vertex_edge_count[i];
-        if (div > eps) {
-          const float lambda_w = lambda * smooth_weights[i];
-          madd_v3_v3fl(vertexCos[i], sd->delta, lambda_w / div);
+        else {
+          dst[i] = src[i];
         }
-
-        memset(sd, 0, sizeof(*sd));
       }
-    }
+    });
+    std::swap(src, dst);
+  }
+  if (src.data() != vertexCos.data()) {
+    vertexCos.copy_from(src);
   }
-
-  MEM_freeN(vertex_edge_count);
-  MEM_freeN(smooth_data);
 }
 
 static void smooth_iter(CorrectiveSmoothModifierData *csmd,
@@ -330,14 +264,22 @@ static void smooth_iter(CorrectiveSmoothModifierData *csmd,
                         const float *smooth_weights,
                         uint iterations)
 {
+  using namespace blender;
+  /* Vertex to edge adjacency in compressed sparse row layout, built once for all iterations. */
+  const Span<int2> edges = mesh->edges();
+  Array<int> vert_to_edge_offsets;
+  Array<int> vert_to_edge_indices;
+  const GroupedSpan<int> vert_to_edge = bke::mesh::build_vert_to_edge_map(
+      edges, int(vertexCos.size()), vert_to_edge_offsets, vert_to_edge_indices);
+
   switch (csmd->smooth_type) {
     case MOD_CORRECTIVESMOOTH_SMOOTH_LENGTH_WEIGHT:
-      smooth_iter__length_weight(csmd, mesh, vertexCos, smooth_weights, iterations);
+      smooth_iter__length_weight(csmd, edges, vert_to_edge, vertexCos, smooth_weights, iterations);
       break;
 
     /* case MOD_CORRECTIVESMOOTH_SMOOTH_SIMPLE: */
     default:
-      smooth_iter__simple(csmd, mesh, vertexCos, smooth_weights, iterations);
+      smooth_iter__simple(csmd, edges, vert_to_edge, vertexCos, smooth_weights, iterations);
       break;
   }
 }
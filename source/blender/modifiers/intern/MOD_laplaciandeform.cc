@@ -11,6 +11,7 @@
 #include "BLI_math_geom.h"
 #include "BLI_math_vector.h"
 #include "BLI_string.h"
+#include "BLI_task.hh"
 #include "BLI_utildefines_stack.h"
 
 #include "MEM_guardedalloc.h"
@@ -307,97 +308,121 @@ static void initLaplacianMatrix(LaplacianSystem *sys)
 
 static void computeImplictRotations(LaplacianSystem *sys)
 {
-  int vid, *vidn = nullptr;
-  float minj, mjt, qj[3], vj[3];
-  int i, j, ln;
-
-  for (i = 0; i < sys->verts_num; i++) {
-    normalize_v3(sys->no[i]);
-    vidn = sys->ringv_map[i].indices;
-    ln = sys->ringv_map[i].count;
-    minj = 1000000.0f;
-    for (j = 0; j < ln; j++) {
-      vid = vidn[j];
-      copy_v3_v3(qj, sys->co[vid]);
-      sub_v3_v3v3(vj, qj, sys->co[i]);
-      normalize_v3(vj);
-      mjt = fabsf(dot_v3v3(vj, sys->no[i]));
-      if (mjt < minj) {
-        minj = mjt;
-        sys->unit_verts[i] = vidn[j];
-      }
-    }
-  }
+  blender::threading::parallel_for(
+      blender::IndexRange(sys->verts_num), 1024, [&](const blender::IndexRange range) {
+        for (const int i : range) {
+          normalize_v3(sys->no[i]);
+          const int *vidn = sys->ringv_map[i].indices;
+          const int ln = sys->ringv_map[i].count;
+          float minj = 1000000.0f;
+          for (int j = 0; j < ln; j++) {
+            const int vid = vidn[j];
+            float vj[3];
+            sub_v3_v3v3(vj, sys->co[vid], sys->co[i]);
+            normalize_v3(vj);
+            const float mjt = fabsf(dot_v3v3(vj, sys->no[i]));
+            if (mjt < minj) {
+              minj = mjt;
+              sys->unit_verts[i] = vidn[j];
+            }
+          }
+        }
+      });
 }
 
-static void rotateDifferentialCoordinates(LaplacianSystem *sys)
+static void rotateDifferentialCoordinate(LaplacianSystem *sys, const int i)
 {
   float alpha, beta, gamma;
   float pj[3], ni[3], di[3];
   float uij[3], dun[3], e2[3], pi[3], fni[3], vn[3][3];
-  int i, j, fidn_num, k, fi;
+  int j, fidn_num, k, fi;
   int *fidn;
 
-  for (i = 0; i < sys->verts_num; i++) {
-    copy_v3_v3(pi, sys->co[i]);
-    copy_v3_v3(ni, sys->no[i]);
-    k = sys->unit_verts[i];
-    copy_v3_v3(pj, sys->co[k]);
-    sub_v3_v3v3(uij, pj, pi);
-    mul_v3_v3fl(dun, ni, dot_v3v3(uij, ni));
-    sub_v3_v3(uij, dun);
-    normalize_v3(uij);
-    cross_v3_v3v3(e2, ni, uij);
-    copy_v3_v3(di, sys->delta[i]);
-    alpha = dot_v3v3(ni, di);
-    beta = dot_v3v3(uij, di);
-    gamma = dot_v3v3(e2, di);
-
-    pi[0] = EIG_linear_solver_variable_get(sys->context, 0, i);
-    pi[1] = EIG_linear_solver_variable_get(sys->context, 1, i);
-    pi[2] = EIG_linear_solver_variable_get(sys->context, 2, i);
-    zero_v3(ni);
-    fidn_num = sys->ringf_map[i].count;
-    for (fi = 0; fi < fidn_num; fi++) {
-      const uint *vin;
-      fidn = sys->ringf_map[i].indices;
-      vin = sys->tris[fidn[fi]];
-      for (j = 0; j < 3; j++) {
-        vn[j][0] = EIG_linear_solver_variable_get(sys->context, 0, vin[j]);
-        vn[j][1] = EIG_linear_solver_variable_get(sys->context, 1, vin[j]);
-        vn[j][2] = EIG_linear_solver_variable_get(sys->context, 2, vin[j]);
-        if (vin[j] == sys->unit_verts[i]) {
-          copy_v3_v3(pj, vn[j]);
-        }
+  copy_v3_v3(pi, sys->co[i]);
+  copy_v3_v3(ni, sys->no[i]);
+  k = sys->unit_verts[i];
+  copy_v3_v3(pj, sys->co[k]);
+  sub_v3_v3v3(uij, pj, pi);
+  mul_v3_v3fl(dun, ni, dot_v3v3(uij, ni));
+  sub_v3_v3(uij, dun);
+  normalize_v3(uij);
+  cross_v3_v3v3(e2, ni, uij);
+  copy_v3_v3(di, sys->delta[i]);
+  alpha = dot_v3v3(ni, di);
+  beta = dot_v3v3(uij, di);
+  gamma = dot_v3v3(e2, di);
+
+  pi[0] = EIG_linear_solver_variable_get(sys->context, 0, i);
+  pi[1] = EIG_linear_solver_variable_get(sys->context, 1, i);
+  pi[2] = EIG_linear_solver_variable_get(sys->context, 2, i);
+  zero_v3(ni);
+  fidn_num = sys->ringf_map[i].count;
+  for (fi = 0; fi < fidn_num; fi++) {
+    const uint *vin;
+    fidn = sys->ringf_map[i].indices;
+    vin = sys->tris[fidn[fi]];
+    for (j = 0; j < 3; j++) {
+      vn[j][0] = EIG_linear_solver_variable_get(sys->context, 0, vin[j]);
+      vn[j][1] = EIG_linear_solver_variable_get(sys->context, 1, vin[j]);
+      vn[j][2] = EIG_linear_solver_variable_get(sys->context, 2, vin[j]);
+      if (vin[j] == sys->unit_verts[i]) {
+        copy_v3_v3(pj, vn[j]);
       }
-
-      normal_tri_v3(fni, UNPACK3(vn));
-      add_v3_v3(ni, fni);
     }
 
-    normalize_v3(ni);
-    sub_v3_v3v3(uij, pj, pi);
-    mul_v3_v3fl(dun, ni, dot_v3v3(uij, ni));
-    sub_v3_v3(uij, dun);
-    normalize_v3(uij);
-    cross_v3_v3v3(e2, ni, uij);
-    fni[0] = alpha * ni[0] + beta * uij[0] + gamma * e2[0];
-    fni[1] = alpha * ni[1] + beta * uij[1] + gamma * e2[1];
-    fni[2] = alpha * ni[2] + beta * uij[2] + gamma * e2[2];
-
-    if (len_squared_v3(fni) > FLT_EPSILON) {
-      EIG_linear_solver_right_hand_side_add(sys->context, 0, i, fni[0]);
-      EIG_linear_solver_right_hand_side_add(sys->context, 1, i, fni[1]);
-      EIG_linear_solver_right_hand_side_add(sys->context, 2, i, fni[2]);
-    }
-    else {
-      EIG_linear_solver_right_hand_side_add(sys->context, 0, i, sys->delta[i][0]);
-      EIG_linear_solver_right_hand_side_add(sys->context, 1, i, sys->delta[i][1]);
-      EIG_linear_solver_right_hand_side_add(sys->context, 2, i, sys->delta[i][2]);
-    }
+    normal_tri_v3(fni, UNPACK3(vn));
+    add_v3_v3(ni, fni);
+  }
+
+  normalize_v3(ni);
+  sub_v3_v3v3(uij, pj, pi);
+  mul_v3_v3fl(dun, ni, dot_v3v3(uij, ni));
+  sub_v3_v3(uij, dun);
+  normalize_v3(uij);
+  cross_v3_v3v3(e2, ni, uij);
+  fni[0] = alpha * ni[0] + beta * uij[0] + gamma * e2[0];
+  fni[1] = alpha * ni[1] + beta * uij[1] + gamma * e2[1];
+  fni[2] = alpha * ni[2] + beta * uij[2] + gamma * e2[2];
+
+  if (len_squared_v3(fni) > FLT_EPSILON) {
+    EIG_linear_solver_right_hand_side_add(sys->context, 0, i, fni[0]);
+    EIG_linear_solver_right_hand_side_add(sys->context, 1, i, fni[1]);
+    EIG_linear_solver_right_hand_side_add(sys->context, 2, i, fni[2]);
+  }
+  else {
+    EIG_linear_solver_right_hand_side_add(sys->context, 0, i, sys->delta[i][0]);
+    EIG_linear_solver_right_hand_side_add(sys->context, 1, i, sys->delta[i][1]);
+    EIG_linear_solver_right_hand_side_add(sys->context, 2, i, sys->delta[i][2]);
   }
 }
 
+/**
+ * Every vertex only reads the solution of the previous solve and only writes its own right hand
+ * side values, so vertices are processed in parallel. The matrix of the solver is already
+ * constructed at this point.
+ */
+static void rotateDifferentialCoordinates(LaplacianSystem *sys)
+{
+  blender::threading::parallel_for(
+      blender::IndexRange(sys->verts_num), 512, [&](const blender::IndexRange range) {
+        for (const int i : range) {
+          rotateDifferentialCoordinate(sys, i);
+        }
+      });
+}
+
+static void copySolutionToCoordinates(LaplacianSystem *sys, float (*vertexCos)[3])
+{
+  blender::threading::parallel_for(
+      blender::IndexRange(sys->verts_num), 4096, [&](const blender::IndexRange range) {
+        for (const int vid : range) {
+          vertexCos[vid][0] = EIG_linear_solver_variable_get(sys->context, 0, vid);
+          vertexCos[vid][1] = EIG_linear_solver_variable_get(sys->context, 1, vid);
+          vertexCos[vid][2] = EIG_linear_solver_variable_get(sys->context, 2, vid);
+        }
+      });
+}
+
 static void laplacianDeformPreview(LaplacianSystem *sys, float (*vertexCos)[3])
 {
   int vid, i, j, n, na;
@@ -453,11 +478,7 @@ static void laplacianDeformPreview(LaplacianSystem *sys, float (*vertexCos)[3])
         }
       }
       if (sys->has_solution) {
-        for (vid = 0; vid < sys->verts_num; vid++) {
-          vertexCos[vid][0] = EIG_linear_solver_variable_get(sys->context, 0, vid);
-          vertexCos[vid][1] = EIG_linear_solver_variable_get(sys->context, 1, vid);
-          vertexCos[vid][2] = EIG_linear_solver_variable_get(sys->context, 2, vid);
-        }
+        copySolutionToCoordinates(sys, vertexCos);
       }
       else {
         sys->has_solution = false;
@@ -469,11 +490,16 @@ static void laplacianDeformPreview(LaplacianSystem *sys, float (*vertexCos)[3])
     sys->is_matrix_computed = true;
   }
   else if (sys->has_solution) {
-    for (i = 0; i < n; i++) {
-      EIG_linear_solver_right_hand_side_add(sys->context, 0, i, sys->delta[i][0]);
-      EIG_linear_solver_right_hand_side_add(sys->context, 1, i, sys->delta[i][1]);
-      EIG_linear_solver_right_hand_side_add(sys->context, 2, i, sys->delta[i][2]);
-    }
+    /* The factorization of the matrix is kept from the first solve, only the right hand side
+     * changes with the anchors. */
+    blender::threading::parallel_for(
+        blender::IndexRange(n), 4096, [&](const blender::IndexRange range) {
+          for (const int i : range) {
+            EIG_linear_solver_right_hand_side_add(sys->context, 0, i, sys->delta[i][0]);
+            EIG_linear_solver_right_hand_side_add(sys->context, 1, i, sys->delta[i][1]);
+            EIG_linear_solver_right_hand_side_add(sys->context, 2, i, sys->delta[i][2]);
+          }
+        });
     for (i = 0; i < na; i++) {
       vid = sys->index_anchors[i];
       EIG_linear_solver_right_hand_side_add(sys->context, 0, n + i, vertexCos[vid][0]);
@@ -499,11 +525,7 @@ static void laplacianDeformPreview(LaplacianSystem *sys, float (*vertexCos)[3])
         }
       }
       if (sys->has_solution) {
-        for (vid = 0; vid < sys->verts_num; vid++) {
-          vertexCos[vid][0] = EIG_linear_solver_variable_get(sys->context, 0, vid);
-          vertexCos[vid][1] = EIG_linear_solver_variable_get(sys->context, 1, vid);
-          vertexCos[vid][2] = EIG_linear_solver_variable_get(sys->context, 2, vid);
-        }
+        copySolutionToCoordinates(sys, vertexCos);
       }
       else {
         sys->has_solution = false;
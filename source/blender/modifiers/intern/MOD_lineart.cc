@@ -95,6 +95,8 @@ static void copy_data(const ModifierData *md, ModifierData *target, const int fl
       reinterpret_cast<GreasePencilLineartModifierData *>(target);
 
   target_lmd->runtime = MEM_new<LineartModifierRuntime>(__func__, *source_runtime);
+  /* The cached adjacency belongs to the evaluation of the source modifier. */
+  target_lmd->runtime->adjacency_cache.reset();
 }
 
 static void free_data(ModifierData *md)
@@ -6,6 +6,8 @@
  * \ingroup modifiers
  */
 
+#include <memory>
+
 #include "BLI_utildefines.h"
 
 #include "BLI_math_matrix.h"
@@ -52,6 +54,17 @@ static void init_data(ModifierData *md)
   MEMCPY_STRUCT_AFTER(mcmd, DNA_struct_default_get(MeshCacheModifierData), modifier);
 }
 
+static void free_runtime_data(void *runtime_data)
+{
+  delete static_cast<MeshCacheFile *>(runtime_data);
+}
+
+static void free_data(ModifierData *md)
+{
+  free_runtime_data(md->runtime);
+  md->runtime = nullptr;
+}
+
 static bool depends_on_time(Scene * /*scene*/, ModifierData *md)
 {
   MeshCacheModifierData *mcmd = (MeshCacheModifierData *)md;
@@ -138,23 +151,31 @@ static void meshcache_do(MeshCacheModifierData *mcmd,
   /* -------------------------------------------------------------------- */
   /* Read the File (or error out when the file is bad) */
 
-  /* would be nice if we could avoid doing this _every_ frame */
   STRNCPY(filepath, mcmd->filepath);
   BLI_path_abs(filepath, ID_BLEND_PATH_FROM_GLOBAL((ID *)ob));
 
-  switch (mcmd->type) {
-    case MOD_MESHCACHE_TYPE_MDD:
-      ok = MOD_meshcache_read_mdd_times(
-          filepath, vertexCos, verts_num, mcmd->interp, time, fps, mcmd->time_mode, &err_str);
-      break;
-    case MOD_MESHCACHE_TYPE_PC2:
-      ok = MOD_meshcache_read_pc2_times(
-          filepath, vertexCos, verts_num, mcmd->interp, time, fps, mcmd->time_mode, &err_str);
-      break;
-    default:
-      ok = false;
-      break;
+  /* The file stays mapped in the runtime data, so that playback does not reopen it every frame. */
+  std::unique_ptr<MeshCacheFile> file(static_cast<MeshCacheFile *>(mcmd->modifier.runtime));
+  mcmd->modifier.runtime = nullptr;
+  if (!MOD_meshcache_file_ensure(file, filepath, &err_str)) {
+    ok = false;
+  }
+  else {
+    switch (mcmd->type) {
+      case MOD_MESHCACHE_TYPE_MDD:
+        ok = MOD_meshcache_read_mdd_times(
+            *file, vertexCos, verts_num, mcmd->interp, time, fps, mcmd->time_mode, &err_str);
+        break;
+      case MOD_MESHCACHE_TYPE_PC2:
+        ok = MOD_meshcache_read_pc2_times(
+            *file, vertexCos, verts_num, mcmd->interp, time, fps, mcmd->time_mode, &err_str);
+        break;
+      default:
+        ok = false;
+        break;
+    }
   }
+  mcmd->modifier.runtime = file.release();
 
   /* -------------------------------------------------------------------- */
   /* tricky shape key integration (slow!) */
@@ -395,14 +416,14 @@ ModifierTypeInfo modifierType_MeshCache = {
 
     /*init_data*/ init_data,
     /*required_data_mask*/ nullptr,
-    /*free_data*/ nullptr,
+    /*free_data*/ free_data,
     /*is_disabled*/ is_disabled,
     /*update_depsgraph*/ nullptr,
     /*depends_on_time*/ depends_on_time,
     /*depends_on_normals*/ nullptr,
     /*foreach_ID_link*/ nullptr,
     /*foreach_tex_link*/ nullptr,
-    /*free_runtime_data*/ nullptr,
+    /*free_runtime_data*/ free_runtime_data,
     /*panel_register*/ panel_register,
     /*blend_write*/ nullptr,
     /*blend_read*/ nullptr,
@@ -7,27 +7,26 @@
  */
 
 #include <algorithm>
-#include <cerrno>
-#include <cstdio>
-#include <cstring>
 
 #include "BLI_utildefines.h"
 
-#include "BLI_fileops.h"
 #ifdef __BIG_ENDIAN__
 #  include "BLI_endian_switch.h"
 #endif
 
-#ifdef WIN32
-#  include "BLI_winstuff.h"
-#endif
-
 #include "BLT_translation.hh"
 
 #include "DNA_modifier_types.h"
 
 #include "MOD_meshcache_util.hh" /* own include */
 
+/** PC2 files are stored little-endian. */
+#ifdef __BIG_ENDIAN__
+#  define PC2_SWITCH_ENDIAN true
+#else
+#  define PC2_SWITCH_ENDIAN false
+#endif
+
 struct PC2Head {
   char header[12];  /* 'POINTCACHE2\0' */
   int file_version; /* unused - should be 1 */
@@ -37,12 +36,12 @@ struct PC2Head {
   int frame_tot;
 }; /* frames, verts */
 
-static bool meshcache_read_pc2_head(FILE *fp,
+static bool meshcache_read_pc2_head(const MeshCacheFile &file,
                                     const int verts_tot,
                                     PC2Head *pc2_head,
                                     const char **r_err_str)
 {
-  if (!fread(pc2_head, sizeof(*pc2_head), 1, fp)) {
+  if (!file.read(pc2_head, 0, sizeof(*pc2_head))) {
     *r_err_str = RPT_("Missing header");
     return false;
   }
@@ -66,7 +65,6 @@ static bool meshcache_read_pc2_head(FILE *fp,
     *r_err_str = RPT_("Invalid frame total");
     return false;
   }
-  /* Intentionally don't seek back. */
 
   return true;
 }
@@ -76,28 +74,27 @@ static bool meshcache_read_pc2_head(FILE *fp,
  *
  * currently same as for MDD
  */
-static bool meshcache_read_pc2_range(FILE *fp,
+static bool meshcache_read_pc2_range(const MeshCacheFile &file,
                                      const int verts_tot,
                                      const float frame,
                                      const char interp,
+                                     PC2Head *r_pc2_head,
                                      int r_index_range[2],
                                      float *r_factor,
                                      const char **r_err_str)
 {
-  PC2Head pc2_head;
-
   /* first check interpolation and get the vert locations */
 
-  if (meshcache_read_pc2_head(fp, verts_tot, &pc2_head, r_err_str) == false) {
+  if (meshcache_read_pc2_head(file, verts_tot, r_pc2_head, r_err_str) == false) {
     return false;
   }
 
-  MOD_meshcache_calc_range(frame, interp, pc2_head.frame_tot, r_index_range, r_factor);
+  MOD_meshcache_calc_range(frame, interp, r_pc2_head->frame_tot, r_index_range, r_factor);
 
   return true;
 }
 
-static bool meshcache_read_pc2_range_from_time(FILE *fp,
+static bool meshcache_read_pc2_range_from_time(const MeshCacheFile &file,
                                                const int verts_tot,
                                                const float time,
                                                const float fps,
@@ -107,7 +104,7 @@ static bool meshcache_read_pc2_range_from_time(FILE *fp,
   PC2Head pc2_head;
   float frame;
 
-  if (meshcache_read_pc2_head(fp, verts_tot, &pc2_head, r_err_str) == false) {
+  if (meshcache_read_pc2_head(file, verts_tot, &pc2_head, r_err_str) == false) {
     return false;
   }
 
@@ -124,7 +121,7 @@ static bool meshcache_read_pc2_range_from_time(FILE *fp,
   return true;
 }
 
-bool MOD_meshcache_read_pc2_index(FILE *fp,
+bool MOD_meshcache_read_pc2_index(const MeshCacheFile &file,
                                   float (*vertexCos)[3],
                                   const int verts_tot,
                                   const int index,
@@ -133,72 +130,38 @@ bool MOD_meshcache_read_pc2_index(FILE *fp,
 {
   PC2Head pc2_head;
 
-  if (meshcache_read_pc2_head(fp, verts_tot, &pc2_head, r_err_str) == false) {
-    return false;
-  }
-
-  if (BLI_fseek(fp, sizeof(float[3]) * index * pc2_head.verts_tot, SEEK_CUR) != 0) {
-    *r_err_str = RPT_("Failed to seek frame");
+  if (meshcache_read_pc2_head(file, verts_tot, &pc2_head, r_err_str) == false) {
     return false;
   }
 
-  size_t verts_read_num = 0;
-  errno = 0;
-  if (factor >= 1.0f) {
-    float *vco = *vertexCos;
-    uint i;
-    for (i = pc2_head.verts_tot; i != 0; i--, vco += 3) {
-      verts_read_num += fread(vco, sizeof(float[3]), 1, fp);
-
-#ifdef __BIG_ENDIAN__
-      BLI_endian_switch_float(vco + 0);
-      BLI_endian_switch_float(vco + 1);
-      BLI_endian_switch_float(vco + 2);
-#endif /* __BIG_ENDIAN__ */
-    }
-  }
-  else {
-    const float ifactor = 1.0f - factor;
-    float *vco = *vertexCos;
-    uint i;
-    for (i = pc2_head.verts_tot; i != 0; i--, vco += 3) {
-      float tvec[3];
-      verts_read_num += fread(tvec, sizeof(float[3]), 1, fp);
-
-#ifdef __BIG_ENDIAN__
-      BLI_endian_switch_float(tvec + 0);
-      BLI_endian_switch_float(tvec + 1);
-      BLI_endian_switch_float(tvec + 2);
-#endif /* __BIG_ENDIAN__ */
-
-      vco[0] = (vco[0] * ifactor) + (tvec[0] * factor);
-      vco[1] = (vco[1] * ifactor) + (tvec[1] * factor);
-      vco[2] = (vco[2] * ifactor) + (tvec[2] * factor);
-    }
-  }
-
-  if (verts_read_num != pc2_head.verts_tot) {
-    *r_err_str = errno ? strerror(errno) : RPT_("Vertex coordinate read failed");
+  const size_t offset = sizeof(PC2Head) +
+                        sizeof(float[3]) * size_t(index) * size_t(pc2_head.verts_tot);
+  if (!MOD_meshcache_read_coords(
+          file, offset, PC2_SWITCH_ENDIAN, vertexCos, pc2_head.verts_tot, factor))
+  {
+    *r_err_str = RPT_("Vertex coordinate read failed");
     return false;
   }
 
   return true;
 }
 
-bool MOD_meshcache_read_pc2_frame(FILE *fp,
+bool MOD_meshcache_read_pc2_frame(const MeshCacheFile &file,
                                   float (*vertexCos)[3],
                                   const int verts_tot,
                                   const char interp,
                                   const float frame,
                                   const char **r_err_str)
 {
+  PC2Head pc2_head;
   int index_range[2];
   float factor;
 
-  if (meshcache_read_pc2_range(fp,
+  if (meshcache_read_pc2_range(file,
                                verts_tot,
                                frame,
                                interp,
+                               &pc2_head,
                                index_range,
                                &factor, /* read into these values */
                                r_err_str) == false)
@@ -208,28 +171,27 @@ bool MOD_meshcache_read_pc2_frame(FILE *fp,
 
   if (index_range[0] == index_range[1]) {
     /* read single */
-    if ((BLI_fseek(fp, 0, SEEK_SET) == 0) &&
-        MOD_meshcache_read_pc2_index(fp, vertexCos, verts_tot, index_range[0], 1.0f, r_err_str))
+    if (!MOD_meshcache_read_pc2_index(file, vertexCos, verts_tot, index_range[0], 1.0f, r_err_str))
     {
-      return true;
+      return false;
     }
-
-    return false;
   }
-
   /* read both and interpolate */
-  if ((BLI_fseek(fp, 0, SEEK_SET) == 0) &&
-      MOD_meshcache_read_pc2_index(fp, vertexCos, verts_tot, index_range[0], 1.0f, r_err_str) &&
-      (BLI_fseek(fp, 0, SEEK_SET) == 0) &&
-      MOD_meshcache_read_pc2_index(fp, vertexCos, verts_tot, index_range[1], factor, r_err_str))
+  else if (!(MOD_meshcache_read_pc2_index(
+                 file, vertexCos, verts_tot, index_range[0], 1.0f, r_err_str) &&
+             MOD_meshcache_read_pc2_index(
+                 file, vertexCos, verts_tot, index_range[1], factor, r_err_str)))
   {
-    return true;
+    return false;
   }
 
-  return false;
+  MOD_meshcache_prefetch_frames(
+      file, sizeof(PC2Head), verts_tot, pc2_head.frame_tot, index_range[1]);
+
+  return true;
 }
 
-bool MOD_meshcache_read_pc2_times(const char *filepath,
+bool MOD_meshcache_read_pc2_times(const MeshCacheFile &file,
                                   float (*vertexCos)[3],
                                   const int verts_tot,
                                   const char interp,
@@ -240,14 +202,6 @@ bool MOD_meshcache_read_pc2_times(const char *filepath,
 {
   float frame;
 
-  FILE *fp = BLI_fopen(filepath, "rb");
-  bool ok;
-
-  if (fp == nullptr) {
-    *r_err_str = errno ? strerror(errno) : RPT_("Unknown error opening file");
-    return false;
-  }
-
   switch (time_mode) {
     case MOD_MESHCACHE_TIME_FRAME: {
       frame = time;
@@ -255,30 +209,24 @@ bool MOD_meshcache_read_pc2_times(const char *filepath,
     }
     case MOD_MESHCACHE_TIME_SECONDS: {
       /* we need to find the closest time */
-      if (meshcache_read_pc2_range_from_time(fp, verts_tot, time, fps, &frame, r_err_str) == false)
+      if (meshcache_read_pc2_range_from_time(file, verts_tot, time, fps, &frame, r_err_str) ==
+          false)
       {
-        fclose(fp);
         return false;
       }
-      rewind(fp);
       break;
     }
     case MOD_MESHCACHE_TIME_FACTOR:
     default: {
       PC2Head pc2_head;
-      if (meshcache_read_pc2_head(fp, verts_tot, &pc2_head, r_err_str) == false) {
-        fclose(fp);
+      if (meshcache_read_pc2_head(file, verts_tot, &pc2_head, r_err_str) == false) {
         return false;
       }
 
       frame = std::clamp(time, 0.0f, 1.0f) * float(pc2_head.frame_tot);
-      rewind(fp);
       break;
     }
   }
 
-  ok = MOD_meshcache_read_pc2_frame(fp, vertexCos, verts_tot, interp, frame, r_err_str);
-
-  fclose(fp);
-  return ok;
+  return MOD_meshcache_read_pc2_frame(file, vertexCos, verts_tot, interp, frame, r_err_str);
 }
@@ -6,12 +6,35 @@
  * \ingroup modifiers
  */
 
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+
+#include "BLI_array.hh"
+#include "BLI_endian_switch.h"
+#include "BLI_fileops.h"
 #include "BLI_math_base.h"
+#include "BLI_math_vector_types.hh"
+#include "BLI_mmap.h"
+#include "BLI_task.hh"
+
+#ifdef WIN32
+#  include "BLI_winstuff.h"
+#  include <io.h>
+#else
+#  include <unistd.h>
+#endif
+
+#include "BLT_translation.hh"
 
 #include "DNA_modifier_types.h"
 
 #include "MOD_meshcache_util.hh"
 
+/** Number of frames to prefetch ahead of the frames which are being read. */
+#define PREFETCH_FRAMES_NUM 2
+
 void MOD_meshcache_calc_range(const float frame,
                               const char interp,
                               const int frame_tot,
@@ -48,3 +71,124 @@ void MOD_meshcache_calc_range(const float frame,
     }
   }
 }
+
+/* -------------------------------------------------------------------- */
+/** \name Memory-Mapped Cache File
+ * \{ */
+
+MeshCacheFile::~MeshCacheFile()
+{
+  if (mmap_file) {
+    BLI_mmap_free(mmap_file);
+  }
+  if (file != -1) {
+    close(file);
+  }
+}
+
+size_t MeshCacheFile::size() const
+{
+  return BLI_mmap_get_length(mmap_file);
+}
+
+bool MeshCacheFile::read(void *dest, const size_t offset, const size_t length) const
+{
+  return BLI_mmap_read(mmap_file, dest, offset, length);
+}
+
+void MeshCacheFile::prefetch(const size_t offset, const size_t length) const
+{
+  BLI_mmap_prefetch(mmap_file, offset, length);
+}
+
+bool MOD_meshcache_file_ensure(std::unique_ptr<MeshCacheFile> &file,
+                               const char *filepath,
+                               const char **r_err_str)
+{
+  BLI_stat_t st;
+  errno = 0;
+  if (BLI_stat(filepath, &st) != 0) {
+    file.reset();
+    *r_err_str = errno ? strerror(errno) : RPT_("Unknown error opening file");
+    return false;
+  }
+  if (file && file->filepath == filepath && file->file_size == int64_t(st.st_size) &&
+      file->file_mtime == int64_t(st.st_mtime))
+  {
+    return true;
+  }
+
+  file = std::make_unique<MeshCacheFile>();
+  file->filepath = filepath;
+  file->file_size = int64_t(st.st_size);
+  file->file_mtime = int64_t(st.st_mtime);
+  errno = 0;
+  file->file = BLI_open(filepath, O_BINARY | O_RDONLY, 0);
+  if (file->file == -1) {
+    *r_err_str = errno ? strerror(errno) : RPT_("Unknown error opening file");
+    file.reset();
+    return false;
+  }
+  file->mmap_file = BLI_mmap_open(file->file);
+  if (file->mmap_file == nullptr) {
+    *r_err_str = RPT_("Failed to map file into memory");
+    file.reset();
+    return false;
+  }
+  return true;
+}
+
+bool MOD_meshcache_read_coords(const MeshCacheFile &file,
+                               const size_t offset,
+                               const bool switch_endian,
+                               float (*vertexCos)[3],
+                               const int verts_tot,
+                               const float factor)
+{
+  using namespace blender;
+  MutableSpan<float3> positions(reinterpret_cast<float3 *>(vertexCos), verts_tot);
+  if (factor >= 1.0f) {
+    if (!file.read(positions.data(), offset, positions.size_in_bytes())) {
+      return false;
+    }
+    if (switch_endian) {
+      threading::parallel_for(positions.index_range(), 8192, [&](const IndexRange range) {
+        BLI_endian_switch_float_array(&positions[range.start()].x, int(range.size() * 3));
+      });
+    }
+    return true;
+  }
+
+  Array<float3> frame_positions(verts_tot);
+  if (!file.read(frame_positions.data(), offset, frame_positions.as_span().size_in_bytes())) {
+    return false;
+  }
+  const float ifactor = 1.0f - factor;
+  threading::parallel_for(positions.index_range(), 8192, [&](const IndexRange range) {
+    if (switch_endian) {
+      BLI_endian_switch_float_array(&frame_positions[range.start()].x, int(range.size() * 3));
+    }
+    for (const int i : range) {
+      positions[i] = (positions[i] * ifactor) + (frame_positions[i] * factor);
+    }
+  });
+  return true;
+}
+
+void MOD_meshcache_prefetch_frames(const MeshCacheFile &file,
+                                   const size_t frames_offset,
+                                   const int verts_tot,
+                                   const int frame_tot,
+                                   const int last_read_index)
+{
+  const size_t frame_size = sizeof(float[3]) * size_t(verts_tot);
+  const int prefetch_start = last_read_index + 1;
+  const int prefetch_end = std::min(frame_tot, prefetch_start + PREFETCH_FRAMES_NUM);
+  if (prefetch_start >= prefetch_end) {
+    return;
+  }
+  file.prefetch(frames_offset + frame_size * size_t(prefetch_start),
+                frame_size * size_t(prefetch_end - prefetch_start));
+}
+
+/** \} */
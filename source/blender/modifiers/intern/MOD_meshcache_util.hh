@@ -8,23 +8,61 @@
 
 #pragma once
 
-#include <cstdio>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+struct BLI_mmap_file;
+
+/**
+ * A cache file which stays memory-mapped between evaluations, owned by the runtime data of the
+ * modifier. Frames are copied out of the mapping in bulk, instead of being read one vertex at a
+ * time.
+ */
+struct MeshCacheFile {
+  std::string filepath;
+  int file = -1;
+  BLI_mmap_file *mmap_file = nullptr;
+  /** Used to detect when the file was written to since it was mapped. */
+  int64_t file_size = 0;
+  int64_t file_mtime = 0;
+
+  ~MeshCacheFile();
+
+  size_t size() const;
+  /** Copy bytes from the file, returns false when reading past the end or on IO errors. */
+  bool read(void *dest, size_t offset, size_t length) const;
+  /**
+   * Let the operating system read the given range of the file in the background, so that
+   * reading it later does not have to wait for the disk. Used to prefetch the next frames.
+   */
+  void prefetch(size_t offset, size_t length) const;
+};
+
+/**
+ * Make sure \a file maps the file at \a filepath, (re)opening it when the path changed or the
+ * file was modified since it was mapped.
+ */
+bool MOD_meshcache_file_ensure(std::unique_ptr<MeshCacheFile> &file,
+                               const char *filepath,
+                               const char **r_err_str);
 
 /* `MOD_meshcache_mdd.cc` */
 
-bool MOD_meshcache_read_mdd_index(FILE *fp,
+bool MOD_meshcache_read_mdd_index(const MeshCacheFile &file,
                                   float (*vertexCos)[3],
                                   int verts_tot,
                                   int index,
                                   float factor,
                                   const char **r_err_str);
-bool MOD_meshcache_read_mdd_frame(FILE *fp,
+bool MOD_meshcache_read_mdd_frame(const MeshCacheFile &file,
                                   float (*vertexCos)[3],
                                   int verts_tot,
                                   char interp,
                                   float frame,
                                   const char **r_err_str);
-bool MOD_meshcache_read_mdd_times(const char *filepath,
+bool MOD_meshcache_read_mdd_times(const MeshCacheFile &file,
                                   float (*vertexCos)[3],
                                   int verts_tot,
                                   char interp,
@@ -35,19 +73,19 @@ bool MOD_meshcache_read_mdd_times(const char *filepath,
 
 /* `MOD_meshcache_pc2.cc` */
 
-bool MOD_meshcache_read_pc2_index(FILE *fp,
+bool MOD_meshcache_read_pc2_index(const MeshCacheFile &file,
                                   float (*vertexCos)[3],
                                   int verts_tot,
                                   int index,
                                   float factor,
                                   const char **r_err_str);
-bool MOD_meshcache_read_pc2_frame(FILE *fp,
+bool MOD_meshcache_read_pc2_frame(const MeshCacheFile &file,
                                   float (*vertexCos)[3],
                                   int verts_tot,
                                   char interp,
                                   float frame,
                                   const char **r_err_str);
-bool MOD_meshcache_read_pc2_times(const char *filepath,
+bool MOD_meshcache_read_pc2_times(const MeshCacheFile &file,
                                   float (*vertexCos)[3],
                                   int verts_tot,
                                   char interp,
@@ -61,4 +99,24 @@ bool MOD_meshcache_read_pc2_times(const char *filepath,
 void MOD_meshcache_calc_range(
     float frame, char interp, int frame_tot, int r_index_range[2], float *r_factor);
 
+/**
+ * Read \a verts_tot coordinates at \a offset in the file, blending them into \a vertexCos with
+ * \a factor (1.0 replaces the coordinates), optionally switching the endianness of the values.
+ */
+bool MOD_meshcache_read_coords(const MeshCacheFile &file,
+                               size_t offset,
+                               bool switch_endian,
+                               float (*vertexCos)[3],
+                               int verts_tot,
+                               float factor);
+
+/**
+ * Prefetch the frames following the frames which were just read, for playback.
+ */
+void MOD_meshcache_prefetch_frames(const MeshCacheFile &file,
+                                   size_t frames_offset,
+                                   int verts_tot,
+                                   int frame_tot,
+                                   int last_read_index);
+
 #define FRAME_SNAP_EPS 0.0001f
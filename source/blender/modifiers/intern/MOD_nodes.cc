@@ -87,6 +87,7 @@
 #include "NOD_geometry_nodes_execute.hh"
 #include "NOD_geometry_nodes_gizmos.hh"
 #include "NOD_geometry_nodes_lazy_function.hh"
+#include "NOD_geometry_nodes_node_output_cache.hh"
 #include "NOD_node_declaration.hh"
 #include "NOD_socket_usage_inference.hh"
 
@@ -1823,6 +1824,23 @@ static void modifyGeometry(ModifierData *md,
   find_side_effect_nodes(*nmd, *ctx, side_effect_nodes, socket_log_contexts);
   call_data.side_effect_nodes = &side_effect_nodes;
 
+  /* The node output cache is only used in the active depsgraph, because it has to be stored on the
+   * original modifier to survive updates of the evaluated copy. */
+  nodes::GeoNodesNodeOutputCache *node_output_cache = nullptr;
+  if (DEG_is_active(ctx->depsgraph)) {
+    if (nmd->flag & NODES_MODIFIER_CACHE_NODE_OUTPUTS) {
+      if (!nmd_orig->runtime->node_output_cache) {
+        nmd_orig->runtime->node_output_cache = std::make_shared<nodes::GeoNodesNodeOutputCache>();
+      }
+      node_output_cache = nmd_orig->runtime->node_output_cache.get();
+      node_output_cache->begin_evaluation();
+      call_data.node_output_cache = node_output_cache;
+    }
+    else {
+      nmd_orig->runtime->node_output_cache.reset();
+    }
+  }
+
   bke::ModifierComputeContext modifier_compute_context{nullptr, nmd->modifier.name};
 
   geometry_set = nodes::execute_geometry_nodes_on_geometry(tree,
@@ -1831,6 +1849,10 @@ static void modifyGeometry(ModifierData *md,
                                                            call_data,
                                                            std::move(geometry_set));
 
+  if (node_output_cache) {
+    node_output_cache->remove_unused_entries();
+  }
+
   if (logging_enabled(ctx)) {
     nmd_orig->runtime->eval_log = std::move(eval_log);
   }
@@ -2428,6 +2450,7 @@ static void draw_manage_panel(const bContext *C,
                               PointerRNA *modifier_ptr,
                               NodesModifierData &nmd)
 {
+  uiItemR(layout, modifier_ptr, "use_node_output_cache", UI_ITEM_NONE, std::nullopt, ICON_NONE);
   if (uiLayout *panel_layout = uiLayoutPanelProp(
           C, layout, modifier_ptr, "open_bake_panel", IFACE_("Bake")))
   {
@@ -8,17 +8,25 @@
 
 #pragma once
 
+#include "BLI_array.hh"
+#include "BLI_implicit_sharing_ptr.hh"
 #include "BLI_linklist.h"
+#include "BLI_map.hh"
 #include "BLI_math_matrix_types.hh"
 #include "BLI_math_vector.h"
 #include "BLI_set.hh"
+#include "BLI_struct_equality_utils.hh"
 #include "BLI_threads.h"
 
 #include "ED_grease_pencil.hh"
 
 #include <algorithm>
+#include <array>
 #include <cmath>
+#include <memory>
+#include <mutex>
 
+struct LineartAdjacencyCache;
 struct LineartBoundingArea;
 struct LineartEdge;
 struct LineartVert;
@@ -30,6 +38,10 @@ struct LineartModifierRuntime {
    * update. This way line art can load objects from this list instead of iterating over all
    * objects that may or may not have finished evaluating. */
   blender::Set<const Object *> object_dependencies;
+
+  /* Triangle adjacency of the loaded meshes, kept between evaluations so that it doesn't have to
+   * be rebuilt when only the camera or some objects moved. See #LineartAdjacencyCache. */
+  std::shared_ptr<LineartAdjacencyCache> adjacency_cache;
 };
 
 struct LineartStaticMemPoolNode {
@@ -268,6 +280,49 @@ struct LineartAdjacentEdge {
   uint32_t e;
 };
 
+struct LineartEdgeNeighbor {
+  int e;
+  uint16_t flags;
+  int v1, v2;
+};
+
+/**
+ * Triangle edge adjacency of the loaded meshes, kept in the modifier runtime between evaluations.
+ * It only depends on the topology and triangulation of a mesh, so it can be reused as long as
+ * the mesh data didn't change, e.g. when only the camera or object transforms are animated.
+ * Otherwise finding the adjacent triangle edges requires sorting all triangle edges again.
+ */
+struct LineartAdjacencyCache {
+  /** The mesh arrays the triangulation and the adjacency are computed from. */
+  struct Key {
+    const void *positions;
+    const void *corner_verts;
+    const void *face_offsets;
+
+    uint64_t hash() const
+    {
+      return blender::get_default_hash(positions, corner_verts, face_offsets);
+    }
+
+    BLI_STRUCT_EQUALITY_OPERATORS_3(Key, positions, corner_verts, face_offsets)
+  };
+
+  struct Item {
+    /**
+     * Users of the arrays in the key. Keeping them alive makes sure that their memory is not
+     * reused for different data, and that they are copied before they are modified.
+     */
+    std::array<blender::ImplicitSharingPtr<>, 3> sharing_infos;
+    /** Adjacent triangle edge of every triangle edge, or -1. */
+    blender::Array<int> edge_neighbors;
+    /** Items which were not used by the last evaluation are freed. */
+    bool used = true;
+  };
+
+  std::mutex mutex;
+  blender::Map<Key, std::unique_ptr<Item>> items;
+};
+
 enum eLineArtTileRecursiveLimit {
   /* If tile gets this small, it's already much smaller than a pixel. No need to continue
    * splitting. */
@@ -307,6 +362,9 @@ struct LineartData {
    * (shadow stage) or a reference to LineartData::render_data_pool (final stage). */
   LineartStaticMemPool *edge_data_pool;
 
+  /* Owned by #LineartModifierRuntime, may be null. */
+  LineartAdjacencyCache *adjacency_cache;
+
   struct _qtree {
 
     int count_x, count_y;
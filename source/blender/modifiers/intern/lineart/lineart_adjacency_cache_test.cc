@@ -0,0 +1,162 @@
+/* SPDX-FileCopyrightText: 2025 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include <algorithm>
+
+#include "testing/testing.h"
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_math_vector_types.hh"
+#include "BLI_offset_indices.hh"
+
+#include "BKE_idtype.hh"
+#include "BKE_lib_id.hh"
+#include "BKE_mesh.hh"
+
+#include "DNA_mesh_types.h"
+
+#include "MOD_lineart.hh"
+#include "lineart_intern.hh"
+
+namespace blender::lineart::tests {
+
+class LineartAdjacencyCacheTest : public testing::Test {
+ public:
+  Mesh *mesh = nullptr;
+  LineartAdjacencyCache cache;
+
+  static void SetUpTestSuite()
+  {
+    BKE_idtype_init();
+  }
+
+  void SetUp() override
+  {
+    mesh = create_grid(20);
+  }
+
+  void TearDown() override
+  {
+    BKE_id_free(nullptr, mesh);
+  }
+
+  /** A grid of `size * size` quads. */
+  static Mesh *create_grid(const int size)
+  {
+    const int verts_per_side = size + 1;
+    const int faces_num = size * size;
+    Mesh *mesh = BKE_mesh_new_nomain(
+        verts_per_side * verts_per_side, 0, faces_num, faces_num * 4);
+    MutableSpan<float3> positions = mesh->vert_positions_for_write();
+    for (const int y : IndexRange(verts_per_side)) {
+      for (const int x : IndexRange(verts_per_side)) {
+        positions[y * verts_per_side + x] = float3(x, y, (x * y) % 3);
+      }
+    }
+    offset_indices::fill_constant_group_size(4, 0, mesh->face_offsets_for_write());
+    MutableSpan<int> corner_verts = mesh->corner_verts_for_write();
+    for (const int y : IndexRange(size)) {
+      for (const int x : IndexRange(size)) {
+        const int face = y * size + x;
+        const int v = y * verts_per_side + x;
+        corner_verts[face * 4 + 0] = v;
+        corner_verts[face * 4 + 1] = v + 1;
+        corner_verts[face * 4 + 2] = v + verts_per_side + 1;
+        corner_verts[face * 4 + 3] = v + verts_per_side;
+      }
+    }
+    bke::mesh_calc_edges(*mesh, false, false);
+    return mesh;
+  }
+
+  int total_edges() const
+  {
+    return mesh->corner_tris().size() * 3;
+  }
+
+  /** Build the adjacency with the cache and compare it with building it without the cache. */
+  void expect_matches_uncached()
+  {
+    LineartEdgeNeighbor *cached = lineart_build_edge_neighbor(mesh, total_edges(), &cache);
+    LineartEdgeNeighbor *uncached = lineart_build_edge_neighbor(mesh, total_edges(), nullptr);
+    for (const int i : IndexRange(total_edges())) {
+      EXPECT_EQ(cached[i].e, uncached[i].e);
+      EXPECT_EQ(cached[i].v1, uncached[i].v1);
+      EXPECT_EQ(cached[i].v2, uncached[i].v2);
+      EXPECT_EQ(cached[i].flags, uncached[i].flags);
+    }
+    MEM_freeN(cached);
+    MEM_freeN(uncached);
+  }
+
+  Span<int> cached_neighbors() const
+  {
+    EXPECT_EQ(cache.items.size(), 1);
+    return (*cache.items.values().begin())->edge_neighbors;
+  }
+};
+
+TEST_F(LineartAdjacencyCacheTest, HitMatchesUncached)
+{
+  expect_matches_uncached();
+  const Span<int> neighbors = cached_neighbors();
+  EXPECT_EQ(neighbors.size(), total_edges());
+  /* Edges inside of the grid have adjacent triangle edges. */
+  EXPECT_GT(std::count_if(neighbors.begin(), neighbors.end(), [](int e) { return e != -1; }), 0);
+
+  /* The second build reuses the cached item. */
+  expect_matches_uncached();
+  EXPECT_EQ(cached_neighbors().data(), neighbors.data());
+}
+
+TEST_F(LineartAdjacencyCacheTest, TopologyEditMisses)
+{
+  expect_matches_uncached();
+
+  /* Reverse the winding of a face. The cache holds a user of the array, so it is copied. */
+  MutableSpan<int> corner_verts = mesh->corner_verts_for_write();
+  std::swap(corner_verts[1], corner_verts[3]);
+  mesh->tag_topology_changed();
+  expect_matches_uncached();
+  EXPECT_EQ(cache.items.size(), 2);
+}
+
+TEST_F(LineartAdjacencyCacheTest, DeformMisses)
+{
+  expect_matches_uncached();
+
+  /* The triangulation may depend on the positions, so they are part of the key. */
+  mesh->vert_positions_for_write()[0].z += 1.0f;
+  mesh->tag_positions_changed();
+  expect_matches_uncached();
+  EXPECT_EQ(cache.items.size(), 2);
+}
+
+TEST_F(LineartAdjacencyCacheTest, UnusedItemsAreFreed)
+{
+  expect_matches_uncached();
+  lineart_adjacency_cache_free_unused(&cache);
+  EXPECT_EQ(cache.items.size(), 1);
+
+  /* The next evaluation only loads the deformed mesh. */
+  mesh->vert_positions_for_write()[0].z += 1.0f;
+  mesh->tag_positions_changed();
+  expect_matches_uncached();
+  EXPECT_EQ(cache.items.size(), 2);
+  lineart_adjacency_cache_free_unused(&cache);
+  EXPECT_EQ(cache.items.size(), 1);
+  const int *neighbors = cached_neighbors().data();
+
+  /* The item of the deformed mesh is still used. */
+  expect_matches_uncached();
+  EXPECT_EQ(cached_neighbors().data(), neighbors);
+
+  /* Nothing is loaded by the last evaluation. */
+  lineart_adjacency_cache_free_unused(&cache);
+  lineart_adjacency_cache_free_unused(&cache);
+  EXPECT_TRUE(cache.items.is_empty());
+}
+
+}  // namespace blender::lineart::tests
@@ -17,6 +17,7 @@
 #include "BLI_math_rotation.h"
 #include "BLI_sort.hh"
 #include "BLI_task.h"
+#include "BLI_task.hh"
 #include "BLI_time.h"
 #include "BLI_utildefines.h"
 #include "BLI_vector.hh"
@@ -1418,12 +1419,6 @@ void lineart_main_discard_out_of_frame_edges(LineartData *ld)
   }
 }
 
-struct LineartEdgeNeighbor {
-  int e;
-  uint16_t flags;
-  int v1, v2;
-};
-
 struct VertData {
   blender::Span<blender::float3> positions;
   LineartVert *v_arr;
@@ -1880,12 +1875,93 @@ static void lineart_load_tri_task(void *__restrict userdata,
   /* Re-use this field to refer to adjacent info, will be cleared after culling stage. */
   tri->intersecting_verts = static_cast<LinkNode *>((void *)&tri_task_data->tri_adj[i]);
 }
+
+static LineartAdjacencyCache *lineart_adjacency_cache_ensure(GreasePencilLineartModifierData *lmd)
+{
+  LineartModifierRuntime *runtime = reinterpret_cast<LineartModifierRuntime *>(lmd->runtime);
+  if (!runtime) {
+    return nullptr;
+  }
+  if (!runtime->adjacency_cache) {
+    runtime->adjacency_cache = std::make_shared<LineartAdjacencyCache>();
+  }
+  return runtime->adjacency_cache.get();
+}
+
+void lineart_adjacency_cache_free_unused(LineartAdjacencyCache *cache)
+{
+  if (!cache) {
+    return;
+  }
+  std::lock_guard lock{cache->mutex};
+  cache->items.remove_if([](const auto &item) { return !item.value->used; });
+  for (std::unique_ptr<LineartAdjacencyCache::Item> &item : cache->items.values()) {
+    item->used = false;
+  }
+}
+
+/**
+ * Get the cache item for the mesh, which is added when it doesn't exist yet. Returns null when the
+ * mesh arrays are not implicitly shared, because a stable key can't be created for them then.
+ * \param r_edge_neighbors: The cached adjacency, empty when it still has to be computed.
+ */
+static LineartAdjacencyCache::Item *lineart_adjacency_cache_lookup(
+    LineartAdjacencyCache &cache, const Mesh &mesh, blender::Span<int> &r_edge_neighbors)
+{
+  using namespace blender;
+  const bke::AttributeAccessor attributes = mesh.attributes();
+  const bke::GAttributeReader positions = attributes.lookup("position");
+  const bke::GAttributeReader corner_verts = attributes.lookup(".corner_vert");
+  const std::array<const ImplicitSharingInfo *, 3> sharing_infos = {
+      positions.sharing_info, corner_verts.sharing_info, mesh.runtime->face_offsets_sharing_info};
+  if (std::find(sharing_infos.begin(), sharing_infos.end(), nullptr) != sharing_infos.end()) {
+    return nullptr;
+  }
+  const LineartAdjacencyCache::Key key{positions.varray.get_internal_span().data(),
+                                       corner_verts.varray.get_internal_span().data(),
+                                       mesh.face_offsets().data()};
+
+  std::lock_guard lock{cache.mutex};
+  std::unique_ptr<LineartAdjacencyCache::Item> &item = cache.items.lookup_or_add_cb(key, [&]() {
+    auto new_item = std::make_unique<LineartAdjacencyCache::Item>();
+    for (const int i : IndexRange(3)) {
+      sharing_infos[i]->add_user();
+      new_item->sharing_infos[i] = ImplicitSharingPtr<>(sharing_infos[i]);
+    }
+    return new_item;
+  });
+  item->used = true;
+  r_edge_neighbors = item->edge_neighbors;
+  return item.get();
+}
+
+static void lineart_adjacency_cache_store(LineartAdjacencyCache &cache,
+                                          LineartAdjacencyCache::Item &item,
+                                          const LineartEdgeNeighbor *edge_nabr,
+                                          const int total_edges)
+{
+  using namespace blender;
+  Array<int> edge_neighbors(total_edges);
+  threading::parallel_for(IndexRange(total_edges), 8192, [&](const IndexRange range) {
+    for (const int i : range) {
+      edge_neighbors[i] = edge_nabr[i].e;
+    }
+  });
+  std::lock_guard lock{cache.mutex};
+  /* Another thread may have loaded the same mesh in the mean time. */
+  if (item.edge_neighbors.is_empty()) {
+    item.edge_neighbors = std::move(edge_neighbors);
+  }
+}
+
 struct EdgeNeighborData {
   LineartEdgeNeighbor *edge_nabr;
   LineartAdjacentEdge *adj_e;
   blender::Span<int> corner_verts;
   blender::Span<int3> corner_tris;
   blender::Span<int> tri_faces;
+  /** Adjacency from a previous evaluation, empty when it has to be computed. */
+  blender::Span<int> cached_neighbors;
 };
 
 static void lineart_edge_neighbor_init_task(void *__restrict userdata,
@@ -1893,22 +1969,27 @@ static void lineart_edge_neighbor_init_task(void *__restrict userdata,
                                             const TaskParallelTLS *__restrict /*tls*/)
 {
   EdgeNeighborData *en_data = (EdgeNeighborData *)userdata;
-  LineartAdjacentEdge *adj_e = &en_data->adj_e[i];
   const int3 &tri = en_data->corner_tris[i / 3];
   LineartEdgeNeighbor *edge_nabr = &en_data->edge_nabr[i];
   const blender::Span<int> corner_verts = en_data->corner_verts;
 
-  adj_e->e = i;
-  adj_e->v1 = corner_verts[tri[i % 3]];
-  adj_e->v2 = corner_verts[tri[(i + 1) % 3]];
-  if (adj_e->v1 > adj_e->v2) {
-    std::swap(adj_e->v1, adj_e->v2);
+  edge_nabr->v1 = corner_verts[tri[i % 3]];
+  edge_nabr->v2 = corner_verts[tri[(i + 1) % 3]];
+  if (edge_nabr->v1 > edge_nabr->v2) {
+    std::swap(edge_nabr->v1, edge_nabr->v2);
+  }
+  edge_nabr->flags = 0;
+
+  if (!en_data->cached_neighbors.is_empty()) {
+    edge_nabr->e = en_data->cached_neighbors[i];
+    return;
   }
   edge_nabr->e = -1;
 
-  edge_nabr->v1 = adj_e->v1;
-  edge_nabr->v2 = adj_e->v2;
-  edge_nabr->flags = 0;
+  LineartAdjacentEdge *adj_e = &en_data->adj_e[i];
+  adj_e->e = i;
+  adj_e->v1 = edge_nabr->v1;
+  adj_e->v2 = edge_nabr->v2;
 }
 
 static void lineart_sort_adjacent_items(LineartAdjacentEdge *ai, int length)
@@ -1930,11 +2011,10 @@ static void lineart_sort_adjacent_items(LineartAdjacentEdge *ai, int length)
       });
 }
 
-static LineartEdgeNeighbor *lineart_build_edge_neighbor(Mesh *mesh, int total_edges)
+LineartEdgeNeighbor *lineart_build_edge_neighbor(Mesh *mesh,
+                                                 int total_edges,
+                                                 LineartAdjacencyCache *cache)
 {
-  /* Because the mesh is triangulated, so `mesh->edges_num` should be reliable? */
-  LineartAdjacentEdge *adj_e = static_cast<LineartAdjacentEdge *>(
-      MEM_mallocN(sizeof(LineartAdjacentEdge) * total_edges, "LineartAdjacentEdge arr"));
   LineartEdgeNeighbor *edge_nabr = static_cast<LineartEdgeNeighbor *>(
       MEM_mallocN(sizeof(LineartEdgeNeighbor) * total_edges, "LineartEdgeNeighbor arr"));
 
@@ -1944,12 +2024,27 @@ static LineartEdgeNeighbor *lineart_build_edge_neighbor(Mesh *mesh, int total_ed
   en_settings.min_iter_per_thread = 50000;
 
   EdgeNeighborData en_data;
-  en_data.adj_e = adj_e;
+  en_data.adj_e = nullptr;
   en_data.edge_nabr = edge_nabr;
   en_data.corner_verts = mesh->corner_verts();
   en_data.corner_tris = mesh->corner_tris();
   en_data.tri_faces = mesh->corner_tri_faces();
 
+  LineartAdjacencyCache::Item *cache_item = cache ? lineart_adjacency_cache_lookup(
+                                                        *cache, *mesh, en_data.cached_neighbors) :
+                                                    nullptr;
+  if (!en_data.cached_neighbors.is_empty()) {
+    /* Only the vertex indices have to be filled in, the adjacency didn't change. */
+    BLI_task_parallel_range(
+        0, total_edges, &en_data, lineart_edge_neighbor_init_task, &en_settings);
+    return edge_nabr;
+  }
+
+  /* Because the mesh is triangulated, so `mesh->edges_num` should be reliable? */
+  LineartAdjacentEdge *adj_e = static_cast<LineartAdjacentEdge *>(
+      MEM_mallocN(sizeof(LineartAdjacentEdge) * total_edges, "LineartAdjacentEdge arr"));
+  en_data.adj_e = adj_e;
+
   BLI_task_parallel_range(0, total_edges, &en_data, lineart_edge_neighbor_init_task, &en_settings);
 
   lineart_sort_adjacent_items(adj_e, total_edges);
@@ -1963,6 +2058,10 @@ static LineartEdgeNeighbor *lineart_build_edge_neighbor(Mesh *mesh, int total_ed
 
   MEM_freeN(adj_e);
 
+  if (cache_item) {
+    lineart_adjacency_cache_store(*cache, *cache_item, edge_nabr, total_edges);
+  }
+
   return edge_nabr;
 }
 
@@ -2125,7 +2224,9 @@ static void lineart_geometry_object_load(LineartObjectInfo *ob_info,
   edge_feat_data.tri_faces = mesh->corner_tri_faces();
   edge_feat_data.sharp_edges = sharp_edges;
   edge_feat_data.sharp_faces = sharp_faces;
-  edge_feat_data.edge_nabr = lineart_build_edge_neighbor(mesh, total_edges);
+  /* Meshes created only for line art are freed after loading, don't cache their adjacency. */
+  edge_feat_data.edge_nabr = lineart_build_edge_neighbor(
+      mesh, total_edges, ob_info->free_use_mesh ? nullptr : la_data->adjacency_cache);
   edge_feat_data.tri_array = la_tri_arr;
   edge_feat_data.v_array = la_v_arr;
   edge_feat_data.crease_threshold = crease_angle;
@@ -3595,6 +3696,7 @@ static LineartData *lineart_create_render_buffer_v3(Scene *scene,
       MEM_callocN(sizeof(LineartData), "Line Art render buffer"));
   lmd->cache = lc;
   lmd->la_data_ptr = ld;
+  ld->adjacency_cache = lineart_adjacency_cache_ensure(lmd);
   lc->all_enabled_edge_types = lmd->edge_types_override;
 
   if (!scene || !camera || !lc) {
@@ -5086,6 +5188,9 @@ bool MOD_lineart_compute_feature_lines_v3(Depsgraph *depsgraph,
                                shadow_elns,
                                included_objects);
 
+  /* The shadow pass (if any) and the main pass both loaded their geometry at this point. */
+  lineart_adjacency_cache_free_unused(ld->adjacency_cache);
+
   if (shadow_generated) {
     lineart_main_transform_and_add_shadow(ld, shadow_veln, shadow_eeln);
   }
@@ -246,3 +246,17 @@ void lineart_destroy_render_data_keep_init(struct LineartData *ld);
 #ifdef __cplusplus
 }
 #endif
+
+struct LineartAdjacencyCache;
+struct LineartEdgeNeighbor;
+struct Mesh;
+
+/**
+ * Find the adjacent triangle edge of every triangle edge of the mesh. The result is reused from
+ * and stored in the cache, when one is given. The returned array has to be freed by the caller.
+ */
+LineartEdgeNeighbor *lineart_build_edge_neighbor(Mesh *mesh,
+                                                 int total_edges,
+                                                 LineartAdjacencyCache *cache);
+/** Free the adjacency of meshes which were not loaded since the last call. */
+void lineart_adjacency_cache_free_unused(LineartAdjacencyCache *cache);
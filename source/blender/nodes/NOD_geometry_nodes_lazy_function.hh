@@ -41,6 +41,8 @@ struct Scene;
 
 namespace blender::nodes {
 
+class GeoNodesNodeOutputCache;
+
 using lf::LazyFunction;
 using mf::MultiFunction;
 using ReferenceSetIndex = int;
@@ -240,6 +242,11 @@ struct GeoNodesCallData {
    * If this is null, all socket values will be logged.
    */
   const Set<ComputeContextHash> *socket_log_contexts = nullptr;
+  /**
+   * Optional cache that allows reusing outputs of nodes from a previous evaluation when their
+   * inputs did not change.
+   */
+  GeoNodesNodeOutputCache *node_output_cache = nullptr;
 
   /**
    * Data from the modifier that is being evaluated.
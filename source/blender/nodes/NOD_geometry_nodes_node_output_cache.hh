@@ -0,0 +1,94 @@
+/* SPDX-FileCopyrightText: 2025 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+/** \file
+ * \ingroup nodes
+ *
+ * The node output cache allows reusing the outputs of geometry nodes from a previous evaluation
+ * when the inputs of a node did not change. This avoids recomputing e.g. an expensive generator in
+ * the beginning of a node tree when only a parameter at the end of it is changed.
+ *
+ * A node is only cached when its type explicitly opted in with
+ * #bNodeType::geometry_node_cacheable, because the outputs of some nodes depend on more than just
+ * their inputs (e.g. the scene time or other objects).
+ *
+ * The inputs of a node are compared in a way that does not require hashing the actual geometry:
+ * - Geometry components are compared by identity and by their implicit sharing version. Since the
+ *   cache keeps a weak user of every component, the same address can't be reused by a different
+ *   component.
+ * - Single values are compared by value, fields with #fn::FieldNode::is_equal_to.
+ * Inputs that can't be compared (e.g. data-blocks or volume grids) disable caching for the node.
+ *
+ * Since cached outputs are shared with the cache, they stay implicitly shared and are therefore
+ * unchanged when they are passed to the next node. This way, a whole chain of nodes can be reused.
+ */
+
+#include <mutex>
+
+#include "BLI_compute_context.hh"
+#include "BLI_function_ref.hh"
+#include "BLI_map.hh"
+#include "BLI_struct_equality_utils.hh"
+
+#include "FN_lazy_function.hh"
+
+struct bNode;
+
+namespace blender::nodes {
+
+namespace lf = fn::lazy_function;
+
+class GeoNodesNodeOutputCache : NonCopyable, NonMovable {
+ public:
+  struct Entry;
+
+ private:
+  /** Identifies a node in a specific compute context. */
+  struct NodeInContext {
+    ComputeContextHash context_hash;
+    int32_t node_id;
+
+    BLI_STRUCT_EQUALITY_OPERATORS_2(NodeInContext, context_hash, node_id)
+
+    uint64_t hash() const
+    {
+      return get_default_hash(this->context_hash, this->node_id);
+    }
+  };
+
+  mutable std::mutex mutex_;
+  Map<NodeInContext, std::shared_ptr<const Entry>> entries_;
+  /** Incremented for every evaluation, used to find entries that were not used anymore. */
+  int64_t evaluation_index_ = 0;
+
+ public:
+  GeoNodesNodeOutputCache();
+  ~GeoNodesNodeOutputCache();
+
+  /**
+   * Either outputs the values from a previous evaluation of the node with the same inputs, or
+   * calls the given function to compute the outputs and remembers them for later evaluations.
+   * All inputs of the node have to be available already.
+   */
+  void execute_node(const bNode &node,
+                    lf::Params &params,
+                    const lf::Context &context,
+                    FunctionRef<void(lf::Params &params)> execute_fn);
+
+  /** Has to be called before every evaluation of the node tree that uses this cache. */
+  void begin_evaluation();
+  /**
+   * Frees entries that have not been used in the evaluation since the last call to
+   * #begin_evaluation. This keeps the memory usage bounded to what is needed for one evaluation.
+   */
+  void remove_unused_entries();
+  void clear();
+
+  /** Number of nodes that have cached outputs currently. */
+  int64_t size() const;
+};
+
+}  // namespace blender::nodes
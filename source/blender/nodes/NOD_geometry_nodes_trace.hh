@@ -0,0 +1,148 @@
+/* SPDX-FileCopyrightText: 2025 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+/** \file
+ * \ingroup nodes
+ *
+ * Headless tracing of geometry nodes evaluation. Unlike #geo_eval_log, which only keeps what the
+ * node editor needs to draw the latest evaluation, the trace records an event for every execution
+ * of a node and every zone iteration over any number of evaluations, with the time range, thread
+ * and the number of geometry elements that go in and out of the node. The result can be exported
+ * as Chrome trace JSON, which can be opened with `chrome://tracing` or https://ui.perfetto.dev.
+ *
+ * Allocated memory is not recorded per node. The memory statistics of the allocator are either
+ * global or per thread, and nodes spawn tasks on other threads, so neither would be accurate.
+ *
+ * Recording is disabled by default, and has no overhead besides checking an atomic flag then.
+ * It is controlled with the `--debug-geometry-nodes-trace` command line argument and the
+ * `bpy.app.geometry_nodes_trace` Python module.
+ */
+
+#include <chrono>
+#include <mutex>
+#include <string>
+
+#include "BLI_string_ref.hh"
+#include "BLI_utility_mixins.hh"
+
+#include "FN_lazy_function.hh"
+
+struct bNode;
+namespace blender {
+class ComputeContext;
+}
+namespace blender::bke {
+class GeometrySet;
+}
+
+namespace blender::nodes::geo_eval_trace {
+
+namespace lf = fn::lazy_function;
+
+using Clock = std::chrono::steady_clock;
+using TimePoint = Clock::time_point;
+
+/** Number of elements in all geometries that are passed into or out of a node. */
+struct GeometryElementCounts {
+  int64_t points = 0;
+  int64_t faces = 0;
+  int64_t curves = 0;
+  int64_t instances = 0;
+  /** False when no geometry was counted at all, to distinguish it from empty geometries. */
+  bool has_geometry = false;
+
+  void add(const bke::GeometrySet &geometry);
+  /** Adds the geometries in the value if it has a geometry type, ignores other values. */
+  void add(const CPPType &type, const void *value);
+};
+
+enum class EventType : int8_t {
+  Node,
+  GroupNode,
+  ZoneIteration,
+};
+
+/**
+ * Records a trace event for the duration of its lifetime when recording is enabled. Does
+ * nothing otherwise.
+ */
+class ScopedEvent : NonCopyable, NonMovable {
+ private:
+  bool is_recording_;
+  EventType type_;
+  const ComputeContext *compute_context_;
+  const bNode *node_;
+  int iteration_;
+  TimePoint start_;
+
+ public:
+  GeometryElementCounts inputs;
+  GeometryElementCounts outputs;
+
+  /**
+   * \param compute_context: The context the node is evaluated in.
+   * \param iteration: The zone iteration for #EventType::ZoneIteration.
+   */
+  ScopedEvent(const ComputeContext *compute_context,
+              const bNode &node,
+              EventType type = EventType::Node,
+              int iteration = -1);
+  ~ScopedEvent();
+
+  bool is_recording() const
+  {
+    return is_recording_;
+  }
+
+  /** Count the geometry elements in all inputs that are available currently. */
+  void add_available_inputs(const lf::Params &params);
+};
+
+/**
+ * Passes everything through to the actual parameters of a node, but counts the geometry elements
+ * of the outputs when they are set. That has to happen before the output values are forwarded.
+ */
+class CountOutputsParams : public lf::Params {
+ private:
+  lf::Params &base_params_;
+  ScopedEvent &event_;
+  /** Outputs may be set from different threads when the node uses multi-threading. */
+  std::mutex mutex_;
+
+ public:
+  CountOutputsParams(lf::Params &base_params, ScopedEvent &event);
+
+  void *try_get_input_data_ptr_impl(int index) const override;
+  void *try_get_input_data_ptr_or_request_impl(int index) override;
+  void *get_output_data_ptr_impl(int index) override;
+  void output_set_impl(int index) override;
+  bool output_was_set_impl(int index) const override;
+  lf::ValueUsage get_output_usage_impl(int index) const override;
+  void set_input_unused_impl(int index) override;
+  bool try_enable_multi_threading_impl() override;
+};
+
+bool is_recording();
+
+/**
+ * Start recording events. Previously recorded events are removed. This must not be called while
+ * geometry nodes are evaluated.
+ */
+void begin_recording();
+/** Stop recording events. The events that have been recorded are kept until they are cleared. */
+void end_recording();
+/** Remove all recorded events. This must not be called while geometry nodes are evaluated. */
+void clear();
+
+int64_t events_num();
+
+/**
+ * Write all recorded events to a file in the Chrome trace event format.
+ * \return False if the file could not be written.
+ */
+bool write_chrome_trace(StringRefNull filepath);
+
+}  // namespace blender::nodes::geo_eval_trace
@@ -234,6 +234,7 @@ static void node_register()
   blender::bke::node_type_storage(
       &ntype, "NodeGeometryMeshLine", node_free_standard_storage, node_copy_standard_storage);
   ntype.geometry_node_execute = node_geo_exec;
+  ntype.geometry_node_cacheable = true;
   ntype.draw_buttons = node_layout;
   ntype.updatefunc = node_update;
   ntype.gather_link_search_ops = node_gather_link_searches;
@@ -569,6 +569,7 @@ static void node_register()
   ntype.enum_name_legacy = "SCALE_ELEMENTS";
   ntype.nclass = NODE_CLASS_GEOMETRY;
   ntype.geometry_node_execute = node_geo_exec;
+  ntype.geometry_node_cacheable = true;
   ntype.declare = node_declare;
   ntype.draw_buttons = node_layout;
   ntype.initfunc = node_init;
@@ -255,6 +255,7 @@ static void node_register()
   blender::bke::node_type_size(&ntype, 170, 120, 700);
   ntype.initfunc = node_init;
   ntype.geometry_node_execute = node_geo_exec;
+  ntype.geometry_node_cacheable = true;
   ntype.draw_buttons = node_layout;
   blender::bke::node_register_type(&ntype);
 
@@ -3,6 +3,7 @@
  * SPDX-License-Identifier: GPL-2.0-or-later */
 
 #include "NOD_geometry_nodes_lazy_function.hh"
+#include "NOD_geometry_nodes_trace.hh"
 
 #include "BKE_anonymous_attribute_make.hh"
 #include "BKE_compute_contexts.hh"
@@ -161,6 +162,10 @@ class ForeachGeometryElementNodeExecuteWrapper : public lf::GraphExecutorNodeExe
 
     GeoNodesLFLocalUserData body_local_user_data{body_user_data};
     lf::Context body_context{context.storage, &body_user_data, &body_local_user_data};
+    const geo_eval_trace::ScopedEvent trace_event{user_data.compute_context,
+                                                  *output_bnode_,
+                                                  geo_eval_trace::EventType::ZoneIteration,
+                                                  index};
     fn.execute(params, body_context);
   }
 };
@@ -22,6 +22,8 @@
 
 #include "NOD_geometry_exec.hh"
 #include "NOD_geometry_nodes_lazy_function.hh"
+#include "NOD_geometry_nodes_node_output_cache.hh"
+#include "NOD_geometry_nodes_trace.hh"
 #include "NOD_multi_function.hh"
 #include "NOD_node_declaration.hh"
 
@@ -241,19 +243,36 @@ class LazyFunctionForGeometryNode : public LazyFunction {
       return;
     }
 
+    geo_eval_trace::ScopedEvent trace_event{user_data->compute_context, node_};
+    std::optional<geo_eval_trace::CountOutputsParams> trace_params;
+    if (trace_event.is_recording()) {
+      trace_event.add_available_inputs(params);
+      trace_params.emplace(params, trace_event);
+    }
+    lf::Params &exec_params = trace_params ? *trace_params : params;
+
     auto get_anonymous_attribute_name = [&](const int i) {
       return this->anonymous_attribute_name_for_output(*user_data, i);
     };
 
-    GeoNodeExecParams geo_params{
-        node_,
-        params,
-        context,
-        own_lf_graph_info_.mapping.lf_input_index_for_output_bsocket_usage,
-        own_lf_graph_info_.mapping.lf_input_index_for_reference_set_for_output,
-        get_anonymous_attribute_name};
+    auto execute_node = [&](lf::Params &node_params) {
+      GeoNodeExecParams geo_params{
+          node_,
+          node_params,
+          context,
+          own_lf_graph_info_.mapping.lf_input_index_for_output_bsocket_usage,
+          own_lf_graph_info_.mapping.lf_input_index_for_reference_set_for_output,
+          get_anonymous_attribute_name};
+      node_.typeinfo->geometry_node_execute(geo_params);
+    };
 
-    node_.typeinfo->geometry_node_execute(geo_params);
+    if (node_.typeinfo->geometry_node_cacheable) {
+      if (GeoNodesNodeOutputCache *cache = user_data->call_data->node_output_cache) {
+        cache->execute_node(node_, exec_params, context, execute_node);
+        return;
+      }
+    }
+    execute_node(exec_params);
   }
 
   std::string input_name(const int index) const override
@@ -1128,6 +1147,8 @@ class LazyFunctionForGroupNode : public LazyFunction {
     const ScopedNodeTimer node_timer{context, group_node_};
     GeoNodesLFUserData *user_data = dynamic_cast<GeoNodesLFUserData *>(context.user_data);
     BLI_assert(user_data != nullptr);
+    const geo_eval_trace::ScopedEvent trace_event{
+        user_data->compute_context, group_node_, geo_eval_trace::EventType::GroupNode};
 
     if (has_many_nodes_) {
       /* If the called node group has many nodes, it's likely that executing it takes a while even
@@ -0,0 +1,489 @@
+/* SPDX-FileCopyrightText: 2025 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup nodes
+ */
+
+#include <atomic>
+#include <variant>
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_array.hh"
+#include "BLI_linear_allocator.hh"
+
+#include "BKE_geometry_nodes_reference_set.hh"
+#include "BKE_geometry_set.hh"
+#include "BKE_node.hh"
+#include "BKE_node_socket_value.hh"
+
+#include "FN_field.hh"
+
+#include "NOD_geometry_nodes_lazy_function.hh"
+#include "NOD_geometry_nodes_log.hh"
+#include "NOD_geometry_nodes_node_output_cache.hh"
+
+namespace blender::nodes {
+
+/**
+ * Remembers a geometry component without owning it. The weak user guarantees that the address is
+ * not reused by another component while the cache entry exists.
+ */
+class ComponentVersion : NonCopyable {
+ private:
+  const ImplicitSharingInfo *sharing_info_ = nullptr;
+  int64_t version_ = 0;
+
+ public:
+  ComponentVersion() = default;
+
+  explicit ComponentVersion(const ImplicitSharingInfo *sharing_info) : sharing_info_(sharing_info)
+  {
+    if (sharing_info_) {
+      sharing_info_->add_weak_user();
+      version_ = sharing_info_->version();
+    }
+  }
+
+  ComponentVersion(ComponentVersion &&other) noexcept
+      : sharing_info_(std::exchange(other.sharing_info_, nullptr)), version_(other.version_)
+  {
+  }
+
+  ComponentVersion &operator=(ComponentVersion &&other) noexcept
+  {
+    if (this != &other) {
+      std::destroy_at(this);
+      new (this) ComponentVersion(std::move(other));
+    }
+    return *this;
+  }
+
+  ~ComponentVersion()
+  {
+    if (sharing_info_) {
+      sharing_info_->remove_weak_user_and_delete_if_last();
+    }
+  }
+
+  BLI_STRUCT_EQUALITY_OPERATORS_2(ComponentVersion, sharing_info_, version_)
+};
+
+struct GeometryFingerprint {
+  std::array<ComponentVersion, GEO_COMPONENT_TYPE_ENUM_SIZE> components;
+  std::string name;
+
+  friend bool operator==(const GeometryFingerprint &a, const GeometryFingerprint &b)
+  {
+    return a.components == b.components && a.name == b.name;
+  }
+};
+
+using InputFingerprint = std::variant<bool,
+                                      bke::SocketValueVariant,
+                                      GeometryFingerprint,
+                                      bke::GeometryNodesReferenceSet>;
+
+/**
+ * Everything that the outputs of a cacheable node depend on.
+ */
+struct InputsFingerprint {
+  const bke::bNodeType *node_type = nullptr;
+  int16_t custom1 = 0;
+  int16_t custom2 = 0;
+  float custom3 = 0.0f;
+  float custom4 = 0.0f;
+  /** A copy of the DNA storage of the node, which contains its settings. */
+  Array<std::byte> storage;
+  /** Indexed by lazy-function input index. */
+  Vector<InputFingerprint> inputs;
+};
+
+struct GeoNodesNodeOutputCache::Entry {
+  InputsFingerprint fingerprint;
+  LinearAllocator<> allocator;
+  /** Indexed by lazy-function output index. Null when the output was not computed. */
+  Array<GMutablePointer> outputs;
+  /** Information that the node logged, so that it is still shown when the outputs are reused. */
+  Vector<geo_eval_log::NodeWarning> warnings;
+  Vector<std::pair<std::string, geo_eval_log::NamedAttributeUsage>> used_named_attributes;
+  mutable std::atomic<int64_t> last_used_evaluation = 0;
+
+  ~Entry()
+  {
+    for (GMutablePointer &value : outputs) {
+      if (value.get()) {
+        value.destruct();
+      }
+    }
+  }
+};
+
+static bool socket_values_equal(const bke::SocketValueVariant &a, const bke::SocketValueVariant &b)
+{
+  if (a.is_single() != b.is_single()) {
+    return false;
+  }
+  if (a.is_single()) {
+    const GPointer a_value = a.get_single_ptr();
+    const GPointer b_value = b.get_single_ptr();
+    return a_value.type() == b_value.type() &&
+           a_value.type()->is_equal_or_false(a_value.get(), b_value.get());
+  }
+  return a.get<fn::GField>() == b.get<fn::GField>();
+}
+
+static bool reference_sets_equal(const bke::GeometryNodesReferenceSet &a,
+                                 const bke::GeometryNodesReferenceSet &b)
+{
+  const bool a_empty = !a.names || a.names->is_empty();
+  const bool b_empty = !b.names || b.names->is_empty();
+  if (a_empty || b_empty) {
+    return a_empty == b_empty;
+  }
+  return *a.names == *b.names;
+}
+
+static bool inputs_equal(const InputFingerprint &a, const InputFingerprint &b)
+{
+  if (a.index() != b.index()) {
+    return false;
+  }
+  if (const bool *a_bool = std::get_if<bool>(&a)) {
+    return *a_bool == std::get<bool>(b);
+  }
+  if (const auto *a_value = std::get_if<bke::SocketValueVariant>(&a)) {
+    return socket_values_equal(*a_value, std::get<bke::SocketValueVariant>(b));
+  }
+  if (const auto *a_geometry = std::get_if<GeometryFingerprint>(&a)) {
+    return *a_geometry == std::get<GeometryFingerprint>(b);
+  }
+  return reference_sets_equal(std::get<bke::GeometryNodesReferenceSet>(a),
+                              std::get<bke::GeometryNodesReferenceSet>(b));
+}
+
+static bool fingerprints_equal(const InputsFingerprint &a, const InputsFingerprint &b)
+{
+  if (a.node_type != b.node_type || a.custom1 != b.custom1 || a.custom2 != b.custom2 ||
+      a.custom3 != b.custom3 || a.custom4 != b.custom4)
+  {
+    return false;
+  }
+  if (a.storage.as_span() != b.storage.as_span()) {
+    return false;
+  }
+  if (a.inputs.size() != b.inputs.size()) {
+    return false;
+  }
+  for (const int i : a.inputs.index_range()) {
+    if (!inputs_equal(a.inputs[i], b.inputs[i])) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static std::optional<InputFingerprint> fingerprint_input(const CPPType &type, const void *value)
+{
+  if (type.is<bool>()) {
+    return *static_cast<const bool *>(value);
+  }
+  if (type.is<bke::SocketValueVariant>()) {
+    const auto &value_variant = *static_cast<const bke::SocketValueVariant *>(value);
+    if (value_variant.is_volume_grid()) {
+      /* Grids are not compared currently. */
+      return std::nullopt;
+    }
+    return value_variant;
+  }
+  if (type.is<bke::GeometrySet>()) {
+    const auto &geometry = *static_cast<const bke::GeometrySet *>(value);
+    GeometryFingerprint fingerprint;
+    for (const int i : IndexRange(GEO_COMPONENT_TYPE_ENUM_SIZE)) {
+      fingerprint.components[i] = ComponentVersion(
+          geometry.get_component(bke::GeometryComponent::Type(i)));
+    }
+    fingerprint.name = geometry.name;
+    return fingerprint;
+  }
+  if (type.is<bke::GeometryNodesReferenceSet>()) {
+    return *static_cast<const bke::GeometryNodesReferenceSet *>(value);
+  }
+  /* Other types like data-block pointers are not cached, because the referenced data may change
+   * without a change of the pointer. */
+  return std::nullopt;
+}
+
+static std::optional<InputsFingerprint> fingerprint_inputs(const bNode &node,
+                                                           const lf::Params &params)
+{
+  const Span<lf::Input> inputs = params.fn_.inputs();
+  InputsFingerprint fingerprint;
+  fingerprint.inputs.reserve(inputs.size());
+  for (const int i : inputs.index_range()) {
+    const void *value = params.try_get_input_data_ptr(i);
+    BLI_assert(value != nullptr);
+    std::optional<InputFingerprint> input_fingerprint = fingerprint_input(*inputs[i].type, value);
+    if (!input_fingerprint) {
+      return std::nullopt;
+    }
+    fingerprint.inputs.append(std::move(*input_fingerprint));
+  }
+  fingerprint.node_type = node.typeinfo;
+  fingerprint.custom1 = node.custom1;
+  fingerprint.custom2 = node.custom2;
+  fingerprint.custom3 = node.custom3;
+  fingerprint.custom4 = node.custom4;
+  if (node.storage) {
+    /* The storage of cacheable nodes must not contain pointers, so comparing it byte-wise is
+     * enough to detect changed settings. */
+    const Span<std::byte> storage{static_cast<const std::byte *>(node.storage),
+                                  int64_t(MEM_allocN_len(node.storage))};
+    fingerprint.storage = storage;
+  }
+  return fingerprint;
+}
+
+/**
+ * Wraps the actual parameters of the node and keeps a copy of every output value that is set.
+ */
+class RecordOutputsParams : public lf::Params {
+ private:
+  lf::Params &base_params_;
+  GeoNodesNodeOutputCache::Entry &entry_;
+  Span<void *> output_buffers_;
+
+ public:
+  RecordOutputsParams(lf::Params &base_params,
+                      GeoNodesNodeOutputCache::Entry &entry,
+                      const Span<void *> output_buffers)
+      : lf::Params(base_params.fn_, false),
+        base_params_(base_params),
+        entry_(entry),
+        output_buffers_(output_buffers)
+  {
+  }
+
+  void *try_get_input_data_ptr_impl(const int index) const override
+  {
+    return base_params_.try_get_input_data_ptr(index);
+  }
+
+  void *try_get_input_data_ptr_or_request_impl(const int index) override
+  {
+    return base_params_.try_get_input_data_ptr_or_request(index);
+  }
+
+  void *get_output_data_ptr_impl(const int index) override
+  {
+    return base_params_.get_output_data_ptr(index);
+  }
+
+  void output_set_impl(const int index) override
+  {
+    if (void *buffer = output_buffers_[index]) {
+      const CPPType &type = *fn_.outputs()[index].type;
+      type.copy_construct(base_params_.get_output_data_ptr(index), buffer);
+      /* Each output is only set once, so this is thread-safe. */
+      entry_.outputs[index] = {type, buffer};
+    }
+    base_params_.output_set(index);
+  }
+
+  bool output_was_set_impl(const int index) const override
+  {
+    return base_params_.output_was_set(index);
+  }
+
+  lf::ValueUsage get_output_usage_impl(const int index) const override
+  {
+    return base_params_.get_output_usage(index);
+  }
+
+  void set_input_unused_impl(const int index) override
+  {
+    base_params_.set_input_unused(index);
+  }
+
+  bool try_enable_multi_threading_impl() override
+  {
+    return base_params_.try_enable_multi_threading();
+  }
+};
+
+/**
+ * \return True if all currently required outputs of the node were found in the cache.
+ */
+static bool try_output_cached_values(const GeoNodesNodeOutputCache::Entry &entry,
+                                     lf::Params &params)
+{
+  const Span<lf::Output> outputs = params.fn_.outputs();
+  Vector<int, 16> outputs_to_set;
+  for (const int i : outputs.index_range()) {
+    if (params.output_was_set(i)) {
+      continue;
+    }
+    if (params.get_output_usage(i) == lf::ValueUsage::Unused) {
+      continue;
+    }
+    if (!entry.outputs[i].get()) {
+      /* The output was not computed in the previous evaluation. */
+      return false;
+    }
+    outputs_to_set.append(i);
+  }
+  for (const int i : outputs_to_set) {
+    const GMutablePointer cached_value = entry.outputs[i];
+    cached_value.type()->copy_construct(cached_value.get(), params.get_output_data_ptr(i));
+    params.output_set(i);
+  }
+  return true;
+}
+
+static void replay_logged_info(const bNode &node,
+                               const GeoNodesNodeOutputCache::Entry &entry,
+                               geo_eval_log::GeoTreeLogger &tree_logger)
+{
+  for (const geo_eval_log::NodeWarning &warning : entry.warnings) {
+    tree_logger.node_warnings.append(
+        *tree_logger.allocator,
+        {node.identifier, {warning.type, tree_logger.allocator->copy_string(warning.message)}});
+  }
+  for (const auto &[name, usage] : entry.used_named_attributes) {
+    tree_logger.used_named_attributes.append(
+        *tree_logger.allocator,
+        {node.identifier, tree_logger.allocator->copy_string(name), usage});
+  }
+}
+
+static void remember_logged_info(const bNode &node,
+                                 const geo_eval_log::GeoTreeLogger &tree_logger,
+                                 GeoNodesNodeOutputCache::Entry &entry)
+{
+  for (const geo_eval_log::GeoTreeLogger::WarningWithNode &warning : tree_logger.node_warnings) {
+    if (warning.node_id == node.identifier) {
+      entry.warnings.append(warning.warning);
+    }
+  }
+  for (const geo_eval_log::GeoTreeLogger::AttributeUsageWithNode &attribute_usage :
+       tree_logger.used_named_attributes)
+  {
+    if (attribute_usage.node_id == node.identifier) {
+      entry.used_named_attributes.append({attribute_usage.attribute_name, attribute_usage.usage});
+    }
+  }
+}
+
+static bool outputs_can_be_cached(const GeoNodesNodeOutputCache::Entry &entry)
+{
+  for (const GMutablePointer &value : entry.outputs) {
+    if (value.is_type<bke::GeometrySet>()) {
+      if (!value.get<bke::GeometrySet>()->owns_direct_data()) {
+        /* The geometry may reference data that is freed after the evaluation. */
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+GeoNodesNodeOutputCache::GeoNodesNodeOutputCache() = default;
+GeoNodesNodeOutputCache::~GeoNodesNodeOutputCache() = default;
+
+void GeoNodesNodeOutputCache::execute_node(const bNode &node,
+                                           lf::Params &params,
+                                           const lf::Context &context,
+                                           const FunctionRef<void(lf::Params &params)> execute_fn)
+{
+  const auto &user_data = *static_cast<GeoNodesLFUserData *>(context.user_data);
+  const auto &local_user_data = *static_cast<GeoNodesLFLocalUserData *>(context.local_user_data);
+
+  std::optional<InputsFingerprint> fingerprint = fingerprint_inputs(node, params);
+  if (!fingerprint) {
+    execute_fn(params);
+    return;
+  }
+
+  const NodeInContext key{user_data.compute_context->hash(), node.identifier};
+  std::shared_ptr<const Entry> cached_entry;
+  int64_t evaluation_index;
+  {
+    std::lock_guard lock{mutex_};
+    cached_entry = entries_.lookup_default(key, nullptr);
+    evaluation_index = evaluation_index_;
+  }
+  if (cached_entry && fingerprints_equal(cached_entry->fingerprint, *fingerprint)) {
+    if (try_output_cached_values(*cached_entry, params)) {
+      cached_entry->last_used_evaluation = evaluation_index;
+      if (geo_eval_log::GeoTreeLogger *tree_logger = local_user_data.try_get_tree_logger(
+              user_data))
+      {
+        replay_logged_info(node, *cached_entry, *tree_logger);
+      }
+      return;
+    }
+  }
+  cached_entry.reset();
+
+  const Span<lf::Output> outputs = params.fn_.outputs();
+  auto entry = std::make_shared<Entry>();
+  entry->fingerprint = std::move(*fingerprint);
+  entry->outputs.reinitialize(outputs.size());
+  entry->last_used_evaluation = evaluation_index;
+
+  /* Only remember outputs that are actually computed. Unused outputs might be left
+   * uninitialized or may contain dummy values. */
+  Array<void *, 16> output_buffers(outputs.size(), nullptr);
+  for (const int i : outputs.index_range()) {
+    if (params.output_was_set(i) || params.get_output_usage(i) == lf::ValueUsage::Unused) {
+      continue;
+    }
+    const CPPType &type = *outputs[i].type;
+    output_buffers[i] = entry->allocator.allocate(type.size(), type.alignment());
+  }
+
+  RecordOutputsParams record_params{params, *entry, output_buffers};
+  execute_fn(record_params);
+
+  if (!outputs_can_be_cached(*entry)) {
+    return;
+  }
+  if (const geo_eval_log::GeoTreeLogger *tree_logger = local_user_data.try_get_tree_logger(
+          user_data))
+  {
+    remember_logged_info(node, *tree_logger, *entry);
+  }
+
+  std::lock_guard lock{mutex_};
+  entries_.add_overwrite(key, std::move(entry));
+}
+
+void GeoNodesNodeOutputCache::begin_evaluation()
+{
+  std::lock_guard lock{mutex_};
+  evaluation_index_++;
+}
+
+void GeoNodesNodeOutputCache::remove_unused_entries()
+{
+  std::lock_guard lock{mutex_};
+  entries_.remove_if([&](const auto item) {
+    return item.value->last_used_evaluation < evaluation_index_;
+  });
+}
+
+void GeoNodesNodeOutputCache::clear()
+{
+  std::lock_guard lock{mutex_};
+  entries_.clear();
+}
+
+int64_t GeoNodesNodeOutputCache::size() const
+{
+  std::lock_guard lock{mutex_};
+  return entries_.size();
+}
+
+}  // namespace blender::nodes
@@ -0,0 +1,274 @@
+/* SPDX-FileCopyrightText: 2025 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup nodes
+ */
+
+#include "testing/testing.h"
+#include "tests/blendfile_loading_base_test.h"
+
+#include "BLI_array.hh"
+#include "BLI_listbase.h"
+#include "BLI_math_vector.h"
+#include "BLI_math_vector_types.hh"
+
+#include "BKE_collection.hh"
+#include "BKE_global.hh"
+#include "BKE_layer.hh"
+#include "BKE_lib_id.hh"
+#include "BKE_main.hh"
+#include "BKE_main_invariants.hh"
+#include "BKE_mesh.hh"
+#include "BKE_modifier.hh"
+#include "BKE_node.hh"
+#include "BKE_node_tree_update.hh"
+#include "BKE_object.hh"
+#include "BKE_scene.hh"
+
+#include "DEG_depsgraph.hh"
+#include "DEG_depsgraph_build.hh"
+#include "DEG_depsgraph_query.hh"
+
+#include "DNA_mesh_types.h"
+#include "DNA_modifier_types.h"
+#include "DNA_node_types.h"
+#include "DNA_object_types.h"
+#include "DNA_scene_types.h"
+
+#include "MOD_nodes.hh"
+
+#include "NOD_geometry_nodes_node_output_cache.hh"
+
+namespace blender::nodes::tests {
+
+/**
+ * The node tree of a nodes modifier is `Grid -> Transform -> Group Output`. Both nodes are
+ * cacheable. The group input is connected to the transform node by tests that use the geometry
+ * of the object.
+ */
+class NodeOutputCacheTest : public BlendfileLoadingBaseTest {
+ protected:
+  Main *bmain = nullptr;
+  Main *bmain_backup = nullptr;
+  Scene *scene = nullptr;
+  Object *object = nullptr;
+  Mesh *mesh = nullptr;
+  bNodeTree *ntree = nullptr;
+  NodesModifierData *nmd = nullptr;
+  bNode *group_input = nullptr;
+  bNode *grid = nullptr;
+  bNode *transform = nullptr;
+  bNode *group_output = nullptr;
+
+  void SetUp() override
+  {
+    BlendfileLoadingBaseTest::SetUp();
+    /* Node tree updates tag the global main database. */
+    bmain = BKE_main_new();
+    bmain_backup = G_MAIN;
+    G_MAIN = bmain;
+
+    scene = BKE_scene_add(bmain, "Scene");
+    mesh = BKE_mesh_new_nomain(4, 0, 0, 0);
+    MutableSpan<float3> positions = mesh->vert_positions_for_write();
+    for (const int i : positions.index_range()) {
+      positions[i] = float3(i, 0.0f, 0.0f);
+    }
+    BKE_libblock_management_main_add(bmain, mesh);
+    object = BKE_object_add_only_object(bmain, OB_MESH, "Object");
+    object->data = mesh;
+    BKE_collection_object_add(bmain, scene->master_collection, object);
+
+    add_node_tree();
+    add_modifier();
+    BKE_main_ensure_invariants(*bmain);
+
+    depsgraph = create_evaluated_depsgraph();
+    /* The cache is only used by the active depsgraph. */
+    DEG_make_active(depsgraph);
+    evaluate();
+  }
+
+  void TearDown() override
+  {
+    BlendfileLoadingBaseTest::TearDown();
+    G_MAIN = bmain_backup;
+    BKE_main_free(bmain);
+  }
+
+  void add_node_tree()
+  {
+    ntree = bke::node_tree_add_tree(bmain, "Nodes", "GeometryNodeTree");
+    ntree->tree_interface.add_socket(
+        "Geometry", "", "NodeSocketGeometry", NODE_INTERFACE_SOCKET_OUTPUT, nullptr);
+    ntree->tree_interface.add_socket(
+        "Geometry", "", "NodeSocketGeometry", NODE_INTERFACE_SOCKET_INPUT, nullptr);
+
+    group_input = bke::node_add_node(nullptr, ntree, "NodeGroupInput");
+    grid = bke::node_add_node(nullptr, ntree, "GeometryNodeMeshGrid");
+    transform = bke::node_add_node(nullptr, ntree, "GeometryNodeTransform");
+    group_output = bke::node_add_node(nullptr, ntree, "NodeGroupOutput");
+    set_translation(float3(0.0f, 0.0f, 1.0f));
+
+    link(grid, "Mesh", transform, "Geometry");
+    link(transform, "Geometry", group_output, "Socket_0");
+  }
+
+  void add_modifier()
+  {
+    nmd = reinterpret_cast<NodesModifierData *>(BKE_modifier_new(eModifierType_Nodes));
+    BLI_addtail(&object->modifiers, nmd);
+    BKE_modifier_unique_name(&object->modifiers, &nmd->modifier);
+    BKE_modifiers_persistent_uid_init(*object, nmd->modifier);
+    nmd->node_group = ntree;
+    id_us_plus(&ntree->id);
+    nmd->flag |= NODES_MODIFIER_CACHE_NODE_OUTPUTS;
+    MOD_nodes_update_interface(object, nmd);
+  }
+
+  /** Replaces the link to the input socket, if there is one. */
+  void link(bNode *from, const char *from_identifier, bNode *to, const char *to_identifier)
+  {
+    bNodeSocket *to_socket = bke::node_find_socket(to, SOCK_IN, to_identifier);
+    bke::node_remove_socket_links(ntree, to_socket);
+    bke::node_add_link(
+        ntree, from, bke::node_find_socket(from, SOCK_OUT, from_identifier), to, to_socket);
+  }
+
+  void set_translation(const float3 &translation)
+  {
+    bNodeSocket *socket = bke::node_find_socket(transform, SOCK_IN, "Translation");
+    copy_v3_v3(socket->default_value_typed<bNodeSocketValueVector>()->value, translation);
+    BKE_ntree_update_tag_socket_property(ntree, socket);
+  }
+
+  void set_grid_size(const float size)
+  {
+    bNodeSocket *socket = bke::node_find_socket(grid, SOCK_IN, "Size X");
+    socket->default_value_typed<bNodeSocketValueFloat>()->value = size;
+    BKE_ntree_update_tag_socket_property(ntree, socket);
+  }
+
+  Depsgraph *create_evaluated_depsgraph()
+  {
+    ViewLayer *view_layer = BKE_view_layer_default_view(scene);
+    BKE_view_layer_synced_ensure(scene, view_layer);
+    Depsgraph *new_depsgraph = DEG_graph_new(bmain, scene, view_layer, DAG_EVAL_VIEWPORT);
+    DEG_graph_build_from_view_layer(new_depsgraph);
+    BKE_scene_graph_update_tagged(new_depsgraph, bmain);
+    return new_depsgraph;
+  }
+
+  void evaluate()
+  {
+    BKE_main_ensure_invariants(*bmain);
+    BKE_scene_graph_update_tagged(depsgraph, bmain);
+  }
+
+  /** Evaluate again without changing anything that the node tree depends on. */
+  void evaluate_unchanged()
+  {
+    DEG_id_tag_update_ex(bmain, &object->id, ID_RECALC_GEOMETRY);
+    evaluate();
+  }
+
+  Span<float3> evaluated_positions(const Depsgraph *graph)
+  {
+    const Object *object_eval = DEG_get_evaluated_object(graph, object);
+    return BKE_object_get_evaluated_mesh(object_eval)->vert_positions();
+  }
+
+  int64_t cache_size() const
+  {
+    return nmd->runtime->node_output_cache ? nmd->runtime->node_output_cache->size() : 0;
+  }
+
+  /** Compare the result with an evaluation in a depsgraph that does not use the cache. */
+  void expect_matches_fresh_evaluation()
+  {
+    Depsgraph *fresh_depsgraph = create_evaluated_depsgraph();
+    const Span<float3> positions = evaluated_positions(depsgraph);
+    const Span<float3> fresh_positions = evaluated_positions(fresh_depsgraph);
+    EXPECT_EQ(positions, fresh_positions);
+    DEG_graph_free(fresh_depsgraph);
+  }
+};
+
+TEST_F(NodeOutputCacheTest, HitMatchesFreshEvaluation)
+{
+  EXPECT_EQ(cache_size(), 2);
+  const float3 *positions = evaluated_positions(depsgraph).data();
+
+  evaluate_unchanged();
+  /* Outputs are shared with the cache, so the positions of the transformed grid are reused. */
+  EXPECT_EQ(evaluated_positions(depsgraph).data(), positions);
+  EXPECT_EQ(cache_size(), 2);
+  expect_matches_fresh_evaluation();
+}
+
+TEST_F(NodeOutputCacheTest, SocketValueChangeInvalidates)
+{
+  const Array<float3> old_positions(evaluated_positions(depsgraph));
+
+  set_translation(float3(0.0f, 2.0f, 0.0f));
+  evaluate();
+  const Array<float3> positions(evaluated_positions(depsgraph));
+  ASSERT_EQ(positions.size(), old_positions.size());
+  for (const int i : positions.index_range()) {
+    const float3 expected = old_positions[i] + float3(0.0f, 2.0f, -1.0f);
+    EXPECT_V3_NEAR(positions[i], expected, 1e-6f);
+  }
+  EXPECT_EQ(cache_size(), 2);
+  expect_matches_fresh_evaluation();
+
+  /* Changing an input of the first node invalidates the following nodes too. */
+  set_grid_size(5.0f);
+  evaluate();
+  EXPECT_NE(evaluated_positions(depsgraph), positions.as_span());
+  expect_matches_fresh_evaluation();
+}
+
+TEST_F(NodeOutputCacheTest, MeshEditInvalidates)
+{
+  link(group_input, "Socket_1", transform, "Geometry");
+  evaluate();
+  EXPECT_EQ(evaluated_positions(depsgraph)[3], float3(3.0f, 0.0f, 1.0f));
+  expect_matches_fresh_evaluation();
+
+  mesh->vert_positions_for_write()[3] = float3(3.0f, 4.0f, 0.0f);
+  mesh->tag_positions_changed();
+  DEG_id_tag_update_ex(bmain, &mesh->id, ID_RECALC_GEOMETRY);
+  evaluate();
+  EXPECT_EQ(evaluated_positions(depsgraph)[3], float3(3.0f, 4.0f, 1.0f));
+  expect_matches_fresh_evaluation();
+}
+
+TEST_F(NodeOutputCacheTest, UnusedEntriesAreFreed)
+{
+  EXPECT_EQ(cache_size(), 2);
+
+  /* The grid node is not evaluated anymore. */
+  link(group_input, "Socket_1", transform, "Geometry");
+  evaluate();
+  EXPECT_EQ(cache_size(), 1);
+
+  /* No cacheable node is evaluated anymore. */
+  link(group_input, "Socket_1", group_output, "Socket_0");
+  evaluate();
+  EXPECT_EQ(cache_size(), 0);
+  expect_matches_fresh_evaluation();
+}
+
+TEST_F(NodeOutputCacheTest, DisablingFreesCache)
+{
+  ASSERT_NE(nmd->runtime->node_output_cache, nullptr);
+
+  nmd->flag &= ~NODES_MODIFIER_CACHE_NODE_OUTPUTS;
+  evaluate_unchanged();
+  EXPECT_EQ(nmd->runtime->node_output_cache, nullptr);
+  expect_matches_fresh_evaluation();
+}
+
+}  // namespace blender::nodes::tests
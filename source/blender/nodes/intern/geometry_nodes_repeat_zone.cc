@@ -3,6 +3,7 @@
  * SPDX-License-Identifier: GPL-2.0-or-later */
 
 #include "NOD_geometry_nodes_lazy_function.hh"
+#include "NOD_geometry_nodes_trace.hh"
 
 #include "BKE_compute_contexts.hh"
 #include "BKE_node_runtime.hh"
@@ -56,6 +57,10 @@ class RepeatBodyNodeExecuteWrapper : public lf::GraphExecutorNodeExecuteWrapper
 
     GeoNodesLFLocalUserData body_local_user_data{body_user_data};
     lf::Context body_context{context.storage, &body_user_data, &body_local_user_data};
+    const geo_eval_trace::ScopedEvent trace_event{user_data.compute_context,
+                                                  *repeat_output_bnode_,
+                                                  geo_eval_trace::EventType::ZoneIteration,
+                                                  iteration};
     fn.execute(params, body_context);
   }
 };
@@ -0,0 +1,372 @@
+/* SPDX-FileCopyrightText: 2025 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup nodes
+ */
+
+#include <atomic>
+#include <sstream>
+
+#include <fmt/format.h>
+
+#include "BLI_compute_context.hh"
+#include "BLI_enumerable_thread_specific.hh"
+#include "BLI_fileops.hh"
+#include "BLI_map.hh"
+#include "BLI_serialize.hh"
+#include "BLI_vector.hh"
+
+#include "BKE_compute_contexts.hh"
+#include "BKE_curves.hh"
+#include "BKE_geometry_set.hh"
+#include "BKE_instances.hh"
+
+#include "DNA_mesh_types.h"
+#include "DNA_node_types.h"
+#include "DNA_pointcloud_types.h"
+
+#include "NOD_geometry_nodes_trace.hh"
+
+namespace blender::nodes::geo_eval_trace {
+
+/* -------------------------------------------------------------------- */
+/** \name Recorded Events
+ * \{ */
+
+struct Event {
+  EventType type;
+  std::string name;
+  /** Identifies the context path in #LocalEvents::context_paths. */
+  std::optional<ComputeContextHash> context_hash;
+  TimePoint start;
+  TimePoint end;
+  GeometryElementCounts inputs;
+  GeometryElementCounts outputs;
+};
+
+/** Events are recorded per thread, so that threads don't have to synchronize. */
+struct LocalEvents {
+  Vector<Event> events;
+  /** Readable description of every compute context that events were recorded in. */
+  Map<ComputeContextHash, std::string> context_paths;
+};
+
+struct TraceState {
+  std::atomic<bool> is_recording = false;
+  TimePoint begin_time;
+  threading::EnumerableThreadSpecific<LocalEvents> events_per_thread;
+};
+
+static TraceState &get_trace_state()
+{
+  static TraceState state;
+  return state;
+}
+
+static std::string compute_context_path(const ComputeContext &compute_context)
+{
+  Vector<const ComputeContext *> stack;
+  for (const ComputeContext *current = &compute_context; current; current = current->parent()) {
+    stack.append(current);
+  }
+  std::stringstream stream;
+  for (const int i : stack.index_range()) {
+    const ComputeContext *current = stack[stack.size() - 1 - i];
+    if (i > 0) {
+      stream << " > ";
+    }
+    current->print_current_in_line(stream);
+    if (const auto *context = dynamic_cast<const bke::RepeatZoneComputeContext *>(current)) {
+      stream << " [" << context->iteration() << "]";
+    }
+    else if (const auto *context =
+                 dynamic_cast<const bke::ForeachGeometryElementZoneComputeContext *>(current))
+    {
+      stream << " [" << context->index() << "]";
+    }
+  }
+  return stream.str();
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Event Recording
+ * \{ */
+
+void GeometryElementCounts::add(const bke::GeometrySet &geometry)
+{
+  this->has_geometry = true;
+  if (const Mesh *mesh = geometry.get_mesh()) {
+    this->points += mesh->verts_num;
+    this->faces += mesh->faces_num;
+  }
+  if (const PointCloud *pointcloud = geometry.get_pointcloud()) {
+    this->points += pointcloud->totpoint;
+  }
+  if (const Curves *curves_id = geometry.get_curves()) {
+    const bke::CurvesGeometry &curves = curves_id->geometry.wrap();
+    this->points += curves.points_num();
+    this->curves += curves.curves_num();
+  }
+  if (const bke::Instances *instances = geometry.get_instances()) {
+    this->instances += instances->instances_num();
+  }
+}
+
+void GeometryElementCounts::add(const CPPType &type, const void *value)
+{
+  if (type.is<bke::GeometrySet>()) {
+    this->add(*static_cast<const bke::GeometrySet *>(value));
+  }
+  else if (type.is<Vector<bke::GeometrySet>>()) {
+    /* Multi-input sockets. */
+    for (const bke::GeometrySet &geometry : *static_cast<const Vector<bke::GeometrySet> *>(value))
+    {
+      this->add(geometry);
+    }
+  }
+}
+
+ScopedEvent::ScopedEvent(const ComputeContext *compute_context,
+                         const bNode &node,
+                         const EventType type,
+                         const int iteration)
+    : is_recording_(geo_eval_trace::is_recording())
+{
+  if (!is_recording_) {
+    return;
+  }
+  type_ = type;
+  compute_context_ = compute_context;
+  node_ = &node;
+  iteration_ = iteration;
+  start_ = Clock::now();
+}
+
+ScopedEvent::~ScopedEvent()
+{
+  if (!is_recording_) {
+    return;
+  }
+  const TimePoint end = Clock::now();
+
+  LocalEvents &local = get_trace_state().events_per_thread.local();
+  Event event;
+  event.type = type_;
+  event.name = iteration_ == -1 ? std::string(node_->name) :
+                                  fmt::format("{} [{}]", node_->name, iteration_);
+  if (compute_context_) {
+    event.context_hash = compute_context_->hash();
+    local.context_paths.lookup_or_add_cb(compute_context_->hash(), [&]() {
+      return compute_context_path(*compute_context_);
+    });
+  }
+  event.start = start_;
+  event.end = end;
+  event.inputs = this->inputs;
+  event.outputs = this->outputs;
+  local.events.append(std::move(event));
+}
+
+void ScopedEvent::add_available_inputs(const lf::Params &params)
+{
+  const Span<lf::Input> fn_inputs = params.fn_.inputs();
+  for (const int i : fn_inputs.index_range()) {
+    if (const void *value = params.try_get_input_data_ptr(i)) {
+      this->inputs.add(*fn_inputs[i].type, value);
+    }
+  }
+}
+
+CountOutputsParams::CountOutputsParams(lf::Params &base_params, ScopedEvent &event)
+    : lf::Params(base_params.fn_, false), base_params_(base_params), event_(event)
+{
+}
+
+void *CountOutputsParams::try_get_input_data_ptr_impl(const int index) const
+{
+  return base_params_.try_get_input_data_ptr(index);
+}
+
+void *CountOutputsParams::try_get_input_data_ptr_or_request_impl(const int index)
+{
+  return base_params_.try_get_input_data_ptr_or_request(index);
+}
+
+void *CountOutputsParams::get_output_data_ptr_impl(const int index)
+{
+  return base_params_.get_output_data_ptr(index);
+}
+
+void CountOutputsParams::output_set_impl(const int index)
+{
+  /* The value is forwarded to other nodes when the output is set, so it has to be counted
+   * before. */
+  GeometryElementCounts counts;
+  counts.add(*fn_.outputs()[index].type, base_params_.get_output_data_ptr(index));
+  if (counts.has_geometry) {
+    std::lock_guard lock{mutex_};
+    event_.outputs.points += counts.points;
+    event_.outputs.faces += counts.faces;
+    event_.outputs.curves += counts.curves;
+    event_.outputs.instances += counts.instances;
+    event_.outputs.has_geometry = true;
+  }
+  base_params_.output_set(index);
+}
+
+bool CountOutputsParams::output_was_set_impl(const int index) const
+{
+  return base_params_.output_was_set(index);
+}
+
+lf::ValueUsage CountOutputsParams::get_output_usage_impl(const int index) const
+{
+  return base_params_.get_output_usage(index);
+}
+
+void CountOutputsParams::set_input_unused_impl(const int index)
+{
+  base_params_.set_input_unused(index);
+}
+
+bool CountOutputsParams::try_enable_multi_threading_impl()
+{
+  return base_params_.try_enable_multi_threading();
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Recording Control
+ * \{ */
+
+bool is_recording()
+{
+  return get_trace_state().is_recording.load(std::memory_order_relaxed);
+}
+
+void begin_recording()
+{
+  TraceState &state = get_trace_state();
+  clear();
+  state.begin_time = Clock::now();
+  state.is_recording.store(true, std::memory_order_relaxed);
+}
+
+void end_recording()
+{
+  get_trace_state().is_recording.store(false, std::memory_order_relaxed);
+}
+
+void clear()
+{
+  TraceState &state = get_trace_state();
+  for (LocalEvents &local : state.events_per_thread) {
+    local.events.clear_and_shrink();
+    local.context_paths.clear();
+  }
+}
+
+int64_t events_num()
+{
+  int64_t num = 0;
+  for (LocalEvents &local : get_trace_state().events_per_thread) {
+    num += local.events.size();
+  }
+  return num;
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Chrome Trace Export
+ * \{ */
+
+static const char *event_type_name(const EventType type)
+{
+  switch (type) {
+    case EventType::Node:
+      return "Node";
+    case EventType::GroupNode:
+      return "Group Node";
+    case EventType::ZoneIteration:
+      return "Zone Iteration";
+  }
+  BLI_assert_unreachable();
+  return "";
+}
+
+static void serialize_element_counts(const GeometryElementCounts &counts,
+                                     io::serialize::DictionaryValue &io_counts)
+{
+  io_counts.append_int("points", counts.points);
+  io_counts.append_int("faces", counts.faces);
+  io_counts.append_int("curves", counts.curves);
+  io_counts.append_int("instances", counts.instances);
+}
+
+bool write_chrome_trace(const StringRefNull filepath)
+{
+  using namespace io::serialize;
+  TraceState &state = get_trace_state();
+
+  auto to_microseconds = [&](const TimePoint time) {
+    return std::chrono::duration<double, std::micro>(time - state.begin_time).count();
+  };
+
+  DictionaryValue io_root;
+  ArrayValue &io_events = *io_root.append_array("traceEvents");
+  int thread_index = 0;
+  for (const LocalEvents &local : state.events_per_thread) {
+    if (local.events.is_empty()) {
+      continue;
+    }
+    DictionaryValue &io_thread_name = *io_events.append_dict();
+    io_thread_name.append_str("name", "thread_name");
+    io_thread_name.append_str("ph", "M");
+    io_thread_name.append_int("pid", 1);
+    io_thread_name.append_int("tid", thread_index);
+    io_thread_name.append_dict("args")->append_str("name", fmt::format("Thread {}", thread_index));
+
+    for (const Event &event : local.events) {
+      DictionaryValue &io_event = *io_events.append_dict();
+      io_event.append_str("name", event.name);
+      io_event.append_str("cat", event_type_name(event.type));
+      io_event.append_str("ph", "X");
+      io_event.append_double("ts", to_microseconds(event.start));
+      io_event.append_double("dur",
+                             std::chrono::duration<double, std::micro>(event.end - event.start)
+                                 .count());
+      io_event.append_int("pid", 1);
+      io_event.append_int("tid", thread_index);
+      DictionaryValue &io_args = *io_event.append_dict("args");
+      if (event.context_hash) {
+        io_args.append_str("context", local.context_paths.lookup(*event.context_hash));
+      }
+      if (event.inputs.has_geometry) {
+        serialize_element_counts(event.inputs, *io_args.append_dict("inputs"));
+      }
+      if (event.outputs.has_geometry) {
+        serialize_element_counts(event.outputs, *io_args.append_dict("outputs"));
+      }
+    }
+    thread_index++;
+  }
+  io_root.append_str("displayTimeUnit", "ms");
+
+  fstream stream(filepath, std::ios::out | std::ios::trunc);
+  if (!stream.is_open()) {
+    return false;
+  }
+  JsonFormatter formatter;
+  formatter.serialize(stream, io_root);
+  return !stream.fail();
+}
+
+/** \} */
+
+}  // namespace blender::nodes::geo_eval_trace
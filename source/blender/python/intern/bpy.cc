@@ -40,6 +40,7 @@
 #include "bpy_operator.hh"
 #include "bpy_props.hh"
 #include "bpy_rna.hh"
+#include "bpy_rna_attribute.hh"
 #include "bpy_rna_data.hh"
 #include "bpy_rna_gizmo.hh"
 #include "bpy_rna_types_capi.hh"
@@ -749,6 +750,8 @@ void BPy_init_modules(bContext *C)
 
   BPY_rna_data_context_type_ready();
 
+  BPY_rna_attribute_buffer_type_ready();
+
   BPY_rna_gizmo_module(mod);
 
   bpy_import_test("bpy_types");
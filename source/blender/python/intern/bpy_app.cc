@@ -32,6 +32,7 @@
 #include "BPY_extern_python.hh" /* For #BPY_python_app_help_text_fn. */
 
 /* modules */
+#include "bpy_app_geometry_nodes_trace.hh"
 #include "bpy_app_icons.hh"
 #include "bpy_app_timers.hh"
 
@@ -121,6 +122,7 @@ static PyStructSequence_Field app_info_fields[] = {
     {"translations", "Application and addons internationalization API"},
 
     /* Modules (not struct sequence). */
+    {"geometry_nodes_trace", "Record the execution of geometry nodes"},
     {"icons", "Manage custom icons"},
     {"timers", "Manage timers"},
     {nullptr},
@@ -218,6 +220,7 @@ static PyObject *make_app_info()
   SetObjItem(BPY_app_translations_struct());
 
   /* modules */
+  SetObjItem(BPY_app_geometry_nodes_trace_module());
   SetObjItem(BPY_app_icons_module());
   SetObjItem(BPY_app_timers_module());
 
@@ -489,6 +492,11 @@ static PyGetSetDef bpy_app_getsets[] = {
      bpy_app_debug_set,
      bpy_app_debug_doc,
      (void *)G_DEBUG_DEPSGRAPH_PRETTY},
+    {"debug_depsgraph_validate",
+     bpy_app_debug_get,
+     bpy_app_debug_set,
+     bpy_app_debug_doc,
+     (void *)G_DEBUG_DEPSGRAPH_VALIDATE},
     {"debug_simdata",
      bpy_app_debug_get,
      bpy_app_debug_set,
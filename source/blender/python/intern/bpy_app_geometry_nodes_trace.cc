@@ -0,0 +1,189 @@
+/* SPDX-FileCopyrightText: 2025 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup pythonintern
+ *
+ * Recording of geometry nodes execution traces.
+ */
+
+#include <Python.h>
+
+#include "NOD_geometry_nodes_trace.hh"
+
+#include "../generic/py_capi_utils.hh"
+#include "../generic/python_compat.hh"
+
+#include "bpy_app_geometry_nodes_trace.hh"
+
+namespace geo_eval_trace = blender::nodes::geo_eval_trace;
+
+PyDoc_STRVAR(
+    /* Wrap. */
+    bpy_app_geometry_nodes_trace_start_doc,
+    ".. function:: start()\n"
+    "\n"
+    "   Start recording the execution of geometry nodes. Events recorded before are removed.\n"
+    "   Must not be called while geometry nodes are evaluated.\n");
+static PyObject *bpy_app_geometry_nodes_trace_start(PyObject * /*self*/)
+{
+  geo_eval_trace::begin_recording();
+  Py_RETURN_NONE;
+}
+
+PyDoc_STRVAR(
+    /* Wrap. */
+    bpy_app_geometry_nodes_trace_stop_doc,
+    ".. function:: stop()\n"
+    "\n"
+    "   Stop recording, the recorded events are kept until they are written or cleared.\n");
+static PyObject *bpy_app_geometry_nodes_trace_stop(PyObject * /*self*/)
+{
+  geo_eval_trace::end_recording();
+  Py_RETURN_NONE;
+}
+
+PyDoc_STRVAR(
+    /* Wrap. */
+    bpy_app_geometry_nodes_trace_is_recording_doc,
+    ".. function:: is_recording()\n"
+    "\n"
+    "   :return: True when the execution of geometry nodes is recorded currently.\n"
+    "   :rtype: bool\n");
+static PyObject *bpy_app_geometry_nodes_trace_is_recording(PyObject * /*self*/)
+{
+  return PyBool_FromLong(geo_eval_trace::is_recording());
+}
+
+PyDoc_STRVAR(
+    /* Wrap. */
+    bpy_app_geometry_nodes_trace_clear_doc,
+    ".. function:: clear()\n"
+    "\n"
+    "   Remove all recorded events. Must not be called while geometry nodes are evaluated.\n");
+static PyObject *bpy_app_geometry_nodes_trace_clear(PyObject * /*self*/)
+{
+  geo_eval_trace::clear();
+  Py_RETURN_NONE;
+}
+
+PyDoc_STRVAR(
+    /* Wrap. */
+    bpy_app_geometry_nodes_trace_events_num_doc,
+    ".. function:: events_num()\n"
+    "\n"
+    "   :return: The number of recorded events.\n"
+    "   :rtype: int\n");
+static PyObject *bpy_app_geometry_nodes_trace_events_num(PyObject * /*self*/)
+{
+  return PyLong_FromLongLong(geo_eval_trace::events_num());
+}
+
+PyDoc_STRVAR(
+    /* Wrap. */
+    bpy_app_geometry_nodes_trace_write_doc,
+    ".. function:: write(filepath)\n"
+    "\n"
+    "   Write the recorded events in the Chrome trace event format, which can be opened with\n"
+    "   ``chrome://tracing`` or https://ui.perfetto.dev. Every event contains the node name,\n"
+    "   compute context and the number of geometry elements that were passed into and out of\n"
+    "   the node.\n"
+    "\n"
+    "   :arg filepath: File path of the JSON file.\n"
+    "   :type filepath: str | bytes\n");
+static PyObject *bpy_app_geometry_nodes_trace_write(PyObject * /*self*/,
+                                                    PyObject *args,
+                                                    PyObject *kw)
+{
+  PyC_UnicodeAsBytesAndSize_Data filepath_data = {nullptr};
+
+  static const char *_keywords[] = {"filepath", nullptr};
+  static _PyArg_Parser _parser = {
+      PY_ARG_PARSER_HEAD_COMPAT()
+      "O&" /* `filepath` */
+      ":write",
+      _keywords,
+      nullptr,
+  };
+  if (!_PyArg_ParseTupleAndKeywordsFast(
+          args, kw, &_parser, PyC_ParseUnicodeAsBytesAndSize, &filepath_data))
+  {
+    return nullptr;
+  }
+
+  const bool success = geo_eval_trace::write_chrome_trace(filepath_data.value);
+  Py_XDECREF(filepath_data.value_coerce);
+
+  if (!success) {
+    PyErr_SetString(PyExc_OSError, "Unable to write trace file");
+    return nullptr;
+  }
+  Py_RETURN_NONE;
+}
+
+#if (defined(__GNUC__) && !defined(__clang__))
+#  pragma GCC diagnostic push
+#  pragma GCC diagnostic ignored "-Wcast-function-type"
+#endif
+
+static PyMethodDef M_AppGeometryNodesTrace_methods[] = {
+    {"start",
+     (PyCFunction)bpy_app_geometry_nodes_trace_start,
+     METH_NOARGS,
+     bpy_app_geometry_nodes_trace_start_doc},
+    {"stop",
+     (PyCFunction)bpy_app_geometry_nodes_trace_stop,
+     METH_NOARGS,
+     bpy_app_geometry_nodes_trace_stop_doc},
+    {"is_recording",
+     (PyCFunction)bpy_app_geometry_nodes_trace_is_recording,
+     METH_NOARGS,
+     bpy_app_geometry_nodes_trace_is_recording_doc},
+    {"clear",
+     (PyCFunction)bpy_app_geometry_nodes_trace_clear,
+     METH_NOARGS,
+     bpy_app_geometry_nodes_trace_clear_doc},
+    {"events_num",
+     (PyCFunction)bpy_app_geometry_nodes_trace_events_num,
+     METH_NOARGS,
+     bpy_app_geometry_nodes_trace_events_num_doc},
+    {"write",
+     (PyCFunction)bpy_app_geometry_nodes_trace_write,
+     METH_VARARGS | METH_KEYWORDS,
+     bpy_app_geometry_nodes_trace_write_doc},
+    {nullptr, nullptr, 0, nullptr},
+};
+
+#if (defined(__GNUC__) && !defined(__clang__))
+#  pragma GCC diagnostic pop
+#endif
+
+PyDoc_STRVAR(
+    /* Wrap. */
+    M_AppGeometryNodesTrace_doc,
+    "Record the execution of geometry nodes to find out where time is spent.\n"
+    "Recording can also be started with the ``--debug-geometry-nodes-trace`` command line "
+    "argument.");
+static PyModuleDef M_AppGeometryNodesTrace_module_def = {
+    /*m_base*/ PyModuleDef_HEAD_INIT,
+    /*m_name*/ "bpy.app.geometry_nodes_trace",
+    /*m_doc*/ M_AppGeometryNodesTrace_doc,
+    /*m_size*/ 0,
+    /*m_methods*/ M_AppGeometryNodesTrace_methods,
+    /*m_slots*/ nullptr,
+    /*m_traverse*/ nullptr,
+    /*m_clear*/ nullptr,
+    /*m_free*/ nullptr,
+};
+
+PyObject *BPY_app_geometry_nodes_trace_module()
+{
+  PyObject *sys_modules = PyImport_GetModuleDict();
+
+  PyObject *mod = PyModule_Create(&M_AppGeometryNodesTrace_module_def);
+
+  PyDict_SetItem(sys_modules, PyModule_GetNameObject(mod), mod);
+
+  return mod;
+}
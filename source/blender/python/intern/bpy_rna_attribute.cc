@@ -0,0 +1,653 @@
+/* SPDX-FileCopyrightText: 2025 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup pythonintern
+ *
+ * This file extends geometry attributes with buffer protocol access to the arrays of #Mesh,
+ * #Curves and #PointCloud data-blocks.
+ *
+ * A read-only buffer gives direct access without copying. It keeps a user of the implicitly
+ * shared array, so the memory stays valid even when the data-block is changed or freed while the
+ * buffer is still referenced from Python. A writable buffer owns a copy of the values that is
+ * written back when the buffer is released.
+ */
+
+#include <Python.h>
+
+#include "MEM_guardedalloc.h"
+
+#include "../generic/py_capi_utils.hh"
+#include "../generic/python_compat.hh"
+
+#include "BLI_implicit_sharing.hh"
+#include "BLI_string.h"
+#include "BLI_string_ref.hh"
+
+#include "DNA_curves_types.h"
+#include "DNA_customdata_types.h"
+#include "DNA_mesh_types.h"
+#include "DNA_pointcloud_types.h"
+
+#include "BKE_attribute.h"
+#include "BKE_curves.hh"
+#include "BKE_customdata.hh"
+#include "BKE_idtype.hh"
+#include "BKE_mesh_types.hh"
+
+#include "DEG_depsgraph.hh"
+
+#include "WM_api.hh"
+#include "WM_types.hh"
+
+#include "bpy_rna.hh"
+#include "bpy_rna_attribute.hh"
+
+using blender::ImplicitSharingInfo;
+using blender::StringRef;
+
+/* -------------------------------------------------------------------- */
+/** \name Buffer Type
+ *
+ * The exporter of the buffer protocol, only accessed through the `memoryview` returned by the
+ * methods below.
+ * \{ */
+
+#define BPY_ATTRIBUTE_BUFFER_NDIM_MAX 3
+
+struct BPy_AttributeBuffer {
+  PyObject_HEAD /* Required Python macro. */
+  void *data;
+  /** For read-only buffers, a user of the array is kept as long as the buffer exists. */
+  const ImplicitSharingInfo *sharing_info;
+  const char *format;
+  Py_ssize_t itemsize;
+  int ndim;
+  Py_ssize_t shape[BPY_ATTRIBUTE_BUFFER_NDIM_MAX];
+  Py_ssize_t strides[BPY_ATTRIBUTE_BUFFER_NDIM_MAX];
+  /**
+   * Writable buffers own #data, a copy of the values that is written back to the geometry when
+   * the last view is released. Writing to the array of the geometry directly would break implicit
+   * sharing: copies of the geometry made while the buffer is used would share the array and change
+   * with it, and writes from Blender would move the geometry to a new array.
+   */
+  bool is_writable;
+  int exports_num;
+  /**
+   * The Python instance of the original data-block for writable buffers. It is invalidated when
+   * the data-block is freed, so it is safe to check before writing back.
+   */
+  PyObject *py_id;
+  /** Attribute the values are written back to, the name is empty for offsets. */
+  eCustomDataType type;
+  blender::bke::AttrDomain domain;
+  char name[MAX_CUSTOMDATA_LAYER_NAME];
+};
+
+/** Empty arrays might not be allocated, but buffers still need a valid pointer. */
+static int bpy_attribute_buffer_empty_data = 0;
+
+/** Clear caches derived from the changed data of the original data-block. */
+static void bpy_attribute_buffer_tag_changed(ID &id, const StringRef name)
+{
+  switch (GS(id.name)) {
+    case ID_ME: {
+      Mesh &mesh = reinterpret_cast<Mesh &>(id);
+      if (name == "position") {
+        mesh.tag_positions_changed();
+      }
+      else if (name.is_empty() || name.startswith(".")) {
+        /* Offsets and other internal arrays like `.corner_vert` or `.edge_verts` define the
+         * topology. */
+        mesh.tag_topology_changed();
+      }
+      else if (ELEM(name, "sharp_face", "sharp_edge")) {
+        mesh.tag_sharpness_changed();
+      }
+      else if (name == "material_index") {
+        mesh.tag_material_index_changed();
+      }
+      break;
+    }
+    case ID_CV: {
+      blender::bke::CurvesGeometry &curves = reinterpret_cast<Curves &>(id).geometry.wrap();
+      if (name == "position") {
+        curves.tag_positions_changed();
+      }
+      else if (name == "radius") {
+        curves.tag_radii_changed();
+      }
+      else if (name == "material_index") {
+        curves.tag_material_index_changed();
+      }
+      else {
+        curves.tag_topology_changed();
+      }
+      break;
+    }
+    case ID_PT: {
+      PointCloud &pointcloud = reinterpret_cast<PointCloud &>(id);
+      if (name == "position") {
+        pointcloud.tag_positions_changed();
+      }
+      else if (name == "radius") {
+        pointcloud.tag_radii_changed();
+      }
+      break;
+    }
+    default:
+      break;
+  }
+  DEG_id_tag_update(&id, 0);
+  WM_main_add_notifier(NC_GEOM | ND_DATA, &id);
+}
+
+static Py_ssize_t bpy_attribute_buffer_len(const BPy_AttributeBuffer *self)
+{
+  Py_ssize_t len = self->itemsize;
+  for (int i = 0; i < self->ndim; i++) {
+    len *= self->shape[i];
+  }
+  return len;
+}
+
+/**
+ * Copy the values of a writable buffer to the original data-block, unless it was freed or the
+ * attribute was removed or resized in the meantime.
+ */
+static void bpy_attribute_buffer_write_back(BPy_AttributeBuffer *self)
+{
+  const int size = int(self->shape[0]);
+  if (size == 0 || !PYRNA_STRUCT_IS_VALID(self->py_id)) {
+    return;
+  }
+  ID &id = *reinterpret_cast<BPy_StructRNA *>(self->py_id)->ptr->owner_id;
+
+  void *dst = nullptr;
+  if (self->name[0] == '\0') {
+    switch (GS(id.name)) {
+      case ID_ME: {
+        Mesh &mesh = reinterpret_cast<Mesh &>(id);
+        if (mesh.faces_num + 1 == size) {
+          dst = mesh.face_offsets_for_write().data();
+        }
+        break;
+      }
+      case ID_CV: {
+        blender::bke::CurvesGeometry &curves = reinterpret_cast<Curves &>(id).geometry.wrap();
+        if (curves.curves_num() + 1 == size) {
+          dst = curves.offsets_for_write().data();
+        }
+        break;
+      }
+      default:
+        break;
+    }
+  }
+  else {
+    AttributeOwner owner = AttributeOwner::from_id(&id);
+    CustomDataLayer *layer = BKE_attribute_find(owner, self->name, self->type, self->domain);
+    if (layer && layer->data && BKE_attribute_data_length(owner, layer) == size) {
+      CustomData_ensure_data_is_mutable(layer, size);
+      dst = layer->data;
+    }
+  }
+  if (dst == nullptr) {
+    return;
+  }
+  memcpy(dst, self->data, size_t(bpy_attribute_buffer_len(self)));
+  bpy_attribute_buffer_tag_changed(id, self->name);
+}
+
+static int bpy_attribute_buffer__bf_getbuffer(BPy_AttributeBuffer *self,
+                                              Py_buffer *view,
+                                              int flags)
+{
+  if ((flags & PyBUF_WRITABLE) && !self->is_writable) {
+    PyErr_SetString(PyExc_BufferError, "Attribute buffer is read-only, use write=True");
+    return -1;
+  }
+
+  memset(view, 0, sizeof(*view));
+  view->obj = (PyObject *)self;
+  view->buf = self->data;
+  view->itemsize = self->itemsize;
+  view->len = bpy_attribute_buffer_len(self);
+  view->readonly = !self->is_writable;
+  if (flags & PyBUF_FORMAT) {
+    view->format = (char *)self->format;
+  }
+  if (flags & PyBUF_ND) {
+    view->ndim = self->ndim;
+    view->shape = self->shape;
+  }
+  if (flags & PyBUF_STRIDES) {
+    view->strides = self->strides;
+  }
+
+  self->exports_num++;
+  Py_INCREF(self);
+  return 0;
+}
+
+static void bpy_attribute_buffer__bf_releasebuffer(BPy_AttributeBuffer *self,
+                                                   Py_buffer * /*view*/)
+{
+  self->exports_num--;
+  if (self->is_writable && self->exports_num == 0) {
+    bpy_attribute_buffer_write_back(self);
+  }
+}
+
+static PyBufferProcs bpy_attribute_buffer__tp_as_buffer = {
+    /*bf_getbuffer*/ (getbufferproc)bpy_attribute_buffer__bf_getbuffer,
+    /*bf_releasebuffer*/ (releasebufferproc)bpy_attribute_buffer__bf_releasebuffer,
+};
+
+static void bpy_attribute_buffer_dealloc(BPy_AttributeBuffer *self)
+{
+  if (self->sharing_info) {
+    self->sharing_info->remove_user_and_delete_if_last();
+  }
+  if (self->is_writable && self->data != &bpy_attribute_buffer_empty_data) {
+    MEM_freeN(self->data);
+  }
+  Py_XDECREF(self->py_id);
+  PyObject_Del(self);
+}
+
+static PyTypeObject bpy_attribute_buffer_Type = {
+    /*ob_base*/ PyVarObject_HEAD_INIT(nullptr, 0)
+    /*tp_name*/ "bpy_attribute_buffer",
+    /*tp_basicsize*/ sizeof(BPy_AttributeBuffer),
+    /*tp_itemsize*/ 0,
+    /*tp_dealloc*/ (destructor)bpy_attribute_buffer_dealloc,
+    /*tp_vectorcall_offset*/ 0,
+    /*tp_getattr*/ nullptr,
+    /*tp_setattr*/ nullptr,
+    /*tp_as_async*/ nullptr,
+    /*tp_repr*/ nullptr,
+    /*tp_as_number*/ nullptr,
+    /*tp_as_sequence*/ nullptr,
+    /*tp_as_mapping*/ nullptr,
+    /*tp_hash*/ nullptr,
+    /*tp_call*/ nullptr,
+    /*tp_str*/ nullptr,
+    /*tp_getattro*/ nullptr,
+    /*tp_setattro*/ nullptr,
+    /*tp_as_buffer*/ &bpy_attribute_buffer__tp_as_buffer,
+    /*tp_flags*/ Py_TPFLAGS_DEFAULT,
+    /*tp_doc*/ nullptr,
+    /*tp_traverse*/ nullptr,
+    /*tp_clear*/ nullptr,
+    /*tp_richcompare*/ nullptr,
+    /*tp_weaklistoffset*/ 0,
+    /*tp_iter*/ nullptr,
+    /*tp_iternext*/ nullptr,
+    /*tp_methods*/ nullptr,
+    /*tp_members*/ nullptr,
+    /*tp_getset*/ nullptr,
+    /*tp_base*/ nullptr,
+    /*tp_dict*/ nullptr,
+    /*tp_descr_get*/ nullptr,
+    /*tp_descr_set*/ nullptr,
+    /*tp_dictoffset*/ 0,
+    /*tp_init*/ nullptr,
+    /*tp_alloc*/ nullptr,
+    /*tp_new*/ nullptr,
+    /*tp_free*/ nullptr,
+    /*tp_is_gc*/ nullptr,
+    /*tp_bases*/ nullptr,
+    /*tp_mro*/ nullptr,
+    /*tp_cache*/ nullptr,
+    /*tp_subclasses*/ nullptr,
+    /*tp_weaklist*/ nullptr,
+    /*tp_del*/ nullptr,
+    /*tp_version_tag*/ 0,
+    /*tp_finalize*/ nullptr,
+    /*tp_vectorcall*/ nullptr,
+};
+
+/**
+ * Create a `memoryview` of the array. A read-only buffer adds a user to the sharing info, a
+ * writable buffer copies the values.
+ */
+static PyObject *bpy_attribute_buffer_create(ID &id,
+                                             const char *name,
+                                             const eCustomDataType type,
+                                             const blender::bke::AttrDomain domain,
+                                             const void *data,
+                                             const ImplicitSharingInfo *sharing_info,
+                                             const char *format,
+                                             const Py_ssize_t itemsize,
+                                             const int ndim,
+                                             const Py_ssize_t *shape,
+                                             const bool is_writable)
+{
+  BLI_assert(ndim <= BPY_ATTRIBUTE_BUFFER_NDIM_MAX);
+  BPy_AttributeBuffer *self = PyObject_New(BPy_AttributeBuffer, &bpy_attribute_buffer_Type);
+  self->format = format;
+  self->itemsize = itemsize;
+  self->ndim = ndim;
+  /* Arrays are always contiguous. */
+  for (int i = ndim - 1; i >= 0; i--) {
+    self->shape[i] = shape[i];
+    self->strides[i] = (i == ndim - 1) ? itemsize : self->strides[i + 1] * shape[i + 1];
+  }
+  self->is_writable = is_writable;
+  self->exports_num = 0;
+  self->sharing_info = nullptr;
+  self->py_id = nullptr;
+  self->type = type;
+  self->domain = domain;
+  STRNCPY(self->name, name);
+
+  const Py_ssize_t len = bpy_attribute_buffer_len(self);
+  if (len == 0) {
+    self->data = &bpy_attribute_buffer_empty_data;
+  }
+  else if (is_writable) {
+    self->data = MEM_mallocN(size_t(len), __func__);
+    memcpy(self->data, data, size_t(len));
+    self->py_id = pyrna_id_CreatePyObject(&id);
+  }
+  else {
+    self->data = const_cast<void *>(data);
+    self->sharing_info = sharing_info;
+    if (sharing_info) {
+      sharing_info->add_user();
+    }
+  }
+
+  PyObject *ret = PyMemoryView_FromObject((PyObject *)self);
+  Py_DECREF(self);
+  return ret;
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Utilities
+ * \{ */
+
+/**
+ * Get the data-block of the geometry, checking whether it can be written to.
+ */
+static ID *bpy_rna_geometry_id_get(BPy_StructRNA *self, const bool write, const char *error_prefix)
+{
+  ID *id = self->ptr->owner_id;
+  if (!ELEM(GS(id->name), ID_ME, ID_CV, ID_PT)) {
+    PyErr_Format(PyExc_TypeError,
+                 "%s: only supported for mesh, curves and point cloud data, not %s",
+                 error_prefix,
+                 BKE_idtype_idcode_to_name(GS(id->name)));
+    return nullptr;
+  }
+  if (write) {
+    if (!pyrna_write_check()) {
+      PyErr_Format(PyExc_AttributeError,
+                   "%s: writing to ID classes in this context is not allowed",
+                   error_prefix);
+      return nullptr;
+    }
+    if (!ID_IS_EDITABLE(id) || (id->tag & ID_TAG_COPIED_ON_EVAL)) {
+      PyErr_Format(PyExc_RuntimeError,
+                   "%s: data-block '%s' is not editable",
+                   error_prefix,
+                   id->name + 2);
+      return nullptr;
+    }
+  }
+  return id;
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Attribute Buffer API
+ * \{ */
+
+PyDoc_STRVAR(
+    /* Wrap. */
+    bpy_rna_attribute_as_buffer_doc,
+    ".. method:: as_buffer(*, write=False)\n"
+    "\n"
+    "   Access the attribute values, a read-only buffer does not copy them. The buffer has "
+    "one row per element, vector, color and matrix attributes have additional dimensions. "
+    "String attributes are not supported.\n"
+    "\n"
+    "   Changes to the geometry that are made while a read-only buffer is referenced are not "
+    "visible in the buffer, since the array is copied before the geometry is changed. "
+    "The original array stays valid as long as the buffer is referenced.\n"
+    "\n"
+    "   :arg write: Make the buffer writable. Unlike a read-only buffer, a writable buffer "
+    "copies the values when it is created. The copy is written to the attribute and tagged "
+    "for update once the buffer is released, for example at the end of a ``with`` statement. "
+    "Changes made to the attribute in other ways while the buffer is referenced are "
+    "overwritten. The values are dropped when the data-block is freed or the attribute is "
+    "removed or resized before the buffer is released.\n"
+    "   :type write: bool\n"
+    "   :return: Buffer which is compatible with NumPy.\n"
+    "   :rtype: memoryview\n");
+static PyObject *bpy_rna_attribute_as_buffer(PyObject *self, PyObject *args, PyObject *kw)
+{
+  BPy_StructRNA *pyrna = (BPy_StructRNA *)self;
+  PYRNA_STRUCT_CHECK_OBJ(pyrna);
+
+  bool write = false;
+  static const char *_keywords[] = {"write", nullptr};
+  static _PyArg_Parser _parser = {
+      PY_ARG_PARSER_HEAD_COMPAT()
+      "|$" /* Optional keyword only arguments. */
+      "O&" /* `write` */
+      ":as_buffer",
+      _keywords,
+      nullptr,
+  };
+  if (!_PyArg_ParseTupleAndKeywordsFast(args, kw, &_parser, PyC_ParseBool, &write)) {
+    return nullptr;
+  }
+
+  ID *id = bpy_rna_geometry_id_get(pyrna, write, "as_buffer");
+  if (id == nullptr) {
+    return nullptr;
+  }
+  CustomDataLayer *layer = static_cast<CustomDataLayer *>(pyrna->ptr->data);
+  AttributeOwner owner = AttributeOwner::from_id(id);
+  const int length = BKE_attribute_data_length(owner, layer);
+  if (layer->data == nullptr && length > 0) {
+    PyErr_SetString(PyExc_RuntimeError,
+                    "as_buffer: attribute data is not available, the mesh may be in edit-mode");
+    return nullptr;
+  }
+
+  const char *format;
+  Py_ssize_t itemsize;
+  Py_ssize_t shape[BPY_ATTRIBUTE_BUFFER_NDIM_MAX] = {length, 0, 0};
+  int ndim = 1;
+  switch (eCustomDataType(layer->type)) {
+    case CD_PROP_FLOAT:
+      format = "f";
+      itemsize = sizeof(float);
+      break;
+    case CD_PROP_FLOAT2:
+      format = "f";
+      itemsize = sizeof(float);
+      shape[ndim++] = 2;
+      break;
+    case CD_PROP_FLOAT3:
+      format = "f";
+      itemsize = sizeof(float);
+      shape[ndim++] = 3;
+      break;
+    case CD_PROP_COLOR:
+    case CD_PROP_QUATERNION:
+      format = "f";
+      itemsize = sizeof(float);
+      shape[ndim++] = 4;
+      break;
+    case CD_PROP_FLOAT4X4:
+      format = "f";
+      itemsize = sizeof(float);
+      shape[ndim++] = 4;
+      shape[ndim++] = 4;
+      break;
+    case CD_PROP_INT32:
+      format = "i";
+      itemsize = sizeof(int32_t);
+      break;
+    case CD_PROP_INT32_2D:
+      format = "i";
+      itemsize = sizeof(int32_t);
+      shape[ndim++] = 2;
+      break;
+    case CD_PROP_INT16_2D:
+      format = "h";
+      itemsize = sizeof(int16_t);
+      shape[ndim++] = 2;
+      break;
+    case CD_PROP_INT8:
+      format = "b";
+      itemsize = sizeof(int8_t);
+      break;
+    case CD_PROP_BYTE_COLOR:
+      format = "B";
+      itemsize = sizeof(uint8_t);
+      shape[ndim++] = 4;
+      break;
+    case CD_PROP_BOOL:
+      format = "?";
+      itemsize = sizeof(bool);
+      break;
+    default:
+      PyErr_Format(PyExc_TypeError,
+                   "as_buffer: attribute '%s' of this type is not supported",
+                   layer->name);
+      return nullptr;
+  }
+
+  return bpy_attribute_buffer_create(*id,
+                                     layer->name,
+                                     eCustomDataType(layer->type),
+                                     BKE_attribute_domain(owner, layer),
+                                     layer->data,
+                                     layer->sharing_info,
+                                     format,
+                                     itemsize,
+                                     ndim,
+                                     shape,
+                                     write);
+}
+
+PyDoc_STRVAR(
+    /* Wrap. */
+    bpy_rna_geometry_offsets_as_buffer_doc,
+    ".. method:: offsets_as_buffer(*, write=False)\n"
+    "\n"
+    "   Access the offsets into the corners of faces or into the points of curves, a "
+    "read-only buffer does not copy them. The buffer has one more value than the number of "
+    "faces or curves, the last value is the total number of corners or points.\n"
+    "\n"
+    "   :arg write: Make the buffer writable, see :meth:`bpy.types.Attribute.as_buffer`.\n"
+    "   :type write: bool\n"
+    "   :return: Buffer of 32-bit integers which is compatible with NumPy.\n"
+    "   :rtype: memoryview\n");
+static PyObject *bpy_rna_geometry_offsets_as_buffer(PyObject *self, PyObject *args, PyObject *kw)
+{
+  BPy_StructRNA *pyrna = (BPy_StructRNA *)self;
+  PYRNA_STRUCT_CHECK_OBJ(pyrna);
+
+  bool write = false;
+  static const char *_keywords[] = {"write", nullptr};
+  static _PyArg_Parser _parser = {
+      PY_ARG_PARSER_HEAD_COMPAT()
+      "|$" /* Optional keyword only arguments. */
+      "O&" /* `write` */
+      ":offsets_as_buffer",
+      _keywords,
+      nullptr,
+  };
+  if (!_PyArg_ParseTupleAndKeywordsFast(args, kw, &_parser, PyC_ParseBool, &write)) {
+    return nullptr;
+  }
+
+  ID *id = bpy_rna_geometry_id_get(pyrna, write, "offsets_as_buffer");
+  if (id == nullptr) {
+    return nullptr;
+  }
+
+  const int *data = nullptr;
+  const ImplicitSharingInfo *sharing_info = nullptr;
+  int size = 0;
+  switch (GS(id->name)) {
+    case ID_ME: {
+      Mesh *mesh = reinterpret_cast<Mesh *>(id);
+      if (mesh->faces_num > 0) {
+        data = mesh->face_offset_indices;
+        sharing_info = mesh->runtime->face_offsets_sharing_info;
+        size = mesh->faces_num + 1;
+      }
+      break;
+    }
+    case ID_CV: {
+      blender::bke::CurvesGeometry &curves = reinterpret_cast<Curves *>(id)->geometry.wrap();
+      if (curves.curves_num() > 0) {
+        data = curves.curve_offsets;
+        sharing_info = curves.runtime->curve_offsets_sharing_info;
+        size = curves.curves_num() + 1;
+      }
+      break;
+    }
+    default:
+      PyErr_SetString(PyExc_TypeError, "offsets_as_buffer: geometry has no offsets");
+      return nullptr;
+  }
+
+  const Py_ssize_t shape[1] = {size};
+  return bpy_attribute_buffer_create(*id,
+                                     "",
+                                     CD_PROP_INT32,
+                                     blender::bke::AttrDomain::Auto,
+                                     data,
+                                     sharing_info,
+                                     "i",
+                                     sizeof(int),
+                                     1,
+                                     shape,
+                                     write);
+}
+
+#if (defined(__GNUC__) && !defined(__clang__))
+#  pragma GCC diagnostic push
+#  pragma GCC diagnostic ignored "-Wcast-function-type"
+#endif
+
+PyMethodDef BPY_rna_attribute_as_buffer_method_def = {
+    "as_buffer",
+    (PyCFunction)bpy_rna_attribute_as_buffer,
+    METH_VARARGS | METH_KEYWORDS,
+    bpy_rna_attribute_as_buffer_doc,
+};
+
+PyMethodDef BPY_rna_geometry_offsets_as_buffer_method_def = {
+    "offsets_as_buffer",
+    (PyCFunction)bpy_rna_geometry_offsets_as_buffer,
+    METH_VARARGS | METH_KEYWORDS,
+    bpy_rna_geometry_offsets_as_buffer_doc,
+};
+
+#if (defined(__GNUC__) && !defined(__clang__))
+#  pragma GCC diagnostic pop
+#endif
+
+int BPY_rna_attribute_buffer_type_ready()
+{
+  if (PyType_Ready(&bpy_attribute_buffer_Type) < 0) {
+    return -1;
+  }
+
+  return 0;
+}
+
+/** \} */
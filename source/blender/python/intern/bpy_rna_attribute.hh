@@ -0,0 +1,16 @@
+/* SPDX-FileCopyrightText: 2025 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup pythonintern
+ */
+
+#pragma once
+
+#include <Python.h>
+
+int BPY_rna_attribute_buffer_type_ready();
+
+extern PyMethodDef BPY_rna_attribute_as_buffer_method_def;
+extern PyMethodDef BPY_rna_geometry_offsets_as_buffer_method_def;
@@ -21,6 +21,7 @@
 
 #include "bpy_library.hh"
 #include "bpy_rna.hh"
+#include "bpy_rna_attribute.hh"
 #include "bpy_rna_callback.hh"
 #include "bpy_rna_context.hh"
 #include "bpy_rna_data.hh"
@@ -66,6 +67,27 @@ static PyMethodDef pyrna_blenddatalibraries_methods[] = {
 
 /** \} */
 
+/* -------------------------------------------------------------------- */
+/** \name Geometry Attributes
+ * \{ */
+
+static PyMethodDef pyrna_attribute_methods[] = {
+    {nullptr, nullptr, 0, nullptr}, /* #BPY_rna_attribute_as_buffer_method_def */
+    {nullptr, nullptr, 0, nullptr},
+};
+
+static PyMethodDef pyrna_mesh_methods[] = {
+    {nullptr, nullptr, 0, nullptr}, /* #BPY_rna_geometry_offsets_as_buffer_method_def */
+    {nullptr, nullptr, 0, nullptr},
+};
+
+static PyMethodDef pyrna_curves_methods[] = {
+    {nullptr, nullptr, 0, nullptr}, /* #BPY_rna_geometry_offsets_as_buffer_method_def */
+    {nullptr, nullptr, 0, nullptr},
+};
+
+/** \} */
+
 /* -------------------------------------------------------------------- */
 /** \name UI Layout
  * \{ */
@@ -292,6 +314,19 @@ void BPY_rna_types_extend_capi()
   pyrna_struct_type_extend_capi(
       &RNA_BlendDataLibraries, pyrna_blenddatalibraries_methods, nullptr);
 
+  /* Geometry Attributes */
+  ARRAY_SET_ITEMS(pyrna_attribute_methods, BPY_rna_attribute_as_buffer_method_def);
+  BLI_STATIC_ASSERT(ARRAY_SIZE(pyrna_attribute_methods) == 2, "Unexpected number of methods")
+  pyrna_struct_type_extend_capi(&RNA_Attribute, pyrna_attribute_methods, nullptr);
+
+  ARRAY_SET_ITEMS(pyrna_mesh_methods, BPY_rna_geometry_offsets_as_buffer_method_def);
+  BLI_STATIC_ASSERT(ARRAY_SIZE(pyrna_mesh_methods) == 2, "Unexpected number of methods")
+  pyrna_struct_type_extend_capi(&RNA_Mesh, pyrna_mesh_methods, nullptr);
+
+  ARRAY_SET_ITEMS(pyrna_curves_methods, BPY_rna_geometry_offsets_as_buffer_method_def);
+  BLI_STATIC_ASSERT(ARRAY_SIZE(pyrna_curves_methods) == 2, "Unexpected number of methods")
+  pyrna_struct_type_extend_capi(&RNA_Curves, pyrna_curves_methods, nullptr);
+
   /* uiLayout */
   ARRAY_SET_ITEMS(pyrna_uilayout_methods, BPY_rna_uilayout_introspect_method_def);
   BLI_STATIC_ASSERT(ARRAY_SIZE(pyrna_uilayout_methods) == 2, "Unexpected number of methods")
@@ -14,6 +14,7 @@
 #include "DNA_object_types.h"
 #include "DNA_scene_types.h"
 
+#include "BLI_array.hh"
 #include "BLI_linklist.h"
 #include "BLI_math_geom.h"
 #include "BLI_math_vector.h"
@@ -22,7 +23,7 @@
 
 #include "BKE_cloth.hh"
 #include "BKE_collision.h"
-#include "BKE_effect.h"
+#include "BKE_effect.hh"
 
 #include "SIM_mass_spring.h"
 #include "implicit.h"
@@ -706,20 +707,21 @@ static void cloth_calc_force(
                                                  "effector forces");
     float(*forcevec)[3] = is_not_hair ? winvec + mvert_num : winvec;
 
-    for (i = 0; i < cloth->mvert_num; i++) {
-      float x[3], v[3];
-      EffectedPoint epoint;
-
-      SIM_mass_spring_get_motion_state(data, i, x, v);
-      pd_point_from_loc(scene, x, v, i, &epoint);
-      BKE_effectors_apply(effectors,
-                          nullptr,
-                          clmd->sim_parms->effector_weights,
-                          &epoint,
-                          forcevec[i],
-                          winvec[i],
-                          nullptr);
+    blender::Array<blender::float3> positions(mvert_num);
+    blender::Array<blender::float3> velocities(mvert_num);
+    for (i = 0; i < mvert_num; i++) {
+      SIM_mass_spring_get_motion_state(data, i, positions[i], velocities[i]);
+    }
+    BKE_effectors_apply_array(effectors,
+                              nullptr,
+                              clmd->sim_parms->effector_weights,
+                              scene,
+                              positions,
+                              velocities,
+                              {reinterpret_cast<blender::float3 *>(forcevec), mvert_num},
+                              {reinterpret_cast<blender::float3 *>(winvec), mvert_num});
 
+    for (i = 0; i < mvert_num; i++) {
       has_wind = has_wind || !is_zero_v3(winvec[i]);
       has_force = has_force || !is_zero_v3(forcevec[i]);
     }
@@ -12,9 +12,12 @@
 
 #  include "MEM_guardedalloc.h"
 
+#  include "BLI_array.hh"
 #  include "BLI_math_geom.h"
 #  include "BLI_math_matrix.h"
 #  include "BLI_math_vector.h"
+#  include "BLI_offset_indices.hh"
+#  include "BLI_task.hh"
 
 #  include "BKE_cloth.hh"
 
@@ -24,9 +27,13 @@
 #    pragma GCC diagnostic ignored "-Wtype-limits"
 #  endif
 
-#  ifdef _OPENMP
-#    define CLOTH_OPENMP_LIMIT 512
-#  endif
+using blender::Array;
+using blender::IndexRange;
+using blender::OffsetIndices;
+namespace threading = blender::threading;
+
+/* Number of vertices processed by a task in parallel long vector and matrix operations. */
+static constexpr int64_t LFVECTOR_GRAIN_SIZE = 4096;
 
 // #define DEBUG_TIME
 
@@ -134,10 +141,11 @@ DO_INLINE void cp_lfvector(float (*to)[3], float (*from)[3], uint verts)
 /* init long vector with float[3] */
 DO_INLINE void init_lfvector(float (*fLongVector)[3], const float vector[3], uint verts)
 {
-  uint i = 0;
-  for (i = 0; i < verts; i++) {
-    copy_v3_v3(fLongVector[i], vector);
-  }
+  threading::parallel_for(IndexRange(verts), LFVECTOR_GRAIN_SIZE, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      copy_v3_v3(fLongVector[i], vector);
+    }
+  });
 }
 /* zero long vector with float[3] */
 DO_INLINE void zero_lfvector(float (*to)[3], uint verts)
@@ -147,33 +155,44 @@ DO_INLINE void zero_lfvector(float (*to)[3], uint verts)
 /* Multiply long vector with scalar. */
 DO_INLINE void mul_lfvectorS(float (*to)[3], float (*fLongVector)[3], float scalar, uint verts)
 {
-  uint i = 0;
-
-  for (i = 0; i < verts; i++) {
-    mul_fvector_S(to[i], fLongVector[i], scalar);
-  }
+  threading::parallel_for(IndexRange(verts), LFVECTOR_GRAIN_SIZE, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      mul_fvector_S(to[i], fLongVector[i], scalar);
+    }
+  });
 }
 /* Multiply long vector with scalar.
  * `A -= B * float` */
 DO_INLINE void submul_lfvectorS(float (*to)[3], float (*fLongVector)[3], float scalar, uint verts)
 {
-  uint i = 0;
-  for (i = 0; i < verts; i++) {
-    VECSUBMUL(to[i], fLongVector[i], scalar);
-  }
+  threading::parallel_for(IndexRange(verts), LFVECTOR_GRAIN_SIZE, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      VECSUBMUL(to[i], fLongVector[i], scalar);
+    }
+  });
 }
 /* dot product for big vector */
 DO_INLINE float dot_lfvector(float (*fLongVectorA)[3], float (*fLongVectorB)[3], uint verts)
 {
-  long i = 0;
-  float temp = 0.0;
-  /* XXX brecht, disabled this for now (first schedule line was already disabled),
-   * due to non-commutative nature of floating point ops this makes the sim give
-   * different results each time you run it!
-   * schedule(guided, 2) */
-  // #pragma omp parallel for reduction(+: temp) if (verts > CLOTH_OPENMP_LIMIT)
-  for (i = 0; i < long(verts); i++) {
-    temp += dot_v3v3(fLongVectorA[i], fLongVectorB[i]);
+  /* Floating point addition is not associative, so a reduction in the order in which threads
+   * finish would give the simulation different results every time it runs. Instead the partial
+   * sums of fixed size chunks are added in order, which only depends on the vertex count. */
+  const int64_t chunks_num = int64_t(divide_ceil_ul(verts, LFVECTOR_GRAIN_SIZE));
+  Array<float, 64> chunk_sums(chunks_num);
+  threading::parallel_for(IndexRange(chunks_num), 1, [&](const IndexRange range) {
+    for (const int64_t chunk : range) {
+      const int64_t start = chunk * LFVECTOR_GRAIN_SIZE;
+      const IndexRange verts_range(start, std::min<int64_t>(LFVECTOR_GRAIN_SIZE, verts - start));
+      float temp = 0.0f;
+      for (const int64_t i : verts_range) {
+        temp += dot_v3v3(fLongVectorA[i], fLongVectorB[i]);
+      }
+      chunk_sums[chunk] = temp;
+    }
+  });
+  float temp = 0.0f;
+  for (const float chunk_sum : chunk_sums) {
+    temp += chunk_sum;
   }
   return temp;
 }
@@ -183,21 +202,21 @@ DO_INLINE void add_lfvector_lfvector(float (*to)[3],
                                      float (*fLongVectorB)[3],
                                      uint verts)
 {
-  uint i = 0;
-
-  for (i = 0; i < verts; i++) {
-    add_v3_v3v3(to[i], fLongVectorA[i], fLongVectorB[i]);
-  }
+  threading::parallel_for(IndexRange(verts), LFVECTOR_GRAIN_SIZE, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      add_v3_v3v3(to[i], fLongVectorA[i], fLongVectorB[i]);
+    }
+  });
 }
 /* `A = B + C * float` -> for big vector. */
 DO_INLINE void add_lfvector_lfvectorS(
     float (*to)[3], float (*fLongVectorA)[3], float (*fLongVectorB)[3], float bS, uint verts)
 {
-  uint i = 0;
-
-  for (i = 0; i < verts; i++) {
-    VECADDS(to[i], fLongVectorA[i], fLongVectorB[i], bS);
-  }
+  threading::parallel_for(IndexRange(verts), LFVECTOR_GRAIN_SIZE, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      VECADDS(to[i], fLongVectorA[i], fLongVectorB[i], bS);
+    }
+  });
 }
 /* `A = B * float + C * float` -> for big vector */
 DO_INLINE void add_lfvectorS_lfvectorS(float (*to)[3],
@@ -207,20 +226,21 @@ DO_INLINE void add_lfvectorS_lfvectorS(float (*to)[3],
                                        float bS,
                                        uint verts)
 {
-  uint i = 0;
-
-  for (i = 0; i < verts; i++) {
-    VECADDSS(to[i], fLongVectorA[i], aS, fLongVectorB[i], bS);
-  }
+  threading::parallel_for(IndexRange(verts), LFVECTOR_GRAIN_SIZE, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      VECADDSS(to[i], fLongVectorA[i], aS, fLongVectorB[i], bS);
+    }
+  });
 }
 /* `A = B - C * float` -> for big vector. */
 DO_INLINE void sub_lfvector_lfvectorS(
     float (*to)[3], float (*fLongVectorA)[3], float (*fLongVectorB)[3], float bS, uint verts)
 {
-  uint i = 0;
-  for (i = 0; i < verts; i++) {
-    VECSUBS(to[i], fLongVectorA[i], fLongVectorB[i], bS);
-  }
+  threading::parallel_for(IndexRange(verts), LFVECTOR_GRAIN_SIZE, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      VECSUBS(to[i], fLongVectorA[i], fLongVectorB[i], bS);
+    }
+  });
 }
 /* `A = B - C` -> for big vector. */
 DO_INLINE void sub_lfvector_lfvector(float (*to)[3],
@@ -228,11 +248,11 @@ DO_INLINE void sub_lfvector_lfvector(float (*to)[3],
                                      float (*fLongVectorB)[3],
                                      uint verts)
 {
-  uint i = 0;
-
-  for (i = 0; i < verts; i++) {
-    sub_v3_v3v3(to[i], fLongVectorA[i], fLongVectorB[i]);
-  }
+  threading::parallel_for(IndexRange(verts), LFVECTOR_GRAIN_SIZE, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      sub_v3_v3v3(to[i], fLongVectorA[i], fLongVectorB[i]);
+    }
+  });
 }
 ///////////////////////////
 // 3x3 matrix
@@ -574,35 +594,93 @@ DO_INLINE void initdiag_bfmatrix(fmatrix3x3 *matrix, float m3[3][3])
   }
 }
 
-/* SPARSE SYMMETRIC multiply big matrix with long vector. */
-/* STATUS: verified */
-DO_INLINE void mul_bfmatrix_lfvector(float (*to)[3], fmatrix3x3 *from, lfVector *fLongVector)
+/**
+ * The off-diagonal blocks of a sparse symmetric matrix grouped by row, so that the rows of a
+ * matrix-vector product can be computed independently. The matrices store each pair of connected
+ * vertices only once, in the lower triangle, so every block also contributes to the row of its
+ * column in transposed form.
+ */
+struct BlockRows {
+  /** Off-diagonal blocks with their row index matching the row, in block order. */
+  Array<int> offsets;
+  Array<int> blocks;
+  /** Off-diagonal blocks with their column index matching the row, in block order. */
+  Array<int> transposed_offsets;
+  Array<int> transposed_blocks;
+};
+
+static void group_blocks_by_vertex(const fmatrix3x3 *matrix,
+                                   const int num_blocks,
+                                   const bool use_column,
+                                   Array<int> &r_offsets,
+                                   Array<int> &r_blocks)
 {
-  uint vcount = from[0].vcount;
-  lfVector *temp = create_lfvector(vcount);
+  const uint vcount = matrix[0].vcount;
+  const IndexRange blocks_range(vcount, num_blocks);
+  r_offsets.reinitialize(vcount + 1);
+  r_offsets.fill(0);
+  for (const int64_t block : blocks_range) {
+    r_offsets[use_column ? matrix[block].c : matrix[block].r]++;
+  }
+  const OffsetIndices<int> offsets = blender::offset_indices::accumulate_counts_to_offsets(
+      r_offsets);
+  r_blocks.reinitialize(offsets.total_size());
+  Array<int> fill_counts(vcount, 0);
+  /* Keep the block order in every row, so that results don't depend on the grouping. */
+  for (const int64_t block : blocks_range) {
+    const uint vert = use_column ? matrix[block].c : matrix[block].r;
+    r_blocks[offsets[vert][fill_counts[vert]++]] = int(block);
+  }
+}
 
-  zero_lfvector(to, vcount);
+static void build_block_rows(const fmatrix3x3 *matrix, const int num_blocks, BlockRows &rows)
+{
+  group_blocks_by_vertex(matrix, num_blocks, false, rows.offsets, rows.blocks);
+  group_blocks_by_vertex(
+      matrix, num_blocks, true, rows.transposed_offsets, rows.transposed_blocks);
+}
 
-#  pragma omp parallel sections if (vcount > CLOTH_OPENMP_LIMIT)
-  {
-#  pragma omp section
-    {
-      for (uint i = from[0].vcount; i < from[0].vcount + from[0].scount; i++) {
-        /* This is the lower triangle of the sparse matrix,
-         * therefore multiplication occurs with transposed sub-matrices. */
-        muladd_fmatrixT_fvector(to[from[i].c], from[i].m, fLongVector[from[i].r]);
-      }
-    }
-#  pragma omp section
-    {
-      for (uint i = 0; i < from[0].vcount + from[0].scount; i++) {
-        muladd_fmatrix_fvector(temp[from[i].r], from[i].m, fLongVector[from[i].c]);
-      }
-    }
-  }
-  add_lfvector_lfvector(to, to, temp, from[0].vcount);
+/* SPARSE SYMMETRIC multiply big matrix with long vector. */
+/* STATUS: verified */
+DO_INLINE void mul_bfmatrix_lfvector(float (*to)[3],
+                                     const fmatrix3x3 *from,
+                                     const BlockRows &rows,
+                                     lfVector *fLongVector)
+{
+  const OffsetIndices<int> offsets(rows.offsets);
+  const OffsetIndices<int> transposed_offsets(rows.transposed_offsets);
+  /* Every row sums its blocks in the same order as a serial loop over all blocks would. */
+  threading::parallel_for(
+      IndexRange(from[0].vcount), LFVECTOR_GRAIN_SIZE / 4, [&](const IndexRange range) {
+        for (const int64_t row : range) {
+          float transposed_sum[3] = {0.0f, 0.0f, 0.0f};
+          for (const int block : rows.transposed_blocks.as_span().slice(transposed_offsets[row]))
+          {
+            /* This is the lower triangle of the sparse matrix,
+             * therefore multiplication occurs with transposed sub-matrices. */
+            muladd_fmatrixT_fvector(transposed_sum, from[block].m, fLongVector[from[block].r]);
+          }
+          float sum[3] = {0.0f, 0.0f, 0.0f};
+          muladd_fmatrix_fvector(sum, from[row].m, fLongVector[row]);
+          for (const int block : rows.blocks.as_span().slice(offsets[row])) {
+            muladd_fmatrix_fvector(sum, from[block].m, fLongVector[from[block].c]);
+          }
+          add_v3_v3v3(to[row], transposed_sum, sum);
+        }
+      });
+}
 
-  del_lfvector(temp);
+/* Multiply the diagonal blocks of a big matrix with a long vector. */
+DO_INLINE void mul_diag_bfmatrix_lfvector(float (*to)[3],
+                                          const fmatrix3x3 *from,
+                                          lfVector *fLongVector)
+{
+  threading::parallel_for(
+      IndexRange(from[0].vcount), LFVECTOR_GRAIN_SIZE, [&](const IndexRange range) {
+        for (const int64_t i : range) {
+          mul_v3_m3v3(to[i], from[i].m, fLongVector[i]);
+        }
+      });
 }
 
 /* SPARSE SYMMETRIC sub big matrix with big matrix. */
@@ -611,12 +689,13 @@ DO_INLINE void mul_bfmatrix_lfvector(float (*to)[3], fmatrix3x3 *from, lfVector
 DO_INLINE void subadd_bfmatrixS_bfmatrixS(
     fmatrix3x3 *to, fmatrix3x3 *from, float aS, fmatrix3x3 *matrix, float bS)
 {
-  uint i = 0;
-
-  /* process diagonal elements */
-  for (i = 0; i < matrix[0].vcount + matrix[0].scount; i++) {
-    subadd_fmatrixS_fmatrixS(to[i].m, from[i].m, aS, matrix[i].m, bS);
-  }
+  threading::parallel_for(IndexRange(matrix[0].vcount + matrix[0].scount),
+                          LFVECTOR_GRAIN_SIZE,
+                          [&](const IndexRange range) {
+                            for (const int64_t i : range) {
+                              subadd_fmatrixS_fmatrixS(to[i].m, from[i].m, aS, matrix[i].m, bS);
+                            }
+                          });
 }
 
 ///////////////////////////////////////////////////////////////////
@@ -734,11 +813,25 @@ BLI_INLINE void root_to_world_m3(Implicit_Data *data,
 
 DO_INLINE void filter(lfVector *V, fmatrix3x3 *S)
 {
-  uint i = 0;
+  threading::parallel_for(
+      IndexRange(S[0].vcount), LFVECTOR_GRAIN_SIZE, [&](const IndexRange range) {
+        for (const int64_t i : range) {
+          mul_m3_v3(S[i].m, V[S[i].r]);
+        }
+      });
+}
 
-  for (i = 0; i < S[0].vcount; i++) {
-    mul_m3_v3(S[i].m, V[S[i].r]);
-  }
+/* Block-Jacobi preconditioner: the inverse of every diagonal block of A. */
+static void build_block_jacobi_preconditioner(const fmatrix3x3 *lA, fmatrix3x3 *Pinv)
+{
+  threading::parallel_for(
+      IndexRange(lA[0].vcount), LFVECTOR_GRAIN_SIZE, [&](const IndexRange range) {
+        for (const int64_t i : range) {
+          if (!invert_m3_m3(Pinv[i].m, lA[i].m)) {
+            unit_m3(Pinv[i].m);
+          }
+        }
+      });
 }
 
 /* this version of the CG algorithm does not work very well with partial constraints
@@ -813,9 +906,11 @@ static int cg_filtered(lfVector *ldV, fmatrix3x3 *lA, lfVector *lB, lfVector *z,
 
 static int cg_filtered(lfVector *ldV,
                        fmatrix3x3 *lA,
+                       const BlockRows &rows,
                        lfVector *lB,
                        lfVector *z,
                        fmatrix3x3 *S,
+                       fmatrix3x3 *Pinv,
                        ImplicitSolverResult *result)
 {
   /* Solves for unknown X in equation AX=B */
@@ -829,7 +924,9 @@ static int cg_filtered(lfVector *ldV,
   lfVector *c = create_lfvector(numverts);
   lfVector *q = create_lfvector(numverts);
   lfVector *s = create_lfvector(numverts);
-  float bnorm2, delta_new, delta_old, delta_target, alpha;
+  float bnorm2, rnorm2, delta_new, delta_old, delta_target, alpha;
+
+  build_block_jacobi_preconditioner(lA, Pinv);
 
   cp_lfvector(ldV, z, numverts);
 
@@ -840,16 +937,19 @@ static int cg_filtered(lfVector *ldV,
   delta_target = conjgrad_epsilon * conjgrad_epsilon * bnorm2;
 
   /* r = filter(B - A * dV) */
-  mul_bfmatrix_lfvector(AdV, lA, ldV);
+  mul_bfmatrix_lfvector(AdV, lA, rows, ldV);
   sub_lfvector_lfvector(r, lB, AdV, numverts);
   filter(r, S);
 
   /* c = filter(P^-1 * r) */
-  cp_lfvector(c, r, numverts);
+  mul_diag_bfmatrix_lfvector(c, Pinv, r);
   filter(c, S);
 
   /* delta = r^T * c */
   delta_new = dot_lfvector(r, c, numverts);
+  /* The tolerance is checked on the residual itself, which does not depend on the
+   * preconditioner. */
+  rnorm2 = dot_lfvector(r, r, numverts);
 
 #  ifdef IMPLICIT_PRINT_SOLVER_INPUT_OUTPUT
   printf("==== A ====\n");
@@ -862,8 +962,8 @@ static int cg_filtered(lfVector *ldV,
   print_bfmatrix(S);
 #  endif
 
-  while (delta_new > delta_target && conjgrad_loopcount < conjgrad_looplimit) {
-    mul_bfmatrix_lfvector(q, lA, c);
+  while (rnorm2 > delta_target && conjgrad_loopcount < conjgrad_looplimit) {
+    mul_bfmatrix_lfvector(q, lA, rows, c);
     filter(q, S);
 
     alpha = delta_new / dot_lfvector(c, q, numverts);
@@ -873,9 +973,10 @@ static int cg_filtered(lfVector *ldV,
     add_lfvector_lfvectorS(r, r, q, -alpha, numverts);
 
     /* s = P^-1 * r */
-    cp_lfvector(s, r, numverts);
+    mul_diag_bfmatrix_lfvector(s, Pinv, r);
     delta_old = delta_new;
     delta_new = dot_lfvector(r, s, numverts);
+    rnorm2 = dot_lfvector(r, r, numverts);
 
     add_lfvector_lfvectorS(c, s, c, delta_new / delta_old, numverts);
     filter(c, S);
@@ -900,7 +1001,7 @@ static int cg_filtered(lfVector *ldV,
   result->status = conjgrad_loopcount < conjgrad_looplimit ? SIM_SOLVER_SUCCESS :
                                                              SIM_SOLVER_NO_CONVERGENCE;
   result->iterations = conjgrad_loopcount;
-  result->error = bnorm2 > 0.0f ? sqrtf(delta_new / bnorm2) : 0.0f;
+  result->error = bnorm2 > 0.0f ? sqrtf(rnorm2 / bnorm2) : 0.0f;
 
   /* True means we reached desired accuracy in given time - ie stable. */
   return conjgrad_loopcount < conjgrad_looplimit;
@@ -1123,7 +1224,11 @@ bool SIM_mass_spring_solve_velocities(Implicit_Data *data, float dt, ImplicitSol
 
   subadd_bfmatrixS_bfmatrixS(data->A, data->dFdV, dt, data->dFdX, (dt * dt));
 
-  mul_bfmatrix_lfvector(dFdXmV, data->dFdX, data->V);
+  /* All matrices share the same sparsity pattern. */
+  BlockRows rows;
+  build_block_rows(data->A, data->num_blocks, rows);
+
+  mul_bfmatrix_lfvector(dFdXmV, data->dFdX, rows, data->V);
 
   add_lfvectorS_lfvectorS(data->B, data->F, dt, dFdXmV, (dt * dt), numverts);
 
@@ -1132,7 +1237,7 @@ bool SIM_mass_spring_solve_velocities(Implicit_Data *data, float dt, ImplicitSol
 #  endif
 
   /* Conjugate gradient algorithm to solve Ax=b. */
-  cg_filtered(data->dV, data->A, data->B, data->z, data->S, result);
+  cg_filtered(data->dV, data->A, rows, data->B, data->z, data->S, data->Pinv, result);
 
   // cg_filtered_pre(id->dV, id->A, id->B, id->z, id->S, id->P, id->Pinv, id->bigI);
 
@@ -83,6 +83,7 @@
 #include "BKE_scene.hh"
 #include "BKE_screen.hh"
 #include "BKE_sound.h"
+#include "BKE_subdiv.hh"
 #include "BKE_undo_system.hh"
 #include "BKE_workspace.hh"
 
@@ -530,6 +531,8 @@ static void wm_init_userdef(Main *bmain)
   const int64_t cache_limit = int64_t(U.memcachelimit) * 1024 * 1024;
   MEM_CacheLimiter_set_maximum(cache_limit);
   blender::memory_cache::set_approximate_size_limit(cache_limit);
+  blender::bke::subdiv::topology_refiner_cache_set_limit(int64_t(U.subdiv_cache_limit) * 1024 *
+                                                         1024);
 
   BKE_sound_init(bmain);
 
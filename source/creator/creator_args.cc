@@ -28,6 +28,7 @@
 #  include "BLI_string.h"
 #  include "BLI_string_utf8.h"
 #  include "BLI_system.h"
+#  include "BLI_task_trace.hh"
 #  include "BLI_threads.h"
 #  include "BLI_utildefines.h"
 #  ifndef NDEBUG
@@ -35,6 +36,7 @@
 #  endif
 
 #  include "BKE_appdir.hh"
+#  include "BKE_blender.hh"
 #  include "BKE_blender_cli_command.hh"
 #  include "BKE_blender_version.h"
 #  include "BKE_blendfile.hh"
@@ -59,6 +61,8 @@
 #    include "BPY_extern_run.hh"
 #  endif
 
+#  include "NOD_geometry_nodes_trace.hh"
+
 #  include "RE_engine.h"
 #  include "RE_pipeline.h"
 
@@ -751,6 +755,9 @@ static void print_help(bArgs *ba, bool all)
   BLI_args_print_arg_doc(ba, "--debug-depsgraph-time");
   BLI_args_print_arg_doc(ba, "--debug-depsgraph-pretty");
   BLI_args_print_arg_doc(ba, "--debug-depsgraph-uid");
+  BLI_args_print_arg_doc(ba, "--debug-depsgraph-validate");
+  BLI_args_print_arg_doc(ba, "--debug-geometry-nodes-trace");
+  BLI_args_print_arg_doc(ba, "--debug-task-trace");
   BLI_args_print_arg_doc(ba, "--debug-ghost");
   BLI_args_print_arg_doc(ba, "--debug-wintab");
   BLI_args_print_arg_doc(ba, "--debug-gpu");
@@ -1350,6 +1357,9 @@ static const char arg_handle_debug_mode_generic_set_doc_depsgraph_pretty[] =
 static const char arg_handle_debug_mode_generic_set_doc_depsgraph_uid[] =
     "\n\t"
     "Verify validness of session-wide identifiers assigned to ID data-blocks.";
+static const char arg_handle_debug_mode_generic_set_doc_depsgraph_validate[] =
+    "\n\t"
+    "Compare dependency graphs which were updated incrementally against a full rebuild.";
 static const char arg_handle_debug_mode_generic_set_doc_gpu_force_workarounds[] =
     "\n\t"
     "Enable workarounds for typical GPU issues and disable all GPU extensions.";
@@ -1442,6 +1452,60 @@ static int arg_handle_debug_value_set(int argc, const char **argv, void * /*data
   return 0;
 }
 
+static void geometry_nodes_trace_write_at_exit(void *user_data)
+{
+  const char *filepath = static_cast<const char *>(user_data);
+  blender::nodes::geo_eval_trace::end_recording();
+  if (!blender::nodes::geo_eval_trace::write_chrome_trace(filepath)) {
+    fprintf(stderr, "Error: could not write geometry nodes trace to '%s'.\n", filepath);
+  }
+}
+
+static const char arg_handle_debug_geometry_nodes_trace_set_doc[] =
+    "<filepath>\n"
+    "\tRecord the execution of every geometry node and zone iteration,\n"
+    "\tand write it to a Chrome trace JSON file on exit.";
+static int arg_handle_debug_geometry_nodes_trace_set(int argc,
+                                                     const char **argv,
+                                                     void * /*data*/)
+{
+  const char *arg_id = "--debug-geometry-nodes-trace";
+  if (argc > 1) {
+    blender::nodes::geo_eval_trace::begin_recording();
+    /* The arguments stay valid until exit. */
+    BKE_blender_atexit_register(geometry_nodes_trace_write_at_exit, (void *)argv[1]);
+    return 1;
+  }
+  fprintf(stderr, "\nError: '%s' no args given.\n", arg_id);
+  return 0;
+}
+
+static void task_trace_write_at_exit(void *user_data)
+{
+  const char *filepath = static_cast<const char *>(user_data);
+  blender::threading::trace::disable();
+  if (!blender::threading::trace::write_chrome_trace(filepath)) {
+    fprintf(stderr, "Error: could not write task trace to '%s'.\n", filepath);
+  }
+}
+
+static const char arg_handle_debug_task_trace_set_doc[] =
+    "<filepath>\n"
+    "\tRecord the tasks run by the task scheduler on every thread,\n"
+    "\tand write them to a Chrome trace JSON file on exit.";
+static int arg_handle_debug_task_trace_set(int argc, const char **argv, void * /*data*/)
+{
+  const char *arg_id = "--debug-task-trace";
+  if (argc > 1) {
+    blender::threading::trace::enable();
+    /* The arguments stay valid until exit. */
+    BKE_blender_atexit_register(task_trace_write_at_exit, (void *)argv[1]);
+    return 1;
+  }
+  fprintf(stderr, "\nError: '%s' no args given.\n", arg_id);
+  return 0;
+}
+
 static const char arg_handle_debug_gpu_set_doc[] =
     "\n"
     "\tEnable GPU debug context and information for OpenGL 4.3+.";
@@ -2792,6 +2856,12 @@ void main_args_setup(bContext *C, bArgs *ba, bool all)
   BLI_args_add(ba, nullptr, "--debug-memory", CB(arg_handle_debug_mode_memory_set), nullptr);
 
   BLI_args_add(ba, nullptr, "--debug-value", CB(arg_handle_debug_value_set), nullptr);
+  BLI_args_add(ba,
+               nullptr,
+               "--debug-geometry-nodes-trace",
+               CB(arg_handle_debug_geometry_nodes_trace_set),
+               nullptr);
+  BLI_args_add(ba, nullptr, "--debug-task-trace", CB(arg_handle_debug_task_trace_set), nullptr);
   BLI_args_add(ba,
                nullptr,
                "--debug-jobs",
@@ -2854,6 +2924,11 @@ void main_args_setup(bContext *C, bArgs *ba, bool all)
                "--debug-depsgraph-uid",
                CB_EX(arg_handle_debug_mode_generic_set, depsgraph_uid),
                (void *)G_DEBUG_DEPSGRAPH_UID);
+  BLI_args_add(ba,
+               nullptr,
+               "--debug-depsgraph-validate",
+               CB_EX(arg_handle_debug_mode_generic_set, depsgraph_validate),
+               (void *)G_DEBUG_DEPSGRAPH_VALIDATE);
   BLI_args_add(ba,
                nullptr,
                "--debug-gpu-force-workarounds",
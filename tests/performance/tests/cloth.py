@@ -0,0 +1,64 @@
+# SPDX-FileCopyrightText: 2025 Blender Authors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+import api
+
+
+def _run(args):
+    import bpy
+    import time
+
+    # Start from an empty scene, the benchmark does not need any file.
+    bpy.ops.wm.read_factory_settings(use_empty=True)
+    scene = bpy.context.scene
+
+    # A grid of about 100k vertices, pinned along one edge so the solver has constraints.
+    subdivisions = args['subdivisions']
+    bpy.ops.mesh.primitive_grid_add(
+        x_subdivisions=subdivisions,
+        y_subdivisions=subdivisions,
+        size=2.0,
+        location=(0, 0, 1),
+    )
+    ob = bpy.context.object
+    group = ob.vertex_groups.new(name="Pin")
+    group.add([v.index for v in ob.data.vertices if v.co.y > 0.999], 1.0, 'REPLACE')
+
+    md = ob.modifiers.new("Cloth", 'CLOTH')
+    md.settings.vertex_group_mass = group.name
+    md.settings.quality = 5
+    md.point_cache.frame_start = 1
+    md.point_cache.frame_end = args['frames']
+
+    scene.frame_start = 1
+    scene.frame_end = args['frames']
+
+    start_time = time.time()
+    for frame in range(scene.frame_start, scene.frame_end + 1):
+        scene.frame_set(frame)
+    elapsed_time = time.time() - start_time
+
+    result = {'time': elapsed_time / (scene.frame_end - scene.frame_start)}
+    return result
+
+
+class ClothTest(api.Test):
+    def __init__(self, subdivisions, frames):
+        self.subdivisions = subdivisions
+        self.frames = frames
+
+    def name(self):
+        return "cloth_grid_{}k".format(self.subdivisions * self.subdivisions // 1000)
+
+    def category(self):
+        return "cloth"
+
+    def run(self, env, device_id):
+        args = {'subdivisions': self.subdivisions, 'frames': self.frames}
+        result, _ = env.run_in_blender(_run, args)
+        return result
+
+
+def generate(env):
+    return [ClothTest(subdivisions=317, frames=10)]
@@ -0,0 +1,84 @@
+# SPDX-FileCopyrightText: 2025 Blender Authors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+import api
+
+
+def _run(args):
+    import bpy
+    import time
+
+    # Start from an empty scene, the benchmark does not need any file.
+    bpy.ops.wm.read_factory_settings(use_empty=True)
+    scene = bpy.context.scene
+
+    # A sphere of about 100k vertices, deformed differently on every frame by a wave modifier,
+    # so that the smoothing or solve has to run again for every frame.
+    bpy.ops.mesh.primitive_uv_sphere_add(segments=args['segments'], ring_count=args['segments'] // 2)
+    ob = bpy.context.object
+    wave = ob.modifiers.new("Wave", 'WAVE')
+    wave.height = 0.1
+    wave.width = 0.5
+
+    if args['modifier'] == 'CORRECTIVE_SMOOTH':
+        md = ob.modifiers.new("Smooth", 'CORRECTIVE_SMOOTH')
+        md.smooth_type = args['smooth_type']
+        md.iterations = 10
+        md.rest_source = 'ORCO'
+    else:
+        group = ob.vertex_groups.new(name="Anchors")
+        group.add([v.index for v in ob.data.vertices if abs(v.co.z) > 0.9], 1.0, 'REPLACE')
+        md = ob.modifiers.new("Deform", 'LAPLACIANDEFORM')
+        md.vertex_group = group.name
+        md.iterations = 2
+        with bpy.context.temp_override(object=ob):
+            bpy.ops.object.laplaciandeform_bind(modifier=md.name)
+
+    scene.frame_start = 1
+    scene.frame_end = args['frames']
+    depsgraph = bpy.context.evaluated_depsgraph_get()
+
+    start_time = time.time()
+    for frame in range(scene.frame_start, scene.frame_end + 1):
+        scene.frame_set(frame)
+        ob.evaluated_get(depsgraph)
+    elapsed_time = time.time() - start_time
+
+    result = {'time': elapsed_time / (scene.frame_end - scene.frame_start + 1)}
+    return result
+
+
+class DeformModifierTest(api.Test):
+    def __init__(self, modifier, smooth_type, segments, frames):
+        self.modifier = modifier
+        self.smooth_type = smooth_type
+        self.segments = segments
+        self.frames = frames
+
+    def name(self):
+        name = self.modifier.lower()
+        if self.smooth_type:
+            name += "_" + self.smooth_type.lower()
+        return "{}_{}k".format(name, self.segments * self.segments // 2 // 1000)
+
+    def category(self):
+        return "deform_modifiers"
+
+    def run(self, env, device_id):
+        args = {
+            'modifier': self.modifier,
+            'smooth_type': self.smooth_type,
+            'segments': self.segments,
+            'frames': self.frames,
+        }
+        result, _ = env.run_in_blender(_run, args)
+        return result
+
+
+def generate(env):
+    return [
+        DeformModifierTest('CORRECTIVE_SMOOTH', 'SIMPLE', segments=448, frames=10),
+        DeformModifierTest('CORRECTIVE_SMOOTH', 'LENGTH_WEIGHTED', segments=448, frames=10),
+        DeformModifierTest('LAPLACIANDEFORM', None, segments=448, frames=10),
+    ]
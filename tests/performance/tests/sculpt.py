@@ -135,6 +135,11 @@ def _run(args: dict):
 
     prepare_sculpt_scene(context, args['mode'])
 
+    if brush := args.get('brush'):
+        bpy.ops.brush.asset_activate(
+            asset_library_type='ESSENTIALS',
+            relative_asset_identifier="brushes/essentials_brushes-mesh_sculpt.blend/Brush/" + brush)
+
     context_override = context.copy()
     set_view3d_context_override(context_override)
 
@@ -171,6 +176,39 @@ class SculptBrushTest(api.Test):
         return result
 
 
+class SculptEssentialBrushTest(api.Test):
+    """
+    Replay the stroke with a brush from the essentials asset library, so that no benchmark file
+    is needed. Covers the brushes that share the vectorized distance, falloff and mask kernels.
+    """
+
+    def __init__(self, brush: str, mode: SculptMode):
+        self.brush = brush
+        self.mode = mode
+
+    def name(self):
+        name = "essentials_{}".format(self.brush.lower().replace(" ", "_"))
+        if self.mode == SculptMode.MESH:
+            return name
+
+        return "{}_{}".format(self.mode.name.lower(), name)
+
+    def category(self):
+        return "sculpt"
+
+    def run(self, env, _device_id):
+        args = {"mode": self.mode.value, "brush": self.brush}
+
+        result, _ = env.run_in_blender(_run, args)
+
+        return result
+
+
+ESSENTIAL_BRUSHES = ("Draw", "Clay Strips", "Smooth", "Grab")
+
+
 def generate(env):
     filepaths = env.find_blend_files('sculpt/*')
-    return [SculptBrushTest(filepath, mode) for filepath in filepaths for mode in SculptMode]
+    tests = [SculptBrushTest(filepath, mode) for filepath in filepaths for mode in SculptMode]
+    tests += [SculptEssentialBrushTest(brush, mode) for brush in ESSENTIAL_BRUSHES for mode in SculptMode]
+    return tests
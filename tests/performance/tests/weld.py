@@ -0,0 +1,73 @@
+# SPDX-FileCopyrightText: 2025 Blender Authors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+import api
+
+
+def _run(args):
+    import bmesh
+    import bpy
+    import time
+
+    # Start from an empty scene, the benchmark does not need any file.
+    bpy.ops.wm.read_factory_settings(use_empty=True)
+
+    # A grid with all faces split apart, so that every vertex has up to three duplicates, like
+    # meshes from CAD tessellation or photogrammetry that have to be cleaned up.
+    bpy.ops.mesh.primitive_grid_add(x_subdivisions=args['subdivisions'],
+                                    y_subdivisions=args['subdivisions'])
+    ob = bpy.context.object
+    bm = bmesh.new()
+    bm.from_mesh(ob.data)
+    bmesh.ops.split_edges(bm, edges=bm.edges[:])
+    bm.to_mesh(ob.data)
+    bm.free()
+
+    weld = ob.modifiers.new("Weld", 'WELD')
+    weld.mode = args['mode']
+    weld.merge_threshold = 0.0001
+
+    depsgraph = bpy.context.evaluated_depsgraph_get()
+    iterations = args['iterations']
+
+    start_time = time.time()
+    for _ in range(iterations):
+        ob.data.update()
+        depsgraph.update()
+        ob.evaluated_get(depsgraph)
+    elapsed_time = time.time() - start_time
+
+    result = {'time': elapsed_time / iterations}
+    return result
+
+
+class WeldTest(api.Test):
+    def __init__(self, mode, subdivisions, iterations):
+        self.mode = mode
+        self.subdivisions = subdivisions
+        self.iterations = iterations
+
+    def name(self):
+        verts_num = (self.subdivisions - 1) * (self.subdivisions - 1) * 4
+        return "weld_{}_{}m".format(self.mode.lower(), verts_num // 1000000)
+
+    def category(self):
+        return "weld"
+
+    def run(self, env, device_id):
+        args = {
+            'mode': self.mode,
+            'subdivisions': self.subdivisions,
+            'iterations': self.iterations,
+        }
+        result, _ = env.run_in_blender(_run, args)
+        return result
+
+
+def generate(env):
+    return [
+        WeldTest('ALL', subdivisions=1001, iterations=5),
+        WeldTest('ALL', subdivisions=1601, iterations=3),
+        WeldTest('CONNECTED', subdivisions=1601, iterations=3),
+    ]
@@ -0,0 +1,192 @@
+# SPDX-FileCopyrightText: 2025 Blender Authors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+# ./blender.bin --background --factory-startup --python tests/python/bl_depsgraph_incremental.py -- --verbose
+
+"""
+Check that the incremental relations update used by object duplication and deletion builds the
+same dependency graph as a full rebuild.
+
+The comparison itself is done by the dependency graph when `bpy.app.debug_depsgraph_validate` is
+enabled, it only reports a mismatch on the standard output and falls back to a full build. So the
+output of the update is captured and checked here.
+"""
+
+import ctypes
+import os
+import sys
+import tempfile
+import unittest
+
+import bpy
+
+
+def _libc_fflush():
+    if sys.platform == "win32":
+        libc = ctypes.cdll.ucrtbase
+    else:
+        libc = ctypes.CDLL(None)
+    libc.fflush(None)
+
+
+class CaptureOutput:
+    """Capture the standard output at the file descriptor level, to include C `printf`."""
+
+    def __enter__(self):
+        sys.stdout.flush()
+        _libc_fflush()
+        self._file = tempfile.TemporaryFile(mode="w+b")
+        self._stdout_fd = os.dup(1)
+        os.dup2(self._file.fileno(), 1)
+        self.text = ""
+        return self
+
+    def __exit__(self, exc_type, exc_value, traceback):
+        sys.stdout.flush()
+        _libc_fflush()
+        os.dup2(self._stdout_fd, 1)
+        os.close(self._stdout_fd)
+        self._file.seek(0)
+        self.text = self._file.read().decode("utf-8", errors="replace")
+        self._file.close()
+        # Keep the output visible in the test log.
+        sys.stdout.write(self.text)
+
+
+class DepsgraphIncrementalTest(unittest.TestCase):
+
+    def setUp(self):
+        bpy.ops.wm.read_factory_settings(use_empty=True)
+        self.debug_build = bpy.app.debug_depsgraph_build
+        self.debug_validate = bpy.app.debug_depsgraph_validate
+        bpy.app.debug_depsgraph_build = True
+        bpy.app.debug_depsgraph_validate = True
+
+        scene = bpy.context.scene
+        collection = scene.collection
+
+        def add_object(name, data=None, location=(0.0, 0.0, 0.0)):
+            ob = bpy.data.objects.new(name, data)
+            ob.location = location
+            collection.objects.link(ob)
+            return ob
+
+        self.parent = add_object("Parent", location=(1.0, 2.0, 3.0))
+        mesh = bpy.data.meshes.new("Mesh")
+        mesh.from_pydata([(0.0, 0.0, 0.0), (1.0, 0.0, 0.0), (0.0, 1.0, 0.0)], [], [(0, 1, 2)])
+        self.child = add_object("Child", mesh, location=(0.0, 0.0, 1.0))
+        self.child.parent = self.parent
+
+        self.target = add_object("Target", location=(4.0, 0.0, 0.0))
+        self.constrained = add_object("Constrained")
+        constraint = self.constrained.constraints.new('COPY_LOCATION')
+        constraint.target = self.target
+
+        self.driven = add_object("Driven")
+        fcurve = self.driven.driver_add("location", 0)
+        driver = fcurve.driver
+        driver.type = 'SCRIPTED'
+        driver.expression = "var * 2"
+        var = driver.variables.new()
+        var.type = 'SINGLE_PROP'
+        var.targets[0].id = self.target
+        var.targets[0].data_path = "location[0]"
+
+        # Build the initial graph, only updates of an existing graph can be incremental.
+        bpy.context.view_layer.update()
+
+    def tearDown(self):
+        bpy.app.debug_depsgraph_build = self.debug_build
+        bpy.app.debug_depsgraph_validate = self.debug_validate
+
+    def select(self, *objects):
+        view_layer = bpy.context.view_layer
+        for ob in view_layer.objects:
+            ob.select_set(ob in objects)
+        view_layer.objects.active = objects[0]
+
+    def run_and_update(self, operator, *, expect_incremental=True):
+        """
+        Run the operator and update the dependency graph, checking that the incremental update
+        matches the full build.
+        """
+        self.assertEqual(operator(), {'FINISHED'})
+        with CaptureOutput() as output:
+            bpy.context.view_layer.update()
+        self.assertNotIn("Depsgraph validation:", output.text)
+        self.assertNotIn("does not match full build", output.text)
+        if expect_incremental:
+            self.assertIn("objects added", output.text)
+
+    def duplicate(self, *objects):
+        self.select(*objects)
+        self.run_and_update(bpy.ops.object.duplicate)
+        return bpy.context.view_layer.objects.active
+
+    def evaluated_location(self, ob):
+        depsgraph = bpy.context.evaluated_depsgraph_get()
+        return tuple(ob.evaluated_get(depsgraph).matrix_world.translation)
+
+    def test_duplicate_parented(self):
+        child_new = self.duplicate(self.child)
+        self.assertEqual(child_new.parent, self.parent)
+        self.parent.location = (-1.0, 0.0, 0.0)
+        bpy.context.view_layer.update()
+        self.assertEqual(self.evaluated_location(child_new), (-1.0, 0.0, 1.0))
+
+    def test_duplicate_parent_with_child(self):
+        self.duplicate(self.parent, self.child)
+        child_new = next(ob for ob in bpy.context.selected_objects if ob.type == 'MESH')
+        self.assertNotEqual(child_new.parent, self.parent)
+        child_new.parent.location = (0.0, 5.0, 0.0)
+        bpy.context.view_layer.update()
+        self.assertEqual(self.evaluated_location(child_new), (0.0, 5.0, 1.0))
+
+    def test_duplicate_constrained(self):
+        constrained_new = self.duplicate(self.constrained)
+        self.assertEqual(constrained_new.constraints[0].target, self.target)
+        self.target.location = (0.0, 0.0, 7.0)
+        bpy.context.view_layer.update()
+        self.assertEqual(self.evaluated_location(constrained_new), (0.0, 0.0, 7.0))
+
+    def test_duplicate_driven(self):
+        driven_new = self.duplicate(self.driven)
+        self.target.location = (3.0, 0.0, 0.0)
+        bpy.context.view_layer.update()
+        self.assertEqual(self.evaluated_location(driven_new)[0], 6.0)
+
+    def test_duplicate_target(self):
+        # The duplicated target has no users yet, existing relations have to stay untouched.
+        self.duplicate(self.target)
+        self.target.location = (2.0, 0.0, 0.0)
+        bpy.context.view_layer.update()
+        self.assertEqual(self.evaluated_location(self.constrained), (2.0, 0.0, 0.0))
+        self.assertEqual(self.evaluated_location(self.driven)[0], 4.0)
+
+    def test_delete(self):
+        self.select(self.child, self.constrained, self.driven)
+        self.run_and_update(bpy.ops.object.delete)
+        self.assertEqual(set(bpy.context.scene.objects), {self.parent, self.target})
+
+    def test_delete_duplicates(self):
+        self.duplicate(self.child, self.constrained, self.driven)
+        self.run_and_update(bpy.ops.object.delete)
+        self.assertEqual(len(bpy.context.scene.objects), 5)
+        self.target.location = (1.0, 0.0, 0.0)
+        bpy.context.view_layer.update()
+        self.assertEqual(self.evaluated_location(self.constrained), (1.0, 0.0, 0.0))
+        self.assertEqual(self.evaluated_location(self.driven)[0], 2.0)
+
+    def test_delete_used_objects(self):
+        # Other objects depend on the deleted ones, the update may fall back to a full build.
+        self.select(self.parent, self.target)
+        self.run_and_update(bpy.ops.object.delete, expect_incremental=False)
+        self.assertIsNone(self.child.parent)
+        bpy.context.view_layer.update()
+        self.assertEqual(self.evaluated_location(self.child), (0.0, 0.0, 1.0))
+
+
+if __name__ == "__main__":
+    sys.argv = [__file__] + (sys.argv[sys.argv.index("--") + 1:] if "--" in sys.argv else [])
+    unittest.main()
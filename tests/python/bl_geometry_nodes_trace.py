@@ -0,0 +1,146 @@
+# SPDX-FileCopyrightText: 2025 Blender Authors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+# ./blender.bin --background --factory-startup --python tests/python/bl_geometry_nodes_trace.py -- --verbose
+
+import json
+import os
+import sys
+import tempfile
+import unittest
+
+import bpy
+
+trace = bpy.app.geometry_nodes_trace
+
+
+def new_geometry_tree(name):
+    tree = bpy.data.node_groups.new(name, "GeometryNodeTree")
+    tree.interface.new_socket("Geometry", in_out='INPUT', socket_type='NodeSocketGeometry')
+    tree.interface.new_socket("Geometry", in_out='OUTPUT', socket_type='NodeSocketGeometry')
+    group_input = tree.nodes.new("NodeGroupInput")
+    group_output = tree.nodes.new("NodeGroupOutput")
+    return tree, group_input, group_output
+
+
+class GeometryNodesTraceTest(unittest.TestCase):
+
+    def setUp(self):
+        bpy.ops.wm.read_factory_settings(use_empty=True)
+
+        inner_tree, inner_input, inner_output = new_geometry_tree("Inner")
+        transform = inner_tree.nodes.new("GeometryNodeTransform")
+        transform.name = "Transform"
+        inner_tree.links.new(inner_input.outputs[0], transform.inputs["Geometry"])
+        inner_tree.links.new(transform.outputs["Geometry"], inner_output.inputs[0])
+
+        tree, group_input, group_output = new_geometry_tree("Trace")
+        nodes = tree.nodes
+        links = tree.links
+        triangulate = nodes.new("GeometryNodeTriangulate")
+        triangulate.name = "Triangulate"
+        group = nodes.new("GeometryNodeGroup")
+        group.name = "Group"
+        group.node_tree = inner_tree
+        repeat_input = nodes.new("GeometryNodeRepeatInput")
+        repeat_output = nodes.new("GeometryNodeRepeatOutput")
+        repeat_output.name = "Repeat Output"
+        repeat_input.pair_with_output(repeat_output)
+        repeat_input.inputs["Iterations"].default_value = 2
+        set_position = nodes.new("GeometryNodeSetPosition")
+        set_position.name = "Set Position"
+
+        links.new(group_input.outputs[0], triangulate.inputs["Mesh"])
+        links.new(triangulate.outputs["Mesh"], group.inputs[0])
+        links.new(group.outputs[0], repeat_input.inputs["Geometry"])
+        links.new(repeat_input.outputs["Geometry"], set_position.inputs["Geometry"])
+        links.new(set_position.outputs["Geometry"], repeat_output.inputs["Geometry"])
+        links.new(repeat_output.outputs["Geometry"], group_output.inputs[0])
+
+        mesh = bpy.data.meshes.new("Quad")
+        mesh.from_pydata([(0.0, 0.0, 0.0), (1.0, 0.0, 0.0), (1.0, 1.0, 0.0), (0.0, 1.0, 0.0)],
+                         [], [(0, 1, 2, 3)])
+        self.object = bpy.data.objects.new("Object", mesh)
+        bpy.context.scene.collection.objects.link(self.object)
+        modifier = self.object.modifiers.new("Trace", 'NODES')
+        modifier.node_group = tree
+
+        self._tempdir = tempfile.TemporaryDirectory()
+        self.filepath = os.path.join(self._tempdir.name, "trace.json")
+
+    def tearDown(self):
+        trace.stop()
+        trace.clear()
+        self._tempdir.cleanup()
+
+    def record(self):
+        trace.start()
+        self.assertTrue(trace.is_recording())
+        bpy.context.evaluated_depsgraph_get()
+        trace.stop()
+        self.assertFalse(trace.is_recording())
+        trace.write(self.filepath)
+        with open(self.filepath, encoding="utf-8") as fh:
+            return json.load(fh)
+
+    def test_structure(self):
+        data = self.record()
+        self.assertEqual(set(data.keys()), {"traceEvents", "displayTimeUnit"})
+        events = data["traceEvents"]
+        thread_names = [event for event in events if event["ph"] == "M"]
+        node_events = [event for event in events if event["ph"] == "X"]
+        self.assertEqual(len(thread_names) + len(node_events), len(events))
+        self.assertEqual(len(node_events), trace.events_num())
+
+        thread_ids = set()
+        for event in thread_names:
+            self.assertEqual(event["name"], "thread_name")
+            self.assertEqual(event["args"]["name"], "Thread {:d}".format(event["tid"]))
+            thread_ids.add(event["tid"])
+        self.assertEqual(len(thread_ids), len(thread_names))
+
+        for event in node_events:
+            self.assertEqual(
+                set(event.keys()), {"name", "cat", "ph", "ts", "dur", "pid", "tid", "args"})
+            self.assertIn(event["cat"], {"Node", "Group Node", "Zone Iteration"})
+            self.assertIn(event["tid"], thread_ids)
+            self.assertGreaterEqual(event["ts"], 0.0)
+            self.assertGreaterEqual(event["dur"], 0.0)
+            self.assertTrue(event["args"]["context"].startswith("Modifier: Trace"))
+            self.assertTrue(set(event["args"].keys()) <= {"context", "inputs", "outputs"})
+
+    def test_events(self):
+        events = [event for event in self.record()["traceEvents"] if event["ph"] == "X"]
+
+        def find_events(name, cat):
+            return [event for event in events if event["name"] == name and event["cat"] == cat]
+
+        triangulate = find_events("Triangulate", "Node")
+        self.assertEqual(len(triangulate), 1)
+        counts = {"points": 4, "faces": 1, "curves": 0, "instances": 0}
+        self.assertEqual(triangulate[0]["args"]["inputs"], counts)
+        self.assertEqual(triangulate[0]["args"]["outputs"], dict(counts, faces=2))
+
+        self.assertEqual(len(find_events("Group", "Group Node")), 1)
+        transform = find_events("Transform", "Node")
+        self.assertEqual(len(transform), 1)
+        self.assertEqual(transform[0]["args"]["context"], "Modifier: Trace > Node: Group")
+
+        self.assertEqual(len(find_events("Repeat Output [0]", "Zone Iteration")), 1)
+        self.assertEqual(len(find_events("Repeat Output [1]", "Zone Iteration")), 1)
+        set_position = find_events("Set Position", "Node")
+        self.assertEqual(len(set_position), 2)
+        self.assertEqual(sorted(event["args"]["context"][-3:] for event in set_position),
+                         ["[0]", "[1]"])
+
+    def test_not_recording(self):
+        trace.start()
+        trace.stop()
+        bpy.context.evaluated_depsgraph_get()
+        self.assertEqual(trace.events_num(), 0)
+
+
+if __name__ == "__main__":
+    sys.argv = [__file__] + (sys.argv[sys.argv.index("--") + 1:] if "--" in sys.argv else [])
+    unittest.main()
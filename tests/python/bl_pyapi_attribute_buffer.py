@@ -0,0 +1,103 @@
+# SPDX-FileCopyrightText: 2025 Blender Authors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+# ./blender.bin --background --python tests/python/bl_pyapi_attribute_buffer.py -- --verbose
+import bpy
+import unittest
+
+
+class TestAttributeBuffer(unittest.TestCase):
+
+    def setUp(self):
+        self.mesh = bpy.data.meshes.new("test_mesh")
+        self.mesh.from_pydata(
+            [(0.0, 0.0, 0.0), (1.0, 0.0, 0.0), (1.0, 1.0, 0.0), (0.0, 1.0, 0.0), (2.0, 0.0, 0.0)],
+            [],
+            [(0, 1, 2, 3), (1, 4, 2)],
+        )
+
+    def tearDown(self):
+        bpy.data.meshes.remove(self.mesh)
+        del self.mesh
+
+    def test_position_read(self):
+        buf = self.mesh.attributes["position"].as_buffer()
+        self.assertEqual(buf.shape, (5, 3))
+        self.assertEqual(buf.format, "f")
+        self.assertTrue(buf.readonly)
+        self.assertEqual(buf.tolist()[4], [2.0, 0.0, 0.0])
+
+    def test_position_write(self):
+        with self.mesh.attributes["position"].as_buffer(write=True) as buf:
+            self.assertFalse(buf.readonly)
+            buf[4, 1] = 3.0
+        self.assertEqual(tuple(self.mesh.vertices[4].co), (2.0, 3.0, 0.0))
+
+    def test_read_only(self):
+        buf = self.mesh.attributes["position"].as_buffer()
+        with self.assertRaises(TypeError):
+            buf[0, 0] = 1.0
+
+    def test_write_after_copy(self):
+        # Writing must not change a copy of the mesh that shares the array.
+        mesh_copy = self.mesh.copy()
+        with self.mesh.attributes["position"].as_buffer(write=True) as buf:
+            buf[0, 0] = -1.0
+        self.assertEqual(mesh_copy.vertices[0].co[0], 0.0)
+        self.assertEqual(self.mesh.vertices[0].co[0], -1.0)
+        bpy.data.meshes.remove(mesh_copy)
+
+    def test_copy_while_writing(self):
+        # A copy made while the buffer is in use must not see later writes.
+        with self.mesh.attributes["position"].as_buffer(write=True) as buf:
+            buf[0, 0] = -1.0
+            mesh_copy = self.mesh.copy()
+            buf[1, 0] = -2.0
+        self.assertEqual(mesh_copy.vertices[0].co[0], 0.0)
+        self.assertEqual(mesh_copy.vertices[1].co[0], 1.0)
+        self.assertEqual(self.mesh.vertices[0].co[0], -1.0)
+        self.assertEqual(self.mesh.vertices[1].co[0], -2.0)
+        bpy.data.meshes.remove(mesh_copy)
+
+    def test_write_outlives_mesh(self):
+        # The copy of a freed mesh stays writable, but its values are dropped on release.
+        buf = self.mesh.attributes["position"].as_buffer(write=True)
+        bpy.data.meshes.remove(self.mesh)
+        self.setUp()
+        buf[0, 0] = 7.0
+        self.assertEqual(buf[0, 0], 7.0)
+        buf.release()
+        self.assertEqual([tuple(v.co) for v in self.mesh.vertices], [
+            (0.0, 0.0, 0.0), (1.0, 0.0, 0.0), (1.0, 1.0, 0.0), (0.0, 1.0, 0.0), (2.0, 0.0, 0.0)])
+
+    def test_corner_vert_write(self):
+        with self.mesh.attributes[".corner_vert"].as_buffer(write=True) as buf:
+            buf[6] = 3
+        self.assertEqual(tuple(self.mesh.polygons[1].vertices), (1, 4, 3))
+
+    def test_outlives_mesh(self):
+        buf = self.mesh.attributes["position"].as_buffer()
+        bpy.data.meshes.remove(self.mesh)
+        self.mesh = bpy.data.meshes.new("test_mesh")
+        self.assertEqual(buf.tolist()[1], [1.0, 0.0, 0.0])
+
+    def test_topology(self):
+        self.assertEqual(self.mesh.offsets_as_buffer().tolist(), [0, 4, 7])
+        self.assertEqual(self.mesh.attributes[".corner_vert"].as_buffer().tolist(),
+                         [0, 1, 2, 3, 1, 4, 2])
+
+    def test_types(self):
+        attributes = self.mesh.attributes
+        self.assertEqual(attributes.new("f", 'FLOAT', 'POINT').as_buffer().shape, (5,))
+        self.assertEqual(attributes.new("c", 'FLOAT_COLOR', 'CORNER').as_buffer().shape, (7, 4))
+        self.assertEqual(attributes.new("b", 'BOOLEAN', 'FACE').as_buffer().format, "?")
+        self.assertEqual(attributes.new("m", 'FLOAT4X4', 'FACE').as_buffer().shape, (2, 4, 4))
+        with self.assertRaises(TypeError):
+            attributes.new("s", 'STRING', 'POINT').as_buffer()
+
+
+if __name__ == "__main__":
+    import sys
+    sys.argv = [__file__] + (sys.argv[sys.argv.index("--") + 1:] if "--" in sys.argv else [])
+    unittest.main()